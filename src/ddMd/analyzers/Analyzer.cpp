@@ -30,7 +30,8 @@ namespace DdMd
     : ParamComposite(),
       outputFileName_(),
       simulationPtr_(&simulation),
-      interval_(1)
+      interval_(1),
+      observables_(0)
    {}
 
    /*
@@ -131,6 +131,14 @@ namespace DdMd
       */
       bool isAtInterval(long counter) const;
 
+      /**
+      * Get observables required by sample(), as Simulation::ObservableFlag bits.
+      *
+      * The Integrator computes these observables in the force calculation
+      * that precedes each step at which this analyzer is sampled.
+      */
+      int observables() const;
+
       // Static members
 
       /**
@@ -195,6 +203,15 @@ namespace DdMd
       */
       void saveOutputFileName(Serializable::OArchive &ar);
 
+      /**
+      * Register observables required by the sample() method.
+      *
+      * Should be called in the subclass constructor.
+      *
+      * \param flags bitwise OR of Simulation::ObservableFlag values
+      */
+      void addObservables(int flags);
+
       /**
       * Get the parent Simulation by reference.
       */
@@ -221,6 +238,9 @@ namespace DdMd
       /// Number of simulation steps between subsequent actions.
       long   interval_;
 
+      /// Observables required by sample(), as Simulation::ObservableFlag bits.
+      int    observables_;
+
    };
 
    // Inline methods
@@ -237,6 +257,18 @@ namespace DdMd
    inline bool Analyzer::isAtInterval(long counter) const
    {  return (counter%interval_ == 0); }
 
+   /*
+   * Return observables required by sample().
+   */
+   inline int Analyzer::observables() const
+   {  return observables_; }
+
+   /*
+   * Register observables required by sample().
+   */
+   inline void Analyzer::addObservables(int flags)
+   {  observables_ |= flags; }
+
    /*
    * Get the outputFileName string.
    */
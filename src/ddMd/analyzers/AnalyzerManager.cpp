@@ -96,6 +96,24 @@ namespace DdMd
       }
    }
  
+   /*
+   * Return observables required by analyzers scheduled at step iStep.
+   */
+   int AnalyzerManager::observables(long iStep) const
+   {
+      int flags = 0;
+      if (Analyzer::baseInterval > 0) {
+         if (iStep % Analyzer::baseInterval == 0) { 
+            for (int i=0; i < size(); ++i) {
+               if ((*this)[i].isAtInterval(iStep)) {
+                  flags |= (*this)[i].observables();
+               }
+            }
+         }
+      }
+      return flags;
+   }
+ 
    /*
    * Call output method of each analyzer.
    */
@@ -81,6 +81,17 @@ namespace DdMd
       * \param iStep time step counter
       */
       void sample(long iStep);
+
+      /**
+      * Return observables required by analyzers scheduled at a step.
+      *
+      * Returns a bitwise OR of the Simulation::ObservableFlag values
+      * registered by all analyzers whose sample method will act at 
+      * step iStep, as defined in the sample() method, or 0 if none.
+      *
+      * \param iStep time step counter
+      */
+      int observables(long iStep) const;
  
       /**
       * Call output method of each analyzer.
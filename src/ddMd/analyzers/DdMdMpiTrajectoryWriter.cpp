@@ -0,0 +1,133 @@
+#ifndef DDMD_DDMD_MPI_TRAJECTORY_WRITER_CPP
+#define DDMD_DDMD_MPI_TRAJECTORY_WRITER_CPP
+
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2012, David Morse (morse012@umn.edu)
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "DdMdMpiTrajectoryWriter.h"
+#include <ddMd/simulation/Simulation.h>
+#include <ddMd/storage/AtomStorage.h>
+#include <ddMd/storage/AtomIterator.h>
+#include <ddMd/chemistry/Atom.h>
+#include <util/archives/MemoryCounter.h>
+#include <util/boundary/Boundary.h>
+#include <util/space/Vector.h>
+
+#include <fstream>
+#include <string>
+
+namespace DdMd
+{
+
+   using namespace Util;
+
+   /*
+   * Constructor.
+   */
+   DdMdMpiTrajectoryWriter::DdMdMpiTrajectoryWriter(Simulation& simulation)
+    : DdMdTrajectoryWriter(simulation),
+      buffer_()
+   {  setClassName("DdMdMpiTrajectoryWriter"); }
+
+   /*
+   * Destructor.
+   */
+   DdMdMpiTrajectoryWriter::~DdMdMpiTrajectoryWriter()
+   {}
+
+   /*
+   * Write frame to file, header on first sample.
+   */
+   void DdMdMpiTrajectoryWriter::sample(long iStep)
+   {
+      if (isAtInterval(iStep))  {
+
+         // Write the header through the master processor
+         if (nSample_ == 0) {
+            std::ofstream file;
+            if (domain().isMaster()) {
+               simulation().fileMaster().openOutputFile(outputFileName(),
+                                                        file);
+            }
+            writeHeader(file, iStep);
+            if (domain().isMaster()) {
+               file.close();
+            }
+         }
+
+         writeSharedFrame();
+         ++nSample_;
+      }
+   }
+
+   /*
+   * Append one frame to the file, using a single collective write.
+   *
+   * The master (rank 0) writes the boundary, followed by its own atoms.
+   * Each other processor writes its atoms after those of all lower ranks.
+   */
+   void DdMdMpiTrajectoryWriter::writeSharedFrame()
+   {
+      MPI::Intracomm& communicator = domain().communicator();
+      Vector r;
+      AtomIterator atomIter;
+      int id, typeId, nAtom, nAtomBefore;
+      bool isCartesian = atomStorage().isCartesian();
+
+      MemoryCounter counter;
+      counter << boundary();
+      MPI::Offset boundarySize = counter.size();
+      MPI::Offset recordSize = 2*sizeof(int) + 2*sizeof(Vector);
+
+      // Allocate buffer for the boundary and all local atoms
+      if (!buffer_.isAllocated()) {
+         buffer_.allocate(boundarySize
+                          + recordSize*atomStorage().atomCapacity());
+      }
+
+      // Count atoms on lower ranked processors
+      nAtom = atomStorage().nAtom();
+      communicator.Scan(&nAtom, &nAtomBefore, 1, MPI::INT, MPI::SUM);
+      nAtomBefore -= nAtom;
+
+      // Pack boundary (master only) and local atom records
+      buffer_.clear();
+      if (domain().isMaster()) {
+         buffer_ << boundary();
+      }
+      atomStorage().begin(atomIter);
+      for ( ; atomIter.notEnd(); ++atomIter) {
+         id = atomIter->id();
+         typeId = atomIter->typeId();
+         buffer_ << id;
+         buffer_ << typeId;
+         if (isCartesian) {
+            r = atomIter->position();
+         } else {
+            boundary().transformGenToCart(atomIter->position(), r);
+         }
+         buffer_ << r;
+         buffer_ << atomIter->velocity();
+      }
+
+      // Open file, and write all blocks after the end of the file
+      std::string filename
+                    = simulation().fileMaster().outputFilePath(outputFileName());
+      MPI::File file = MPI::File::Open(communicator, filename.c_str(),
+                                       MPI::MODE_WRONLY | MPI::MODE_CREATE,
+                                       MPI::INFO_NULL);
+      MPI::Offset offset = file.Get_size();
+      if (!domain().isMaster()) {
+         offset += boundarySize + recordSize*nAtomBefore;
+      }
+      int size = buffer_.cursor() - buffer_.begin();
+      file.Write_at_all(offset, buffer_.begin(), size, MPI::BYTE);
+      file.Close();
+   }
+
+}
+#endif
@@ -0,0 +1,75 @@
+#ifndef DDMD_DDMD_MPI_TRAJECTORY_WRITER_H
+#define DDMD_DDMD_MPI_TRAJECTORY_WRITER_H
+
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2012, David Morse (morse012@umn.edu)
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <ddMd/analyzers/DdMdTrajectoryWriter.h>   // base class
+#include <util/archives/MemoryOArchive.h>          // member
+
+namespace DdMd
+{
+
+   using namespace Util;
+
+   /**
+   * Native binary trajectory format for ddSim, written with MPI-IO.
+   *
+   * The file has the same format as that written by DdMdTrajectoryWriter.
+   * The header is written by the master processor, as for the base class.
+   * Each frame is written by a single collective MPI-IO write, in which
+   * every processor writes the records of the atoms it owns into its own
+   * block of the file, at an offset given by the number of atoms owned
+   * by lower ranked processors. Atoms thus need never be sent to the
+   * master processor. Atom records appear in a different order than in
+   * a file written by DdMdTrajectoryWriter, but each record contains
+   * the atom id, which readers use to identify the atom.
+   *
+   * The file is opened and closed by all processors for each frame, and
+   * each frame is appended at the end of the file. After a restart, new
+   * frames are thus appended to the existing file.
+   *
+   * \ingroup DdMd_Analyzer_Module
+   */
+   class DdMdMpiTrajectoryWriter : public DdMdTrajectoryWriter
+   {
+
+   public:
+
+      /**
+      * Constructor.
+      *
+      * \param simulation parent Simulation object
+      */
+      DdMdMpiTrajectoryWriter(Simulation& simulation);
+
+      /**
+      * Destructor.
+      */
+      virtual ~DdMdMpiTrajectoryWriter();
+
+      /**
+      * Write a frame to file, and the header on the first sample.
+      *
+      * \param iStep MD time step index
+      */
+      virtual void sample(long iStep);
+
+   private:
+
+      /// Buffer for the atom records of this processor.
+      MemoryOArchive buffer_;
+
+      /**
+      * Append one frame to the file, using a collective write.
+      */
+      void writeSharedFrame();
+
+   };
+
+}
+#endif
@@ -33,13 +33,16 @@ namespace DdMd
       accumulator_(NULL),
       nSamplePerBlock_(1),
       isInitialized_(false)
-   {  setClassName("ExternalEnergyAverage"); }
+   {
+      setClassName("ExternalEnergyAverage");
+      addObservables(Simulation::POTENTIAL_ENERGIES);
+   }
 
    /*
    * Destructor.
    */
    ExternalEnergyAverage::~ExternalEnergyAverage() 
-   {  
+   {
       if(accumulator_ != NULL) {
          delete accumulator_;
       }
@@ -38,7 +38,10 @@ namespace DdMd
     : Analyzer(simulation),
       nSample_(0),
       isInitialized_(false)
-   {  setClassName("LogEnergy"); }
+   {
+      setClassName("LogEnergy");
+      addObservables(Simulation::POTENTIAL_ENERGIES);
+   }
 
    /*
    * Read interval and outputFileName. 
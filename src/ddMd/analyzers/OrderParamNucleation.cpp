@@ -149,15 +149,10 @@ namespace DdMd
          }
 
          #ifdef UTIL_MPI
-         // Loop over wavevectors
-         for (int i = 0; i < nAtomType_; ++i) {
-            for (int j = 0; j < nBin_; ++j) {
-            //Sum values from all processors.
-            simulation().domain().communicator().
-                         Reduce(&cosFactors_(i, j), &totalCosFactors_(i, j),
-                                1, MPI::DOUBLE, MPI::SUM, 0);
-            }
-         }
+         // Sum values from all processors, in one reduction.
+         simulation().domain().communicator().
+                      Reduce(&cosFactors_(0, 0), &totalCosFactors_(0, 0),
+                             nAtomType_*nBin_, MPI::DOUBLE, MPI::SUM, 0);
          #else
          for (int i = 0; i < nAtomType_; ++i) {
             for (int j = 0; j < nBin_; ++j) {
@@ -28,7 +28,10 @@ namespace DdMd
     : Analyzer(simulation),
       nSample_(0),
       isInitialized_(false)
-   {  setClassName("OutputBoxdim"); }
+   {
+      setClassName("OutputBoxdim");
+      addObservables(Simulation::VIRIAL_STRESS);
+   }
 
    /*
    * Read interval and outputFileName.
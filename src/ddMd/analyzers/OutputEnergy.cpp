@@ -41,7 +41,10 @@ namespace DdMd
     : Analyzer(simulation),
       nSample_(0),
       isInitialized_(false)
-   {  setClassName("OutputEnergy"); }
+   {
+      setClassName("OutputEnergy");
+      addObservables(Simulation::POTENTIAL_ENERGIES);
+   }
 
    /*
    * Read interval and outputFileName. 
@@ -0,0 +1,355 @@
+#ifndef DDMD_RDF_CPP
+#define DDMD_RDF_CPP
+
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2012, David Morse (morse012@umn.edu)
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "RDF.h"
+#include <ddMd/storage/AtomStorage.h>
+#include <ddMd/storage/AtomIterator.h>
+#include <ddMd/storage/GhostIterator.h>
+#include <ddMd/communicate/Domain.h>
+#include <ddMd/potentials/pair/PairPotential.h>
+#include <util/boundary/Boundary.h>
+#include <util/space/Dimension.h>
+#include <util/math/feq.h>
+#include <util/mpi/MpiLoader.h>
+#include <util/misc/ioUtil.h>
+
+namespace DdMd
+{
+
+   using namespace Util;
+
+   /*
+   * Constructor.
+   */
+   RDF::RDF(Simulation& simulation)
+    : Analyzer(simulation),
+      outputFile_(),
+      accumulator_(),
+      cellAtoms_(),
+      atomPtrs_(),
+      atomCells_(),
+      cellBegin_(),
+      typeNumbers_(),
+      totalTypeNumbers_(),
+      gridDimensions_(),
+      max_(1.0),
+      normSum_(0.0),
+      nBin_(1),
+      atomTypeId1_(-1),
+      atomTypeId2_(-1),
+      nAtomType_(0),
+      isInitialized_(false)
+   {  setClassName("RDF"); }
+
+   /*
+   * Destructor.
+   */
+   RDF::~RDF()
+   {}
+
+   /*
+   * Read parameters from file, and allocate arrays.
+   */
+   void RDF::readParameters(std::istream& in)
+   {
+      readInterval(in);
+      readOutputFileName(in);
+      read<double>(in, "max", max_);
+      read<int>(in, "nBin", nBin_);
+      atomTypeId1_ = -1;
+      atomTypeId2_ = -1;
+      read<int>(in, "atomTypeId1", atomTypeId1_, false);
+      read<int>(in, "atomTypeId2", atomTypeId2_, false);
+
+      accumulator_.setParam(max_, nBin_);
+      allocate();
+      normSum_ = 0.0;
+      isInitialized_ = true;
+   }
+
+   /*
+   * Load internal state from an archive.
+   */
+   void RDF::loadParameters(Serializable::IArchive &ar)
+   {
+      loadInterval(ar);
+      loadOutputFileName(ar);
+      loadParameter<double>(ar, "max", max_);
+      loadParameter<int>(ar, "nBin", nBin_);
+      atomTypeId1_ = -1;
+      atomTypeId2_ = -1;
+      loadParameter<int>(ar, "atomTypeId1", atomTypeId1_, false);
+      loadParameter<int>(ar, "atomTypeId2", atomTypeId2_, false);
+
+      accumulator_.setParam(max_, nBin_);
+      normSum_ = 0.0;
+      if (simulation().domain().isMaster()) {
+         ar >> accumulator_;
+         ar >> normSum_;
+         if (nBin_ != accumulator_.nBin()) {
+            UTIL_THROW("Inconsistent nBin values");
+         }
+         if (!feq(max_, accumulator_.max())) {
+            UTIL_THROW("Inconsistent max values");
+         }
+      }
+      allocate();
+      isInitialized_ = true;
+   }
+
+   /*
+   * Save internal state to an archive.
+   */
+   void RDF::save(Serializable::OArchive &ar)
+   {
+      saveInterval(ar);
+      saveOutputFileName(ar);
+      ar << max_;
+      ar << nBin_;
+      Parameter::saveOptional(ar, atomTypeId1_, (atomTypeId1_ >= 0));
+      Parameter::saveOptional(ar, atomTypeId2_, (atomTypeId2_ >= 0));
+      ar << accumulator_;
+      ar << normSum_;
+   }
+
+   /*
+   * Allocate work arrays.
+   */
+   void RDF::allocate()
+   {
+      nAtomType_ = simulation().nAtomType();
+      int capacity = simulation().atomStorage().atomCapacity()
+                   + simulation().atomStorage().ghostCapacity();
+      cellAtoms_.allocate(capacity);
+      atomPtrs_.allocate(capacity);
+      atomCells_.allocate(capacity);
+      typeNumbers_.allocate(nAtomType_);
+      totalTypeNumbers_.allocate(nAtomType_);
+   }
+
+   /*
+   * Clear accumulator.
+   */
+   void RDF::clear()
+   {
+      if (!isInitialized_) {
+         UTIL_THROW("Object not initialized");
+      }
+      accumulator_.clear();
+      normSum_ = 0.0;
+   }
+
+   /*
+   * Sort local and ghost atoms into a grid of cells of width >= max_.
+   *
+   * The interior cells cover the processor domain, extended by half the
+   * pair list skin on each side, since local atoms may drift that far
+   * outside the domain between exchanges. One additional layer of cells
+   * surrounds the interior. Local atoms are listed first in atomPtrs_,
+   * and ghosts outside the grid are discarded.
+   */
+   void RDF::buildCells()
+   {
+      const Boundary& boundary = simulation().boundary();
+      const Domain& domain = simulation().domain();
+      AtomStorage& storage = simulation().atomStorage();
+      Vector lower, widths;
+      double length, margin;
+      int i, m, nCell;
+
+      nCell = 1;
+      for (i = 0; i < Dimension; ++i) {
+         margin = 0.5*simulation().pairPotential().skin()/boundary.length(i);
+         lower[i] = domain.domainBound(i, 0) - margin;
+         length = domain.domainBound(i, 1) + margin - lower[i];
+         m = int(length*boundary.length(i)/max_);
+         if (m < 1) {
+            m = 1;
+         }
+         widths[i] = length/double(m);
+         gridDimensions_[i] = m + 2;
+         nCell *= gridDimensions_[i];
+      }
+      if (cellBegin_.capacity() < nCell + 1) {
+         if (cellBegin_.isAllocated()) {
+            cellBegin_.deallocate();
+         }
+         cellBegin_.allocate(nCell + 1);
+      }
+      for (i = 0; i <= nCell; ++i) {
+         cellBegin_[i] = 0;
+      }
+
+      // Find cell for each atom, and count atoms per cell
+      AtomIterator  atomIter;
+      GhostIterator ghostIter;
+      Vector r;
+      double x;
+      int cell, c, nAtom;
+      bool inGrid;
+      nAtom = 0;
+      for (storage.begin(atomIter); atomIter.notEnd(); ++atomIter) {
+         boundary.transformCartToGen(atomIter->position(), r);
+         cell = 0;
+         for (i = 0; i < Dimension; ++i) {
+            c = int((r[i] - lower[i])/widths[i]) + 1;
+            if (c < 1) c = 1;
+            if (c > gridDimensions_[i] - 2) c = gridDimensions_[i] - 2;
+            cell = cell*gridDimensions_[i] + c;
+         }
+         atomPtrs_[nAtom] = atomIter.get();
+         atomCells_[nAtom] = cell;
+         ++cellBegin_[cell + 1];
+         ++nAtom;
+      }
+      for (storage.begin(ghostIter); ghostIter.notEnd(); ++ghostIter) {
+         boundary.transformCartToGen(ghostIter->position(), r);
+         cell = 0;
+         inGrid = true;
+         for (i = 0; i < Dimension; ++i) {
+            x = (r[i] - lower[i])/widths[i] + 1.0;
+            if (x < 0.0 || x >= double(gridDimensions_[i])) {
+               inGrid = false;
+               break;
+            }
+            cell = cell*gridDimensions_[i] + int(x);
+         }
+         if (inGrid) {
+            atomPtrs_[nAtom] = ghostIter.get();
+            atomCells_[nAtom] = cell;
+            ++cellBegin_[cell + 1];
+            ++nAtom;
+         }
+      }
+
+      // Convert counts to offsets, and sort atoms by cell
+      for (i = 0; i < nCell; ++i) {
+         cellBegin_[i+1] += cellBegin_[i];
+      }
+      for (i = 0; i < nAtom; ++i) {
+         cell = atomCells_[i];
+         cellAtoms_[cellBegin_[cell]] = atomPtrs_[i];
+         ++cellBegin_[cell];
+      }
+      for (i = nCell; i > 0; --i) {
+         cellBegin_[i] = cellBegin_[i-1];
+      }
+      cellBegin_[0] = 0;
+   }
+
+   /*
+   * Add particle pairs to RDF histogram.
+   */
+   void RDF::sample(long iStep)
+   {
+      if (!isAtInterval(iStep))  return;
+
+      if (max_ > simulation().pairPotential().maxPairCutoff()) {
+         UTIL_THROW("RDF max exceeds maximum pair potential cutoff");
+      }
+      buildCells();
+      accumulator_.beginSnapshot();
+
+      const Atom* atom1Ptr;
+      const Atom* atom2Ptr;
+      Vector dr;
+      double maxSq, dRsq;
+      int i, nLocal, cell1, cell2, k2, dx, dy, dz, type1;
+      const int ny = gridDimensions_[1];
+      const int nz = gridDimensions_[2];
+
+      for (i = 0; i < nAtomType_; ++i) {
+         typeNumbers_[i] = 0;
+      }
+      maxSq = max_*max_;
+
+      // Loop over local atoms (listed first in atomPtrs_)
+      nLocal = simulation().atomStorage().nAtom();
+      for (i = 0; i < nLocal; ++i) {
+         atom1Ptr = atomPtrs_[i];
+         type1 = atom1Ptr->typeId();
+         ++typeNumbers_[type1];
+         if (atomTypeId1_ >= 0 && type1 != atomTypeId1_) continue;
+
+         // Loop over atoms in this and neighboring cells
+         cell1 = atomCells_[i];
+         for (dx = -1; dx <= 1; ++dx) {
+            for (dy = -1; dy <= 1; ++dy) {
+               for (dz = -1; dz <= 1; ++dz) {
+                  cell2 = cell1 + (dx*ny + dy)*nz + dz;
+                  for (k2 = cellBegin_[cell2]; k2 < cellBegin_[cell2+1]; ++k2) {
+                     atom2Ptr = cellAtoms_[k2];
+                     if (atom2Ptr == atom1Ptr) continue;
+                     if (atomTypeId2_ >= 0 &&
+                         atom2Ptr->typeId() != atomTypeId2_) continue;
+                     dr.subtract(atom1Ptr->position(), atom2Ptr->position());
+                     dRsq = dr.square();
+                     if (dRsq < maxSq) {
+                        accumulator_.sample(sqrt(dRsq));
+                     }
+                  }
+               }
+            }
+         }
+      }
+
+      // Add histograms and atom type counts on master
+      #ifdef UTIL_MPI
+      MPI::Intracomm& communicator = simulation().domain().communicator();
+      accumulator_.reduce(communicator, 0);
+      communicator.Reduce(&typeNumbers_[0], &totalTypeNumbers_[0],
+                          nAtomType_, MPI::INT, MPI::SUM, 0);
+      #else
+      for (i = 0; i < nAtomType_; ++i) {
+         totalTypeNumbers_[i] = typeNumbers_[i];
+      }
+      #endif
+
+      // Increment normSum_ on master
+      if (simulation().domain().isMaster()) {
+         double n1 = 0.0;
+         double n2 = 0.0;
+         for (i = 0; i < nAtomType_; ++i) {
+            if (atomTypeId1_ < 0 || i == atomTypeId1_) {
+               n1 += totalTypeNumbers_[i];
+            }
+            if (atomTypeId2_ < 0 || i == atomTypeId2_) {
+               n2 += totalTypeNumbers_[i];
+            }
+         }
+         normSum_ += n1*n2/simulation().boundary().volume();
+      }
+   }
+
+   /*
+   * Output results to file after simulation is completed.
+   */
+   void RDF::output()
+   {
+      if (simulation().domain().isMaster()) {
+         simulation().fileMaster().openOutputFile(outputFileName(".prm"),
+                                                  outputFile_);
+         writeParam(outputFile_);
+         outputFile_.close();
+
+         simulation().fileMaster().openOutputFile(outputFileName(".dat"),
+                                                  outputFile_);
+         double nSnapshot = double(accumulator_.nSnapshot());
+         accumulator_.setNorm(normSum_/nSnapshot);
+         if (atomTypeId1_ < 0 && atomTypeId2_ < 0) {
+            accumulator_.setOutputIntegral(true);
+         }
+         accumulator_.output(outputFile_);
+         outputFile_.close();
+      }
+   }
+
+}
+#endif
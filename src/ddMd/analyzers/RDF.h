@@ -0,0 +1,163 @@
+#ifndef DDMD_RDF_H
+#define DDMD_RDF_H
+
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2012, David Morse (morse012@umn.edu)
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <ddMd/analyzers/Analyzer.h>
+#include <ddMd/simulation/Simulation.h>
+#include <util/accumulators/RadialDistribution.h>   // member
+#include <util/containers/DArray.h>                 // member template
+#include <util/space/IntVector.h>                   // member
+
+namespace DdMd
+{
+
+   using namespace Util;
+
+   class Atom;
+
+   /**
+   * RDF evaluates the atomic radial distribution function.
+   *
+   * Each processor sorts its local and ghost atoms into a grid of cells
+   * with widths no less than the maximum radius max, and histograms the
+   * distances from each local atom to all local and ghost atoms within
+   * a distance max. Histograms from all processors are then added on the
+   * master. Each ordered pair is thus counted once, by the processor that
+   * owns the first atom. Because atoms drift by up to half the pair list
+   * skin between exchanges, ghosts are only guaranteed to be available
+   * within the maximum pair potential cutoff, excluding the skin, so
+   * max may not exceed PairPotential::maxPairCutoff().
+   *
+   * Optional parameters atomTypeId1 and atomTypeId2 restrict the types
+   * of the first and second atom in each pair. A negative value (the
+   * default) accepts all types.
+   *
+   * \sa \ref ddMd_analyzer_RDF_page "param file format"
+   *
+   * \ingroup DdMd_Analyzer_Module
+   */
+   class RDF : public Analyzer
+   {
+
+   public:
+
+      /**
+      * Constructor.
+      *
+      * \param simulation  parent Simulation object.
+      */
+      RDF(Simulation& simulation);
+
+      /**
+      * Destructor.
+      */
+      virtual ~RDF();
+
+      /**
+      * Read parameters from file.
+      *
+      * \param in input parameter stream
+      */
+      virtual void readParameters(std::istream& in);
+
+      /**
+      * Load internal state from an archive.
+      *
+      * \param ar input/loading archive
+      */
+      virtual void loadParameters(Serializable::IArchive &ar);
+
+      /**
+      * Save internal state to an archive.
+      *
+      * \param ar output/saving archive
+      */
+      virtual void save(Serializable::OArchive &ar);
+
+      /**
+      * Clear accumulator.
+      */
+      virtual void clear();
+
+      /**
+      * Add particle pairs to RDF histogram.
+      *
+      * \param iStep MD step index
+      */
+      virtual void sample(long iStep);
+
+      /**
+      * Output results to output file.
+      */
+      virtual void output();
+
+   private:
+
+      /// Output file stream.
+      std::ofstream outputFile_;
+
+      /// Statistical accumulator (complete only on master).
+      RadialDistribution  accumulator_;
+
+      /// Pointers to local and ghost atoms, sorted by cell.
+      DArray<Atom*> cellAtoms_;
+
+      /// Pointers to local and ghost atoms, in order of iteration.
+      DArray<Atom*> atomPtrs_;
+
+      /// Cell index for each atom in atomPtrs_.
+      DArray<int> atomCells_;
+
+      /// Index in cellAtoms_ of first atom in each cell (nCell + 1 values).
+      DArray<int> cellBegin_;
+
+      /// Number of atoms of each type on this processor.
+      DArray<int> typeNumbers_;
+
+      /// Total number of atoms of each type (on master).
+      DArray<int> totalTypeNumbers_;
+
+      /// Number of cells in each direction, including ghost layers.
+      IntVector gridDimensions_;
+
+      /// Maximum radius in histogram.
+      double max_;
+
+      /// Sum of snapshot values of n1*n2/volume (on master).
+      double normSum_;
+
+      /// Number of bins in histogram.
+      int nBin_;
+
+      /// Type of first atom in each pair (negative for any).
+      int atomTypeId1_;
+
+      /// Type of second atom in each pair (negative for any).
+      int atomTypeId2_;
+
+      /// Number of atom types.
+      int nAtomType_;
+
+      /// Has readParam or loadParam been called?
+      bool isInitialized_;
+
+      /*
+      * Allocate work arrays.
+      */
+      void allocate();
+
+      /*
+      * Sort local and ghost atoms into cells.
+      */
+      void buildCells();
+
+   };
+
+}
+#endif
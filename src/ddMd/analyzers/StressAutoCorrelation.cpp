@@ -12,9 +12,11 @@
 //#include <util/misc/FileMaster.h>
 #include <util/misc/ioUtil.h>
 #include <util/format/Int.h>
+#include <util/format/Lng.h>
 #include <util/format/Dbl.h>
 
 #include <sstream>
+#include <vector>
 
 namespace DdMd
 {
@@ -28,8 +30,12 @@ namespace DdMd
     : Analyzer(simulation),
       accumulator_(),
       capacity_(-1),
+      maxStageId_(-1),
       isInitialized_(false)
-   {  setClassName("StressAutoCorrelation"); }
+   {
+      setClassName("StressAutoCorrelation");
+      addObservables(Simulation::VIRIAL_STRESS);
+   }
 
    /*
    * Read interval and outputFileName. 
@@ -39,11 +45,8 @@ namespace DdMd
       readInterval(in);
       readOutputFileName(in);
       read<int>(in,"capacity", capacity_);
-      // Allocate memory
-      // Autocorrelation accumulator allocation is so to work for
-      // a symmetric matrix, 6 is number of independent elements in 
-      // a symmetric matrix.
-      accumulator_.setParam(6, capacity_);
+      read<int>(in,"maxStageId", maxStageId_);
+      accumulator_.setParam(capacity_, maxStageId_);
 
       isInitialized_ = true;
    }
@@ -59,6 +62,7 @@ namespace DdMd
 
       MpiLoader<Serializable::IArchive> loader(*this, ar);
       loader.load(capacity_);
+      loader.load(maxStageId_);
 
       if (simulation().domain().isMaster()) {
          accumulator_.loadParameters(ar);
@@ -74,6 +78,8 @@ namespace DdMd
    {
       saveInterval(ar);
       saveOutputFileName(ar);
+      ar << capacity_;
+      ar << maxStageId_;
 
       if (simulation().domain().isMaster()) {
          ar << accumulator_;
@@ -98,26 +104,22 @@ namespace DdMd
 
 
    /*
- *    * Set actual number of molecules and clear accumulator.
- *       */
+   * Clear accumulator.
+   */
    void StressAutoCorrelation::setup()
    {
       if (!isInitialized_) {
          UTIL_THROW("Object not initialized.");
       }
-
-       // Set number of molecules and clear accumulator
-       accumulator_.setNEnsemble(6);
-       accumulator_.clear();
+      accumulator_.clear();
    }
 
    /*
    * Sample the stress tensor.
    */
    void StressAutoCorrelation::sample(long iStep) 
-   {  
-      DArray<double> elements;
-      elements.allocate(9);
+   {
+      Tensor elements;
       double pressure;
       double temprature;
  
@@ -125,30 +127,25 @@ namespace DdMd
          Simulation& sys = simulation();
          sys.computeVirialStress();
          sys.computeKineticStress();
-         sys.computeKineticEnergy();
-         simulation().atomStorage().computeNAtomTotal(simulation().domain().communicator());
 
          if (sys.domain().isMaster()) {
             Tensor virial  = sys.virialStress();
             Tensor kinetic = sys.kineticStress();
-            Tensor total = total.add(virial, kinetic);
+            Tensor total;
+            total.add(virial, kinetic);
             pressure = sys.kineticPressure()+sys.virialPressure();
-            double ndof = simulation().atomStorage().nAtomTotal()*3;
-            //temprature = sys.kineticEnergy()*2.0/ndof;
             temprature = 1;
 
-             
-            elements[0] = (total(0,0) - pressure / 3.0) / (10.0 * temprature);
-            elements[4] = (total(1,1) - pressure / 3.0) / (10.0 * temprature);
-            elements[8] = (total(2,2) - pressure / 3.0) / (10.0 * temprature);
-            elements[1] = (total(0,1) + total(1,0)) / 2.0 / (10.0 * temprature);
-            elements[2] = (total(0,2) + total(2,0)) / 2.0 / (10.0 * temprature);
-            elements[5] = (total(1,2) + total(2,1)) / 2.0 / (10.0 * temprature);
-            elements[3] = elements[1];
-            elements[6] = elements[2];
-            elements[7] = elements[5];
-             
-          
+            elements(0,0) = (total(0,0) - pressure / 3.0) / (10.0 * temprature);
+            elements(1,1) = (total(1,1) - pressure / 3.0) / (10.0 * temprature);
+            elements(2,2) = (total(2,2) - pressure / 3.0) / (10.0 * temprature);
+            elements(0,1) = (total(0,1) + total(1,0)) / 2.0 / (10.0 * temprature);
+            elements(0,2) = (total(0,2) + total(2,0)) / 2.0 / (10.0 * temprature);
+            elements(1,2) = (total(1,2) + total(2,1)) / 2.0 / (10.0 * temprature);
+            elements(1,0) = elements(0,1);
+            elements(2,0) = elements(0,2);
+            elements(2,1) = elements(1,2);
+
             accumulator_.sample(elements);
          }
       }
@@ -170,14 +167,21 @@ namespace DdMd
          outputFile_ << "average   " << accumulator_.average() << std::endl;
          outputFile_ << std::endl;
          outputFile_ << "Format of *.dat file" << std::endl;
-         outputFile_ << "[int time in samples]  [double autocorrelation function]"
+         outputFile_ << "[long time in samples]  [double autocorrelation function]"
                      << std::endl;
          outputFile_ << std::endl;
          outputFile_.close();
 
-         // Write xy autocorrelation function to data file
+         // Write autocorrelation function, averaged over components
+         std::vector<long> delays;
+         std::vector<double> corrs;
+         accumulator_.getCorrelations(delays, corrs);
          simulation().fileMaster().openOutputFile(outputFileName(".corr"), outputFile_);
-         accumulator_.output(outputFile_);
+         for (unsigned int i = 0; i < delays.size(); ++i) {
+            outputFile_ << Lng(delays[i]) 
+                        << Dbl(corrs[i]/double(Dimension*Dimension)) 
+                        << std::endl;
+         }
          outputFile_.close();
       }     
    }
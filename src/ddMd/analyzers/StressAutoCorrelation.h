@@ -12,7 +12,7 @@
 #include <ddMd/simulation/Simulation.h>
 #include <util/mpi/MpiLoader.h>
 #include <util/space/Tensor.h>
-#include <util/accumulators/AutoCorrArray.h>     // member template
+#include <util/accumulators/AutoCorrelation.h>   // member template
 
 namespace DdMd
 {
@@ -20,7 +20,11 @@ namespace DdMd
    using namespace Util;
 
    /**
-   * Periodically write (tensor) StressTensor to file.
+   * Compute the autocorrelation function of the deviatoric stress tensor.
+   *
+   * The autocorrelation function is computed by a hierarchical
+   * AutoCorrelation accumulator, which yields correlations at delays
+   * that span many decades at a bounded cost per sample.
    *
    * \ingroup DdMd_Analyzer_Module
    */
@@ -91,11 +95,14 @@ namespace DdMd
       std::ofstream  outputFile_;
       
       /// Statistical accumulator.
-      AutoCorrArray<double, double>  accumulator_;
+      AutoCorrelation<Tensor, double>  accumulator_;
 
-      /// Number of samples per block average output
+      /// Number of values in history of each accumulator stage.
       int  capacity_;
 
+      /// Maximum stage index of the hierarchical accumulator.
+      int  maxStageId_;
+
       /// Has readParam been called?
       long  isInitialized_;
    
@@ -159,11 +159,13 @@ namespace DdMd
          isFirstStep_ = false;
          Vector position;
          std::complex<double> expFactor;
-         double  product;
          AtomIterator  atomIter;
-         int i, j, typeId;
+         int i, j, k, typeId;
 
          makeWaveVectors();
+         if (!phases_.isAllocated()) {
+            allocatePhases();
+         }
 
          // Set all Fourier modes to zero
          for (i = 0; i < nWave_; ++i) {
@@ -178,10 +180,13 @@ namespace DdMd
             typeId   = atomIter->typeId();
  
             // Loop over wavevectors
+            makePhases(position);
             for (i = 0; i < nWave_; ++i) {
                
-               product = position.dot(waveVectors_[i]);
-               expFactor = exp( product*Constants::Im );
+               expFactor = phases_(0, waveIntVectors_[i][0] - minIntVector_[0]);
+               for (k = 1; k < Dimension; ++k) {
+                  expFactor *= phases_(k, waveIntVectors_[i][k] - minIntVector_[k]);
+               }
                for (j = 0; j < nMode_; ++j) {
                   fourierModes_(i, j) += modes_(j, typeId)*expFactor;
                }
@@ -195,15 +200,10 @@ namespace DdMd
          }
  
          #ifdef UTIL_MPI
-         // Loop over wavevectors
-         for (int i = 0; i < nWave_; ++i) {
-            for (int j = 0; j < nMode_; ++j) {
-            //Sum values from all processors.
-            simulation().domain().communicator().
-                         Reduce(&fourierModes_(i, j), &totalFourierModes_(i, j),
-                                1, MPI::DOUBLE_COMPLEX, MPI::SUM, 0);
-            }
-         }
+         // Sum values from all processors, in one reduction.
+         simulation().domain().communicator().
+                      Reduce(&fourierModes_(0, 0), &totalFourierModes_(0, 0),
+                             nWave_*nMode_, MPI::DOUBLE_COMPLEX, MPI::SUM, 0);
          #else
          for (int i = 0; i < nWave_; ++i) {
             for (int j = 0; j < nMode_; ++j) {
@@ -255,6 +255,11 @@ namespace DdMd
       Boundary* boundaryPtr = &simulation().boundary();
       int       i, j;
 
+      // Store reciprocal basis vectors
+      for (j = 0; j < Dimension; ++j) {
+         basisVectors_[j] = boundaryPtr->reciprocalBasisVector(j);
+      }
+
       // Calculate wavevectors
       for (i = 0; i < nWave_; ++i) {
          waveVectors_[i] = Vector::Zero;
@@ -266,6 +271,54 @@ namespace DdMd
       }
    }
 
+   /*
+   * Find range of Miller indices in each direction, and allocate phases_.
+   */
+   void StructureFactor::allocatePhases() 
+   {
+      int i, j, nPhase;
+      nPhase = 1;
+      for (j = 0; j < Dimension; ++j) {
+         minIntVector_[j] = 0;
+         maxIntVector_[j] = 0;
+         for (i = 0; i < nWave_; ++i) {
+            if (waveIntVectors_[i][j] < minIntVector_[j]) {
+               minIntVector_[j] = waveIntVectors_[i][j];
+            }
+            if (waveIntVectors_[i][j] > maxIntVector_[j]) {
+               maxIntVector_[j] = waveIntVectors_[i][j];
+            }
+         }
+         if (maxIntVector_[j] - minIntVector_[j] + 1 > nPhase) {
+            nPhase = maxIntVector_[j] - minIntVector_[j] + 1;
+         }
+      }
+      phases_.allocate(Dimension, nPhase);
+   }
+
+   /*
+   * Compute exp(i n b_j.r) for all required Miller indices n.
+   *
+   * Uses one complex exponential per axis, and recurrences in n.
+   */
+   void StructureFactor::makePhases(const Vector& position) 
+   {
+      std::complex<double> expFactor, conjFactor;
+      int j, n, offset;
+      for (j = 0; j < Dimension; ++j) {
+         offset = -minIntVector_[j];
+         expFactor = exp(position.dot(basisVectors_[j])*Constants::Im);
+         conjFactor = std::conj(expFactor);
+         phases_(j, offset) = std::complex<double>(1.0, 0.0);
+         for (n = 1; n <= maxIntVector_[j]; ++n) {
+            phases_(j, offset + n) = phases_(j, offset + n - 1)*expFactor;
+         }
+         for (n = -1; n >= minIntVector_[j]; --n) {
+            phases_(j, offset + n) = phases_(j, offset + n + 1)*conjFactor;
+         }
+      }
+   }
+
    /*
    * Write data to three output files.
    */
@@ -12,6 +12,8 @@
 #include <ddMd/simulation/Simulation.h>
 #include <util/containers/DMatrix.h>              // member template
 #include <util/containers/DArray.h>               // member template
+#include <util/containers/FArray.h>               // member template
+#include <util/space/IntVector.h>                 // member
 
 #include <util/global.h>
 
@@ -189,11 +191,39 @@ namespace DdMd
       /// Number of atom types, copied from Simulation::nAtomType().
       int  nAtomType_;
 
+      /**
+      * Phase factors exp(i n b_j.r) for one atom (temporary).
+      *
+      * First index is Cartesian axis j, second is n - minIntVector_[j].
+      */
+      DMatrix< std::complex<double> >  phases_;
+
+      /// Reciprocal basis vectors, set by makeWaveVectors().
+      FArray<Vector, Dimension>  basisVectors_;
+
+      /// Minimum Miller index in each direction.
+      IntVector  minIntVector_;
+
+      /// Maximum Miller index in each direction.
+      IntVector  maxIntVector_;
+
       /**
       * Update wavevectors.
       */
       void makeWaveVectors();
 
+      /**
+      * Find range of Miller indices, and allocate phases_.
+      */
+      void allocatePhases();
+
+      /**
+      * Compute phase factors exp(i n b_j.r) for one position.
+      *
+      * \param position atomic position
+      */
+      void makePhases(const Vector& position);
+
       /// Has readParam been called?
       bool isInitialized_;
 
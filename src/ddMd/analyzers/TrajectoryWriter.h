@@ -171,14 +171,14 @@ namespace DdMd
       GroupCollector<4>& dihedralCollector();
       #endif
 
+      /// Number of configurations dumped thus far (first dump is zero).
+      long nSample_;
+
    private:
  
       // Output file stream
       std::ofstream outputFile_;
 
-      /// Number of configurations dumped thus far (first dump is zero).
-      long nSample_;
-   
       /// Has readParam been called?
       long isInitialized_;
    
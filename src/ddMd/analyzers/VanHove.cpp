@@ -181,13 +181,10 @@ namespace DdMd
          }
 
          #ifdef UTIL_MPI
-         // Loop over wavevectors
-         for (int i = 0; i < nWave_; ++i) {
-            //Sum values from all processors.
-            simulation().domain().communicator().
-            Reduce(&fourierModes_[i], &totalFourierModes_[i],
-                    1, MPI::DOUBLE_COMPLEX, MPI::SUM, 0);
-         }
+         // Sum values from all processors, in one reduction.
+         simulation().domain().communicator().
+                      Reduce(&fourierModes_[0], &totalFourierModes_[0],
+                             nWave_, MPI::DOUBLE_COMPLEX, MPI::SUM, 0);
          #else
          for (int i = 0; i < nWave_; ++i) {
             totalFourierModes_[i] = fourierModes_[i];
@@ -28,7 +28,10 @@ namespace DdMd
     : Analyzer(simulation),
       nSample_(0),
       isInitialized_(false)
-   {  setClassName("VirialStressTensor"); }
+   {
+      setClassName("VirialStressTensor");
+      addObservables(Simulation::VIRIAL_STRESS);
+   }
 
    /*
    * Read interval and outputFileName. 
@@ -8,10 +8,6 @@ ddMd_analyzers_=\
      ddMd/analyzers/OutputPressure.cpp\
      ddMd/analyzers/OutputStressTensor.cpp\
      ddMd/analyzers/VirialStressTensorAverage.cpp\
-<<<<<<< HEAD
-=======
-     ddMd/analyzers/VirialStressTensor.cpp\
->>>>>>> 7454788cb955ae6920d2fc65f1ee1fa595a406d8
      ddMd/analyzers/OutputBoxdim.cpp \
      ddMd/analyzers/OutputTemperature.cpp\
      ddMd/analyzers/OutputPairEnergies.cpp\
@@ -23,7 +19,9 @@ ddMd_analyzers_=\
      ddMd/analyzers/ExternalEnergyAverage.cpp\
      ddMd/analyzers/TrajectoryWriter.cpp\
      ddMd/analyzers/DdMdTrajectoryWriter.cpp\
-     ddMd/analyzers/StressAutoCorrelation.cpp
+     ddMd/analyzers/DdMdMpiTrajectoryWriter.cpp\
+     ddMd/analyzers/StressAutoCorrelation.cpp\
+     ddMd/analyzers/RDF.cpp
 
 ddMd_analyzers_SRCS=\
      $(addprefix $(SRC_DIR)/, $(ddMd_analyzers_))
@@ -32,6 +32,10 @@ namespace DdMd
       intracommPtr_(0),
       #endif
       boundaryPtr_(0),
+      planes_(),
+      planeOffsets_(),
+      balanceInterval_(0),
+      balanceCounter_(0),
       isInitialized_(false)
    {  setClassName("Domain"); }
 
@@ -84,6 +88,8 @@ namespace DdMd
 
       // Read processor grid dimensions and initialize
       read<IntVector>(in, "gridDimensions", gridDimensions_);
+      balanceInterval_ = 0;
+      read<int>(in, "balanceInterval", balanceInterval_, false); // optional
       initialize();
    }
    
@@ -109,6 +115,9 @@ namespace DdMd
 
       // Read processor grid dimensions and initialize
       loadParameter<IntVector>(ar, "gridDimensions", gridDimensions_);
+      balanceInterval_ = 0;
+      loadParameter<int>(ar, "balanceInterval", balanceInterval_, 
+                         false); // optional
       initialize();
    }
 
@@ -116,7 +125,10 @@ namespace DdMd
    * Save internal state to an archive.
    */
    void Domain::save(Serializable::OArchive &ar)
-   {  ar << gridDimensions_; }
+   {
+      ar << gridDimensions_; 
+      Parameter::saveOptional(ar, balanceInterval_, balanceInterval_ != 0);
+   }
   
    /*
    * Initialize data - called by readParameters and loadParameters (private).
@@ -139,9 +151,27 @@ namespace DdMd
          UTIL_THROW("Grid dimensions inconsistent with communicator size");
       }
 
+      if (balanceInterval_ < 0) {
+         UTIL_THROW("Negative balanceInterval");
+      }
+
       // Set grid dimensions
       grid_.setDimensions(gridDimensions_);
 
+      // Initialize uniformly spaced domain boundaries
+      int nPlane = 0;
+      for (int i = 0; i < Dimension; i++) {
+         planeOffsets_[i] = nPlane;
+         nPlane += gridDimensions_[i] + 1;
+      }
+      planes_.allocate(nPlane);
+      for (int i = 0; i < Dimension; i++) {
+         double* planes = &planes_[planeOffsets_[i]];
+         for (int k = 0; k <= gridDimensions_[i]; ++k) {
+            planes[k] = double(k)/double(gridDimensions_[i]);
+         }
+      }
+
       // Mark all directions as periodic.
       for (int i = 0; i < Dimension; i++) {
          gridIsPeriodic_[i] = true;
@@ -200,9 +230,7 @@ namespace DdMd
       assert(j >= 0);
       assert(j < 2);
 
-      double dL;
-      dL = 1.0 / double(gridDimensions_[i]);
-      return (gridCoordinates_[i] + j)*dL;
+      return plane(i, gridCoordinates_[i] + j);
    }
 
    /*
@@ -214,19 +242,28 @@ namespace DdMd
       assert(isInitialized_);
       assert(boundaryPtr_);
 
-      double dL;
       IntVector r;
+      int n;
       for (int i = 0; i < Dimension; ++i) {
-         dL = 1.0 / double(gridDimensions_[i]);
-         r[i] = int(position[i] / dL);
-         if (r[i] < 0 || r[i] >= gridDimensions_[i]) {
+         n = gridDimensions_[i];
+         if (position[i] < 0.0 || position[i] >= 1.0) {
             Log::file() << "Cart i   = " << i << std::endl;
             Log::file() << "position = " << position[i] << std::endl;
-            Log::file() << "dL       = " << dL << std::endl;
-            Log::file() << "r        = " << r[i] << std::endl;
-            Log::file() << "gridDim  = " << gridDimensions_[i] << std::endl;
+            Log::file() << "gridDim  = " << n << std::endl;
             UTIL_THROW("Invalid grid coordinate");
          }
+
+         // Guess for uniform grid, then search neighboring domains
+         r[i] = int(position[i]*double(n));
+         if (r[i] >= n) {
+            r[i] = n - 1;
+         }
+         while (r[i] > 0 && position[i] < plane(i, r[i])) {
+            --r[i];
+         }
+         while (r[i] < n - 1 && position[i] >= plane(i, r[i] + 1)) {
+            ++r[i];
+         }
       }
       return grid_.rank(r);
    }
@@ -240,19 +277,126 @@ namespace DdMd
       assert(isInitialized_);
       assert(boundaryPtr_);
 
-      double dL;
       bool isIn = true;
       for (int i = 0; i < Dimension; ++i) {  
-         dL = 1.0 / double(gridDimensions_[i]);
-         if (position[i] <   gridCoordinates_[i]*dL) {
+         if (position[i] <  plane(i, gridCoordinates_[i])) {
             isIn = false;
          }
-         if (position[i] >= (gridCoordinates_[i] + 1)*dL) {
+         if (position[i] >= plane(i, gridCoordinates_[i] + 1)) {
             isIn = false;
          }
       }
       return isIn;
    }
 
+   /*
+   * Increment balance counter, return true if balancing is scheduled.
+   */
+   bool Domain::updateBalanceCounter()
+   {
+      if (balanceInterval_ <= 0) return false;
+      bool isDue = (balanceCounter_ % balanceInterval_ == 0);
+      ++balanceCounter_;
+      return isDue;
+   }
+
+   /*
+   * Shift domain boundaries so as to equalize the load along each axis.
+   */
+   void Domain::balance(double load, const Vector& minWidths)
+   {
+      assert(isInitialized_);
+
+      DArray<double> localLoads;
+      DArray<double> slabLoads;
+      DArray<double> targets;
+      double* planes;
+      double total, cumulative, target, move, maxMove;
+      int i, k, m, n;
+
+      for (i = 0; i < Dimension; ++i) {
+         n = gridDimensions_[i];
+         if (n == 1) continue;
+         planes = &planes_[planeOffsets_[i]];
+         if (double(n)*minWidths[i] > 1.0) {
+            UTIL_THROW("Processor grid too fine for pair cutoff");
+         }
+
+         // Sum loads of all processors in each slab along axis i
+         localLoads.allocate(n);
+         slabLoads.allocate(n);
+         for (k = 0; k < n; ++k) {
+            localLoads[k] = 0.0;
+         }
+         localLoads[gridCoordinates_[i]] = load;
+         #ifdef UTIL_MPI
+         intracommPtr_->Allreduce(&localLoads[0], &slabLoads[0], n, 
+                                  MPI::DOUBLE, MPI::SUM);
+         #else
+         for (k = 0; k < n; ++k) {
+            slabLoads[k] = localLoads[k];
+         }
+         #endif
+         total = 0.0;
+         for (k = 0; k < n; ++k) {
+            total += slabLoads[k];
+         }
+
+         if (total > 0.0) {
+
+            // Find planes that divide the load equally, assuming that 
+            // load is uniformly distributed within each existing slab.
+            targets.allocate(n + 1);
+            targets[0] = 0.0;
+            targets[n] = 1.0;
+            cumulative = 0.0;
+            m = 0;
+            for (k = 1; k < n; ++k) {
+               target = total*double(k)/double(n);
+               while (m < n - 1 && cumulative + slabLoads[m] < target) {
+                  cumulative += slabLoads[m];
+                  ++m;
+               }
+               if (slabLoads[m] > 0.0) {
+                  targets[k] = planes[m] + (target - cumulative)
+                             *(planes[m+1] - planes[m])/slabLoads[m];
+               } else {
+                  targets[k] = planes[m];
+               }
+            }
+
+            // Limit the shift of each plane, so that no atom is moved 
+            // further than an adjacent domain.
+            maxMove = 0.5*minWidths[i];
+            for (k = 1; k < n; ++k) {
+               move = targets[k] - planes[k];
+               if (move > maxMove) move = maxMove;
+               if (move < -maxMove) move = -maxMove;
+               targets[k] = planes[k] + move;
+            }
+
+            // Enforce minimum width of every domain
+            for (k = 1; k < n; ++k) {
+               if (targets[k] < targets[k-1] + minWidths[i]) {
+                  targets[k] = targets[k-1] + minWidths[i];
+               }
+            }
+            for (k = n - 1; k > 0; --k) {
+               if (targets[k] > targets[k+1] - minWidths[i]) {
+                  targets[k] = targets[k+1] - minWidths[i];
+               }
+            }
+
+            for (k = 1; k < n; ++k) {
+               planes[k] = targets[k];
+            }
+            targets.deallocate();
+         }
+
+         localLoads.deallocate();
+         slabLoads.deallocate();
+      }
+   }
+
 }
 #endif
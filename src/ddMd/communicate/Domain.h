@@ -12,6 +12,7 @@
 #include <util/boundary/Boundary.h>     // typedef used in interface
 #include <util/containers/FMatrix.h>    // member template
 #include <util/containers/FArray.h>     // member template
+#include <util/containers/DArray.h>     // member template
 #include <util/space/IntVector.h>        // member
 #include <util/space/Grid.h>             // member
 #include <util/space/Dimension.h>        // constant expression
@@ -190,6 +191,50 @@ namespace DdMd
       */
       bool isInDomain(const Vector& position) const;
 
+      /**
+      * Get position of a domain boundary plane along one grid axis.
+      *
+      * Along grid axis i, the domains of processors with grid coordinate
+      * k lie between planes plane(i, k) and plane(i, k+1), in generalized 
+      * coordinates, with plane(i, 0) = 0 and plane(i, gridDimension(i))
+      * = 1. All planes are uniformly spaced unless moved by balance().
+      *
+      * \param i index of Cartesian direction 0 <= i < Dimension
+      * \param k plane index, 0 <= k <= gridDimension(i)
+      */
+      double plane(int i, int k) const;
+
+      /**
+      * Get number of exchanges between calls to balance (0 if never).
+      */
+      int balanceInterval() const;
+
+      /**
+      * Increment a counter of exchanges, return true if balance is due.
+      *
+      * Returns true on every balanceInterval-th call, beginning with the
+      * first, and always returns false if balanceInterval is zero.
+      */
+      bool updateBalanceCounter();
+
+      /**
+      * Shift domain boundaries to balance the load among processors.
+      *
+      * Must be called on all processors, with atomic coordinates in
+      * generalized form, just before exchanging atoms. Along each grid
+      * axis, loads of all processors in each slab of domains are summed,
+      * and the boundaries between slabs are shifted toward positions at
+      * which all slabs would have equal load, if the load within each 
+      * slab is distributed uniformly. Each boundary is moved by no more
+      * than half of minWidths[i], and no domain is made narrower than 
+      * minWidths[i], so that atoms are only transferred to neighboring
+      * processors. 
+      *
+      * \param load       measure of work done by this processor
+      * \param minWidths  minimum domain widths (generalized coordinates)
+      */
+      void balance(double load, const Vector& minWidths);
+
       /**
       * Has this Domain been initialized by calling readParam?
       */
@@ -236,6 +281,18 @@ namespace DdMd
       // Pointer to associated Boundary object.
       Boundary* boundaryPtr_;
 
+      // Boundary planes along all axes, in generalized coordinates.
+      DArray<double> planes_;
+
+      // Index in planes_ of the first plane along each axis.
+      IntVector planeOffsets_;
+
+      // Number of exchanges between calls to balance (0 if never).
+      int balanceInterval_;
+
+      // Number of calls to updateBalanceCounter.
+      int balanceCounter_;
+
       // Is this object initialized (Has a grid been set?)
       bool isInitialized_;
 
@@ -342,6 +399,21 @@ namespace DdMd
       return shift_(i, j);  
    }
 
+   /*
+   * Position of boundary plane k along axis i.
+   */
+   inline double Domain::plane(int i, int k) const
+   {  
+      assert(isInitialized_);
+      return planes_[planeOffsets_[i] + k];  
+   }
+
+   /*
+   * Number of exchanges between calls to balance (0 if never).
+   */
+   inline int Domain::balanceInterval() const
+   {  return balanceInterval_;  }
+
    /*
    * Has this Domain been initialized by calling readParam?
    */
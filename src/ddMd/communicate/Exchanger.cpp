@@ -31,12 +31,26 @@ namespace DdMd
 {
    using namespace Util;
 
+   #ifdef UTIL_MPI
+   namespace
+   {
+
+      // MPI tags for messages sent by persistent update requests.
+      const int UpdateTag = 6;
+      const int ForceTag  = 7;
+
+   }
+   #endif
+
    /*
    * Constructor.
    */
    Exchanger::Exchanger()
     : sendArray_(),
       recvArray_(),
+      #ifdef UTIL_MPI
+      hasUpdatePlans_(false),
+      #endif
       bound_(),
       inner_(),
       outer_(),
@@ -47,14 +61,21 @@ namespace DdMd
       groupExchangers_(),
       bufferPtr_(0),
       pairCutoff_(-1.0),
-      timer_(Exchanger::NTime)
+      timer_(Exchanger::NTime),
+      isUpdatePending_(false)
    {  groupExchangers_.reserve(8); }
 
    /*
    * Destructor.
    */
    Exchanger::~Exchanger()
-   {}
+   {
+      #ifdef UTIL_MPI
+      if (!MPI::Is_finalized()) {
+         freeUpdatePlans();
+      }
+      #endif
+   }
 
    /*
    * Set pointers to associated objects.
@@ -94,6 +115,19 @@ namespace DdMd
             recvArray_(i, j).reserve(sendRecvCapacity);
          }
       }
+
+      #ifdef UTIL_MPI
+      // Allocate workspace for update plans. No send or recv array 
+      // can contain more than all local and ghost atoms.
+      int capacity = atomStoragePtr_->atomCapacity() 
+                   + atomStoragePtr_->ghostCapacity();
+      recvForces_.allocate(capacity);
+      displacements_.allocate(capacity);
+      blockLengths_.allocate(capacity);
+      for (i = 0; i < capacity; ++i) {
+         blockLengths_[i] = Dimension;
+      }
+      #endif
    }
 
    /*
@@ -111,6 +145,12 @@ namespace DdMd
       if (atomStoragePtr_->isCartesian()) {
          UTIL_THROW("Error: Coordinates are Cartesian on entry to exchange");
       }
+      if (atomStoragePtr_->updateSortCounter()) {
+         atomStoragePtr_->sortAtoms();
+         for (int k = 0; k < groupExchangers_.size(); ++k) {
+            groupExchangers_[k].findLocals(*atomStoragePtr_);
+         }
+      }
       exchangeAtoms();
       exchangeGhosts();
    }
@@ -811,6 +851,10 @@ namespace DdMd
       #endif // ifdef UTIL_DEBUG
 
       stamp(FIND_GROUP_GHOSTS);
+
+      // Create persistent requests for subsequent updates
+      initUpdatePlans();
+      stamp(UPDATE_PLANS);
    }
 
    /*
@@ -824,70 +868,138 @@ namespace DdMd
       if (!atomStoragePtr_->isCartesian()) {
          UTIL_THROW("Error: Coordinates not Cartesian on entry to update");
       }
+      if (isUpdatePending_) {
+         UTIL_THROW("Error: Nonblocking update is pending");
+      }
 
-      Atom*  atomPtr;
-      int    i, j, k, source, dest, size, shift;
-
+      int i, j;
       for (i = 0; i < Dimension; ++i) {
          for (j = 0; j < 2; ++j) {
+            update(i, j);
+         }
+      }
+   }
 
-            // Shift on receiving processor for periodic boundary conditions
-            shift = domainPtr_->shift(i, j);
-
-            if (gridFlags_[i]) {
-
-               // Pack ghost positions for sending
-               bufferPtr_->clearSendBuffer();
-               bufferPtr_->beginSendBlock(Buffer::UPDATE);
-               size = sendArray_(i, j).size();
-               for (k = 0; k < size; ++k) {
-                  atomPtr = &sendArray_(i, j)[k];
-                  atomPtr->packUpdate(*bufferPtr_);
-               }
-               bufferPtr_->endSendBlock();
-               stamp(PACK_UPDATE);
-
-               // Send and receive buffers
-               source = domainPtr_->sourceRank(i, j);
-               dest   = domainPtr_->destRank(i, j);
-               bufferPtr_->sendRecv(domainPtr_->communicator(), source, dest);
-               stamp(SEND_RECV_UPDATE);
-
-               // Unpack ghost positions
-               bufferPtr_->beginRecvBlock();
-               size = recvArray_(i, j).size();
-               for (k = 0; k < size; ++k) {
-                  atomPtr = &recvArray_(i, j)[k];
-                  atomPtr->unpackUpdate(*bufferPtr_);
-                  if (shift) {
-                     boundaryPtr_->applyShift(atomPtr->position(), i, shift);
-                  }
-               }
-               bufferPtr_->endRecvBlock();
-               stamp(UNPACK_UPDATE);
+   /*
+   * Begin update of ghost atom coordinates.
+   *
+   * Starts the first transfer (i = 0, j = 0) without waiting for it.
+   */
+   void Exchanger::beginUpdate()
+   {
+      stamp(START);
+      if (!atomStoragePtr_->isCartesian()) {
+         UTIL_THROW("Error: Coordinates not Cartesian on entry to update");
+      }
+      if (isUpdatePending_) {
+         UTIL_THROW("Error: Nonblocking update is already pending");
+      }
 
-            } else {
+      if (gridFlags_[0]) {
+         if (!hasUpdatePlans_) {
+            UTIL_THROW("Error: No update plans (exchange not called)");
+         }
+         recvPositionRequests_(0, 0).Start();
+         sendPositionRequests_(0, 0).Start();
+         stamp(SEND_RECV_UPDATE);
+      } else {
+         localUpdate(0, 0);
+      }
+      isUpdatePending_ = true;
+   }
 
-               // If grid().dimension(i) == 1, then copy positions of atoms
-               // listed in sendArray to those listed in the recvArray.
+   /*
+   * Complete update of ghost atom coordinates begun by beginUpdate().
+   */
+   void Exchanger::endUpdate()
+   {
+      stamp(START);
+      if (!isUpdatePending_) {
+         UTIL_THROW("Error: No nonblocking update is pending");
+      }
 
-               size = sendArray_(i, j).size();
-               assert(size == recvArray_(i, j).size());
-               for (k = 0; k < size; ++k) {
-                  atomPtr = &recvArray_(i, j)[k];
-                  atomPtr->position() = sendArray_(i, j)[k].position();
-                  if (shift) {
-                     boundaryPtr_->applyShift(atomPtr->position(), i, shift);
-                  }
-               }
-               stamp(LOCAL_UPDATE);
+      // Complete first transfer
+      if (gridFlags_[0]) {
+         recvPositionRequests_(0, 0).Wait();
+         sendPositionRequests_(0, 0).Wait();
+         stamp(SEND_RECV_UPDATE);
+         shiftUpdate(0, 0);
+      }
 
+      // Remaining transfers, which may forward ghosts received earlier
+      int i, j;
+      for (i = 0; i < Dimension; ++i) {
+         for (j = 0; j < 2; ++j) {
+            if (i > 0 || j > 0) {
+               update(i, j);
             }
+         }
+      }
+      isUpdatePending_ = false;
+   }
 
-         } // transmit direction j = 0, 1
+   /*
+   * Update ghost coordinates for one transfer (private).
+   *
+   * Positions are sent from and received into the Atom objects, using
+   * persistent requests created by the last call to exchangeGhosts().
+   */
+   void Exchanger::update(int i, int j)
+   {
+      if (gridFlags_[i]) {
+         if (!hasUpdatePlans_) {
+            UTIL_THROW("Error: No update plans (exchange not called)");
+         }
+         recvPositionRequests_(i, j).Start();
+         sendPositionRequests_(i, j).Start();
+         recvPositionRequests_(i, j).Wait();
+         sendPositionRequests_(i, j).Wait();
+         stamp(SEND_RECV_UPDATE);
+         shiftUpdate(i, j);
+      } else {
+         localUpdate(i, j);
+      }
+   }
 
-      } // Cartesian direction i = 0, ..., Dimension - 1
+   /*
+   * Apply periodic shift to positions in recvArray_(i, j) (private).
+   */
+   void Exchanger::shiftUpdate(int i, int j)
+   {
+      int shift = domainPtr_->shift(i, j);
+      if (shift) {
+         int size = recvArray_(i, j).size();
+         for (int k = 0; k < size; ++k) {
+            boundaryPtr_->applyShift(recvArray_(i, j)[k].position(), 
+                                     i, shift);
+         }
+      }
+      stamp(SHIFT_UPDATE);
+   }
 
+   /*
+   * Copy positions from sendArray_(i, j) to recvArray_(i, j) (private).
+   *
+   * Used if grid().dimension(i) == 1.
+   */
+   void Exchanger::localUpdate(int i, int j)
+   {
+      Atom*  atomPtr;
+      int    k, size;
+
+      // Shift on receiving processor for periodic boundary conditions
+      int shift = domainPtr_->shift(i, j);
+
+      size = sendArray_(i, j).size();
+      assert(size == recvArray_(i, j).size());
+      for (k = 0; k < size; ++k) {
+         atomPtr = &recvArray_(i, j)[k];
+         atomPtr->position() = sendArray_(i, j)[k].position();
+         if (shift) {
+            boundaryPtr_->applyShift(atomPtr->position(), i, shift);
+         }
+      }
+      stamp(LOCAL_UPDATE);
    }
 
    /*
@@ -900,39 +1012,29 @@ namespace DdMd
    {
       stamp(START);
       Atom*  atomPtr;
-      int    i, j, k, source, dest, size;
+      int    i, j, k, size;
 
       for (i = Dimension - 1; i >= 0; --i) {
          for (j = 1; j >= 0; --j) {
 
             if (gridFlags_[i]) {
 
-               // Pack ghost forces for sending
-               bufferPtr_->clearSendBuffer();
-               bufferPtr_->beginSendBlock(Buffer::FORCE);
-               size = recvArray_(i, j).size();
-               for (k = 0; k < size; ++k) {
-                  atomPtr = &recvArray_(i, j)[k];
-                  atomPtr->packForce(*bufferPtr_);
+               if (!hasUpdatePlans_) {
+                  UTIL_THROW("Error: No update plans (exchange not called)");
                }
-               bufferPtr_->endSendBlock();
-               stamp(PACK_FORCE);
 
-               // Send and receive buffers (reverse direction)
-               source  = domainPtr_->destRank(i, j);
-               dest    = domainPtr_->sourceRank(i, j);
-               bufferPtr_->sendRecv(domainPtr_->communicator(),
-                                    source, dest);
+               // Send ghost forces and receive forces (reverse direction)
+               recvForceRequests_(i, j).Start();
+               sendForceRequests_(i, j).Start();
+               recvForceRequests_(i, j).Wait();
+               sendForceRequests_(i, j).Wait();
                stamp(SEND_RECV_FORCE);
 
-               // Unpack ghost forces
-               bufferPtr_->beginRecvBlock();
+               // Add received forces
                size = sendArray_(i, j).size();
                for (k = 0; k < size; ++k) {
-                  atomPtr = &sendArray_(i, j)[k];
-                  atomPtr->unpackForce(*bufferPtr_);
+                  sendArray_(i, j)[k].force() += recvForces_[k];
                }
-               bufferPtr_->endRecvBlock();
                stamp(UNPACK_FORCE);
 
             } else {
@@ -956,6 +1058,95 @@ namespace DdMd
 
    }
 
+   /*
+   * Create persistent requests for update() and reverseUpdate() (private).
+   *
+   * Atoms listed in the send and recv arrays do not move in memory until
+   * the next exchange, so their positions and forces may be sent and
+   * received in place, using hindexed datatypes of absolute addresses.
+   */
+   void Exchanger::initUpdatePlans()
+   {
+      freeUpdatePlans();
+
+      MPI::Intracomm& comm = domainPtr_->communicator();
+      int i, j, source, dest, size;
+      for (i = 0; i < Dimension; ++i) {
+         if (gridFlags_[i]) {
+            for (j = 0; j < 2; ++j) {
+               source = domainPtr_->sourceRank(i, j);
+               dest   = domainPtr_->destRank(i, j);
+
+               // Ghost positions (forward direction)
+               sendPositionTypes_(i, j) = makeDatatype(sendArray_(i, j), false);
+               recvPositionTypes_(i, j) = makeDatatype(recvArray_(i, j), false);
+               sendPositionRequests_(i, j) = 
+                  comm.Send_init(MPI::BOTTOM, 1, sendPositionTypes_(i, j), 
+                                 dest, UpdateTag);
+               recvPositionRequests_(i, j) = 
+                  comm.Recv_init(MPI::BOTTOM, 1, recvPositionTypes_(i, j), 
+                                 source, UpdateTag);
+
+               // Ghost forces (reverse direction)
+               size = sendArray_(i, j).size();
+               sendForceTypes_(i, j) = makeDatatype(recvArray_(i, j), true);
+               sendForceRequests_(i, j) = 
+                  comm.Send_init(MPI::BOTTOM, 1, sendForceTypes_(i, j), 
+                                 source, ForceTag);
+               recvForceRequests_(i, j) = 
+                  comm.Recv_init(recvForces_.cArray(), Dimension*size, 
+                                 MPI::DOUBLE, dest, ForceTag);
+            }
+         }
+      }
+      hasUpdatePlans_ = true;
+   }
+
+   /*
+   * Free all persistent requests and datatypes (private).
+   */
+   void Exchanger::freeUpdatePlans()
+   {
+      if (!hasUpdatePlans_) return;
+      int i, j;
+      for (i = 0; i < Dimension; ++i) {
+         if (gridFlags_[i]) {
+            for (j = 0; j < 2; ++j) {
+               sendPositionRequests_(i, j).Free();
+               recvPositionRequests_(i, j).Free();
+               sendForceRequests_(i, j).Free();
+               recvForceRequests_(i, j).Free();
+               sendPositionTypes_(i, j).Free();
+               recvPositionTypes_(i, j).Free();
+               sendForceTypes_(i, j).Free();
+            }
+         }
+      }
+      hasUpdatePlans_ = false;
+   }
+
+   /*
+   * Create datatype for positions or forces of an array of atoms (private).
+   */
+   MPI::Datatype 
+   Exchanger::makeDatatype(GPArray<Atom>& atoms, bool forceFlag)
+   {
+      int size = atoms.size();
+      assert(size <= displacements_.capacity());
+      for (int k = 0; k < size; ++k) {
+         if (forceFlag) {
+            displacements_[k] = MPI::Get_address(&atoms[k].force()[0]);
+         } else {
+            displacements_[k] = MPI::Get_address(&atoms[k].position()[0]);
+         }
+      }
+      MPI::Datatype type;
+      type = MPI::DOUBLE.Create_hindexed(size, blockLengths_.cArray(),
+                                         displacements_.cArray());
+      type.Commit();
+      return type;
+   }
+
    /*
    * Output statistics.
    */
@@ -1093,6 +1284,12 @@ namespace DdMd
           << Dbl(FindGroupGhostsT*factor1, 12, 6) << "   " 
           << Dbl(FindGroupGhostsT*factor2, 12, 6) << "   " 
           << Dbl(FindGroupGhostsT*factor3, 12, 6, true) << std::endl;
+      double UpdatePlansT = timer_.time(Exchanger::UPDATE_PLANS);
+      ghostExchangeT += UpdatePlansT;
+      out << "UpdatePlans          " 
+          << Dbl(UpdatePlansT*factor1, 12, 6) << "   " 
+          << Dbl(UpdatePlansT*factor2, 12, 6) << "   " 
+          << Dbl(UpdatePlansT*factor3, 12, 6, true) << std::endl;
       out << "Ghost Exchange (Tot) " 
           << Dbl(ghostExchangeT*factor1, 12, 6) << "   " 
           << Dbl(ghostExchangeT*factor2, 12, 6) << "   " 
@@ -1100,24 +1297,18 @@ namespace DdMd
       out << std::endl;
 
       // Exchanger::update()
-      double PackUpdateT = timer_.time(Exchanger::PACK_UPDATE);
-      updateT += PackUpdateT;
-      out << "PackUpdate           " 
-          << Dbl(PackUpdateT*factor1, 12, 6) << "   " 
-          << Dbl(PackUpdateT*factor2, 12, 6) << "   " 
-          << Dbl(PackUpdateT*factor3, 12, 6, true) << std::endl;
       double SendRecvUpdateT = timer_.time(Exchanger::SEND_RECV_UPDATE);
       updateT += SendRecvUpdateT;
       out << "SendRecvUpdate       " 
           << Dbl(SendRecvUpdateT*factor1, 12, 6) << "   " 
           << Dbl(SendRecvUpdateT*factor2, 12, 6) << "   " 
           << Dbl(SendRecvUpdateT*factor3, 12, 6, true) << std::endl;
-      double UnpackUpdateT = timer_.time(Exchanger::UNPACK_UPDATE);
-      updateT += UnpackUpdateT;
-      out << "UnpackUpdate         " 
-          << Dbl(UnpackUpdateT*factor1, 12, 6) << "   " 
-          << Dbl(UnpackUpdateT*factor2, 12, 6) << "   " 
-          << Dbl(UnpackUpdateT*factor3, 12, 6, true) << std::endl;
+      double ShiftUpdateT = timer_.time(Exchanger::SHIFT_UPDATE);
+      updateT += ShiftUpdateT;
+      out << "ShiftUpdate          " 
+          << Dbl(ShiftUpdateT*factor1, 12, 6) << "   " 
+          << Dbl(ShiftUpdateT*factor2, 12, 6) << "   " 
+          << Dbl(ShiftUpdateT*factor3, 12, 6, true) << std::endl;
       double LocalUpdateT = timer_.time(Exchanger::LOCAL_UPDATE);
       updateT += LocalUpdateT;
       out << "LocalUpdate          " 
@@ -13,6 +13,8 @@
 #include <util/boundary/Boundary.h>
 #include <util/containers/FMatrix.h>
 #include <util/containers/GPArray.h>
+#include <util/containers/DArray.h>
+#include <util/space/Vector.h>
 
 
 namespace DdMd
@@ -85,7 +87,8 @@ namespace DdMd
       * list on each processor, to exchange ownership of local atoms and
       * to exchange ghost atoms. The lists of which atoms were sent and
       * received as ghosts by this method are used in subsequent calls
-      * to update. 
+      * to update. If AtomStorage::updateSortCounter() returns true, local
+      * atoms are first sorted into spatial order by AtomStorage::sortAtoms.
       */
       void exchange();
 
@@ -95,10 +98,38 @@ namespace DdMd
       * This method should be called every time step for which there is
       * no exhange of atom ownership. It communicates ghost coordinates
       * for the same ghosts as those sent by the most recent call to
-      * the exchangeGhosts() methods.
+      * the exchangeGhosts() methods. Positions are sent and received 
+      * in place, without packing, by persistent MPI requests that are
+      * created by exchange().
       */
       void update();
 
+      /**
+      * Begin a nonblocking update of ghost atom coordinates.
+      *
+      * Starts the persistent requests for the first of the transfers
+      * performed by update(), along axis 0, and returns without waiting
+      * for them to complete. The caller may then do work that does not
+      * require ghost coordinates, such as computing forces between pairs
+      * of local atoms, and must call endUpdate() before using any ghost
+      * coordinates. Later transfers along axes 1 and 2 may forward ghosts
+      * received along earlier axes, and so are done within endUpdate().
+      */
+      void beginUpdate();
+
+      /**
+      * Complete an update of ghost coordinates begun by beginUpdate().
+      *
+      * On return, all ghost coordinates are updated, exactly as if
+      * update() had been called in place of beginUpdate().
+      */
+      void endUpdate();
+
+      /**
+      * Has beginUpdate() been called without a matching endUpdate()?
+      */
+      bool isUpdatePending() const;
+
       /**
       * Update ghost atom forces.
       * 
@@ -129,9 +160,9 @@ namespace DdMd
                    SEND_RECV_ATOMS, UNPACK_ATOMS, UNPACK_GROUPS, 
                    MARK_GROUP_GHOSTS, INIT_SEND_ARRAYS, PACK_GHOSTS, 
                    SEND_RECV_GHOSTS, UNPACK_GHOSTS, FIND_GROUP_GHOSTS, 
-                   PACK_UPDATE, SEND_RECV_UPDATE, UNPACK_UPDATE, 
-                   LOCAL_UPDATE, PACK_FORCE, SEND_RECV_FORCE, 
-                   UNPACK_FORCE, LOCAL_FORCE, NTime};
+                   UPDATE_PLANS, SEND_RECV_UPDATE, SHIFT_UPDATE, 
+                   LOCAL_UPDATE, SEND_RECV_FORCE, UNPACK_FORCE, 
+                   LOCAL_FORCE, NTime};
 
    private:
 
@@ -166,6 +197,48 @@ namespace DdMd
       * Used to mark missing atoms for subsequent removal.
       */
       GPArray<Atom> sentAtoms_;
+
+      /**
+      * Persistent requests to send positions of atoms in sendArray_.
+      *
+      * Element (i, j) sends the positions of all atoms in sendArray_(i, j)
+      * directly from the Atom objects, using an MPI derived datatype.
+      * Requests, and the derived datatypes used by them, are recreated
+      * by every call to exchangeGhosts(), and used by update() until 
+      * the next call to exchangeGhosts(). The same applies to all other
+      * persistent requests and datatypes below.
+      */
+      FMatrix<MPI::Prequest, Dimension, 2> sendPositionRequests_;
+
+      /// Persistent requests to receive positions of atoms in recvArray_.
+      FMatrix<MPI::Prequest, Dimension, 2> recvPositionRequests_;
+
+      /// Persistent requests to send forces of atoms in recvArray_.
+      FMatrix<MPI::Prequest, Dimension, 2> sendForceRequests_;
+
+      /// Persistent requests to receive forces into recvForces_.
+      FMatrix<MPI::Prequest, Dimension, 2> recvForceRequests_;
+
+      /// Datatypes for positions of atoms in sendArray_.
+      FMatrix<MPI::Datatype, Dimension, 2> sendPositionTypes_;
+
+      /// Datatypes for positions of atoms in recvArray_.
+      FMatrix<MPI::Datatype, Dimension, 2> recvPositionTypes_;
+
+      /// Datatypes for forces of atoms in recvArray_.
+      FMatrix<MPI::Datatype, Dimension, 2> sendForceTypes_;
+
+      /// Contiguous receive buffer for forces in reverseUpdate().
+      DArray<Vector> recvForces_;
+
+      /// Workspace for addresses used to create datatypes.
+      DArray<MPI::Aint> displacements_;
+
+      /// Workspace for block lengths used to create datatypes.
+      DArray<int> blockLengths_;
+
+      /// Have persistent requests been created by exchangeGhosts()?
+      bool hasUpdatePlans_;
       #endif // UTIL_MPI
 
       /// Processor boundaries (minima j=0, maxima j=1)
@@ -201,6 +274,9 @@ namespace DdMd
       /// Timer
       DdTimer timer_;
 
+      /// Is a nonblocking update (begun by beginUpdate()) pending?
+      bool isUpdatePending_;
+
       /**
       * Exchange ownership of local atoms.
       *
@@ -220,6 +296,44 @@ namespace DdMd
       */
       void exchangeGhosts();
 
+      /**
+      * Update ghost coordinates for one transfer along axis i, direction j.
+      *
+      * \param i Cartesian axis index
+      * \param j direction index (0=lower, 1=higher)
+      */
+      void update(int i, int j);
+
+      /**
+      * Apply periodic shift to coordinates of ghosts in recvArray_(i, j).
+      */
+      void shiftUpdate(int i, int j);
+
+      /**
+      * Copy coordinates of ghosts in sendArray_(i,j) to recvArray_(i,j).
+      */
+      void localUpdate(int i, int j);
+
+      #ifdef UTIL_MPI
+      /**
+      * Create persistent requests used by update() and reverseUpdate().
+      */
+      void initUpdatePlans();
+
+      /**
+      * Free all persistent requests and datatypes.
+      */
+      void freeUpdatePlans();
+
+      /**
+      * Create and commit a datatype for the positions or forces of atoms.
+      *
+      * \param atoms      array of atoms
+      * \param forceFlag  if true, use forces, otherwise positions
+      */
+      MPI::Datatype makeDatatype(GPArray<Atom>& atoms, bool forceFlag);
+      #endif
+
       /**
       * Stamp internal timer.
       */
@@ -233,6 +347,10 @@ namespace DdMd
    inline DdTimer& Exchanger::timer()
    {  return timer_; }
 
+   // Return true if a nonblocking update is pending (public).
+   inline bool Exchanger::isUpdatePending() const
+   {  return isUpdatePending_; }
+
    // Stamp internal timer (private)
    inline void Exchanger::stamp(unsigned int timeId) 
    {  timer_.stamp(timeId); }
@@ -30,6 +30,7 @@
 #include <ddMd/chemistry/Atom.h>
 #include <ddMd/chemistry/Bond.h>
 #include <ddMd/chemistry/MaskPolicy.h>
+#include <util/misc/FileMaster.h>
 #include <util/space/Vector.h>
 #include <util/mpi/MpiSendRecv.h>
 #include <util/mpi/MpiLoader.h>
@@ -133,6 +134,23 @@ namespace DdMd
    }
 
 
+   /*
+   * Open and read a configuration file (default implementation).
+   */
+   void ConfigIo::readConfigFile(const FileMaster& fileMaster, 
+                                 const std::string& filename, 
+                                 MaskPolicy maskPolicy)
+   {
+      std::ifstream file;
+      if (domain().isMaster()) {
+         fileMaster.openInputFile(filename, file);
+      }
+      readConfig(file, maskPolicy);
+      if (domain().isMaster()) {
+         file.close();
+      }
+   }
+
    /*
    * Private method to read Group<N> objects.
    */
@@ -18,6 +18,10 @@
 
 #include <ddMd/chemistry/MaskPolicy.h>
 
+namespace Util {
+   class FileMaster;
+}
+
 namespace DdMd
 {
 
@@ -117,6 +121,23 @@ namespace DdMd
       */
       virtual void readConfig(std::ifstream& file, MaskPolicy maskPolicy) = 0;
 
+      /**
+      * Open and read a configuration file.
+      *
+      * Call on all processors. The default implementation opens the file 
+      * on the master processor, calls readConfig(std::ifstream&, MaskPolicy),
+      * and closes the file. Subclasses that read the file from more than 
+      * one processor should override this method. Postconditions are the 
+      * same as those of readConfig(std::ifstream&, MaskPolicy).
+      *
+      * \param fileMaster FileMaster used to construct the file path.
+      * \param filename name of input file, without input prefix.
+      * \param maskPolicy MaskPolicy to be used in setting atom masks
+      */
+      virtual void readConfigFile(const FileMaster& fileMaster, 
+                                  const std::string& filename, 
+                                  MaskPolicy maskPolicy);
+
       /**
       * Write configuration file.
       *
@@ -0,0 +1,528 @@
+#ifndef DDMD_SERIALIZE_MPI_CONFIG_IO_CPP
+#define DDMD_SERIALIZE_MPI_CONFIG_IO_CPP
+
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2012, David Morse (morse012@umn.edu)
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "SerializeMpiConfigIo.h"
+
+#include <ddMd/simulation/Simulation.h>
+#include <ddMd/communicate/Domain.h>
+
+#include <ddMd/storage/AtomStorage.h>
+#include <ddMd/storage/AtomIterator.h>
+#ifdef INTER_BOND
+#include <ddMd/storage/BondStorage.h>
+#endif
+#ifdef INTER_ANGLE
+#include <ddMd/storage/AngleStorage.h>
+#endif
+#ifdef INTER_DIHEDRAL
+#include <ddMd/storage/DihedralStorage.h>
+#endif
+#include <ddMd/storage/GroupStorage.tpp>
+
+#include <ddMd/chemistry/Atom.h>
+#include <ddMd/chemistry/Group.h>
+#include <ddMd/chemistry/MaskPolicy.h>
+#include <util/misc/FileMaster.h>
+#include <util/space/Vector.h>
+#include <util/mpi/MpiSendRecv.h>
+
+#include <fstream>
+#include <cstring>
+
+namespace DdMd
+{
+
+   using namespace Util;
+
+   /*
+   * Constructor.
+   */
+   SerializeMpiConfigIo::SerializeMpiConfigIo()
+    : SerializeConfigIo()
+   {  setClassName("SerializeMpiConfigIo"); }
+
+   /*
+   * Constructor.
+   */
+   SerializeMpiConfigIo::SerializeMpiConfigIo(Simulation& simulation)
+    : SerializeConfigIo(simulation)
+   {  setClassName("SerializeMpiConfigIo"); }
+
+   /*
+   * Read a configuration file on all processors.
+   */
+   void
+   SerializeMpiConfigIo::readConfigFile(const FileMaster& fileMaster,
+                                        const std::string& filename,
+                                        MaskPolicy maskPolicy)
+   {
+      // Preconditions
+      if (atomStorage().nAtom()) {
+         UTIL_THROW("Atom storage is not empty (has local atoms)");
+      }
+      if (atomStorage().nGhost()) {
+         UTIL_THROW("Atom storage is not empty (has ghost atoms)");
+      }
+      if (atomStorage().isCartesian()) {
+         UTIL_THROW("Atom storage set for Cartesian coordinates");
+      }
+
+      MPI::Intracomm& communicator = domain().communicator();
+
+      // Read boundary on master, find offset of atom section
+      long atomOffset = 0;
+      if (domain().isMaster()) {
+         std::ifstream inputFile;
+         fileMaster.openInputFile(filename, inputFile);
+         Serializable::IArchive ar(inputFile);
+         ar >> boundary();
+         atomOffset = inputFile.tellg();
+         inputFile.close();
+      }
+      bcast(communicator, boundary(), 0);
+      bcast(communicator, atomOffset, 0);
+
+      // Open file for collective reading on all processors
+      std::string path = fileMaster.inputFilePath(filename);
+      MPI::File file = MPI::File::Open(communicator, path.c_str(),
+                                       MPI::MODE_RDONLY, MPI::INFO_NULL);
+      MPI::Offset offset = atomOffset;
+
+      // Read and distribute atoms
+      readAtoms(file, offset);
+
+      // Read and distribute groups
+      bool hasGroups = false;
+      #ifdef INTER_BOND
+      if (bondStorage().capacity()) hasGroups = true;
+      #endif
+      #ifdef INTER_ANGLE
+      if (angleStorage().capacity()) hasGroups = true;
+      #endif
+      #ifdef INTER_DIHEDRAL
+      if (dihedralStorage().capacity()) hasGroups = true;
+      #endif
+      if (hasGroups) {
+         std::vector<int> directory;
+         makeAtomDirectory(directory);
+         bool hasGhosts = false;
+         #ifdef INTER_BOND
+         if (bondStorage().capacity()) {
+            readGroups<2>(file, offset, bondStorage(), directory);
+            bondStorage().isValid(atomStorage(), communicator, hasGhosts);
+            // Set atom "mask" values
+            if (maskPolicy == MaskBonded) {
+               setAtomMasks();
+            }
+         }
+         #endif
+         #ifdef INTER_ANGLE
+         if (angleStorage().capacity()) {
+            readGroups<3>(file, offset, angleStorage(), directory);
+            angleStorage().isValid(atomStorage(), communicator, hasGhosts);
+         }
+         #endif
+         #ifdef INTER_DIHEDRAL
+         if (dihedralStorage().capacity()) {
+            readGroups<4>(file, offset, dihedralStorage(), directory);
+            dihedralStorage().isValid(atomStorage(), communicator,
+                                      hasGhosts);
+         }
+         #endif
+      }
+
+      file.Close();
+   }
+
+   /*
+   * Read atoms, and send each to the processor that owns it.
+   */
+   int SerializeMpiConfigIo::readAtoms(MPI::File& file, MPI::Offset& offset)
+   {
+      MPI::Intracomm& communicator = domain().communicator();
+      int nProc = communicator.Get_size();
+      int myRank = communicator.Get_rank();
+
+      // Record: id, typeId, position, velocity
+      const int recordSize = 2*sizeof(int) + 2*sizeof(Vector);
+      const int rOffset = 2*sizeof(int);
+
+      // Read total number of atoms
+      int nAtom;
+      file.Read_at_all(offset, &nAtom, 1, MPI::INT);
+      offset += sizeof(int);
+
+      // Read a contiguous slice of the atom records on each processor
+      MPI::Offset first = (MPI::Offset)nAtom*myRank/nProc;
+      MPI::Offset last  = (MPI::Offset)nAtom*(myRank + 1)/nProc;
+      int nRead = last - first;
+      std::vector<char> readBuffer(nRead*recordSize + 1);
+      file.Read_at_all(offset + first*recordSize, &readBuffer[0],
+                       nRead*recordSize, MPI::BYTE);
+      offset += (MPI::Offset)nAtom*recordSize;
+
+      // Identify the owner of each atom, and count atoms for each owner
+      std::vector<int> owners(nRead + 1);
+      std::vector<int> sendCounts(nProc, 0);
+      Vector r, rg;
+      int i;
+      for (i = 0; i < nRead; ++i) {
+         std::memcpy(&r[0], &readBuffer[i*recordSize + rOffset],
+                     sizeof(Vector));
+         boundary().transformCartToGen(r, rg);
+         boundary().shiftGen(rg);
+         owners[i] = domain().ownerRank(rg);
+         ++sendCounts[owners[i]];
+      }
+
+      // Copy records into send buffer, ordered by owner
+      std::vector<int> sendBegin(nProc, 0);
+      for (i = 1; i < nProc; ++i) {
+         sendBegin[i] = sendBegin[i-1] + sendCounts[i-1];
+      }
+      std::vector<char> sendBuffer(nRead*recordSize + 1);
+      for (i = 0; i < nRead; ++i) {
+         std::memcpy(&sendBuffer[sendBegin[owners[i]]*recordSize],
+                     &readBuffer[i*recordSize], recordSize);
+         ++sendBegin[owners[i]];
+      }
+
+      // Send all atoms to their owners
+      std::vector<char> recvBuffer;
+      std::vector<int> recvCounts;
+      int nRecv = exchangeRecords(sendBuffer, sendCounts, recordSize,
+                                  recvBuffer, recvCounts);
+
+      // Add received atoms to storage
+      int totalAtomCapacity = atomStorage().totalAtomCapacity();
+      Atom* atomPtr;
+      char* ptr;
+      int id, typeId;
+      for (i = 0; i < nRecv; ++i) {
+         ptr = &recvBuffer[i*recordSize];
+         std::memcpy(&id, ptr, sizeof(int));
+         std::memcpy(&typeId, ptr + sizeof(int), sizeof(int));
+         if (id < 0 || id >= totalAtomCapacity) {
+            UTIL_THROW("Invalid atom id");
+         }
+         if (typeId < 0) {
+            UTIL_THROW("Negative atom type id");
+         }
+         atomPtr = atomStorage().newAtomPtr();
+         atomPtr->setId(id);
+         atomPtr->setTypeId(typeId);
+         std::memcpy(&r[0], ptr + rOffset, sizeof(Vector));
+         boundary().transformCartToGen(r, atomPtr->position());
+         boundary().shiftGen(atomPtr->position());
+         std::memcpy(&atomPtr->velocity()[0],
+                     ptr + rOffset + sizeof(Vector), sizeof(Vector));
+         atomStorage().addNewAtom();
+      }
+
+      // Validate atom distribution
+      atomStorage().isValid(communicator);
+      atomStorage().unsetNAtomTotal();
+      atomStorage().computeNAtomTotal(communicator);
+      if (domain().isMaster()) {
+         if (atomStorage().nAtomTotal() != nAtom) {
+            UTIL_THROW("nAtomTotal != nAtom after distribution");
+         }
+      }
+
+      return nAtom;
+   }
+
+   /*
+   * Make the local part of the distributed atom directory.
+   *
+   * Each processor sends an (atom id, owner rank) pair for each of its
+   * atoms to the directory processor for that atom, id % nProc.
+   */
+   void SerializeMpiConfigIo::makeAtomDirectory(std::vector<int>& directory)
+   {
+      MPI::Intracomm& communicator = domain().communicator();
+      int nProc = communicator.Get_size();
+      int myRank = communicator.Get_rank();
+      int totalAtomCapacity = atomStorage().totalAtomCapacity();
+      const int recordSize = 2*sizeof(int);
+
+      // Count pairs to be sent to each directory processor
+      std::vector<int> sendCounts(nProc, 0);
+      AtomIterator atomIter;
+      atomStorage().begin(atomIter);
+      for ( ; atomIter.notEnd(); ++atomIter) {
+         ++sendCounts[atomIter->id() % nProc];
+      }
+
+      // Copy pairs into send buffer, ordered by directory processor
+      std::vector<int> sendBegin(nProc, 0);
+      int i;
+      for (i = 1; i < nProc; ++i) {
+         sendBegin[i] = sendBegin[i-1] + sendCounts[i-1];
+      }
+      std::vector<char> sendBuffer(atomStorage().nAtom()*recordSize + 1);
+      int record[2];
+      record[1] = myRank;
+      atomStorage().begin(atomIter);
+      for ( ; atomIter.notEnd(); ++atomIter) {
+         record[0] = atomIter->id();
+         i = record[0] % nProc;
+         std::memcpy(&sendBuffer[sendBegin[i]*recordSize], record,
+                     recordSize);
+         ++sendBegin[i];
+      }
+
+      // Send pairs to directory processors
+      std::vector<char> recvBuffer;
+      std::vector<int> recvCounts;
+      int nRecv = exchangeRecords(sendBuffer, sendCounts, recordSize,
+                                  recvBuffer, recvCounts);
+
+      // Store owner ranks, indexed by id/nProc
+      directory.assign((totalAtomCapacity + nProc - 1)/nProc, -1);
+      for (i = 0; i < nRecv; ++i) {
+         std::memcpy(record, &recvBuffer[i*recordSize], recordSize);
+         directory[record[0]/nProc] = record[1];
+      }
+   }
+
+   /*
+   * Find the owner ranks of a list of atoms from the atom directory.
+   *
+   * Queries are sent to directory processors and answered in the order
+   * received, so the answer to each query is returned to the position
+   * in the receive buffer that the query had in the send buffer.
+   */
+   void
+   SerializeMpiConfigIo::findAtomOwners(const std::vector<int>& atomIds,
+                                        const std::vector<int>& directory,
+                                        std::vector<int>& owners)
+   {
+      MPI::Intracomm& communicator = domain().communicator();
+      int nProc = communicator.Get_size();
+      int nQuery = atomIds.size();
+      int i, id, rank;
+
+      // Copy atom ids into send buffer, ordered by directory processor
+      std::vector<int> sendCounts(nProc, 0);
+      for (i = 0; i < nQuery; ++i) {
+         ++sendCounts[atomIds[i] % nProc];
+      }
+      std::vector<int> sendBegin(nProc, 0);
+      for (i = 1; i < nProc; ++i) {
+         sendBegin[i] = sendBegin[i-1] + sendCounts[i-1];
+      }
+      std::vector<int> positions(nQuery + 1);
+      std::vector<char> sendBuffer(nQuery*sizeof(int) + 1);
+      for (i = 0; i < nQuery; ++i) {
+         rank = atomIds[i] % nProc;
+         positions[i] = sendBegin[rank];
+         std::memcpy(&sendBuffer[positions[i]*sizeof(int)], &atomIds[i],
+                     sizeof(int));
+         ++sendBegin[rank];
+      }
+
+      // Send queries to directory processors
+      std::vector<char> queryBuffer;
+      std::vector<int> queryCounts;
+      int nRecv = exchangeRecords(sendBuffer, sendCounts, sizeof(int),
+                                  queryBuffer, queryCounts);
+
+      // Replace each query by the owner rank, and return the answers
+      for (i = 0; i < nRecv; ++i) {
+         std::memcpy(&id, &queryBuffer[i*sizeof(int)], sizeof(int));
+         rank = directory[id/nProc];
+         std::memcpy(&queryBuffer[i*sizeof(int)], &rank, sizeof(int));
+      }
+      std::vector<char> answerBuffer;
+      std::vector<int> answerCounts;
+      exchangeRecords(queryBuffer, queryCounts, sizeof(int),
+                      answerBuffer, answerCounts);
+
+      owners.resize(nQuery);
+      for (i = 0; i < nQuery; ++i) {
+         std::memcpy(&owners[i], &answerBuffer[positions[i]*sizeof(int)],
+                     sizeof(int));
+      }
+   }
+
+   /*
+   * Read Group<N> objects, and send each to the owners of its atoms.
+   */
+   template <int N>
+   int SerializeMpiConfigIo::readGroups(MPI::File& file,
+                                        MPI::Offset& offset,
+                                        GroupStorage<N>& storage,
+                                        const std::vector<int>& directory)
+   {
+      MPI::Intracomm& communicator = domain().communicator();
+      int nProc = communicator.Get_size();
+      int myRank = communicator.Get_rank();
+
+      // Record: id, typeId, atomIds
+      const int recordLength = 2 + N;
+      const int recordSize = recordLength*sizeof(int);
+
+      // Read total number of groups
+      int nGroup;
+      file.Read_at_all(offset, &nGroup, 1, MPI::INT);
+      offset += sizeof(int);
+
+      // Read a contiguous slice of the group records on each processor
+      MPI::Offset first = (MPI::Offset)nGroup*myRank/nProc;
+      MPI::Offset last  = (MPI::Offset)nGroup*(myRank + 1)/nProc;
+      int nRead = last - first;
+      std::vector<int> records(nRead*recordLength + 1);
+      file.Read_at_all(offset + first*recordSize, &records[0],
+                       nRead*recordLength, MPI::INT);
+      offset += (MPI::Offset)nGroup*recordSize;
+
+      // Find the owners of the atoms in all groups
+      int totalAtomCapacity = atomStorage().totalAtomCapacity();
+      std::vector<int> atomIds(nRead*N);
+      std::vector<int> atomOwners;
+      int i, j, k, atomId, rank;
+      for (i = 0; i < nRead; ++i) {
+         for (j = 0; j < N; ++j) {
+            atomId = records[i*recordLength + 2 + j];
+            if (atomId < 0 || atomId >= totalAtomCapacity) {
+               UTIL_THROW("Invalid atom id in group");
+            }
+            atomIds[i*N + j] = atomId;
+         }
+      }
+      findAtomOwners(atomIds, directory, atomOwners);
+
+      // Find the distinct owners of the atoms in each group (-1 if a
+      // duplicate), and count groups to be sent to each processor
+      std::vector<int> owners(nRead*N + 1);
+      std::vector<int> sendCounts(nProc, 0);
+      for (i = 0; i < nRead; ++i) {
+         for (j = 0; j < N; ++j) {
+            rank = atomOwners[i*N + j];
+            if (rank < 0) {
+               UTIL_THROW("Group contains an atom with no owner");
+            }
+            for (k = 0; k < j; ++k) {
+               if (owners[i*N + k] == rank) {
+                  rank = -1;
+                  break;
+               }
+            }
+            owners[i*N + j] = rank;
+            if (rank >= 0) {
+               ++sendCounts[rank];
+            }
+         }
+      }
+
+      // Copy records into send buffer, ordered by destination
+      std::vector<int> sendBegin(nProc, 0);
+      int nSend = sendCounts[0];
+      for (i = 1; i < nProc; ++i) {
+         sendBegin[i] = sendBegin[i-1] + sendCounts[i-1];
+         nSend += sendCounts[i];
+      }
+      std::vector<char> sendBuffer(nSend*recordSize + 1);
+      for (i = 0; i < nRead; ++i) {
+         for (j = 0; j < N; ++j) {
+            rank = owners[i*N + j];
+            if (rank >= 0) {
+               std::memcpy(&sendBuffer[sendBegin[rank]*recordSize],
+                           &records[i*recordLength], recordSize);
+               ++sendBegin[rank];
+            }
+         }
+      }
+
+      // Send all groups to the owners of their atoms
+      std::vector<char> recvBuffer;
+      std::vector<int> recvCounts;
+      int nRecv = exchangeRecords(sendBuffer, sendCounts, recordSize,
+                                  recvBuffer, recvCounts);
+
+      // Add received groups to storage
+      int record[2 + N];
+      Group<N>* groupPtr;
+      for (i = 0; i < nRecv; ++i) {
+         std::memcpy(record, &recvBuffer[i*recordSize], recordSize);
+         groupPtr = storage.newPtr();
+         groupPtr->setId(record[0]);
+         groupPtr->setTypeId(record[1]);
+         for (j = 0; j < N; ++j) {
+            groupPtr->setAtomId(j, record[2 + j]);
+         }
+         if (atomStorage().map().findGroupLocalAtoms(*groupPtr) > 0) {
+            storage.add();
+         } else {
+            storage.returnPtr();
+            UTIL_THROW("Group received by processor that owns no atoms");
+         }
+      }
+
+      // Validate group distribution
+      storage.unsetNTotal();
+      storage.computeNTotal(communicator);
+      if (domain().isMaster()) {
+         if (storage.nTotal() != nGroup) {
+            UTIL_THROW("Number of groups not equal number in file");
+         }
+      }
+
+      return nGroup;
+   }
+
+   /*
+   * Send fixed size records to other processors, in one exchange.
+   */
+   int SerializeMpiConfigIo::exchangeRecords(std::vector<char>& sendBuffer,
+                                             std::vector<int>& sendCounts,
+                                             int recordSize,
+                                             std::vector<char>& recvBuffer,
+                                             std::vector<int>& recvCounts)
+   {
+      MPI::Intracomm& communicator = domain().communicator();
+      int nProc = communicator.Get_size();
+
+      // Exchange numbers of records
+      recvCounts.resize(nProc);
+      communicator.Alltoall(&sendCounts[0], 1, MPI::INT,
+                            &recvCounts[0], 1, MPI::INT);
+
+      // Convert to sizes and displacements in bytes
+      std::vector<int> sendSizes(nProc);
+      std::vector<int> sendDispls(nProc);
+      std::vector<int> recvSizes(nProc);
+      std::vector<int> recvDispls(nProc);
+      int sendTotal = 0;
+      int recvTotal = 0;
+      int nRecv = 0;
+      for (int i = 0; i < nProc; ++i) {
+         sendSizes[i] = sendCounts[i]*recordSize;
+         sendDispls[i] = sendTotal;
+         sendTotal += sendSizes[i];
+         recvSizes[i] = recvCounts[i]*recordSize;
+         recvDispls[i] = recvTotal;
+         recvTotal += recvSizes[i];
+         nRecv += recvCounts[i];
+      }
+
+      // Exchange records
+      recvBuffer.resize(recvTotal + 1);
+      communicator.Alltoallv(&sendBuffer[0], &sendSizes[0], &sendDispls[0],
+                             MPI::BYTE,
+                             &recvBuffer[0], &recvSizes[0], &recvDispls[0],
+                             MPI::BYTE);
+
+      return nRecv;
+   }
+
+}
+#endif
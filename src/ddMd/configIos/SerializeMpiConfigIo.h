@@ -0,0 +1,149 @@
+#ifndef DDMD_SERIALIZE_MPI_CONFIG_IO_H
+#define DDMD_SERIALIZE_MPI_CONFIG_IO_H
+
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2012, David Morse (morse012@umn.edu)
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <ddMd/configIos/SerializeConfigIo.h>   // base class
+
+#include <string>
+#include <vector>
+
+namespace DdMd
+{
+
+   class Simulation;
+
+   using namespace Util;
+
+   /**
+   * Binary configuration file reader in which all processors read.
+   *
+   * This class uses the same binary file format as SerializeConfigIo,
+   * and inherits the readConfig() and writeConfig() methods that read
+   * and write a file on the master processor. It overrides the
+   * readConfigFile() method that implements the READ_CONFIG command,
+   * so that every processor reads a contiguous slice of the atom and
+   * group records with collective MPI-IO reads. Each processor then
+   * sends every atom it has read to the processor whose domain contains
+   * it, in a single all-to-all exchange. Groups are then read in the
+   * same way, and each group is sent to every processor that owns one
+   * or more of its atoms.
+   *
+   * To identify the owners of the atoms in each group, the rank of the
+   * owner of each atom is first recorded in a distributed directory, in
+   * which the entry for atom id is stored on processor id % nProc. Each
+   * processor then queries the directory for the owners of the atoms in
+   * the groups it has read, with one all-to-all exchange in each
+   * direction, so that no processor stores an array with one element
+   * for every possible atom id.
+   *
+   * \ingroup DdMd_ConfigIo_Module
+   */
+   class SerializeMpiConfigIo  : public SerializeConfigIo
+   {
+
+   public:
+
+      /**
+      * Default constructor.
+      */
+      SerializeMpiConfigIo();
+
+      /**
+      * Constructor.
+      *
+      * \param simulation parent Simulation object.
+      */
+      SerializeMpiConfigIo(Simulation& simulation);
+
+      /**
+      * Read a configuration file on all processors.
+      *
+      * Call on all processors. Preconditions and postconditions are those
+      * of SerializeConfigIo::loadConfig().
+      *
+      * \param fileMaster FileMaster used to construct the file path.
+      * \param filename name of input file, without input prefix.
+      * \param maskPolicy MaskPolicy to be used in setting atom masks
+      */
+      virtual void readConfigFile(const FileMaster& fileMaster,
+                                  const std::string& filename,
+                                  MaskPolicy maskPolicy);
+
+   private:
+
+      /**
+      * Read atoms and send each to the processor that owns it.
+      *
+      * \param file MPI file, open on all processors
+      * \param offset offset of atom section on entry, of next on exit
+      * \return total number of atoms in the file
+      */
+      int readAtoms(MPI::File& file, MPI::Offset& offset);
+
+      /**
+      * Read Group<N> objects and send each to the owners of its atoms.
+      *
+      * \param file MPI file, open on all processors
+      * \param offset offset of group section on entry, of next on exit
+      * \param storage GroupStorage<N> object for groups
+      * \param directory local part of the atom directory
+      * \return total number of groups in the file
+      */
+      template <int N>
+      int readGroups(MPI::File& file, MPI::Offset& offset,
+                     GroupStorage<N>& storage,
+                     const std::vector<int>& directory);
+
+      /**
+      * Make the local part of the distributed atom directory.
+      *
+      * On exit, element id/nProc of the directory on processor
+      * id % nProc is the rank of the owner of atom id, or -1 if
+      * there is no such atom.
+      *
+      * \param directory local part of the atom directory (output)
+      */
+      void makeAtomDirectory(std::vector<int>& directory);
+
+      /**
+      * Find the owner ranks of a list of atoms from the atom directory.
+      *
+      * \param atomIds ids of atoms (may contain duplicates)
+      * \param directory local part of the atom directory
+      * \param owners rank of the owner of each atom in atomIds (output)
+      */
+      void findAtomOwners(const std::vector<int>& atomIds,
+                          const std::vector<int>& directory,
+                          std::vector<int>& owners);
+
+      /**
+      * Send fixed size records to other processors, in one exchange.
+      *
+      * On entry, the sendBuffer contains records ordered by destination,
+      * and sendCounts contains the number of records for each processor.
+      * On exit, recvBuffer contains all records received by this one,
+      * ordered by source rank, and recvCounts contains the number of
+      * records received from each processor.
+      *
+      * \param sendBuffer records to send, ordered by destination rank
+      * \param sendCounts number of records to send to each processor
+      * \param recordSize size of each record, in bytes
+      * \param recvBuffer records received from all processors (output)
+      * \param recvCounts number of records from each processor (output)
+      * \return number of records received
+      */
+      int exchangeRecords(std::vector<char>& sendBuffer,
+                          std::vector<int>& sendCounts, int recordSize,
+                          std::vector<char>& recvBuffer,
+                          std::vector<int>& recvCounts);
+
+   };
+
+}
+#endif
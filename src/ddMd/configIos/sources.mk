@@ -4,6 +4,7 @@ ddMd_configIos_=\
    ddMd/configIos/DdMdOrderedConfigIo.cpp \
    ddMd/configIos/LammpsConfigIo.cpp \
    ddMd/configIos/SerializeConfigIo.cpp \
+   ddMd/configIos/SerializeMpiConfigIo.cpp \
    ddMd/configIos/ConfigIoFactory.cpp 
 
 ddMd_configIos_SRCS=\
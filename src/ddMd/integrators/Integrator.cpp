@@ -12,6 +12,7 @@
 #include <ddMd/simulation/Simulation.h>
 #include <ddMd/storage/AtomStorage.h>
 #include <ddMd/storage/AtomIterator.h>
+#include <ddMd/storage/GhostIterator.h>
 #include <ddMd/storage/GroupStorage.tpp>
 #include <ddMd/communicate/Exchanger.h>
 #include <ddMd/analyzers/AnalyzerManager.h>
@@ -31,6 +32,7 @@
 
 #include <util/ensembles/BoundaryEnsemble.h>
 #include <util/mpi/MpiLoader.h>
+#include <util/misc/Log.h>
 #include <util/format/Dbl.h>
 #include <util/format/Int.h>
 #include <util/format/Bool.h>
@@ -47,6 +49,11 @@ namespace DdMd
    Integrator::Integrator(Simulation& simulation)
      : SimulationAccess(simulation),
        timer_(Integrator::NTime),
+       balanceForceTime_(0.0),
+       tuneForceTime_(0.0),
+       tuneBuildTime_(0.0),
+       minSkin_(0.0),
+       maxSkin_(0.0),
        isSetup_(false),
        saveFileName_(),
        saveInterval_(0)
@@ -74,6 +81,15 @@ namespace DdMd
          }
          read<std::string>(in, "saveFileName", saveFileName_);
       }
+      minSkin_ = 0.0;
+      maxSkin_ = 0.0;
+      read<double>(in, "minSkin", minSkin_, false); // optional
+      if (minSkin_ > 0.0) {
+         read<double>(in, "maxSkin", maxSkin_);
+         if (maxSkin_ < minSkin_) {
+            UTIL_THROW("maxSkin < minSkin");
+         }
+      }
    }
 
    /*
@@ -92,6 +108,12 @@ namespace DdMd
          }
          loadParameter<std::string>(ar, "saveFileName", saveFileName_);
       }
+      minSkin_ = 0.0;
+      maxSkin_ = 0.0;
+      loadParameter<double>(ar, "minSkin", minSkin_, false); // optional
+      if (minSkin_ > 0.0) {
+         loadParameter<double>(ar, "maxSkin", maxSkin_);
+      }
 
       MpiLoader<Serializable::IArchive> loader(*this, ar);
       loader.load(iStep_);
@@ -107,6 +129,10 @@ namespace DdMd
       if (saveInterval_ > 0) {
          ar << saveFileName_;
       }
+      Parameter::saveOptional(ar, minSkin_, minSkin_ > 0.0);
+      if (minSkin_ > 0.0) {
+         ar << maxSkin_;
+      }
       ar << iStep_;
       ar << isSetup_;
    }
@@ -148,11 +174,24 @@ namespace DdMd
       if (!atomStorage().isCartesian()) {
          UTIL_THROW("Atom coordinates are not Cartesian");
       }
+      if (hasFastForces()) {
+         computeForcesAndObservables(0);
+         return;
+      }
 
       timer_.stamp(MISC);
       simulation().zeroForces();
       timer_.stamp(ZERO_FORCE);
-      pairPotential().computeForces();
+      if (exchanger().isUpdatePending()) {
+         // Compute local-local pair forces while ghosts are in transit
+         pairPotential().computeInteriorForces();
+         timer_.stamp(PAIR_FORCE);
+         exchanger().endUpdate();
+         timer_.stamp(UPDATE);
+         pairPotential().computeBoundaryForces();
+      } else {
+         pairPotential().computeForces();
+      }
       timer_.stamp(PAIR_FORCE);
       #ifdef INTER_BOND
       if (nBondType()) {
@@ -199,6 +238,10 @@ namespace DdMd
       }
 
       timer_.stamp(MISC);
+      if (exchanger().isUpdatePending()) {
+         exchanger().endUpdate();
+         timer_.stamp(UPDATE);
+      }
       simulation().zeroForces();
       timer_.stamp(ZERO_FORCE);
       pairPotential().computeForcesAndStress(domain().communicator());
@@ -237,6 +280,167 @@ namespace DdMd
       // simulation().forceSignal().notify();
    }
 
+   /*
+   * Compute forces for all local atoms and observables, with timing.
+   */
+   void Integrator::computeForcesAndObservables(int flags)
+   {
+      // Precondition
+      if (!atomStorage().isCartesian()) {
+         UTIL_THROW("Atom coordinates are not Cartesian");
+      }
+
+      // Make list of active potentials, with timer ids. If fast forces
+      // are used, the pair potential follows the fast (group) potentials.
+      const int maxPotential = 5;
+      Potential* potentialPtrs[maxPotential];
+      TimeId timeIds[maxPotential];
+      bool hasStress[maxPotential];
+      bool fastFlag = hasFastForces();
+      int nPotential = 0;
+      if (!fastFlag) {
+         potentialPtrs[nPotential] = &pairPotential();
+         timeIds[nPotential] = PAIR_FORCE;
+         hasStress[nPotential++] = true;
+      }
+      #ifdef INTER_BOND
+      if (nBondType()) {
+         potentialPtrs[nPotential] = &bondPotential();
+         timeIds[nPotential] = BOND_FORCE;
+         hasStress[nPotential++] = true;
+      }
+      #endif
+      #ifdef INTER_ANGLE
+      if (nAngleType()) {
+         potentialPtrs[nPotential] = &anglePotential();
+         timeIds[nPotential] = ANGLE_FORCE;
+         hasStress[nPotential++] = true;
+      }
+      #endif
+      #ifdef INTER_DIHEDRAL
+      if (nDihedralType()) {
+         potentialPtrs[nPotential] = &dihedralPotential();
+         timeIds[nPotential] = DIHEDRAL_FORCE;
+         hasStress[nPotential++] = true;
+      }
+      #endif
+      int nFast = nPotential;
+      if (fastFlag) {
+         potentialPtrs[nPotential] = &pairPotential();
+         timeIds[nPotential] = PAIR_FORCE;
+         hasStress[nPotential++] = true;
+      }
+      #ifdef INTER_EXTERNAL
+      if (hasExternal()) {
+         potentialPtrs[nPotential] = &externalPotential();
+         timeIds[nPotential] = EXTERNAL_FORCE;
+         hasStress[nPotential++] = false;
+      }
+      #endif
+
+      // Choose local contributions to compute, skipping values already set.
+      bool needEnergy = (flags & Simulation::POTENTIAL_ENERGIES);
+      bool needStress = (flags & Simulation::VIRIAL_STRESS);
+      double localEnergies[maxPotential];
+      Tensor localStresses[maxPotential];
+      double* energyPtrs[maxPotential];
+      Tensor* stressPtrs[maxPotential];
+      int i, j, k;
+      for (k = 0; k < nPotential; ++k) {
+         energyPtrs[k] = 0;
+         stressPtrs[k] = 0;
+         if (needEnergy && !potentialPtrs[k]->isEnergySet()) {
+            localEnergies[k] = 0.0;
+            energyPtrs[k] = &localEnergies[k];
+         }
+         if (needStress && hasStress[k] && !potentialPtrs[k]->isStressSet()) {
+            localStresses[k].zero();
+            stressPtrs[k] = &localStresses[k];
+         }
+      }
+
+      timer_.stamp(MISC);
+      if (exchanger().isUpdatePending()) {
+         exchanger().endUpdate();
+         timer_.stamp(UPDATE);
+      }
+      simulation().zeroForces();
+      timer_.stamp(ZERO_FORCE);
+      for (k = 0; k < nPotential; ++k) {
+         if (fastFlag && k == nFast) {
+            // Complete and store fast forces, and clear ghost forces
+            if (reverseUpdateFlag()) {
+               exchanger().reverseUpdate();
+               GhostIterator ghostIter;
+               atomStorage().begin(ghostIter);
+               for ( ; ghostIter.notEnd(); ++ghostIter) {
+                  ghostIter->force().zero();
+               }
+            }
+            storeFastForces();
+         }
+         potentialPtrs[k]->computeForcesAndObservables(energyPtrs[k], 
+                                                       stressPtrs[k]);
+         timer_.stamp(timeIds[k]);
+      }
+
+      // Reverse communication (if any)
+      if (reverseUpdateFlag()) {
+         exchanger().reverseUpdate();
+      }
+
+      // Pack all local contributions into one buffer.
+      double localValues[maxPotential*(1 + Dimension*Dimension)];
+      double totalValues[maxPotential*(1 + Dimension*Dimension)];
+      int n = 0;
+      for (k = 0; k < nPotential; ++k) {
+         if (energyPtrs[k]) {
+            localValues[n++] = localEnergies[k];
+         }
+         if (stressPtrs[k]) {
+            for (i = 0; i < Dimension; ++i) {
+               for (j = 0; j < Dimension; ++j) {
+                  localValues[n++] = localStresses[k](i, j);
+               }
+            }
+         }
+      }
+      if (n == 0) return;
+
+      // Sum over processors, with totals on master and zero on others.
+      #ifdef UTIL_MPI
+      domain().communicator().Reduce(localValues, totalValues, n, 
+                                     MPI::DOUBLE, MPI::SUM, 0);
+      if (domain().communicator().Get_rank() != 0) {
+         for (i = 0; i < n; ++i) {
+            totalValues[i] = 0.0;
+         }
+      }
+      timer_.stamp(ALLREDUCE);
+      #else
+      for (i = 0; i < n; ++i) {
+         totalValues[i] = localValues[i];
+      }
+      #endif
+
+      // Unpack and set total values, in the order packed.
+      Tensor stress;
+      n = 0;
+      for (k = 0; k < nPotential; ++k) {
+         if (energyPtrs[k]) {
+            potentialPtrs[k]->setEnergy(totalValues[n++]);
+         }
+         if (stressPtrs[k]) {
+            for (i = 0; i < Dimension; ++i) {
+               for (j = 0; j < Dimension; ++j) {
+                  stress(i, j) = totalValues[n++];
+               }
+            }
+            potentialPtrs[k]->setStress(stress);
+         }
+      }
+   }
+
    /*
    * Determine whether an atom exchange and reneighboring is needed.
    */
@@ -266,6 +470,128 @@ namespace DdMd
       #endif
    }
 
+   /*
+   * Shift domain boundaries to balance force computation time.
+   */
+   void Integrator::balanceDomains()
+   {
+      double forceTime = timer_.time(PAIR_FORCE) + timer_.time(BOND_FORCE)
+                       + timer_.time(ANGLE_FORCE) 
+                       + timer_.time(DIHEDRAL_FORCE)
+                       + timer_.time(EXTERNAL_FORCE);
+      double load = forceTime - balanceForceTime_;
+      balanceForceTime_ = forceTime;
+
+      Vector minWidths;
+      for (int i = 0; i < Dimension; ++i) {
+         minWidths[i] = pairPotential().cutoff()/boundary().length(i);
+      }
+      domain().balance(load, minWidths);
+   }
+
+   /*
+   * Adjust the pair list skin to minimize the time per step.
+   */
+   void Integrator::tuneSkin(int nStep, int nExchange)
+   {
+      if (minSkin_ <= 0.0) return;
+
+      // Pair force and reneighboring times since the previous call
+      double forceTime = timer_.time(PAIR_FORCE);
+      double buildTime = timer_.time(TRANSFORM_F) + timer_.time(EXCHANGE)
+                       + timer_.time(CELLLIST) + timer_.time(TRANSFORM_R)
+                       + timer_.time(PAIRLIST);
+      double times[2];
+      times[0] = forceTime - tuneForceTime_;
+      times[1] = buildTime - tuneBuildTime_;
+      tuneForceTime_ = forceTime;
+      tuneBuildTime_ = buildTime;
+      #ifdef UTIL_MPI
+      double sums[2];
+      domain().communicator().Allreduce(times, sums, 2, 
+                                        MPI::DOUBLE, MPI::SUM);
+      times[0] = sums[0];
+      times[1] = sums[1];
+      #endif
+      if (nStep <= 0 || nExchange <= 0) return;
+      if (times[0] <= 0.0 || times[1] <= 0.0) return;
+
+      // Coefficients of the model of the time per step used by 
+      // chooseSkin, fit to this run: a is the force time per step, 
+      // and b is the reneighboring time per step times the skin.
+      double oldSkin = pairPotential().skin();
+      double rc = pairPotential().cutoff() - oldSkin;
+      double a = times[0]/double(nStep);
+      double b = oldSkin*times[1]/double(nStep);
+
+      // Pair list cutoff may not exceed the width of any domain.
+      double limit = maxSkin_;
+      double width;
+      int i, k;
+      for (i = 0; i < Dimension; ++i) {
+         for (k = 0; k < domain().gridDimension(i); ++k) {
+            width = domain().plane(i, k+1) - domain().plane(i, k);
+            width *= boundary().length(i);
+            if (rc + limit > width) {
+               limit = width - rc;
+            }
+         }
+      }
+
+      // Number of pairs, taken proportional to (rc + s)^3, may not 
+      // exceed 90% of the pair list capacity on any processor.
+      PairList& pairList = pairPotential().pairList();
+      #ifdef UTIL_MPI
+      pairList.computeStatistics(domain().communicator());
+      #else
+      pairList.computeStatistics();
+      #endif
+      if (pairList.maxNPair() > 0) {
+         double ratio = 0.9*double(pairList.pairCapacity())
+                           /double(pairList.maxNPair());
+         double max = (rc + oldSkin)*pow(ratio, 1.0/3.0) - rc;
+         if (max < limit) {
+            limit = max;
+         }
+      }
+
+      double skin = chooseSkin(a, b, rc, oldSkin, minSkin_, maxSkin_, 
+                               limit);
+      pairPotential().setSkin(skin);
+      exchanger().setPairCutoff(pairPotential().cutoff());
+      if (domain().isMaster()) {
+         if (limit < minSkin_) {
+            Log::file() << "Pair list skin not changed: minSkin too large"
+                        << " for domain widths or pair capacity" 
+                        << std::endl;
+         } else {
+            Log::file() << "Pair list skin changed from " << oldSkin 
+                        << " to " << skin << std::endl;
+         }
+      }
+   }
+
+   /*
+   * Choose a pair list skin from a model of the time per step.
+   */
+   double Integrator::chooseSkin(double a, double b, double rc, 
+                                 double oldSkin, double minSkin, 
+                                 double maxSkin, double limit)
+   {
+      if (limit < minSkin) return oldSkin;
+
+      // Minimum of (rc + s)^3 (a + b/s): 3 a s^2 + 2 b s - b rc = 0
+      double skin = (sqrt(b*b + 3.0*a*b*rc) - b)/(3.0*a);
+
+      // Limit change per run, and enforce bounds.
+      if (skin > 2.0*oldSkin) skin = 2.0*oldSkin;
+      if (skin < 0.5*oldSkin) skin = 0.5*oldSkin;
+      if (skin > maxSkin) skin = maxSkin;
+      if (skin < minSkin) skin = minSkin;
+      if (skin > limit) skin = limit;
+      return skin;
+   }
+
    #if 0
    /*
    * Determine whether an atom exchange and reneighboring is needed.
@@ -540,6 +866,9 @@ namespace DdMd
       iStep_ = 0;
       initDynamicalState();
       timer().clear(); 
+      balanceForceTime_ = 0.0;
+      tuneForceTime_ = 0.0;
+      tuneBuildTime_ = 0.0;
       simulation().exchanger().timer().clear();
       simulation().buffer().clearStatistics();
       atomStorage().clearStatistics();
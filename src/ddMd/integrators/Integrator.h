@@ -113,6 +113,27 @@ namespace DdMd
       */
       int iStep() const;
 
+      /**
+      * Choose a pair list skin from a model of the time per step.
+      *
+      * Models the time per step as (rc + s)^3 (a + b/s), in which s is
+      * the skin, and returns the skin that minimizes it, changed by at
+      * most a factor of two from oldSkin, and restricted to the range
+      * [minSkin, maxSkin] and to s <= limit. Returns oldSkin unchanged
+      * if limit < minSkin, so that no skin in the range is allowed.
+      *
+      * \param a       pair force time per step
+      * \param b       reneighboring time per step, times oldSkin
+      * \param rc      maximum pair potential cutoff
+      * \param oldSkin skin used to measure a and b
+      * \param minSkin minimum skin
+      * \param maxSkin maximum skin
+      * \param limit   maximum skin allowed by domains and pair capacity
+      */
+      static double chooseSkin(double a, double b, double rc, 
+                               double oldSkin, double minSkin, 
+                               double maxSkin, double limit);
+
    protected:
 
       /// Timestamps for loop timing.
@@ -167,6 +188,11 @@ namespace DdMd
       * Upon return, forces are correct for all local atoms. Values
       * of the forces on ghost atoms are undefined. Executes reverse
       * communication if needed, and emits Simulation::forceSignal().
+      *
+      * If a ghost update begun by Exchanger::beginUpdate() is pending,
+      * forces between pairs of local atoms are computed before calling
+      * Exchanger::endUpdate(), and all other forces are computed after.
+      * If hasFastForces() is true, calls computeForcesAndObservables(0).
       */
       void computeForces();
 
@@ -177,9 +203,48 @@ namespace DdMd
       * Upon return, forces are correct for all local atoms. Values
       * of the forces on ghost atoms are undefined. Executes reverse
       * communication if needed, and emits Simulation::forceSignal().
+      * Completes any pending ghost update before computing forces.
       */
       void computeForcesAndVirial();
 
+      /**
+      * Compute forces for all local atoms and observables, with timing.
+      *
+      * Computes forces, as computeForces(), and also computes and sets
+      * the potential energies and/or virial stress selected by flags.
+      * Each potential adds local contributions to its energy and stress
+      * in the same loop as its forces, and all contributions are then
+      * summed over processors in a single reduction. Observables that
+      * are already set are not recomputed.
+      * Completes any pending ghost update before computing forces.
+      *
+      * If hasFastForces() is true, the bond, angle and dihedral forces
+      * are computed first, and storeFastForces() is called when these 
+      * are complete, before the pair and external forces are added.
+      *
+      * \param flags bitwise OR of Simulation::ObservableFlag values
+      */
+      void computeForcesAndObservables(int flags);
+
+      /**
+      * Does this integrator use fast (bond, angle and dihedral) forces?
+      *
+      * Default implementation returns false.
+      */
+      virtual bool hasFastForces() const
+      {  return false; }
+
+      /**
+      * Store the fast forces of all local atoms.
+      *
+      * Called by computeForcesAndObservables() if hasFastForces() is
+      * true, when the force on each local atom is the fast force. The 
+      * pair and external forces are then added to these forces. Default
+      * implementation is empty.
+      */
+      virtual void storeFastForces()
+      {}
+
       /**
       * Determine whether an atom exchange and reneighboring is needed.
       *
@@ -188,6 +253,35 @@ namespace DdMd
       */
       bool isExchangeNeeded(double skin);
 
+      /**
+      * Shift domain boundaries to balance force computation time.
+      *
+      * Passes the time spent computing forces on this processor since
+      * the previous call (or since the last call to clear) to 
+      * Domain::balance(), with minimum domain widths equal to the pair 
+      * list cutoff. Must be called on all processors, with generalized 
+      * atomic coordinates, immediately before Exchanger::exchange().
+      */
+      void balanceDomains();
+
+      /**
+      * Adjust the pair list skin to minimize the time per step.
+      *
+      * Does nothing unless the optional minSkin parameter is positive.
+      * Otherwise, uses the times spent computing pair forces and 
+      * rebuilding the pair list since the previous call (or since the
+      * last call to clear) to choose a new skin in the range [minSkin,
+      * maxSkin], which is used in the next run. The skin is also limited
+      * so that the pair cutoff fits within every domain, and so that the
+      * number of pairs, estimated from the maximum of the run, fits in 
+      * the pair list capacity. Must be called on all processors after 
+      * the main loop of a run.
+      *
+      * \param nStep     number of steps in the run
+      * \param nExchange number of exchanges (pair list builds) in the run
+      */
+      void tuneSkin(int nStep, int nExchange);
+
       /**
       * Get restart file base name. 
       */
@@ -211,6 +305,21 @@ namespace DdMd
       // Performance timer
       DdTimer timer_;
 
+      // Total force time at the previous call to balanceDomains.
+      double balanceForceTime_;
+
+      // Pair force time at the previous call to tuneSkin.
+      double tuneForceTime_;
+
+      // Reneighboring time at the previous call to tuneSkin.
+      double tuneBuildTime_;
+
+      // Minimum pair list skin for tuneSkin (no tuning if 0).
+      double minSkin_;
+
+      // Maximum pair list skin for tuneSkin.
+      double maxSkin_;
+
       // Has setup been called at least once?
       bool isSetup_;
 
@@ -0,0 +1,277 @@
+#ifndef DDMD_NVE_RESPA_INTEGRATOR_CPP
+#define DDMD_NVE_RESPA_INTEGRATOR_CPP
+
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2012, David Morse (morse012@umn.edu)
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "NveRespaIntegrator.h"
+#include <ddMd/simulation/Simulation.h>
+#include <ddMd/storage/AtomStorage.h>
+#include <ddMd/storage/AtomIterator.h>
+#include <ddMd/communicate/Exchanger.h>
+#ifdef INTER_BOND
+#include <ddMd/potentials/bond/BondPotential.h>
+#endif
+#ifdef INTER_ANGLE
+#include <ddMd/potentials/angle/AnglePotential.h>
+#endif
+#ifdef INTER_DIHEDRAL
+#include <ddMd/potentials/dihedral/DihedralPotential.h>
+#endif
+#include <util/global.h>
+
+#include <iostream>
+
+namespace DdMd
+{
+   using namespace Util;
+
+   /*
+   * Constructor.
+   */
+   NveRespaIntegrator::NveRespaIntegrator(Simulation& simulation)
+    : TwoStepIntegrator(simulation),
+      dt_(0.0),
+      nInner_(1)
+   {  setClassName("NveRespaIntegrator"); }
+
+   /*
+   * Destructor.
+   */
+   NveRespaIntegrator::~NveRespaIntegrator()
+   {}
+
+   /*
+   * Read time step dt and number of inner steps.
+   */
+   void NveRespaIntegrator::readParameters(std::istream& in)
+   {
+      read<double>(in, "dt", dt_);
+      read<int>(in, "nInner", nInner_);
+      if (nInner_ < 1) {
+         UTIL_THROW("nInner must be positive");
+      }
+      Integrator::readParameters(in);
+      allocate();
+   }
+
+   /**
+   * Load internal state from an archive.
+   */
+   void NveRespaIntegrator::loadParameters(Serializable::IArchive &ar)
+   {
+      loadParameter<double>(ar, "dt", dt_);
+      loadParameter<int>(ar, "nInner", nInner_);
+      Integrator::loadParameters(ar);
+      allocate();
+      //  Note: Prefactors and fast forces are calculated in setup()
+   }
+
+   /*
+   * Save internal state to an archive.
+   */
+   void NveRespaIntegrator::save(Serializable::OArchive &ar)
+   {
+      ar << dt_;
+      ar << nInner_;
+      Integrator::save(ar);
+   }
+
+   /*
+   * Allocate arrays (private).
+   */
+   void NveRespaIntegrator::allocate()
+   {
+      if (!prefactors_.isAllocated()) {
+         int nAtomType = simulation().nAtomType();
+         prefactors_.allocate(nAtomType);
+         innerPrefactors_.allocate(nAtomType);
+      }
+      if (!fastForces_.isAllocated()) {
+         int atomCapacity = atomStorage().atomCapacity();
+         fastForces_.allocate(atomCapacity);
+      }
+   }
+ 
+   /*
+   * Setup at beginning of run, before entering main loop.
+   */ 
+   void NveRespaIntegrator::setup()
+   {
+
+      // Initialize state and clear statistics on first usage.
+      if (!isSetup()) {
+         clear();
+         setIsSetup();
+      }
+
+      // Exchange atoms, build pair list, compute fast and total forces.
+      setupAtoms();
+      computeFastForces();
+      storeFastForces();
+      simulation().computeForces();
+
+      // Set prefactors for acceleration
+      double dtHalf = 0.5*dt_;
+      double mass;
+      int nAtomType = prefactors_.capacity();
+      for (int i = 0; i < nAtomType; ++i) {
+         mass = simulation().atomType(i).mass();
+         prefactors_[i] = dtHalf/mass;
+         innerPrefactors_[i] = dtHalf/(mass*double(nInner_));
+      }
+   }
+
+   /*
+   * Compute fast (bonded) forces for all local atoms (private).
+   *
+   * Requires that ghost positions be up to date. Forces on ghosts
+   * are undefined on exit.
+   */
+   void NveRespaIntegrator::computeFastForces()
+   {
+      simulation().zeroForces();
+      #ifdef INTER_BOND
+      if (nBondType()) {
+         bondPotential().computeForces();
+      }
+      #endif
+      #ifdef INTER_ANGLE
+      if (nAngleType()) {
+         anglePotential().computeForces();
+      }
+      #endif
+      #ifdef INTER_DIHEDRAL
+      if (nDihedralType()) {
+         dihedralPotential().computeForces();
+      }
+      #endif
+      if (reverseUpdateFlag()) {
+         exchanger().reverseUpdate();
+      }
+   }
+
+   /*
+   * Store fast forces on local atoms.
+   *
+   * Called by computeForcesAndObservables(), and by setup().
+   */
+   void NveRespaIntegrator::storeFastForces()
+   {
+      AtomIterator atomIter;
+      int i = 0;
+      atomStorage().begin(atomIter);
+      for ( ; atomIter.notEnd(); ++atomIter) {
+         fastForces_[i] = atomIter->force();
+         ++i;
+      }
+   }
+
+   /*
+   * First part of RESPA step.
+   *
+   * With fast forces f, slow forces g, and inner time step h = dt/nInner,
+   * a RESPA step is:
+   *
+   *        v += 0.5*g*dt/m
+   *        repeat nInner times:
+   *           v += 0.5*f*h/m
+   *           x += v*h
+   *           calculate fast forces f
+   *           v += 0.5*f*h/m
+   *        calculate slow forces g
+   *        v += 0.5*g*dt/m
+   *
+   * This function executes all but the final force calculation and the
+   * last two velocity updates, combining consecutive velocity updates.
+   * On entry, atom forces are f + g, and f is stored in fastForces_.
+   */
+   void NveRespaIntegrator::integrateStep1()
+   {
+      Vector dv;
+      Vector dr;
+      Vector slow;
+      double prefactor;      // = 0.5*dt/mass
+      double innerPrefactor; // = 0.5*h/mass
+      double h = dt_/double(nInner_);
+      AtomIterator atomIter;
+      int i, iInner;
+
+      // Half step with slow forces, first inner step with fast forces
+      i = 0;
+      atomStorage().begin(atomIter);
+      for ( ; atomIter.notEnd(); ++atomIter) {
+         const Vector& fast = fastForces_[i];
+         prefactor = prefactors_[atomIter->typeId()];
+         innerPrefactor = innerPrefactors_[atomIter->typeId()];
+
+         slow.subtract(atomIter->force(), fast);
+         dv.multiply(slow, prefactor);
+         atomIter->velocity() += dv;
+         dv.multiply(fast, innerPrefactor);
+         atomIter->velocity() += dv;
+
+         dr.multiply(atomIter->velocity(), h);
+         atomIter->position() += dr;
+         ++i;
+      }
+
+      // Remaining inner steps, with fast forces only
+      for (iInner = 1; iInner < nInner_; ++iInner) {
+         timer().stamp(INTEGRATE1);
+         exchanger().update();
+         timer().stamp(UPDATE);
+         computeFastForces();
+         timer().stamp(BOND_FORCE);
+
+         atomStorage().begin(atomIter);
+         for ( ; atomIter.notEnd(); ++atomIter) {
+            innerPrefactor = innerPrefactors_[atomIter->typeId()];
+            dv.multiply(atomIter->force(), 2.0*innerPrefactor);
+            atomIter->velocity() += dv;
+            dr.multiply(atomIter->velocity(), h);
+            atomIter->position() += dr;
+         }
+      }
+   }
+
+   /*
+   * Last part of RESPA step.
+   *
+   * On entry, atom forces are the total forces for the new positions,
+   * and the fast forces are stored in fastForces_.
+   */
+   void NveRespaIntegrator::integrateStep2()
+   {
+      Vector dv;
+      Vector slow;
+      double prefactor;      // = 0.5*dt/mass
+      double innerPrefactor; // = 0.5*h/mass
+      AtomIterator atomIter;
+      int i;
+
+      i = 0;
+      atomStorage().begin(atomIter);
+      for ( ; atomIter.notEnd(); ++atomIter) {
+         const Vector& fast = fastForces_[i];
+         prefactor = prefactors_[atomIter->typeId()];
+         innerPrefactor = innerPrefactors_[atomIter->typeId()];
+
+         slow.subtract(atomIter->force(), fast);
+         dv.multiply(slow, prefactor);
+         atomIter->velocity() += dv;
+         dv.multiply(fast, innerPrefactor);
+         atomIter->velocity() += dv;
+         ++i;
+      }
+
+      // Notify observers of change in velocity
+      simulation().velocitySignal().notify();
+   }
+
+}
+#endif
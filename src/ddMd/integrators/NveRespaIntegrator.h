@@ -0,0 +1,136 @@
+#ifndef DDMD_NVE_RESPA_INTEGRATOR_H
+#define DDMD_NVE_RESPA_INTEGRATOR_H
+
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2012, David Morse (morse012@umn.edu)
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "TwoStepIntegrator.h"      // base class
+#include <util/containers/DArray.h> // member template
+#include <util/space/Vector.h>      // member template parameter
+
+namespace DdMd
+{
+
+   class Simulation;
+   using namespace Util;
+
+   /**
+   * A multiple time step (RESPA) constant energy integrator.
+   *
+   * Forces are split into fast forces, from the bond, angle and dihedral
+   * potentials, and slow forces, from the pair and external potentials. 
+   * Each step of length dt is divided into nInner inner velocity-Verlet 
+   * steps of length dt/nInner, which use only the fast forces. Slow 
+   * forces are evaluated once per step, by the usual force calculation 
+   * in TwoStepIntegrator::run(), and are applied as half-step impulses at
+   * the beginning and end of each step. That calculation computes the
+   * fast forces first, and stores them (see Integrator::hasFastForces),
+   * so slow forces are obtained by subtraction of fast from total forces.
+   * Ghost positions are updated before each inner step, but atoms are 
+   * only exchanged between steps.
+   *
+   * \ingroup DdMd_Integrator_Module
+   */
+   class NveRespaIntegrator : public TwoStepIntegrator
+   {
+
+   public:
+
+      /**
+      * Constructor.
+      */
+      NveRespaIntegrator(Simulation& simulation);
+
+      /**
+      * Destructor.
+      */
+      ~NveRespaIntegrator();
+
+      /**
+      * Read required parameters.
+      *
+      * Reads the time step dt and the number nInner of inner steps.
+      */
+      void readParameters(std::istream& in);
+
+      /**
+      * Load internal state from an archive.
+      *
+      * \param ar input/loading archive
+      */
+      virtual void loadParameters(Serializable::IArchive &ar);
+
+      /**
+      * Save internal state to an archive.
+      *
+      * \param ar output/saving archive
+      */
+      virtual void save(Serializable::OArchive &ar);
+  
+   protected:
+
+      /**
+      * Setup state just before main loop.
+      *
+      * Calls Integrator::setupAtoms(), initializes prefactors and 
+      * computes fast forces.
+      */
+      void setup();
+
+      /**
+      * Return true, to store fast forces in computeForcesAndObservables.
+      */
+      virtual bool hasFastForces() const
+      {  return true; }
+
+      /**
+      * Store the fast forces on local atoms in fastForces_.
+      */
+      virtual void storeFastForces();
+
+      /**
+      * Execute first step of two-step integrator.
+      *
+      * Half-update velocities with slow forces, and take all inner
+      * steps except the last half-update with fast forces.
+      */
+      virtual void integrateStep1();
+
+      /**
+      * Execute second step of two-step integrator.
+      *
+      * Finish the velocity update.
+      */
+      virtual void integrateStep2();
+
+   private:
+
+      /// Fast forces on local atoms, in order of iteration.
+      DArray<Vector> fastForces_;
+
+      /// Factors of 0.5*dt_/mass, calculated in setup().
+      DArray<double> prefactors_;      
+
+      /// Factors of 0.5*(dt_/nInner_)/mass, calculated in setup().
+      DArray<double> innerPrefactors_;      
+
+      /// Time step.
+      double  dt_;
+
+      /// Number of inner steps per step.
+      int nInner_;
+
+      /// Allocate arrays.
+      void allocate();
+
+      /// Compute fast forces for local atoms.
+      void computeFastForces();
+
+   };
+
+}
+#endif
@@ -78,7 +78,22 @@ namespace DdMd
       exchanger().timer().start();
       int  beginStep = iStep_;
       int  endStep = iStep_ + nStep;
+      int  nExchange = 0;
       bool needExchange;
+      int  observables;
+
+      // Overlap ghost updates with pair forces only if no other code uses
+      // ghost positions between the update and the force calculation.
+      bool overlapFlag = simulation().overlapUpdateFlag();
+      #ifdef DDMD_MODIFIERS
+      if (modifierManager.size()) {
+         overlapFlag = false;
+      }
+      #endif
+      #ifdef DDMD_INTEGRATOR_DEBUG
+      overlapFlag = false;
+      #endif
+
       for ( ; iStep_ < endStep; ++iStep_) {
 
          // Atomic coordinates must be Cartesian on entry to loop body.
@@ -132,6 +147,7 @@ namespace DdMd
 
          // Exchange atoms if necessary
          if (needExchange) {
+            ++nExchange;
 
             #ifdef DDMD_MODIFIERS 
             modifierManager.preTransform(iStep_);
@@ -148,6 +164,11 @@ namespace DdMd
             timer().stamp(MODIFIER);
             #endif
       
+            // Shift domain boundaries, if scheduled
+            if (domain().updateBalanceCounter()) {
+               balanceDomains();
+            }
+
             // Exchange atom ownership, reidentify ghosts
             exchanger().exchange();
             timer().stamp(Integrator::EXCHANGE);
@@ -182,8 +203,13 @@ namespace DdMd
             timer().stamp(MODIFIER);
             #endif
      
-            // Update all ghost atom positions 
-            exchanger().update();
+            // Update all ghost atom positions. If overlapFlag, only 
+            // begin the update, which is completed in computeForces().
+            if (overlapFlag) {
+               exchanger().beginUpdate();
+            } else {
+               exchanger().update();
+            }
             timer().stamp(UPDATE);
 
             #ifdef DDMD_MODIFIERS 
@@ -210,14 +236,19 @@ namespace DdMd
          #endif
   
          // Calculate forces: 
-         // Calculate new forces for all local atoms. If constant pressure
-         // ensemble (not rigid), also calculate the virial stress. Both 
-         // methods use the timer() internall, and both send the modifyForce 
-         // signal. 
-         if (simulation().boundaryEnsemble().isRigid()) {
-            computeForces();
+         // Calculate new forces for all local atoms. Also calculate any
+         // potential energies and virial stress needed by analyzers at
+         // the next step, and the virial stress for a constant pressure
+         // ensemble (not rigid), with one pass over pairs and groups and
+         // one reduction. Both methods use the timer() internally.
+         observables = analyzerManager.observables(iStep_ + 1);
+         if (!simulation().boundaryEnsemble().isRigid()) {
+            observables |= Simulation::VIRIAL_STRESS;
+         }
+         if (observables) {
+            computeForcesAndObservables(observables);
          } else {
-            computeForcesAndVirial();
+            computeForces();
          }
 
          #ifdef DDMD_MODIFIERS 
@@ -253,6 +284,9 @@ namespace DdMd
          }
       }
 
+      // Adjust pair list skin for the next run, if enabled.
+      tuneSkin(nStep, nExchange);
+
       // Transform to scaled coordinates, in preparation for the next run.
       atomStorage().transformCartToGen(boundary());
 
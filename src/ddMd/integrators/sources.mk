@@ -2,6 +2,7 @@ ddMd_integrators_=\
    ddMd/integrators/Integrator.cpp \
    ddMd/integrators/TwoStepIntegrator.cpp \
    ddMd/integrators/NveIntegrator.cpp \
+   ddMd/integrators/NveRespaIntegrator.cpp \
    ddMd/integrators/NvtIntegrator.cpp \
    ddMd/integrators/NptIntegrator.cpp \
    ddMd/integrators/NphIntegrator.cpp \
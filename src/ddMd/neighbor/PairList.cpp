@@ -11,10 +11,13 @@
 #include "PairList.h"
 #include "PairIterator.h"
 #include <ddMd/chemistry/Atom.h>
+#include <ddMd/storage/AtomStorage.h>
 #include <util/space/Vector.h>
 #include <util/format/Int.h>
 #include <util/global.h>
 
+#include <algorithm>
+
 namespace DdMd
 {
 
@@ -27,6 +30,8 @@ namespace DdMd
     : atom1Ptrs_(),
       atom2Ptrs_(),
       first_(),
+      packedFirst_(),
+      packedIds_(),
       cutoff_(0.0),
       atomCapacity_(0),
       pairCapacity_(0),
@@ -35,7 +40,9 @@ namespace DdMd
       buildCounter_(0),
       maxNAtom_(0),
       maxNPair_(0),
-      isAllocated_(false)
+      isAllocated_(false),
+      hasPacked_(false),
+      isFull_(false)
    {}
    
    /*
@@ -56,6 +63,8 @@ namespace DdMd
       atom1Ptrs_.reserve(atomCapacity_);
       atom2Ptrs_.reserve(pairCapacity_);
       first_.reserve(atomCapacity_ + 1);
+      packedFirst_.reserve(atomCapacity_ + 1);
+      packedIds_.reserve(pairCapacity_);
   
       isAllocated_ = true;
    }
@@ -68,6 +77,9 @@ namespace DdMd
       atom1Ptrs_.clear();
       atom2Ptrs_.clear();
       first_.clear();
+      packedFirst_.clear();
+      packedIds_.clear();
+      hasPacked_ = false;
    }
  
    /*
@@ -98,6 +110,7 @@ namespace DdMd
       atom2Ptrs_.clear();
       first_.clear();
       first_.append(0);
+      hasPacked_ = false;
 
       // Copy positions and ids into cell list
       cellList.update();
@@ -165,6 +178,70 @@ namespace DdMd
       }
    }
 
+   /*
+   * Build packed list of neighbor indices from the Atom* list.
+   */
+   void PairList::buildPacked(const AtomStorage& storage, bool fullFlag)
+   {
+      if (!storage.isPacked()) {
+         UTIL_THROW("Storage is not packed");
+      }
+      const int nLocal = storage.packed().nLocal();
+      const int nAtom1 = atom1Ptrs_.size();
+      int i, j, id1, id2;
+
+      // Count neighbors of each local atom
+      packedFirst_.clear();
+      packedFirst_.resize(nLocal + 1);
+      for (i = 0; i < nAtom1; ++i) {
+         id1 = storage.packedId(*atom1Ptrs_[i]);
+         assert(id1 < nLocal);
+         packedFirst_[id1 + 1] += first_[i+1] - first_[i];
+         if (fullFlag) {
+            for (j = first_[i]; j < first_[i+1]; ++j) {
+               id2 = storage.packedId(*atom2Ptrs_[j]);
+               if (id2 < nLocal) {
+                  ++packedFirst_[id2 + 1];
+               }
+            }
+         }
+      }
+      for (i = 0; i < nLocal; ++i) {
+         packedFirst_[i+1] += packedFirst_[i];
+      }
+
+      // Fill rows, using packedFirst_[i] as insertion point for row i
+      const int nPair = packedFirst_[nLocal];
+      packedIds_.resize(nPair);
+      for (i = 0; i < nAtom1; ++i) {
+         id1 = storage.packedId(*atom1Ptrs_[i]);
+         for (j = first_[i]; j < first_[i+1]; ++j) {
+            id2 = storage.packedId(*atom2Ptrs_[j]);
+            packedIds_[packedFirst_[id1]++] = id2;
+            if (fullFlag && id2 < nLocal) {
+               packedIds_[packedFirst_[id2]++] = id1;
+            }
+         }
+      }
+
+      // Restore row boundaries (packedFirst_[i] now begins row i+1)
+      for (i = nLocal; i > 0; --i) {
+         packedFirst_[i] = packedFirst_[i-1];
+      }
+      packedFirst_[0] = 0;
+
+      // Sort neighbors in each row by packed index, for locality
+      if (nPair) {
+         int* ids = &packedIds_[0];
+         for (i = 0; i < nLocal; ++i) {
+            std::sort(ids + packedFirst_[i], ids + packedFirst_[i+1]);
+         }
+      }
+
+      isFull_ = fullFlag;
+      hasPacked_ = true;
+   }
+
    /*
    * Initialize a pair iterator.
    */
@@ -181,6 +258,53 @@ namespace DdMd
       }
    }
 
+   /*
+   * Initialize a PairIterator for part of the list.
+   */
+   void PairList::begin(PairIterator& iterator, int part, int nPart) const
+   {
+      assert(part >= 0);
+      assert(part < nPart);
+      int nAtom1 = atom1Ptrs_.size();
+      if (nAtom1) {
+         // Find primary atoms with first_[i] closest to part boundaries
+         long nPair = atom2Ptrs_.size();
+         const int* first = &first_[0];
+         int begin = std::lower_bound(first, first + nAtom1 + 1, 
+                                    int((nPair*part)/nPart)) - first;
+         int end = std::lower_bound(first, first + nAtom1 + 1, 
+                                    int((nPair*(part + 1))/nPart)) - first;
+         iterator.atom1Ptrs_ = &atom1Ptrs_[0];
+         iterator.atom2Ptrs_ = &atom2Ptrs_[0];
+         iterator.first_     = first;
+         iterator.nAtom1_    = end;
+         iterator.nAtom2_    = first_[end];
+         iterator.atom1Id_   = begin;
+         iterator.atom2Id_   = first_[begin];
+      }
+   }
+
+   /*
+   * Get range of packed rows for part of the list.
+   */
+   void PairList::getPackedPart(int part, int nPart, int& begin, int& end)
+   const
+   {
+      assert(hasPacked_);
+      assert(part >= 0);
+      assert(part < nPart);
+      int nRow = packedFirst_.size() - 1;
+      long nPair = packedIds_.size();
+      const int* first = &packedFirst_[0];
+      begin = std::lower_bound(first, first + nRow + 1, 
+                               int((nPair*part)/nPart)) - first;
+      end = std::lower_bound(first, first + nRow + 1, 
+                             int((nPair*(part + 1))/nPart)) - first;
+      if (part == nPart - 1) {
+         end = nRow;
+      }
+   }
+
    /*
    * Compute memory usage statistics (call on all processors).
    */
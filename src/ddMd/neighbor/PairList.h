@@ -19,6 +19,7 @@ namespace DdMd
    using namespace Util;
 
    class Atom;
+   class AtomStorage;
    class PairIterator;
    
    /**
@@ -68,6 +69,13 @@ namespace DdMd
       */
       void allocate(int atomCapacity, int pairCapacity, double cutoff);
 
+      /**
+      * Change the pair list cutoff, for use in the next build.
+      *
+      * \param cutoff       pair list cutoff = potential cutoff  + skin
+      */
+      void setCutoff(double cutoff);
+
       /**
       * Reset this to empty state.
       */  
@@ -81,6 +89,29 @@ namespace DdMd
       */
       void build(CellList& cellList, bool reverseUpdateFlag = false);
 
+      /**
+      * Build a packed copy of the list, using packed atom indices.
+      *
+      * Must be called after build(), when storage.isPacked() is true, and
+      * before any atoms are added to or removed from the storage. The 
+      * packed list contains one row for every local atom in the packed 
+      * ordering of the storage, in packed order, and lists the packed 
+      * indices of neighbors in each row in increasing order. 
+      *
+      * If fullFlag is false, each pair appears once, in the row of the 
+      * same primary atom as in the Atom* list. If fullFlag is true, each
+      * pair of local atoms appears twice, once in the row of each atom, 
+      * while a pair of a local atom and a ghost appears once, in the row
+      * of the local atom. A full list thus allows force loops to modify 
+      * only the force on the atom associated with each row. A full list
+      * may only be constructed from a list built with reverseUpdateFlag 
+      * false, for which all pairs involving ghosts are present.
+      *
+      * \param storage  AtomStorage containing all atoms in the list
+      * \param fullFlag if true, build a full list, else a half list
+      */
+      void buildPacked(const AtomStorage& storage, bool fullFlag = false);
+
       //@}
       /// \name Accessors (miscellaneous)
       //@{ 
@@ -91,6 +122,35 @@ namespace DdMd
       * \param iterator a PairList, initialized on output
       */
       void begin(PairIterator &iterator) const;
+
+      /**
+      * Initialize a PairIterator for one of several parts of the list.
+      *
+      * Divides the list into nPart contiguous parts containing nearly 
+      * equal numbers of pairs, without dividing the neighbors of any 
+      * primary atom, and initializes an iterator that visits only pairs
+      * in part number part. Each primary atom thus appears in only one 
+      * part. This is intended for loops that are divided among threads.
+      *
+      * \param iterator a PairIterator, initialized on output
+      * \param part     index of part, 0 <= part < nPart
+      * \param nPart    number of parts
+      */
+      void begin(PairIterator &iterator, int part, int nPart) const;
+ 
+      /**
+      * Get range of packed rows for one of several parts of the list.
+      *
+      * Divides the packed list into nPart contiguous ranges of rows that
+      * contain nearly equal numbers of pairs, and returns the range for
+      * part number part as rows begin <= i < end. 
+      *
+      * \param part     index of part, 0 <= part < nPart
+      * \param nPart    number of parts
+      * \param begin    index of first row in part (output)
+      * \param end      one more than index of last row in part (output)
+      */
+      void getPackedPart(int part, int nPart, int& begin, int& end) const;
  
       /**
       * Get the number of primary atoms in the PairList.
@@ -116,6 +176,40 @@ namespace DdMd
       * Has memory been allocated for this PairList?
       */
       bool isAllocated() const;
+
+      /**
+      * Is the packed list valid (was buildPacked called after build)?
+      */
+      bool hasPacked() const;
+
+      /**
+      * Is the packed list a full list (each pair stored twice)?
+      */
+      bool isFull() const;
+
+      /**
+      * Get the number of rows (local atoms) in the packed list.
+      */
+      int nPackedAtom() const;
+
+      /**
+      * Get the number of entries in the packed list.
+      */
+      int nPackedPair() const;
+
+      /**
+      * Get the array of indices of the first entry in each packed row.
+      *
+      * Packed indices of neighbors of the local atom with packed index i
+      * are given by elements packedFirst()[i] <= j < packedFirst()[i+1]
+      * of packedNeighbors(). 
+      */
+      const int* packedFirst() const;
+
+      /**
+      * Get the array of packed indices of neighbor atoms.
+      */
+      const int* packedNeighbors() const;
  
       //@}
       /// \name Statistics
@@ -178,6 +272,12 @@ namespace DdMd
       /// Array of indices in atom2Ptrs_ of first neighbor of an Atom.
       GArray<int>  first_; 
 
+      /// Array of indices in packedIds_ of first neighbor of a local atom.
+      GArray<int>  packedFirst_; 
+
+      /// Array of packed indices of neighbor atoms.
+      GArray<int>  packedIds_; 
+
       /// Pair list cutoff radius (pair potential cutoff + skin_).
       double cutoff_;
    
@@ -204,6 +304,12 @@ namespace DdMd
    
       /// Has memory been allocated?
       bool  isAllocated_;
+
+      /// Is the packed list valid?
+      bool  hasPacked_;
+
+      /// Is the packed list a full list?
+      bool  isFull_;
   
       /* 
       * Implementation Notes:
@@ -245,6 +351,12 @@ namespace DdMd
       * Note that GArray<int> first_ contains one more elements than 
       * atom1Ptrs_. The element first_[0] is equal to 0, and the last 
       * element is always equal to the total number of pairs.
+      *
+      * The optional packed list created by buildPacked() uses the same 
+      * compressed row format, with integer arrays packedFirst_ and 
+      * packedIds_, but has a row for every local atom (including those
+      * with no neighbors), so that the row index is the packed index of
+      * the local atom, and no equivalent of atom1Ptrs_ is needed.
       */
 
    }; 
@@ -285,6 +397,12 @@ namespace DdMd
    inline int PairList::maxNPair() const
    { return maxNPair_.value(); }
 
+   /*
+   * Change the pair list cutoff.
+   */ 
+   inline void PairList::setCutoff(double cutoff)
+   {  cutoff_ = cutoff; }
+
    /*
    * Get the number of times this PairList has been built.
    */ 
@@ -297,5 +415,47 @@ namespace DdMd
    inline bool PairList::isAllocated() const
    { return isAllocated_; }
 
+   /*
+   * Is the packed list valid?
+   */ 
+   inline bool PairList::hasPacked() const
+   { return hasPacked_; }
+
+   /*
+   * Is the packed list a full list?
+   */ 
+   inline bool PairList::isFull() const
+   { return isFull_; }
+
+   /*
+   * Get the number of rows in the packed list.
+   */ 
+   inline int PairList::nPackedAtom() const
+   { return packedFirst_.size() ? packedFirst_.size() - 1 : 0; }
+
+   /*
+   * Get the number of entries in the packed list.
+   */ 
+   inline int PairList::nPackedPair() const
+   { return packedIds_.size(); }
+
+   /*
+   * Get array of indices of first neighbor in each packed row.
+   */ 
+   inline const int* PairList::packedFirst() const
+   {
+      assert(hasPacked_); 
+      return &packedFirst_[0]; 
+   }
+
+   /*
+   * Get array of packed neighbor indices.
+   */ 
+   inline const int* PairList::packedNeighbors() const
+   {
+      assert(hasPacked_); 
+      return packedIds_.size() ? &packedIds_[0] : 0; 
+   }
+
 } 
 #endif
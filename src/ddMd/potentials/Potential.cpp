@@ -21,6 +21,9 @@ namespace DdMd
    Potential::Potential()
     : stress_(),
       energy_(),
+      #ifdef UTIL_OPENMP
+      threadForcesPtr_(0),
+      #endif
       reverseUpdateFlag_(false)
    { setClassName("Potential"); }
 
@@ -36,6 +39,14 @@ namespace DdMd
    void Potential::setReverseUpdateFlag(bool reverseUpdateFlag)
    { reverseUpdateFlag_ = reverseUpdateFlag; }
 
+   #ifdef UTIL_OPENMP
+   /*
+   * Set pointer to per-thread force buffers.
+   */
+   void Potential::setThreadForces(ThreadForces* threadForcesPtr)
+   { threadForcesPtr_ = threadForcesPtr; }
+   #endif
+
    /*
    * Get the value of the total energy.
    */
@@ -116,6 +127,21 @@ namespace DdMd
       #endif
    }
 
+   /*
+   * Compute atomic forces and local energy and/or stress contributions.
+   * 
+   * Default implementation computes forces, but cannot compute local 
+   * observables, and so throws an Exception if either is requested.
+   */
+   void Potential::computeForcesAndObservables(double* localEnergyPtr, 
+                                               Tensor* localStressPtr)
+   {
+      if (localEnergyPtr || localStressPtr) {
+         UTIL_THROW("Local energy or stress not implemented");
+      }
+      computeForces(); 
+   }
+
    /*
    * Reduce energy from all processors.
    */
@@ -15,6 +15,7 @@
 namespace DdMd
 {
 
+   class ThreadForces;
    using namespace Util;
 
    /**
@@ -52,6 +53,18 @@ namespace DdMd
       */
       bool reverseUpdateFlag() const;
 
+      #ifdef UTIL_OPENMP
+      /**
+      * Set per-thread force buffers, to enable threaded force loops.
+      *
+      * Subclasses that support threads divide force loops among threads
+      * if this pointer is not null. The default is a null pointer.
+      *
+      * \param threadForcesPtr pointer to buffers (or null, for one thread)
+      */
+      void setThreadForces(ThreadForces* threadForcesPtr);
+      #endif
+
       /// \name Total Energy, Force and Stress 
       //@{
 
@@ -120,6 +133,27 @@ namespace DdMd
       virtual void computeForcesAndStress();
       #endif
 
+      /**
+      * Compute forces and local contributions to energy and/or stress.
+      *
+      * Adds force contributions to all atomic forces and, in the same
+      * loop, adds the contributions of this processor to the energy to
+      * *localEnergyPtr and to the stress (divided by the volume) to
+      * *localStressPtr. A null pointer disables either contribution.
+      * This method does not communicate, and does not set the stored
+      * energy or stress: Local values are summed over processors by 
+      * the caller, as in Integrator::computeForcesAndObservables(),
+      * which then stores the totals by calling setEnergy and setStress.
+      *
+      * The default implementation throws an Exception if either pointer
+      * is not null, and otherwise just calls computeForces().
+      *
+      * \param localEnergyPtr pointer to local energy accumulator (or null)
+      * \param localStressPtr pointer to local stress accumulator (or null)
+      */
+      virtual void 
+      computeForcesAndObservables(double* localEnergyPtr, Tensor* localStressPtr);
+
       /**
       * Return the stress tensor.
       *
@@ -148,6 +182,20 @@ namespace DdMd
       */
       bool isStressSet() const;
 
+      /**
+      * Set a value for the total energy.
+      *
+      * \param energy total energy on master, 0 on other processors
+      */
+      void setEnergy(double energy);
+
+      /**
+      * Set a value for the total stress.
+      *
+      * \param stress total stress on master, 0 on other processors
+      */
+      void setStress(const Tensor& stress);
+
       #ifdef UTIL_MPI
       /**
       * Is the potential in a valid internal state?
@@ -164,15 +212,12 @@ namespace DdMd
 
    protected:
 
+      #ifdef UTIL_OPENMP
       /**
-      * Set a value for the total energy.
+      * Get pointer to per-thread force buffers (null if not threaded).
       */
-      void setEnergy(double energy);
-
-      /**
-      * Set a value for the total stress.
-      */
-      void setStress(const Tensor& stress);
+      ThreadForces* threadForcesPtr() const;
+      #endif
 
       /**
       * Add a pair contribution to the stress tensor.
@@ -220,6 +265,11 @@ namespace DdMd
       /// Total energy.
       Setable<double> energy_;
 
+      #ifdef UTIL_OPENMP
+      /// Pointer to per-thread force buffers (null if not threaded).
+      ThreadForces* threadForcesPtr_;
+      #endif
+
       /// Is reverse update communication enabled?
       bool reverseUpdateFlag_;
 
@@ -228,6 +278,11 @@ namespace DdMd
    inline bool Potential::reverseUpdateFlag() const
    {  return reverseUpdateFlag_; }
 
+   #ifdef UTIL_OPENMP
+   inline ThreadForces* Potential::threadForcesPtr() const
+   {  return threadForcesPtr_; }
+   #endif
+
    /*
    * Add a pair contribution to the virial tensor (protected).
    */
@@ -0,0 +1,80 @@
+#ifndef DDMD_THREAD_FORCES_CPP
+#define DDMD_THREAD_FORCES_CPP
+
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2012, David Morse (morse012@umn.edu)
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#ifdef UTIL_OPENMP
+
+#include "ThreadForces.h"
+
+namespace DdMd
+{
+
+   using namespace Util;
+
+   /*
+   * Constructor.
+   */
+   ThreadForces::ThreadForces()
+    : forces_(),
+      storagePtr_(0),
+      capacity_(0),
+      nThread_(0)
+   {}
+
+   /*
+   * Destructor.
+   */
+   ThreadForces::~ThreadForces()
+   {}
+
+   /*
+   * Allocate and zero buffers for all threads.
+   */
+   void ThreadForces::allocate(AtomStorage& storage, int nThread)
+   {
+      if (forces_.isAllocated()) {
+         UTIL_THROW("ThreadForces already allocated");
+      }
+      if (nThread < 1) {
+         UTIL_THROW("nThread < 1");
+      }
+      storagePtr_ = &storage;
+      nThread_ = nThread;
+      capacity_ = storage.atomCapacity() + storage.ghostCapacity();
+      forces_.allocate(nThread_*capacity_);
+      for (int i = 0; i < forces_.capacity(); ++i) {
+         forces_[i].zero();
+      }
+   }
+
+   /*
+   * Add buffered forces from all threads to atomic forces, zero buffers.
+   */
+   void ThreadForces::reduce(bool addGhosts)
+   {
+      AtomStorage& storage = *storagePtr_;
+      const int nAtom = storage.nAtom();
+      const int nAll = addGhosts ? nAtom + storage.nGhost() : nAtom;
+
+      #pragma omp parallel for num_threads(nThread_) schedule(static)
+      for (int i = 0; i < nAll; ++i) {
+         Atom& atom = i < nAtom ? storage.localAtom(i)
+                                : storage.ghostAtom(i - nAtom);
+         Vector* ptr = &forces_[storage.arrayId(atom)];
+         for (int t = 0; t < nThread_; ++t) {
+            atom.force() += *ptr;
+            ptr->zero();
+            ptr += capacity_;
+         }
+      }
+   }
+
+}
+#endif // ifdef UTIL_OPENMP
+#endif
@@ -0,0 +1,144 @@
+#ifndef DDMD_THREAD_FORCES_H
+#define DDMD_THREAD_FORCES_H
+
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2012, David Morse (morse012@umn.edu)
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#ifdef UTIL_OPENMP
+
+#include <ddMd/storage/AtomStorage.h>     // inline methods
+#include <ddMd/chemistry/Atom.h>          // inline methods
+#include <util/containers/DArray.h>       // member template
+#include <util/space/Vector.h>            // member template parameter
+#include <util/global.h>
+
+namespace DdMd
+{
+
+   using namespace Util;
+
+   /**
+   * Per-thread force accumulation buffers for threaded force loops.
+   *
+   * A ThreadForces object provides a separate array of force vectors for
+   * each of nThread() OpenMP threads, each of which has one element for
+   * every local and ghost atom in an associated AtomStorage, indexed by
+   * AtomStorage::arrayId(). Within a parallel region, each thread adds
+   * force contributions for atoms that may also be modified by other
+   * threads to its own array, using add() or subtract(). After the end
+   * of the parallel region, reduce() adds the sum of the contributions
+   * from all threads to the forces of the corresponding atoms, and
+   * resets all buffers to zero.
+   *
+   * All buffers are zero after allocate() and after each call to reduce().
+   *
+   * \ingroup DdMd_Potential_Module
+   */
+   class ThreadForces
+   {
+
+   public:
+
+      /**
+      * Constructor.
+      */
+      ThreadForces();
+
+      /**
+      * Destructor.
+      */
+      ~ThreadForces();
+
+      /**
+      * Allocate buffers for all local and ghost atoms in a storage.
+      *
+      * \param storage  associated AtomStorage (must be initialized)
+      * \param nThread  maximum number of threads
+      */
+      void allocate(AtomStorage& storage, int nThread);
+
+      /**
+      * Add a force to the buffer of one thread.
+      *
+      * \param threadId  thread index, 0 <= threadId < nThread()
+      * \param atom      local or ghost atom in the associated storage
+      * \param force     force to be added
+      */
+      void add(int threadId, const Atom& atom, const Vector& force);
+
+      /**
+      * Subtract a force from the buffer of one thread.
+      *
+      * \param threadId  thread index, 0 <= threadId < nThread()
+      * \param atom      local or ghost atom in the associated storage
+      * \param force     force to be subtracted
+      */
+      void subtract(int threadId, const Atom& atom, const Vector& force);
+
+      /**
+      * Add buffered forces to atomic forces, and zero all buffers.
+      *
+      * Call from outside of any parallel region. The loop over atoms
+      * is divided among nThread() threads. If addGhosts is false, the
+      * buffers must not contain any contributions to ghost atoms.
+      *
+      * \param addGhosts if true, also add buffered forces to ghosts.
+      */
+      void reduce(bool addGhosts);
+
+      /**
+      * Return the maximum number of threads.
+      */
+      int nThread() const;
+
+      /**
+      * Has memory been allocated?
+      */
+      bool isAllocated() const;
+
+   private:
+
+      /// Buffers for all threads (thread t begins at element t*capacity_).
+      DArray<Vector> forces_;
+
+      /// Pointer to associated AtomStorage.
+      AtomStorage* storagePtr_;
+
+      /// Number of elements per thread (atomCapacity + ghostCapacity).
+      int capacity_;
+
+      /// Maximum number of threads.
+      int nThread_;
+
+   };
+
+   // Inline methods
+
+   inline
+   void ThreadForces::add(int threadId, const Atom& atom, const Vector& force)
+   {
+      assert(threadId >= 0 && threadId < nThread_);
+      forces_[threadId*capacity_ + storagePtr_->arrayId(atom)] += force;
+   }
+
+   inline
+   void
+   ThreadForces::subtract(int threadId, const Atom& atom, const Vector& force)
+   {
+      assert(threadId >= 0 && threadId < nThread_);
+      forces_[threadId*capacity_ + storagePtr_->arrayId(atom)] -= force;
+   }
+
+   inline int ThreadForces::nThread() const
+   {  return nThread_; }
+
+   inline bool ThreadForces::isAllocated() const
+   {  return forces_.isAllocated(); }
+
+}
+#endif // ifdef UTIL_OPENMP
+#endif
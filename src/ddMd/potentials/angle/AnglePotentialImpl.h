@@ -171,6 +171,17 @@ namespace DdMd
       virtual void computeStress();
       #endif
 
+      /**
+      * Compute angle forces and local energy and/or stress.
+      *
+      * Uses a single loop over angles, without communication.
+      *
+      * \param localEnergyPtr pointer to local energy accumulator (or null)
+      * \param localStressPtr pointer to local stress accumulator (or null)
+      */
+      virtual void 
+      computeForcesAndObservables(double* localEnergyPtr, Tensor* localStressPtr);
+
       //@}
 
    private:
@@ -180,6 +191,13 @@ namespace DdMd
       */ 
       Interaction* interactionPtr_;
 
+      #ifdef UTIL_OPENMP
+      /**
+      * Compute angle forces, dividing groups among threads.
+      */
+      void computeForcesThreads();
+      #endif
+
    };
 
 }
@@ -188,6 +206,10 @@ namespace DdMd
 #include <ddMd/simulation/Simulation.h>
 #include <ddMd/storage/GroupStorage.h>
 #include <ddMd/storage/GroupIterator.h>
+#ifdef UTIL_OPENMP
+#include <ddMd/potentials/ThreadForces.h>
+#include <omp.h>
+#endif
 
 #include <util/boundary/Boundary.h>
 #include <util/space/Dimension.h>
@@ -314,6 +336,13 @@ namespace DdMd
    template <class Interaction>
    void AnglePotentialImpl<Interaction>::computeForces()
    {  
+      #ifdef UTIL_OPENMP
+      if (threadForcesPtr()) {
+         computeForcesThreads();
+         return;
+      }
+      #endif
+
       Vector dr1; // R[1] - R[0]
       Vector dr2; // R[2] - R[1]
       Vector f1;  // d(energy)/d(dr1)
@@ -349,6 +378,60 @@ namespace DdMd
       }
    }
 
+   #ifdef UTIL_OPENMP
+   /*
+   * Increment atomic forces, dividing angles among threads (private).
+   */
+   template <class Interaction>
+   void AnglePotentialImpl<Interaction>::computeForcesThreads()
+   {
+      ThreadForces& forces = *threadForcesPtr();
+      const int nGroup = storage().size();
+
+      #pragma omp parallel num_threads(forces.nThread())
+      {
+         Vector dr1; // R[1] - R[0]
+         Vector dr2; // R[2] - R[1]
+         Vector f1;  // d(energy)/d(dr1)
+         Vector f2;  // d(energy)/d(dr2)
+         Vector f;
+         Atom* atom0Ptr;
+         Atom* atom1Ptr;
+         Atom* atom2Ptr;
+         int   type, i;
+         int threadId = omp_get_thread_num();
+         int nThread = omp_get_num_threads();
+         int begin = (nGroup*threadId)/nThread;
+         int end = (nGroup*(threadId + 1))/nThread;
+
+         for (i = begin; i < end; ++i) {
+            Group<3>& group = storage().group(i);
+            type = group.typeId();
+            atom0Ptr = group.atomPtr(0);
+            atom1Ptr = group.atomPtr(1);
+            atom2Ptr = group.atomPtr(2);
+            boundary().distanceSq(atom1Ptr->position(),
+                                  atom0Ptr->position(), dr1);
+            boundary().distanceSq(atom2Ptr->position(),
+                                  atom1Ptr->position(), dr2);
+            interaction().force(dr1, dr2, f1, f2, type);
+            if (!atom0Ptr->isGhost()) {
+               forces.add(threadId, *atom0Ptr, f1);
+            }
+            if (!atom1Ptr->isGhost()) {
+               f.subtract(f2, f1);
+               forces.add(threadId, *atom1Ptr, f);
+            }
+            if (!atom2Ptr->isGhost()) {
+               forces.subtract(threadId, *atom2Ptr, f2);
+            }
+         }
+      }
+
+      forces.reduce(false);
+   }
+   #endif
+
    /*
    * Compute total angle energy on all processors.
    */
@@ -461,5 +544,75 @@ namespace DdMd
       reduceStress(localStress, communicator);
    }
 
+   /*
+   * Compute angle forces and local energy and/or stress, in one loop.
+   */
+   template <class Interaction>
+   void 
+   AnglePotentialImpl<Interaction>::computeForcesAndObservables(double* localEnergyPtr,
+                                                                Tensor* localStressPtr)
+   {
+      Tensor localStress;
+      Vector dr1; // R[1] - R[0]
+      Vector dr2; // R[2] - R[1]
+      Vector f1;  // d(energy)/d(dr1)
+      Vector f2;  // d(energy)/d(dr2)
+      double rsq1, rsq2, cosTheta, factor;
+      double localEnergy = 0.0;
+      double third = 1.0/3.0;
+      GroupIterator<3> iter;
+      Atom* atom0Ptr;
+      Atom* atom1Ptr;
+      Atom* atom2Ptr;
+      int   type, isLocal0, isLocal1, isLocal2;
+
+      localStress.zero();
+      storage().begin(iter);
+      for ( ; iter.notEnd(); ++iter) {
+         type = iter->typeId();
+         atom0Ptr = iter->atomPtr(0);
+         atom1Ptr = iter->atomPtr(1);
+         atom2Ptr = iter->atomPtr(2);
+         isLocal0 = !(atom0Ptr->isGhost());
+         isLocal1 = !(atom1Ptr->isGhost());
+         isLocal2 = !(atom2Ptr->isGhost());
+         // Calculate minimimum image separations
+         rsq1 = boundary().distanceSq(atom1Ptr->position(),
+                                      atom0Ptr->position(), dr1);
+         rsq2 = boundary().distanceSq(atom2Ptr->position(),
+                                      atom1Ptr->position(), dr2);
+         interaction().force(dr1, dr2, f1, f2, type);
+         if (isLocal0) {
+            atom0Ptr->force() += f1;
+         }
+         if (isLocal1) {
+            atom1Ptr->force() -= f1;
+            atom1Ptr->force() += f2;
+         }
+         if (isLocal2) {
+            atom2Ptr->force() -= f2;
+         }
+         factor = (isLocal0 + isLocal1 + isLocal2)*third;
+         if (localEnergyPtr) {
+            cosTheta = dr1.dot(dr2) / sqrt(rsq1 * rsq2);
+            localEnergy += factor*interaction().energy(cosTheta, type);
+         }
+         if (localStressPtr) {
+            dr1 *= -factor;
+            dr2 *= -factor;
+            incrementPairStress(f1, dr1, localStress);
+            incrementPairStress(f2, dr2, localStress);
+         }
+      }
+
+      if (localEnergyPtr) {
+         *localEnergyPtr += localEnergy;
+      }
+      if (localStressPtr) {
+         localStress /= boundary().volume();
+         *localStressPtr += localStress;
+      }
+   }
+
 }
 #endif
@@ -174,6 +174,17 @@ namespace DdMd
       virtual void computeForcesAndStress();
       #endif
 
+      /**
+      * Compute bond forces and local energy and/or stress.
+      *
+      * Uses a single loop over bonds, without communication.
+      *
+      * \param localEnergyPtr pointer to local energy accumulator (or null)
+      * \param localStressPtr pointer to local stress accumulator (or null)
+      */
+      virtual void 
+      computeForcesAndObservables(double* localEnergyPtr, Tensor* localStressPtr);
+
       //@}
 
    private:
@@ -188,6 +199,13 @@ namespace DdMd
       */ 
       Interaction* interactionPtr_;
 
+      #ifdef UTIL_OPENMP
+      /**
+      * Compute bond forces, dividing groups among threads.
+      */
+      void computeForcesThreads();
+      #endif
+
    };
 
 }
@@ -196,6 +214,10 @@ namespace DdMd
 #include <ddMd/simulation/Simulation.h>
 #include <ddMd/storage/GroupStorage.h>
 #include <ddMd/storage/GroupIterator.h>
+#ifdef UTIL_OPENMP
+#include <ddMd/potentials/ThreadForces.h>
+#include <omp.h>
+#endif
 #include <util/boundary/Boundary.h>
 #include <util/space/Vector.h>
 #include <util/global.h>
@@ -330,6 +352,13 @@ namespace DdMd
    template <class Interaction>
    void BondPotentialImpl<Interaction>::computeForces()
    {  
+      #ifdef UTIL_OPENMP
+      if (threadForcesPtr()) {
+         computeForcesThreads();
+         return;
+      }
+      #endif
+
       Vector f;
       double rsq;
       GroupIterator<2> iter;
@@ -358,6 +387,52 @@ namespace DdMd
       }
    }
 
+   #ifdef UTIL_OPENMP
+   /*
+   * Increment atomic forces, dividing bonds among threads (private).
+   *
+   * Each thread processes a contiguous range of bonds, and adds forces
+   * to its own buffer. Buffered forces are then summed.
+   */
+   template <class Interaction>
+   void BondPotentialImpl<Interaction>::computeForcesThreads()
+   {
+      ThreadForces& forces = *threadForcesPtr();
+      const int nGroup = storage().size();
+
+      #pragma omp parallel num_threads(forces.nThread())
+      {
+         Vector f;
+         double rsq;
+         Atom* atom0Ptr;
+         Atom* atom1Ptr;
+         int type, i;
+         int threadId = omp_get_thread_num();
+         int nThread = omp_get_num_threads();
+         int begin = (nGroup*threadId)/nThread;
+         int end = (nGroup*(threadId + 1))/nThread;
+
+         for (i = begin; i < end; ++i) {
+            Group<2>& group = storage().group(i);
+            type = group.typeId();
+            atom0Ptr = group.atomPtr(0);
+            atom1Ptr = group.atomPtr(1);
+            rsq = boundary().distanceSq(atom0Ptr->position(), 
+                                        atom1Ptr->position(), f);
+            f *= interactionPtr_->forceOverR(rsq, type);
+            if (!atom0Ptr->isGhost()) {
+               forces.add(threadId, *atom0Ptr, f);
+            }
+            if (!atom1Ptr->isGhost()) {
+               forces.subtract(threadId, *atom1Ptr, f);
+            }
+         }
+      }
+
+      forces.reduce(false);
+   }
+   #endif
+
    /*
    * Compute total bond energy on all processors, store result on master.
    */
@@ -525,5 +600,64 @@ namespace DdMd
       reduceStress(localStress, communicator);
    }
 
+   /*
+   * Compute bond forces and local energy and/or stress, in one loop.
+   */
+   template <class Interaction>
+   void 
+   BondPotentialImpl<Interaction>::computeForcesAndObservables(double* localEnergyPtr,
+                                                               Tensor* localStressPtr)
+   {
+      Tensor localStress;
+      Vector dr;
+      Vector f;
+      double rsq, weight;
+      double localEnergy = 0.0;
+      GroupIterator<2> iter;
+      Atom*  atom0Ptr;
+      Atom*  atom1Ptr;
+      int    type;
+      int    isLocal0, isLocal1;
+
+      localStress.zero();
+
+      // Iterate over bonds
+      storage().begin(iter);
+      for ( ; iter.notEnd(); ++iter) {
+         type = iter->typeId();
+         atom0Ptr = iter->atomPtr(0);
+         atom1Ptr = iter->atomPtr(1);
+         rsq = boundary().distanceSq(atom0Ptr->position(), 
+                                        atom1Ptr->position(), dr);
+         f  = dr;
+         f *= interactionPtr_->forceOverR(rsq, type);
+         isLocal0 = !(atom0Ptr->isGhost());
+         isLocal1 = !(atom1Ptr->isGhost());
+         assert(isLocal0 || isLocal1);
+         if (isLocal0) {
+            atom0Ptr->force() += f;
+         }
+         if (isLocal1) {
+            atom1Ptr->force() -= f;
+         }
+         weight = (isLocal0 && isLocal1) ? 1.0 : 0.5;
+         if (localEnergyPtr) {
+            localEnergy += weight*interactionPtr_->energy(rsq, type);
+         }
+         if (localStressPtr) {
+            f *= weight;
+            incrementPairStress(f, dr, localStress);
+         }
+      }
+
+      if (localEnergyPtr) {
+         *localEnergyPtr += localEnergy;
+      }
+      if (localStressPtr) {
+         localStress /= boundary().volume();
+         *localStressPtr += localStress;
+      }
+   }
+
 }
 #endif
@@ -181,6 +181,17 @@ namespace DdMd
       virtual void computeStress();
       #endif
 
+      /**
+      * Compute dihedral forces and local energy and/or stress.
+      *
+      * Uses a single loop over dihedrals, without communication.
+      *
+      * \param localEnergyPtr pointer to local energy accumulator (or null)
+      * \param localStressPtr pointer to local stress accumulator (or null)
+      */
+      virtual void 
+      computeForcesAndObservables(double* localEnergyPtr, Tensor* localStressPtr);
+
       //@}
       
    private:
@@ -190,6 +201,13 @@ namespace DdMd
       */ 
       Interaction* interactionPtr_;
 
+      #ifdef UTIL_OPENMP
+      /**
+      * Compute dihedral forces, dividing groups among threads.
+      */
+      void computeForcesThreads();
+      #endif
+
    };
 
 }
@@ -198,6 +216,10 @@ namespace DdMd
 #include <ddMd/simulation/Simulation.h>
 #include <ddMd/storage/GroupStorage.h>
 #include <ddMd/storage/GroupIterator.h>
+#ifdef UTIL_OPENMP
+#include <ddMd/potentials/ThreadForces.h>
+#include <omp.h>
+#endif
 #include <util/boundary/Boundary.h>
 #include <util/space/Vector.h>
 #include <util/global.h>
@@ -341,6 +363,13 @@ namespace DdMd
    template <class Interaction>
    void DihedralPotentialImpl<Interaction>::computeForces()
    {
+      #ifdef UTIL_OPENMP
+      if (threadForcesPtr()) {
+         computeForcesThreads();
+         return;
+      }
+      #endif
+
       // Preconditions
       //if (!storage().isInitialized()) {
       //   UTIL_THROW("GroupStorage must be initialized");
@@ -392,6 +421,67 @@ namespace DdMd
       }
    }
 
+   #ifdef UTIL_OPENMP
+   /*
+   * Increment atomic forces, dividing dihedrals among threads (private).
+   */
+   template <class Interaction>
+   void DihedralPotentialImpl<Interaction>::computeForcesThreads()
+   {
+      ThreadForces& forces = *threadForcesPtr();
+      const int nGroup = storage().size();
+
+      #pragma omp parallel num_threads(forces.nThread())
+      {
+         Vector dr1; // R[1] - R[0]
+         Vector dr2; // R[2] - R[1]
+         Vector dr3; // R[3] - R[2]
+         Vector f1, f2, f3, f;
+         Atom* atom0Ptr;
+         Atom* atom1Ptr;
+         Atom* atom2Ptr;
+         Atom* atom3Ptr;
+         int   type, i;
+         int threadId = omp_get_thread_num();
+         int nThread = omp_get_num_threads();
+         int begin = (nGroup*threadId)/nThread;
+         int end = (nGroup*(threadId + 1))/nThread;
+
+         for (i = begin; i < end; ++i) {
+            Group<4>& group = storage().group(i);
+            type = group.typeId();
+            atom0Ptr = group.atomPtr(0);
+            atom1Ptr = group.atomPtr(1);
+            atom2Ptr = group.atomPtr(2);
+            atom3Ptr = group.atomPtr(3);
+            boundary().distanceSq(atom1Ptr->position(),
+                                  atom0Ptr->position(), dr1);
+            boundary().distanceSq(atom2Ptr->position(),
+                                  atom1Ptr->position(), dr2);
+            boundary().distanceSq(atom3Ptr->position(),
+                                  atom2Ptr->position(), dr3);
+            interaction().force(dr1, dr2, dr3, f1, f2, f3, type);
+            if (!atom0Ptr->isGhost()) {
+               forces.add(threadId, *atom0Ptr, f1);
+            }
+            if (!atom1Ptr->isGhost()) {
+               f.subtract(f2, f1);
+               forces.add(threadId, *atom1Ptr, f);
+            }
+            if (!atom2Ptr->isGhost()) {
+               f.subtract(f3, f2);
+               forces.add(threadId, *atom2Ptr, f);
+            }
+            if (!atom3Ptr->isGhost()) {
+               forces.subtract(threadId, *atom3Ptr, f3);
+            }
+         }
+      }
+
+      forces.reduce(false);
+   }
+   #endif
+
    /*
    * Compute total dihedral energy on all processors.
    */
@@ -501,7 +591,7 @@ namespace DdMd
                                atom2Ptr->position(), dr3);
 
          // Calculate derivatives of energy with respect to dr1, dr2, dr3
-         interaction().force(dr1, dr2, dr2, f1, f2, f3, type);
+         interaction().force(dr1, dr2, dr3, f1, f2, f3, type);
 
          isLocal0 = !(atom0Ptr->isGhost());
          isLocal1 = !(atom1Ptr->isGhost());
@@ -525,5 +615,87 @@ namespace DdMd
       reduceStress(localStress, communicator);
    }
 
+   /*
+   * Compute dihedral forces and local energy and/or stress, in one loop.
+   */
+   template <class Interaction>
+   void 
+   DihedralPotentialImpl<Interaction>::computeForcesAndObservables(double* localEnergyPtr,
+                                                                   Tensor* localStressPtr)
+   {
+      Tensor localStress;
+      Vector dr1; // R[1] - R[0]
+      Vector dr2; // R[2] - R[1]
+      Vector dr3; // R[3] - R[2]
+      Vector f1, f2, f3;
+      double factor;
+      double localEnergy = 0.0;
+      GroupIterator<4> iter;
+      Atom* atom0Ptr;
+      Atom* atom1Ptr;
+      Atom* atom2Ptr;
+      Atom* atom3Ptr;
+      int   type, isLocal0, isLocal1, isLocal2, isLocal3;
+
+      localStress.zero();
+      for (storage().begin(iter); iter.notEnd(); ++iter) {
+         type = iter->typeId();
+         atom0Ptr = iter->atomPtr(0);
+         atom1Ptr = iter->atomPtr(1);
+         atom2Ptr = iter->atomPtr(2);
+         atom3Ptr = iter->atomPtr(3);
+         isLocal0 = !(atom0Ptr->isGhost());
+         isLocal1 = !(atom1Ptr->isGhost());
+         isLocal2 = !(atom2Ptr->isGhost());
+         isLocal3 = !(atom3Ptr->isGhost());
+
+         // Calculate minimimum image separations dr1, dr2, dr3
+         boundary().distanceSq(atom1Ptr->position(),
+                               atom0Ptr->position(), dr1);
+         boundary().distanceSq(atom2Ptr->position(),
+                               atom1Ptr->position(), dr2);
+         boundary().distanceSq(atom3Ptr->position(),
+                               atom2Ptr->position(), dr3);
+
+         // Calculate derivatives of energy with respect to r1, r2, r3
+         interaction().force(dr1, dr2, dr3, f1, f2, f3, type);
+
+         if (isLocal0) {
+            atom0Ptr->force() += f1;
+         }
+         if (isLocal1) {
+            atom1Ptr->force() -= f1;
+            atom1Ptr->force() += f2;
+         }
+         if (isLocal2) {
+            atom2Ptr->force() -= f2;
+            atom2Ptr->force() += f3;
+         }
+         if (isLocal3) {
+            atom3Ptr->force() -= f3;
+         }
+         factor = (isLocal0 + isLocal1 + isLocal2 + isLocal3)*0.25;
+         if (localEnergyPtr) {
+            localEnergy += factor*interaction().energy(dr1, dr2, dr3, type);
+         }
+         if (localStressPtr) {
+            dr1 *= -factor;
+            dr2 *= -factor;
+            dr3 *= -factor;
+            incrementPairStress(f1, dr1, localStress);
+            incrementPairStress(f2, dr2, localStress);
+            incrementPairStress(f3, dr3, localStress);
+         }
+      }
+
+      if (localEnergyPtr) {
+         *localEnergyPtr += localEnergy;
+      }
+      if (localStressPtr) {
+         localStress /= boundary().volume();
+         *localStressPtr += localStress;
+      }
+   }
+
 }
 #endif
@@ -133,6 +133,19 @@ namespace DdMd
       virtual void computeEnergy();
       #endif
 
+      /**
+      * Compute external forces and local energy.
+      *
+      * Uses a single loop over local atoms, without communication. The
+      * external potential does not contribute to the virial stress, so
+      * localStressPtr is ignored.
+      *
+      * \param localEnergyPtr pointer to local energy accumulator (or null)
+      * \param localStressPtr ignored
+      */
+      virtual void 
+      computeForcesAndObservables(double* localEnergyPtr, Tensor* localStressPtr);
+
       //@}
 
    private:
@@ -317,6 +330,21 @@ namespace DdMd
       #endif
    }
 
+   /*
+   * Compute external forces and local energy, in one loop.
+   */
+   template <class Interaction>
+   void 
+   ExternalPotentialImpl<Interaction>::computeForcesAndObservables(double* localEnergyPtr,
+                                                                   Tensor* localStressPtr)
+   {
+      if (localEnergyPtr) {
+         *localEnergyPtr += computeForces(true, true); 
+      } else {
+         computeForces(true, false); 
+      }
+   }
+
    /*
    * Increment atomic forces and/or external energy (private).
    */
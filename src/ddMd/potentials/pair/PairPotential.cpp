@@ -36,6 +36,7 @@ namespace DdMd
       boundaryPtr_(0),
       storagePtr_(0),
       methodId_(0),
+      listType_(0),
       nPair_(0),
       pairEnergies_()
    {  setClassName("PairPotential"); } 
@@ -51,6 +52,7 @@ namespace DdMd
       boundaryPtr_(&simulation.boundary()),
       storagePtr_(&simulation.atomStorage()),
       methodId_(0),
+      listType_(0),
       nPair_(0),
       pairEnergies_()
    {  setClassName("PairPotential"); } 
@@ -94,6 +96,11 @@ namespace DdMd
       read<double>(in, "skin", skin_);
       nCellCut_ = 1; // Default value
       read<int>(in, "nCellCut", nCellCut_, false);  // optional parameter
+      listType_ = 0; // Default value
+      read<int>(in, "listType", listType_, false);  // optional parameter
+      if (listType_ < 0 || listType_ > 2) {
+         UTIL_THROW("Invalid listType: must be 0, 1 or 2");
+      }
       read<int>(in, "pairCapacity", pairCapacity_);
       read<Boundary>(in, "maxBoundary", maxBoundary_);
       cutoff_ = maxPairCutoff() + skin_;
@@ -108,6 +115,7 @@ namespace DdMd
   
       loadParameter<double>(ar, "skin", skin_);
       loadParameter<int>(ar, "nCellCut", nCellCut_, false);
+      loadParameter<int>(ar, "listType", listType_, false);
       loadParameter<int>(ar, "pairCapacity", pairCapacity_);
       loadParameter<Boundary>(ar, "maxBoundary", maxBoundary_);
 
@@ -124,12 +132,26 @@ namespace DdMd
    {
       ar << skin_;
       Parameter::saveOptional(ar, nCellCut_, true);
+      Parameter::saveOptional(ar, listType_, listType_ != 0);
       ar << pairCapacity_;
       ar << maxBoundary_;
       ar << cutoff_;
       ar << methodId_;
    }
 
+   /*
+   * Change the pair list skin and cutoff.
+   */
+   void PairPotential::setSkin(double skin)
+   {
+      if (skin < 0.0) {
+         UTIL_THROW("Negative pair list skin");
+      }
+      skin_ = skin;
+      cutoff_ = maxPairCutoff() + skin_;
+      pairList_.setCutoff(cutoff_);
+   }
+
    /*
    * Allocate memory for the cell list and pair list.
    *
@@ -212,6 +234,13 @@ namespace DdMd
          UTIL_THROW("Coordinates not Cartesian entering buildPairList");
       }
       pairList_.build(cellList_, reverseUpdateFlag());
+      if (listType_ > 0) {
+         if (listType_ == 2 && reverseUpdateFlag()) {
+            UTIL_THROW("Full pair list (listType 2) requires reverseUpdateFlag 0");
+         }
+         storage().pack();
+         pairList_.buildPacked(storage(), listType_ == 2);
+      }
    }
 
    /*
@@ -117,6 +117,25 @@ namespace DdMd
       */
       void setMethodId(int methodId);
 
+      /**
+      * Set id to specify the type of pair list used by methodId 0.
+      *
+      * \param listType  0=Atom* half list, 1=packed half list, 2=packed full list
+      */
+      void setListType(int listType);
+
+      /**
+      * Change the pair list skin, and thus the pair list cutoff.
+      *
+      * The new cutoff is used by the next calls to buildCellList and 
+      * buildPairList, which also recompute the cell grid. The pair list
+      * must thus be rebuilt before it is used again. The caller must 
+      * also pass the new cutoff() to Exchanger::setPairCutoff().
+      *
+      * \param skin new pair list skin length
+      */
+      void setSkin(double skin);
+
       /// \name Interaction interface
       //@{
 
@@ -213,6 +232,26 @@ namespace DdMd
       virtual void computePairEnergies() = 0;
       #endif
 
+      /**
+      * Add pair forces for pairs in which both atoms are local.
+      *
+      * This method may be called between Exchanger::beginUpdate() and
+      * Exchanger::endUpdate(), while ghost coordinates are being updated,
+      * and must be followed by computeBoundaryForces() after the update 
+      * is complete. Together, the two methods add the same forces as
+      * computeForces(). Implementations for which pairs cannot be
+      * separated in this way may add no forces here, and instead add 
+      * all pair forces in computeBoundaryForces().
+      */
+      virtual void computeInteriorForces() = 0;
+
+      /**
+      * Add all pair forces not added by computeInteriorForces().
+      *
+      * Requires valid ghost coordinates. 
+      */
+      virtual void computeBoundaryForces() = 0;
+
       /**
       * Return total pair energies, from all processors.
       *
@@ -276,6 +315,11 @@ namespace DdMd
       */
       int methodId() const;
 
+      /**
+      * Return integer id for pair list type (0=ATOM*, 1=PACKED, 2=FULL)
+      */
+      int listType() const;
+
    protected:
 
       // CellList to construct PairList or calculate nonbonded pair forces.
@@ -333,6 +377,9 @@ namespace DdMd
       /// Index for method used to calculate forces / energies.
       int methodId_;
 
+      /// Index for type of pair list (0=Atom*, 1=packed half, 2=packed full).
+      int listType_;
+
       /// Number of pairs within specified cutoff.
       int nPair_;
 
@@ -378,5 +425,11 @@ namespace DdMd
    inline int PairPotential::methodId() const
    {  return methodId_; }
 
+   inline void PairPotential::setListType(int listType)
+   {  listType_ = listType; }
+
+   inline int PairPotential::listType() const
+   {  return listType_; }
+
 }
 #endif
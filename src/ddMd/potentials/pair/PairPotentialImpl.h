@@ -14,7 +14,7 @@
 
 #include <algorithm>
 
-#define  PAIR_BLOCK_SIZE 16
+#define  PAIR_BLOCK_SIZE 64
 
 namespace DdMd
 {
@@ -162,6 +162,19 @@ namespace DdMd
       */
       virtual void computeForces();
 
+      /**
+      * Add pair forces for pairs in which both atoms are local.
+      *
+      * Adds forces only if the default Atom* pair list is used by a 
+      * single thread. Otherwise, does nothing.
+      */
+      virtual void computeInteriorForces();
+
+      /**
+      * Add all pair forces not added by computeInteriorForces().
+      */
+      virtual void computeBoundaryForces();
+
       /**
       * Compute the total nonBonded pair energy for all processors
       * 
@@ -207,17 +220,25 @@ namespace DdMd
       virtual void computeForcesAndStress();
       #endif
 
+      /**
+      * Compute nonbonded forces and local energy and/or stress.
+      *
+      * If both pointers are null, this simply calls computeForces().
+      * Otherwise, forces and observables are computed in a single scalar
+      * loop over the pair list, without communication, so steps on which
+      * observables are sampled do not use the packed or threaded force
+      * kernels selected by computeForces().
+      *
+      * \param localEnergyPtr pointer to local energy accumulator (or null)
+      * \param localStressPtr pointer to local stress accumulator (or null)
+      */
+      virtual void 
+      computeForcesAndObservables(double* localEnergyPtr, Tensor* localStressPtr);
+
       //@}
 
    private:
 
-      struct PairForce {
-         Vector f;
-         double rsq;
-         Atom*  ptr0;
-         Atom*  ptr1;
-      };
-
       /**
       * Pointer to pair interaction object.
       */ 
@@ -233,8 +254,16 @@ namespace DdMd
 
       /**
       * Calculate atomic pair forces, using PairList.
+      *
+      * \param pairSet 0 for all pairs, 1 for local-local pairs only,
+      *                2 for pairs with a ghost only.
       */
-      void computeForcesList();
+      void computeForcesList(int pairSet = 0);
+
+      /**
+      * Can computeForcesList() separate interior and boundary pairs?
+      */
+      bool hasInteriorForces() const;
 
       /**
       * Calculate atomic pair forces and/or pair potential energy.
@@ -259,8 +288,91 @@ namespace DdMd
       void computeForcesNSq();
 
       #ifdef PAIR_BLOCK_SIZE
-      PairForce  pairs_[PAIR_BLOCK_SIZE];
-      PairForce* inPairs_[PAIR_BLOCK_SIZE];
+      /*
+      * Buffers for a block of pairs, for Interaction block functions.
+      */
+      struct PairBlock 
+      {
+         // Separations (input) and forces (output).
+         double dx[PAIR_BLOCK_SIZE];
+         double dy[PAIR_BLOCK_SIZE];
+         double dz[PAIR_BLOCK_SIZE];
+
+         // Squared separations (input) and energies (output).
+         double rsq[PAIR_BLOCK_SIZE];
+         double energy[PAIR_BLOCK_SIZE];
+
+         // Atom types and pointers.
+         int    type0[PAIR_BLOCK_SIZE];
+         int    type1[PAIR_BLOCK_SIZE];
+         Atom*  ptr0[PAIR_BLOCK_SIZE];
+         Atom*  ptr1[PAIR_BLOCK_SIZE];
+
+         // Packed atom indices (used only with a packed pair list).
+         int    id0[PAIR_BLOCK_SIZE];
+         int    id1[PAIR_BLOCK_SIZE];
+      };
+
+      // Block buffers used by single-threaded loops.
+      PairBlock block_;
+
+      /*
+      * Add forces for the first n pairs in a block.
+      */
+      void addBlockForces(PairBlock& block, int n) const;
+
+      /*
+      * Return sum of energies of the first n pairs in a block.
+      */
+      double blockEnergy(PairBlock& block, int n) const;
+
+      /*
+      * Calculate atomic pair forces, using packed PairList and arrays.
+      */
+      void computeForcesPacked();
+
+      /*
+      * Calculate atomic pair energy, using packed PairList and arrays.
+      */
+      double energyPacked();
+
+      /*
+      * Add packed forces for rows begin <= i < end of packed PairList.
+      */
+      void addPackedForces(int begin, int end, PairBlock& block);
+
+      /*
+      * Return energy of pairs in rows begin <= i < end of packed list.
+      */
+      double packedEnergy(int begin, int end, PairBlock& block);
+
+      /*
+      * Add packed forces for the first n pairs in a block.
+      */
+      void addPackedBlockForces(PairBlock& block, int n);
+
+      /*
+      * Return sum of energies of the first n pairs in a packed block.
+      */
+      double packedBlockEnergy(PairBlock& block, int n);
+
+      #ifdef UTIL_OPENMP
+      /*
+      * Add forces for the first n pairs in a block, within a thread.
+      */
+      void addBlockForces(PairBlock& block, int n, 
+                          ThreadForces& forces, int threadId) const;
+
+      /*
+      * Calculate atomic pair energy, using PairList and threads.
+      */
+      double energyListThreads();
+
+      /*
+      * Calculate atomic pair forces, using PairList and threads.
+      */
+      void computeForcesListThreads();
+      #endif
       #endif
 
    };
@@ -273,6 +385,10 @@ namespace DdMd
 #include <ddMd/storage/GhostIterator.h>
 #include <ddMd/neighbor/PairIterator.h>
 #include <ddMd/communicate/Domain.h>
+#ifdef UTIL_OPENMP
+#include <ddMd/potentials/ThreadForces.h>
+#include <omp.h>
+#endif
 
 #include <util/space/Dimension.h>
 #include <util/space/Vector.h>
@@ -403,6 +519,18 @@ namespace DdMd
    void PairPotentialImpl<Interaction>::computeForces()
    {  
        if (methodId() == 0) {
+          #ifdef PAIR_BLOCK_SIZE
+          if (pairList_.hasPacked()) {
+             computeForcesPacked();
+             return;
+          }
+          #endif
+          #if defined(UTIL_OPENMP) && defined(PAIR_BLOCK_SIZE)
+          if (threadForcesPtr()) {
+             computeForcesListThreads();
+             return;
+          }
+          #endif
           computeForcesList(); 
        } else
        if (methodId() == 1) {
@@ -412,6 +540,46 @@ namespace DdMd
        }
    }
 
+   /*
+   * Increment forces for local-local pairs, if possible.
+   */
+   template <class Interaction>
+   void PairPotentialImpl<Interaction>::computeInteriorForces()
+   {
+      if (hasInteriorForces()) {
+         computeForcesList(1);
+      }
+   }
+
+   /*
+   * Increment all forces not added by computeInteriorForces().
+   */
+   template <class Interaction>
+   void PairPotentialImpl<Interaction>::computeBoundaryForces()
+   {
+      if (hasInteriorForces()) {
+         computeForcesList(2);
+      } else {
+         computeForces();
+      }
+   }
+
+   /*
+   * Does computeForces() use the single-threaded Atom* pair list?
+   */
+   template <class Interaction>
+   bool PairPotentialImpl<Interaction>::hasInteriorForces() const
+   {
+      if (methodId() != 0) return false;
+      #ifdef PAIR_BLOCK_SIZE
+      if (pairList_.hasPacked()) return false;
+      #endif
+      #if defined(UTIL_OPENMP) && defined(PAIR_BLOCK_SIZE)
+      if (threadForcesPtr()) return false;
+      #endif
+      return true;
+   }
+
    /*
    * Compute total pair energy on all processors.
    */
@@ -428,7 +596,24 @@ namespace DdMd
  
       double localEnergy = 0.0; 
       if (methodId() == 0) {
+         #if defined(UTIL_OPENMP) && defined(PAIR_BLOCK_SIZE)
+         if (pairList_.hasPacked()) {
+            localEnergy = energyPacked(); 
+         } else 
+         if (threadForcesPtr()) {
+            localEnergy = energyListThreads(); 
+         } else {
+            localEnergy = energyList(); 
+         }
+         #elif defined(PAIR_BLOCK_SIZE)
+         if (pairList_.hasPacked()) {
+            localEnergy = energyPacked(); 
+         } else {
+            localEnergy = energyList(); 
+         }
+         #else
          localEnergy = energyList(); 
+         #endif
       } else 
       if (methodId() == 1) {
          localEnergy = energyCell(); 
@@ -453,6 +638,33 @@ namespace DdMd
       Atom*  atom0Ptr;
       Atom*  atom1Ptr;
       int    type0, type1;
+
+      #ifdef PAIR_BLOCK_SIZE
+      // Buffer pairs with rsq < cutoff, evaluate energies in blocks
+      int n = 0;
+      for (pairList_.begin(iter); iter.notEnd(); ++iter) {
+         iter.getPair(atom0Ptr, atom1Ptr);
+         assert(!atom0Ptr->isGhost());
+         type0 = atom0Ptr->typeId();
+         type1 = atom1Ptr->typeId();
+         f.subtract(atom0Ptr->position(), atom1Ptr->position());
+         rsq = f.square();
+         if (rsq < interactionPtr_->cutoffSq(type0, type1)) {
+            block_.rsq[n] = rsq;
+            block_.type0[n] = type0;
+            block_.type1[n] = type1;
+            block_.ptr1[n] = atom1Ptr;
+            ++n;
+            if (n == PAIR_BLOCK_SIZE) {
+               energy += blockEnergy(block_, n);
+               n = 0;
+            }
+         }
+      }
+      if (n) {
+         energy += blockEnergy(block_, n);
+      }
+      #else // ifdef PAIR_BLOCK_SIZE
       if (reverseUpdateFlag()) {
          for (pairList_.begin(iter); iter.notEnd(); ++iter) {
             iter.getPair(atom0Ptr, atom1Ptr);
@@ -478,26 +690,60 @@ namespace DdMd
             }
          }
       }
+      #endif // ifdef PAIR_BLOCK_SIZE
+
       return energy;
    }
 
    /*
-   * Increment atomic forces and/or pair energy (private).
+   * Increment atomic forces, using PairList (private).
+   *
+   * If pairSet is 1 or 2, only pairs in which the second atom is local
+   * or a ghost, respectively, are included.
    */
    template <class Interaction>
-   void PairPotentialImpl<Interaction>::computeForcesList()
+   void PairPotentialImpl<Interaction>::computeForcesList(int pairSet)
    {
+      Vector f;
       double rsq;
       PairIterator iter;
       Atom*  atom0Ptr;
       Atom*  atom1Ptr;
       int    type0, type1;
 
+      #ifdef PAIR_BLOCK_SIZE
+      // Buffer pairs with rsq < cutoff, evaluate forces in blocks
+      int n = 0;
+      for (pairList_.begin(iter); iter.notEnd(); ++iter) {
+         iter.getPair(atom0Ptr, atom1Ptr);
+         if (pairSet && atom1Ptr->isGhost() != (pairSet == 2)) continue;
+         f.subtract(atom0Ptr->position(), atom1Ptr->position());
+         rsq = f.square();
+         type0 = atom0Ptr->typeId();
+         type1 = atom1Ptr->typeId();
+         if (rsq < interactionPtr_->cutoffSq(type0, type1)) {
+            block_.dx[n] = f[0];
+            block_.dy[n] = f[1];
+            block_.dz[n] = f[2];
+            block_.type0[n] = type0;
+            block_.type1[n] = type1;
+            block_.ptr0[n] = atom0Ptr;
+            block_.ptr1[n] = atom1Ptr;
+            ++n;
+            if (n == PAIR_BLOCK_SIZE) {
+               addBlockForces(block_, n);
+               n = 0;
+            }
+         }
+      }
+      if (n) {
+         addBlockForces(block_, n);
+      }
+      #else  // ifdef PAIR_BLOCK_SIZE
       if (reverseUpdateFlag()) {
-
-         Vector f;
          for (pairList_.begin(iter); iter.notEnd(); ++iter) {
             iter.getPair(atom0Ptr, atom1Ptr);
+            if (pairSet && atom1Ptr->isGhost() != (pairSet == 2)) continue;
             f.subtract(atom0Ptr->position(), atom1Ptr->position());
             rsq = f.square();
             type0 = atom0Ptr->typeId();
@@ -508,97 +754,485 @@ namespace DdMd
                atom1Ptr->force() -= f;
             }
          }
+      } else {
+         for (pairList_.begin(iter); iter.notEnd(); ++iter) {
+            iter.getPair(atom0Ptr, atom1Ptr);
+            if (pairSet && atom1Ptr->isGhost() != (pairSet == 2)) continue;
+            f.subtract(atom0Ptr->position(), atom1Ptr->position());
+            rsq = f.square();
+            type0 = atom0Ptr->typeId();
+            type1 = atom1Ptr->typeId();
+            if (rsq < interactionPtr_->cutoffSq(type0, type1)) {
+               f *= interactionPtr_->forceOverR(rsq, type0, type1);
+               atom0Ptr->force() += f;
+               if (!atom1Ptr->isGhost()) {
+                  atom1Ptr->force() -= f;
+               }
+            }
+         }
+      }
+      #endif // ifdef PAIR_BLOCK_SIZE
+   }
+
+   #ifdef PAIR_BLOCK_SIZE
+   /*
+   * Compute and add forces for a block of n buffered pairs (private).
+   *
+   * Calls Interaction::forceBlock, which may use SIMD instructions.
+   */
+   template <class Interaction>
+   void 
+   PairPotentialImpl<Interaction>::addBlockForces(PairBlock& block, int n)
+   const
+   {
+      Vector f;
+      int i;
+
+      // Replace separations by forces
+      interactionPtr_->forceBlock(n, block.type0, block.type1, 
+                                  block.dx, block.dy, block.dz);
 
+      // Increment atomic forces
+      if (reverseUpdateFlag()) {
+         for (i = 0; i < n; ++i) {
+            f[0] = block.dx[i];
+            f[1] = block.dy[i];
+            f[2] = block.dz[i];
+            block.ptr0[i]->force() += f;
+            block.ptr1[i]->force() -= f;
+         }
       } else {
+         for (i = 0; i < n; ++i) {
+            f[0] = block.dx[i];
+            f[1] = block.dy[i];
+            f[2] = block.dz[i];
+            block.ptr0[i]->force() += f;
+            if (!block.ptr1[i]->isGhost()) {
+               block.ptr1[i]->force() -= f;
+            }
+         }
+      }
+   }
 
-         #ifdef PAIR_BLOCK_SIZE
-         PairForce* pairPtr;
-         Vector*    forcePtr;
-         int i, j, m, n;
-
-         pairList_.begin(iter);
-         j = pairList_.nPair();  // j = # of remaining unprocessed pairs
-         while (j) {
-
-            // Determine n = number of pairs in this block
-            n = std::min(PAIR_BLOCK_SIZE, j);
-
-            // Calculate separation for each pair in block
-            for (i = 0; i < n; ++i) {
-               pairPtr = &pairs_[i];
-               iter.getPair(atom0Ptr, atom1Ptr);
-               forcePtr = &(pairPtr->f);
-               forcePtr->subtract(atom0Ptr->position(), atom1Ptr->position());
-               pairPtr->ptr0 = atom0Ptr;
-               pairPtr->ptr1 = atom1Ptr;
-               pairPtr->rsq  = forcePtr->square();
-               ++iter;
+   /*
+   * Return total energy of a block of n buffered pairs (private).
+   */
+   template <class Interaction>
+   double 
+   PairPotentialImpl<Interaction>::blockEnergy(PairBlock& block, int n) const
+   {
+      double energy = 0.0;
+      int i;
+      interactionPtr_->energyBlock(n, block.type0, block.type1, 
+                                   block.rsq, block.energy);
+      if (reverseUpdateFlag()) {
+         for (i = 0; i < n; ++i) {
+            energy += block.energy[i];
+         }
+      } else {
+         for (i = 0; i < n; ++i) {
+            if (!block.ptr1[i]->isGhost()) {
+               energy += block.energy[i];
+            } else {
+               energy += 0.5*block.energy[i];
             }
+         }
+      }
+      return energy;
+   }
 
-            // Identify pairs in this block with rsq < cutoff
-            // Determine m = number of pairs with rsq < cutoff
-            m = 0; 
-            for (i = 0; i < n; ++i) {
-               pairPtr = &pairs_[i];
-               atom0Ptr = pairPtr->ptr0;
-               atom1Ptr = pairPtr->ptr1; 
-               type0 = atom0Ptr->typeId();
-               type1 = atom1Ptr->typeId();
-               inPairs_[m] = pairPtr;
-               if (pairPtr->rsq < interactionPtr_->cutoffSq(type0, type1)) {
-                  ++m;
+   /*
+   * Increment atomic forces using packed PairList and arrays (private).
+   *
+   * Forces are accumulated in the packed force arrays of the storage, 
+   * and then added to the atomic forces. If the packed list is a full
+   * list and threads are enabled, rows are divided among threads, each
+   * of which only modifies packed forces on atoms in its own rows.
+   */
+   template <class Interaction>
+   void PairPotentialImpl<Interaction>::computeForcesPacked()
+   {
+      storage().updatePacked();
+      storage().packed().zeroForces();
+
+      #ifdef UTIL_OPENMP
+      if (threadForcesPtr() && pairList_.isFull()) {
+         #pragma omp parallel num_threads(threadForcesPtr()->nThread())
+         {
+            PairBlock block;
+            int begin, end;
+            pairList_.getPackedPart(omp_get_thread_num(), 
+                                    omp_get_num_threads(), begin, end);
+            addPackedForces(begin, end, block);
+         }
+      } else {
+         addPackedForces(0, pairList_.nPackedAtom(), block_);
+      }
+      #else
+      addPackedForces(0, pairList_.nPackedAtom(), block_);
+      #endif
+
+      storage().addPackedForces(reverseUpdateFlag());
+   }
+
+   /*
+   * Calculate pair energy using packed PairList and arrays (private).
+   */
+   template <class Interaction>
+   double PairPotentialImpl<Interaction>::energyPacked()
+   {
+      double energy = 0.0;
+      storage().updatePacked();
+
+      #ifdef UTIL_OPENMP
+      if (threadForcesPtr()) {
+         #pragma omp parallel num_threads(threadForcesPtr()->nThread()) \
+                              reduction(+:energy)
+         {
+            PairBlock block;
+            int begin, end;
+            pairList_.getPackedPart(omp_get_thread_num(), 
+                                    omp_get_num_threads(), begin, end);
+            energy += packedEnergy(begin, end, block);
+         }
+      } else {
+         energy = packedEnergy(0, pairList_.nPackedAtom(), block_);
+      }
+      #else
+      energy = packedEnergy(0, pairList_.nPackedAtom(), block_);
+      #endif
+
+      return energy;
+   }
+
+   /*
+   * Add packed forces for a range of rows of the packed list (private).
+   */
+   template <class Interaction>
+   void 
+   PairPotentialImpl<Interaction>::addPackedForces(int begin, int end, 
+                                                   PairBlock& block)
+   {
+      const PackedAtomArray& packed = storage().packed();
+      const double* x = packed.position(0);
+      const double* y = packed.position(1);
+      const double* z = packed.position(2);
+      const int* types = packed.typeIds();
+      const int* first = pairList_.packedFirst();
+      const int* neighbors = pairList_.packedNeighbors();
+      double xi, yi, zi, dx, dy, dz, rsq;
+      int i, j, k, ti, tj;
+      int n = 0;
+
+      for (i = begin; i < end; ++i) {
+         xi = x[i];
+         yi = y[i];
+         zi = z[i];
+         ti = types[i];
+         for (k = first[i]; k < first[i+1]; ++k) {
+            j = neighbors[k];
+            dx = xi - x[j];
+            dy = yi - y[j];
+            dz = zi - z[j];
+            rsq = dx*dx + dy*dy + dz*dz;
+            tj = types[j];
+            if (rsq < interactionPtr_->cutoffSq(ti, tj)) {
+               block.dx[n] = dx;
+               block.dy[n] = dy;
+               block.dz[n] = dz;
+               block.type0[n] = ti;
+               block.type1[n] = tj;
+               block.id0[n] = i;
+               block.id1[n] = j;
+               ++n;
+               if (n == PAIR_BLOCK_SIZE) {
+                  addPackedBlockForces(block, n);
+                  n = 0;
                }
             }
-              
-            // Calculate and increment forces for pairs with rsq < cutoff 
-            for (i = 0; i < m; ++i) {
-               pairPtr =  inPairs_[i];
-               atom0Ptr = pairPtr->ptr0;
-               atom1Ptr = pairPtr->ptr1; 
-               forcePtr = &(pairPtr->f);
-               type0 = atom0Ptr->typeId();
-               type1 = atom1Ptr->typeId();
-               rsq   = pairPtr->rsq;
-               *forcePtr *= interactionPtr_->forceOverR(rsq, type0, type1);
-               atom0Ptr->force() += *forcePtr;
-               if (!atom1Ptr->isGhost()) {
-                  atom1Ptr->force() -= *forcePtr;
+         }
+      }
+      if (n) {
+         addPackedBlockForces(block, n);
+      }
+   }
+
+   /*
+   * Return energy of pairs in a range of rows of the packed list (private).
+   */
+   template <class Interaction>
+   double 
+   PairPotentialImpl<Interaction>::packedEnergy(int begin, int end, 
+                                                PairBlock& block)
+   {
+      const PackedAtomArray& packed = storage().packed();
+      const double* x = packed.position(0);
+      const double* y = packed.position(1);
+      const double* z = packed.position(2);
+      const int* types = packed.typeIds();
+      const int* first = pairList_.packedFirst();
+      const int* neighbors = pairList_.packedNeighbors();
+      double energy = 0.0;
+      double xi, yi, zi, dx, dy, dz, rsq;
+      int i, j, k, ti, tj;
+      int n = 0;
+
+      for (i = begin; i < end; ++i) {
+         xi = x[i];
+         yi = y[i];
+         zi = z[i];
+         ti = types[i];
+         for (k = first[i]; k < first[i+1]; ++k) {
+            j = neighbors[k];
+            dx = xi - x[j];
+            dy = yi - y[j];
+            dz = zi - z[j];
+            rsq = dx*dx + dy*dy + dz*dz;
+            tj = types[j];
+            if (rsq < interactionPtr_->cutoffSq(ti, tj)) {
+               block.rsq[n] = rsq;
+               block.type0[n] = ti;
+               block.type1[n] = tj;
+               block.id1[n] = j;
+               ++n;
+               if (n == PAIR_BLOCK_SIZE) {
+                  energy += packedBlockEnergy(block, n);
+                  n = 0;
                }
             }
+         }
+      }
+      if (n) {
+         energy += packedBlockEnergy(block, n);
+      }
+      return energy;
+   }
 
-            // Decrement number of remaining unprocess pairs
-            j = j - n; 
+   /*
+   * Compute and add packed forces for a block of n pairs (private).
+   *
+   * For a full list, only the force on the atom of each row (id0) is
+   * modified. For a half list, forces on ghosts (id1 >= nLocal) are 
+   * modified only if reverseUpdateFlag is true.
+   */
+   template <class Interaction>
+   void 
+   PairPotentialImpl<Interaction>::addPackedBlockForces(PairBlock& block, 
+                                                        int n)
+   {
+      PackedAtomArray& packed = storage().packed();
+      double* fx = packed.force(0);
+      double* fy = packed.force(1);
+      double* fz = packed.force(2);
+      int i, id;
+
+      // Replace separations by forces
+      interactionPtr_->forceBlock(n, block.type0, block.type1, 
+                                  block.dx, block.dy, block.dz);
+
+      // Increment packed forces
+      for (i = 0; i < n; ++i) {
+         id = block.id0[i];
+         fx[id] += block.dx[i];
+         fy[id] += block.dy[i];
+         fz[id] += block.dz[i];
+      }
+      if (!pairList_.isFull()) {
+         const int nLocal = packed.nLocal();
+         const bool reverse = reverseUpdateFlag();
+         for (i = 0; i < n; ++i) {
+            id = block.id1[i];
+            if (reverse || id < nLocal) {
+               fx[id] -= block.dx[i];
+               fy[id] -= block.dy[i];
+               fz[id] -= block.dz[i];
+            }
          }
+      }
+   }
 
-         #ifdef UTIL_DEBUG
-         if (j != 0) {
-            UTIL_THROW("Error in counting");
+   /*
+   * Return total energy of a block of n packed pairs (private).
+   *
+   * Each pair in a full list is counted with weight 1/2: Pairs of local 
+   * atoms appear twice, and pairs involving a ghost appear once on each
+   * of two processors.
+   */
+   template <class Interaction>
+   double 
+   PairPotentialImpl<Interaction>::packedBlockEnergy(PairBlock& block, int n)
+   {
+      double energy = 0.0;
+      int i;
+      interactionPtr_->energyBlock(n, block.type0, block.type1, 
+                                   block.rsq, block.energy);
+      if (pairList_.isFull()) {
+         for (i = 0; i < n; ++i) {
+            energy += block.energy[i];
          }
-         if (iter.notEnd()) {
-            UTIL_THROW("Error in iterator");
+         energy *= 0.5;
+      } else
+      if (reverseUpdateFlag()) {
+         for (i = 0; i < n; ++i) {
+            energy += block.energy[i];
          }
-         #endif // ifdef UTIL_DEBUG
+      } else {
+         const int nLocal = storage().packed().nLocal();
+         for (i = 0; i < n; ++i) {
+            if (block.id1[i] < nLocal) {
+               energy += block.energy[i];
+            } else {
+               energy += 0.5*block.energy[i];
+            }
+         }
+      }
+      return energy;
+   }
+
+   #ifdef UTIL_OPENMP
+   /*
+   * Compute and add forces for a block of pairs within a thread (private).
+   *
+   * Forces on primary atoms (ptr0) are added directly, because each
+   * primary atom appears in the part of the PairList of only one thread.
+   * Forces on secondary atoms (ptr1) are added to the thread buffer.
+   */
+   template <class Interaction>
+   void 
+   PairPotentialImpl<Interaction>::addBlockForces(PairBlock& block, int n,
+                                                  ThreadForces& forces, 
+                                                  int threadId) const
+   {
+      Vector f;
+      int i;
 
-         #else  // ifdef PAIR_BLOCK_SIZE
+      // Replace separations by forces
+      interactionPtr_->forceBlock(n, block.type0, block.type1, 
+                                  block.dx, block.dy, block.dz);
+
+      // Increment atomic forces
+      if (reverseUpdateFlag()) {
+         for (i = 0; i < n; ++i) {
+            f[0] = block.dx[i];
+            f[1] = block.dy[i];
+            f[2] = block.dz[i];
+            block.ptr0[i]->force() += f;
+            forces.subtract(threadId, *block.ptr1[i], f);
+         }
+      } else {
+         for (i = 0; i < n; ++i) {
+            f[0] = block.dx[i];
+            f[1] = block.dy[i];
+            f[2] = block.dz[i];
+            block.ptr0[i]->force() += f;
+            if (!block.ptr1[i]->isGhost()) {
+               forces.subtract(threadId, *block.ptr1[i], f);
+            }
+         }
+      }
+   }
+
+   /*
+   * Increment atomic forces using PairList and threads (private).
+   *
+   * Each thread processes one part of the PairList (see PairList::begin),
+   * in blocks. Buffered forces on secondary atoms are then summed.
+   */
+   template <class Interaction>
+   void PairPotentialImpl<Interaction>::computeForcesListThreads()
+   {
+      ThreadForces& forces = *threadForcesPtr();
+
+      #pragma omp parallel num_threads(forces.nThread())
+      {
+         PairBlock block;
          Vector f;
-         for (pairList_.begin(iter); iter.notEnd(); ++iter) {
+         double rsq;
+         PairIterator iter;
+         Atom*  atom0Ptr;
+         Atom*  atom1Ptr;
+         int    type0, type1;
+         int    threadId = omp_get_thread_num();
+         int    n = 0;
+
+         pairList_.begin(iter, threadId, omp_get_num_threads());
+         for ( ; iter.notEnd(); ++iter) {
             iter.getPair(atom0Ptr, atom1Ptr);
             f.subtract(atom0Ptr->position(), atom1Ptr->position());
             rsq = f.square();
             type0 = atom0Ptr->typeId();
             type1 = atom1Ptr->typeId();
             if (rsq < interactionPtr_->cutoffSq(type0, type1)) {
-               f *= interactionPtr_->forceOverR(rsq, type0, type1);
-               atom0Ptr->force() += f;
-               if (!atom1Ptr->isGhost()) {
-                  atom1Ptr->force() -= f;
+               block.dx[n] = f[0];
+               block.dy[n] = f[1];
+               block.dz[n] = f[2];
+               block.type0[n] = type0;
+               block.type1[n] = type1;
+               block.ptr0[n] = atom0Ptr;
+               block.ptr1[n] = atom1Ptr;
+               ++n;
+               if (n == PAIR_BLOCK_SIZE) {
+                  addBlockForces(block, n, forces, threadId);
+                  n = 0;
                }
             }
          }
-         #endif // ifdef PAIR_BLOCK_SIZE
+         if (n) {
+            addBlockForces(block, n, forces, threadId);
+         }
+      }
 
+      forces.reduce(reverseUpdateFlag());
+   }
+
+   /*
+   * Calculate pair energy using PairList and threads (private).
+   */
+   template <class Interaction>
+   double PairPotentialImpl<Interaction>::energyListThreads()
+   {
+      double energy = 0.0;
+
+      #pragma omp parallel num_threads(threadForcesPtr()->nThread()) \
+                           reduction(+:energy)
+      {
+         PairBlock block;
+         Vector f;
+         double rsq;
+         PairIterator iter;
+         Atom*  atom0Ptr;
+         Atom*  atom1Ptr;
+         int    type0, type1;
+         int    n = 0;
+
+         pairList_.begin(iter, omp_get_thread_num(), omp_get_num_threads());
+         for ( ; iter.notEnd(); ++iter) {
+            iter.getPair(atom0Ptr, atom1Ptr);
+            type0 = atom0Ptr->typeId();
+            type1 = atom1Ptr->typeId();
+            f.subtract(atom0Ptr->position(), atom1Ptr->position());
+            rsq = f.square();
+            if (rsq < interactionPtr_->cutoffSq(type0, type1)) {
+               block.rsq[n] = rsq;
+               block.type0[n] = type0;
+               block.type1[n] = type1;
+               block.ptr1[n] = atom1Ptr;
+               ++n;
+               if (n == PAIR_BLOCK_SIZE) {
+                  energy += blockEnergy(block, n);
+                  n = 0;
+               }
+            }
+         }
+         if (n) {
+            energy += blockEnergy(block, n);
+         }
       }
+
+      return energy;
    }
+   #endif // ifdef UTIL_OPENMP
+   #endif // ifdef PAIR_BLOCK_SIZE
 
    /*
    * Increment atomic forces and/or pair energy (private).
@@ -1027,6 +1661,71 @@ namespace DdMd
       reduceStress(localStress, communicator);
    }
 
+   /*
+   * Compute pair forces and local energy and/or stress, in one loop.
+   */
+   template <class Interaction>
+   void 
+   PairPotentialImpl<Interaction>::computeForcesAndObservables(double* localEnergyPtr,
+                                                               Tensor* localStressPtr)
+   {
+      Tensor localStress;
+      Vector dr;
+      Vector f;
+      double rsq, weight;
+      double localEnergy = 0.0;
+      PairIterator iter;
+      Atom*  atom0Ptr;
+      Atom*  atom1Ptr;
+      int    type0, type1;
+      bool   reverseFlag = reverseUpdateFlag();
+
+      // Use the usual (possibly faster) kernel if nothing is requested
+      if (!localEnergyPtr && !localStressPtr) {
+         computeForces();
+         return;
+      }
+
+      localStress.zero();
+      for (pairList_.begin(iter); iter.notEnd(); ++iter) {
+         iter.getPair(atom0Ptr, atom1Ptr);
+         dr.subtract(atom0Ptr->position(), atom1Ptr->position());
+         rsq = dr.square();
+         type0 = atom0Ptr->typeId();
+         type1 = atom1Ptr->typeId();
+         if (rsq < interactionPtr_->cutoffSq(type0, type1)) {
+            f  = dr;
+            f *= interactionPtr_->forceOverR(rsq, type0, type1);
+            assert(!atom0Ptr->isGhost());
+            atom0Ptr->force() += f;
+            // Without reverse communication, a pair with a ghost is
+            // also in the pair list of the processor that owns the 
+            // ghost, so each processor adds half the energy and stress.
+            if (reverseFlag || !atom1Ptr->isGhost()) {
+               atom1Ptr->force() -= f;
+               weight = 1.0;
+            } else {
+               weight = 0.5;
+            }
+            if (localEnergyPtr) {
+               localEnergy += weight*interactionPtr_->energy(rsq, type0, type1);
+            }
+            if (localStressPtr) {
+               f *= weight;
+               incrementPairStress(f, dr, localStress);
+            }
+         }
+      }
+
+      if (localEnergyPtr) {
+         *localEnergyPtr += localEnergy;
+      }
+      if (localStressPtr) {
+         localStress /= boundary().volume();
+         *localStressPtr += localStress;
+      }
+   }
+
    /*
    * Compute total pair energies (Call on all processors).
    */
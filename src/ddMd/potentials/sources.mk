@@ -2,6 +2,7 @@ include $(SRC_DIR)/ddMd/potentials/pair/sources.mk
 
 ddMd_potentials_= \
    ddMd/potentials/Potential.cpp \
+   ddMd/potentials/ThreadForces.cpp \
    $(ddMd_potentials_pair_) 
 
 ifdef INTER_BOND
@@ -169,6 +169,11 @@ namespace DdMd
       #endif
       maskedPairPolicy_(MaskBonded),
       reverseUpdateFlag_(false),
+      nThread_(1),
+      overlapUpdateFlag_(false),
+      #ifdef UTIL_OPENMP
+      threadForces_(),
+      #endif
       #ifdef UTIL_MPI
       communicator_(communicator),
       #endif
@@ -537,6 +542,7 @@ namespace DdMd
       }
       #endif
 
+      initializeThreads();
       readEnsembles(in);
 
       // Integrator
@@ -730,6 +736,7 @@ namespace DdMd
       }
       #endif
 
+      initializeThreads();
       loadEnsembles(ar);
 
       // Integrator
@@ -1018,6 +1025,14 @@ namespace DdMd
       // Reverse communication (true) or not (false)?
       read<bool>(in, "reverseUpdateFlag", reverseUpdateFlag_);
 
+      // Number of threads per processor for force calculations
+      nThread_ = 1;
+      read<int>(in, "nThread", nThread_, false); // optional
+
+      // Overlap ghost updates with pair forces (true) or not? (optional)
+      overlapUpdateFlag_ = false;
+      read<bool>(in, "overlapUpdateFlag", overlapUpdateFlag_, false);
+
    }
 
    /*
@@ -1050,6 +1065,11 @@ namespace DdMd
       #endif
       loadParameter<MaskPolicy>(ar, "maskedPairPolicy", maskedPairPolicy_);
       loadParameter<bool>(ar, "reverseUpdateFlag", reverseUpdateFlag_);
+      nThread_ = 1;
+      loadParameter<int>(ar, "nThread", nThread_, false); // optional
+      overlapUpdateFlag_ = false;
+      loadParameter<bool>(ar, "overlapUpdateFlag", overlapUpdateFlag_, 
+                          false); // optional
 
       isInitialized_ = true;
    }
@@ -1084,6 +1104,45 @@ namespace DdMd
       #endif
       ar << maskedPairPolicy_;
       ar << reverseUpdateFlag_;
+      Parameter::saveOptional(ar, nThread_, nThread_ != 1);
+      Parameter::saveOptional(ar, overlapUpdateFlag_, overlapUpdateFlag_);
+   }
+
+   /*
+   * Check nThread, and allocate per-thread force buffers if nThread > 1.
+   */
+   void Simulation::initializeThreads()
+   {
+      if (nThread_ < 1) {
+         UTIL_THROW("nThread < 1");
+      }
+      #ifdef UTIL_OPENMP
+      if (nThread_ > 1) {
+         threadForces_.allocate(atomStorage_, nThread_);
+         #ifndef DDMD_NOPAIR
+         pairPotentialPtr_->setThreadForces(&threadForces_);
+         #endif
+         #ifdef INTER_BOND
+         if (nBondType_) {
+            bondPotentialPtr_->setThreadForces(&threadForces_);
+         }
+         #endif
+         #ifdef INTER_ANGLE
+         if (nAngleType_) {
+            anglePotentialPtr_->setThreadForces(&threadForces_);
+         }
+         #endif
+         #ifdef INTER_DIHEDRAL
+         if (nDihedralType_) {
+            dihedralPotentialPtr_->setThreadForces(&threadForces_);
+         }
+         #endif
+      }
+      #else
+      if (nThread_ > 1) {
+         UTIL_THROW("nThread > 1 requires compilation with UTIL_OPENMP");
+      }
+      #endif
    }
 
    /*
@@ -1920,19 +1979,12 @@ namespace DdMd
    // --- Config File Read and Write -----------------------------------
 
    /*
-   * Read configuration file on master and distribute atoms.
+   * Read configuration file and distribute atoms.
    */
    void Simulation::readConfig(const std::string& filename)
    {
-      std::ifstream inputFile;
-      if (domain_.isMaster()) {
-         fileMaster().openInputFile(filename, inputFile);
-      }
-      configIo().readConfig(inputFile, maskedPairPolicy_);
+      configIo().readConfigFile(fileMaster(), filename, maskedPairPolicy_);
       exchanger_.exchange();
-      if (domain_.isMaster()) {
-         inputFile.close();
-      }
    }
 
    /*
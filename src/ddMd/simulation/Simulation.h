@@ -16,6 +16,9 @@
 #include <ddMd/storage/BondStorage.h>            // member 
 #include <ddMd/storage/AngleStorage.h>           // member 
 #include <ddMd/storage/DihedralStorage.h>        // member 
+#ifdef UTIL_OPENMP
+#include <ddMd/potentials/ThreadForces.h>        // member 
+#endif
 #include <ddMd/chemistry/AtomType.h>             // member (template param)
 #include <ddMd/chemistry/MaskPolicy.h>           // member
 #include <util/random/Random.h>                  // member 
@@ -244,7 +247,10 @@ namespace DdMd
       //@{
 
       /**
-      * Read configuration file on master and distribute atoms.
+      * Read configuration file and distribute atoms.
+      *
+      * The file is read by the current ConfigIo, using its readConfigFile()
+      * method. Most ConfigIo classes read only on the master processor.
       *
       * Upon return, all processors should have all atoms and
       * groups, and a full set of ghost atoms, but values for
@@ -284,6 +290,16 @@ namespace DdMd
       //@}
       /// \name Force, energy and stress calculators
       //@{
+
+      /**
+      * Bit flags for observables that can be computed with the forces.
+      *
+      * An Analyzer registers the observables that it needs by calling
+      * Analyzer::addObservables() with a bitwise OR of these values. 
+      * Integrator::computeForcesAndObservables() then computes all 
+      * observables requested for a step in the force calculation.
+      */
+      enum ObservableFlag {POTENTIAL_ENERGIES = 1, VIRIAL_STRESS = 2};
       
       /**
       * Compute forces for all local atoms.
@@ -695,6 +711,16 @@ namespace DdMd
       */
       bool reverseUpdateFlag() const;
 
+      /**
+      * Return number of threads used to compute forces on each processor.
+      */
+      int nThread() const;
+
+      /**
+      * Is overlap of ghost updates with pair force calculation enabled?
+      */
+      bool overlapUpdateFlag() const;
+
       //@}
       /// \name Signals
       //@{ 
@@ -770,6 +796,13 @@ namespace DdMd
       */
       void savePotentialStyles(Serializable::OArchive& ar);
 
+      /**
+      * Check nThread, and enable threaded force loops if nThread > 1.
+      *
+      * Call after all potentials have been read or loaded.
+      */
+      void initializeThreads();
+
       /**
       * Read energy and boundary ensembles.
       *
@@ -979,6 +1012,17 @@ namespace DdMd
       /// Is reverse communication enabled?
       bool reverseUpdateFlag_;
 
+      /// Number of threads used for force calculations on each processor.
+      int nThread_;
+
+      /// Is overlap of ghost updates with pair force calculation enabled?
+      bool overlapUpdateFlag_;
+
+      #ifdef UTIL_OPENMP
+      /// Per-thread force buffers (allocated only if nThread_ > 1).
+      ThreadForces threadForces_;
+      #endif
+
       #ifdef UTIL_MPI
       /// Communicator for this system.
       MPI::Intracomm communicator_;
@@ -1202,6 +1246,12 @@ namespace DdMd
    inline bool Simulation::reverseUpdateFlag() const
    {  return reverseUpdateFlag_; }
 
+   inline int Simulation::nThread() const
+   {  return nThread_; }
+
+   inline bool Simulation::overlapUpdateFlag() const
+   {  return overlapUpdateFlag_; }
+
    /// Signal to force unsetting of all computed quantities.
    inline Signal<>& Simulation::modifySignal()
    {  return modifySignal_; }
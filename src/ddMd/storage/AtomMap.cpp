@@ -115,6 +115,22 @@ namespace DdMd
       }
    }
 
+   /*
+   * Reset the pointer to a local atom that has been moved.
+   */
+   void AtomMap::updateLocal(Atom* ptr)
+   {
+      int atomId = ptr->id();
+      if (atomId < 0 || atomId >= totalAtomCapacity_) {
+         Log::file() << "atomId = " << atomId << std::endl;
+         UTIL_THROW("atomId is out of range");
+      }
+      if (0 == atomPtrs_[atomId]) {
+         UTIL_THROW("Error: Attempt to update absent local atom");
+      }
+      atomPtrs_[atomId] = ptr;
+   }
+
    // Ghost atom mutators
 
    /*
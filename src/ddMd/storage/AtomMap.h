@@ -73,6 +73,15 @@ namespace DdMd
       */
       void removeLocal(Atom* ptr); 
 
+      /**
+      * Reset the pointer to a local atom that has moved in memory.
+      *
+      * \throw Exception if no local atom with the same id is present.
+      *
+      * \param ptr New address of a local Atom.
+      */
+      void updateLocal(Atom* ptr); 
+
       /**
       * Add ghost atom.
       * 
@@ -18,6 +18,8 @@
 #include <util/mpi/MpiLoader.h>
 #include <util/global.h>
 
+#include <algorithm>
+
 namespace DdMd
 {
 
@@ -34,11 +36,20 @@ namespace DdMd
       ghostSet_(),
       ghostReservoir_(),
       map_(),
+      snapshot_(),
+      packed_(),
+      atomPackedIds_(),
+      ghostPackedIds_(),
+      sortKeys_(),
+      sortSources_(),
+      sortTemp_(),
       newAtomPtr_(0),
       newGhostPtr_(0),
       atomCapacity_(0),
       ghostCapacity_(0),
       totalAtomCapacity_(0),
+      sortInterval_(0),
+      sortCounter_(0),
       maxNAtomLocal_(0),
       maxNGhostLocal_(0),
       #ifdef UTIL_MPI
@@ -48,6 +59,7 @@ namespace DdMd
       #endif
       locked_(false),
       isInitialized_(false),
+      isPacked_(false),
       isCartesian_(false)
    {  setClassName("AtomStorage"); }
  
@@ -87,6 +99,11 @@ namespace DdMd
       read<int>(in, "atomCapacity", atomCapacity_);
       read<int>(in, "ghostCapacity", ghostCapacity_);
       read<int>(in, "totalAtomCapacity", totalAtomCapacity_);
+      sortInterval_ = 0; // default value
+      read<int>(in, "sortInterval", sortInterval_, false); // optional
+      if (sortInterval_ < 0) {
+         UTIL_THROW("Negative sortInterval");
+      }
       allocate();
    }
 
@@ -98,9 +115,13 @@ namespace DdMd
       loadParameter<int>(ar, "atomCapacity", atomCapacity_);
       loadParameter<int>(ar, "ghostCapacity", ghostCapacity_);
       loadParameter<int>(ar, "totalAtomCapacity", totalAtomCapacity_);
+      loadParameter<int>(ar, "sortInterval", sortInterval_, false);
       MpiLoader<Serializable::IArchive> loader(*this, ar);
       loader.load(maxNAtomLocal_);
       loader.load(maxNGhostLocal_);
+      if (sortInterval_ > 0) {
+         loader.load(sortCounter_);
+      }
       allocate();
    }
 
@@ -112,8 +133,12 @@ namespace DdMd
       ar << atomCapacity_;
       ar << ghostCapacity_;
       ar << totalAtomCapacity_;
+      Parameter::saveOptional(ar, sortInterval_, sortInterval_ > 0);
       ar << maxNAtomLocal_;
       ar << maxNGhostLocal_;
+      if (sortInterval_ > 0) {
+         ar << sortCounter_;
+      }
    }
 
    /*
@@ -216,6 +241,7 @@ namespace DdMd
          UTIL_THROW("AtomStorage is locked");
 
       // Add to containers.
+      isPacked_ = false;
       map_.addLocal(newAtomPtr_);
       atomSet_.append(*newAtomPtr_);
       newAtomPtr_->setIsGhost(false);
@@ -242,6 +268,7 @@ namespace DdMd
    */
    void AtomStorage::removeAtom(Atom* atomPtr)
    {
+      isPacked_ = false;
       map_.removeLocal(atomPtr);
       atomSet_.remove(*atomPtr);
       atomReservoir_.push(*atomPtr);
@@ -257,6 +284,7 @@ namespace DdMd
          UTIL_THROW("AtomStorage is locked");
       }
 
+      isPacked_ = false;
       Atom* atomPtr;
       while (atomSet_.size() > 0) {
          atomPtr = &atomSet_.pop();
@@ -307,6 +335,7 @@ namespace DdMd
       }
 
       // Add to containers
+      isPacked_ = false;
       map_.addGhost(newGhostPtr_);
       ghostSet_.append(*newGhostPtr_);
       newGhostPtr_->setIsGhost(true);
@@ -336,6 +365,7 @@ namespace DdMd
       // Precondition
       if (locked_) UTIL_THROW("AtomStorage is locked");
 
+      isPacked_ = false;
       map_.removeGhost(atomPtr);
       ghostSet_.remove(*atomPtr);
       ghostReservoir_.push(*atomPtr);
@@ -351,6 +381,7 @@ namespace DdMd
          UTIL_THROW("AtomStorage is locked");
 
       // Clear ghosts from the map
+      isPacked_ = false;
       map_.clearGhosts(ghostSet_);
 
       // Transfer ghosts from the set to the reservoir
@@ -371,6 +402,140 @@ namespace DdMd
       }
    }
 
+   // Spatial sorting
+
+   namespace {
+
+      /*
+      * Spread the lowest 10 bits of i, so that bit k moves to bit 3k.
+      */
+      inline unsigned int spreadBits(unsigned int i)
+      {
+         i &= 0x000003ff;
+         i = (i | (i << 16)) & 0xff0000ff;
+         i = (i | (i <<  8)) & 0x0300f00f;
+         i = (i | (i <<  4)) & 0x030c30c3;
+         i = (i | (i <<  2)) & 0x09249249;
+         return i;
+      }
+
+      /*
+      * Return 30-bit Morton index of a position in generalized coordinates.
+      */
+      inline unsigned int mortonKey(const Vector& r)
+      {
+         unsigned int key = 0;
+         int j;
+         for (int i = 0; i < Dimension; ++i) {
+            j = int(r[i]*1024.0);
+            if (j < 0) j = 0;
+            if (j > 1023) j = 1023;
+            key |= spreadBits((unsigned int)j) << i;
+         }
+         return key;
+      }
+
+   }
+
+   /*
+   * Sort local atoms into Morton order, in a contiguous block of atoms_.
+   */
+   void AtomStorage::sortAtoms()
+   {
+      // Preconditions
+      if (locked_) {
+         UTIL_THROW("AtomStorage is locked");
+      }
+      if (isCartesian()) {
+         UTIL_THROW("Coordinates are Cartesian entering sortAtoms");
+      }
+
+      if (!sortKeys_.isAllocated()) {
+         sortKeys_.allocate(atomCapacity_);
+         sortSources_.allocate(atomCapacity_);
+         sortTemp_.allocate(1);
+      }
+
+      // Sort array indices of local atoms by Morton index
+      const int nLocal = nAtom();
+      AtomIterator iter;
+      int i, j, k;
+      i = 0;
+      for (begin(iter); iter.notEnd(); ++iter) {
+         sortKeys_[i].first = mortonKey(iter->position());
+         sortKeys_[i].second = int(iter.get() - &atoms_[0]);
+         ++i;
+      }
+      assert(i == nLocal);
+      if (nLocal) {
+         std::sort(&sortKeys_[0], &sortKeys_[0] + nLocal);
+      }
+
+      // Choose source index for each element of atoms_: Sorted atoms are
+      // moved to elements 0, ..., nLocal - 1, and unused elements fill 
+      // the rest, so that sortSources_ is a permutation.
+      for (i = 0; i < nLocal; ++i) {
+         sortSources_[i] = sortKeys_[i].second;
+      }
+      k = nLocal;
+      for (i = 0; i < atomCapacity_; ++i) {
+         if (atomSet_.index(atoms_[i]) < 0) {
+            sortSources_[k] = i;
+            ++k;
+         }
+      }
+      assert(k == atomCapacity_);
+
+      // Apply the permutation, following each cycle from its first element.
+      // Completed elements are marked by setting sortSources_[i] = -1.
+      Atom& temp = sortTemp_[0];
+      for (i = 0; i < atomCapacity_; ++i) {
+         if (sortSources_[i] < 0) continue;
+         if (sortSources_[i] == i) {
+            sortSources_[i] = -1;
+            continue;
+         }
+         temp = atoms_[i];
+         j = i;
+         while (sortSources_[j] != i) {
+            k = sortSources_[j];
+            atoms_[j] = atoms_[k];
+            sortSources_[j] = -1;
+            j = k;
+         }
+         atoms_[j] = temp;
+         sortSources_[j] = -1;
+      }
+
+      // Reset set of local atoms, reservoir and map
+      atomSet_.clear();
+      for (i = 0; i < nLocal; ++i) {
+         atomSet_.append(atoms_[i]);
+         map_.updateLocal(&atoms_[i]);
+      }
+      while (atomReservoir_.size() > 0) {
+         atomReservoir_.pop();
+      }
+      for (i = atomCapacity_ - 1; i >= nLocal; --i) {
+         atomReservoir_.push(atoms_[i]);
+      }
+
+      isPacked_ = false;
+   }
+
+   /*
+   * Increment counter, return true if a sort is due.
+   */
+   bool AtomStorage::updateSortCounter()
+   {
+      if (sortInterval_ == 0) {
+         return false;
+      }
+      bool isDue = (sortCounter_ % sortInterval_ == 0);
+      ++sortCounter_;
+      return isDue;
+   }
+
    // Snapshot functions
 
    /*
@@ -427,6 +592,60 @@ namespace DdMd
       return max;
    }
 
+   // Packed arrays
+
+   /*
+   * Build packed arrays for all local atoms, followed by all ghosts.
+   */
+   void AtomStorage::pack()
+   {
+      if (!packed_.isAllocated()) {
+         packed_.allocate(atomCapacity_ + ghostCapacity_);
+         atomPackedIds_.allocate(atomCapacity_);
+         ghostPackedIds_.allocate(ghostCapacity_);
+      }
+      packed_.clear();
+
+      int id;
+      if (nAtom()) {
+         AtomIterator atomIter;
+         for (begin(atomIter); atomIter.notEnd(); ++atomIter) {
+            id = packed_.append(*atomIter);
+            atomPackedIds_[int(atomIter.get() - &atoms_[0])] = id;
+         }
+      }
+      if (nGhost()) {
+         GhostIterator ghostIter;
+         for (begin(ghostIter); ghostIter.notEnd(); ++ghostIter) {
+            id = packed_.append(*ghostIter);
+            ghostPackedIds_[int(ghostIter.get() - &ghosts_[0])] = id;
+         }
+      }
+      isPacked_ = true;
+   }
+
+   /*
+   * Copy current atomic positions into the packed arrays.
+   */
+   void AtomStorage::updatePacked()
+   {
+      if (!isPacked_) {
+         UTIL_THROW("Packed arrays are not valid");
+      }
+      packed_.update();
+   }
+
+   /*
+   * Add packed forces to atomic forces.
+   */
+   void AtomStorage::addPackedForces(bool addGhosts)
+   {
+      if (!isPacked_) {
+         UTIL_THROW("Packed arrays are not valid");
+      }
+      packed_.addForces(addGhosts);
+   }
+
    // Accessors
 
    /*
@@ -607,6 +826,16 @@ namespace DdMd
       // Test validity of AtomMap.
       map_.isValid();
 
+      // Test consistency of packed arrays, if any.
+      if (isPacked_) {
+         if (packed_.size() != nAtom() + nGhost()) {
+            UTIL_THROW("Packed size != nAtom + nGhost");
+         }
+         if (packed_.nLocal() != nAtom()) {
+            UTIL_THROW("Packed nLocal != nAtom");
+         }
+      }
+
       // Iterate over, count and find local atoms on this processor.
       ConstAtomIterator localIter;
       Atom* ptr;
@@ -11,6 +11,7 @@
 #include <util/param/ParamComposite.h>        // base class
 #include <ddMd/chemistry/AtomArray.h>         // member
 #include <ddMd/storage/AtomMap.h>             // member
+#include <ddMd/storage/PackedAtomArray.h>     // member
 #include <ddMd/communicate/AtomDistributor.h> // member
 #include <ddMd/communicate/AtomCollector.h>   // member
 #include <ddMd/chemistry/Atom.h>              // member template argument
@@ -22,6 +23,8 @@
 #include <util/boundary/Boundary.h>           // typedef
 #include <util/global.h>
 
+#include <utility>
+
 class AtomStorageTest;
 
 namespace DdMd
@@ -84,6 +87,7 @@ namespace DdMd
       *  - atomCapacity      [int]  max number of atoms owned by processor.
       *  - ghostCapacity     [int]  max number of ghosts on this processor.
       *  - totalatomCapacity [int]  max number of atoms on all processors.
+      *  - sortInterval      [int]  exchanges per spatial sort (optional).
       *
       * \param in input parameter stream.
       */
@@ -323,6 +327,98 @@ namespace DdMd
       */
       double maxSqDisplacement();
 
+      //@}
+      /// \name Packed Arrays
+      //@{
+
+      /**
+      * Build packed arrays of positions and types for all atoms.
+      *
+      * Copies positions and type ids of all local atoms, followed by all
+      * ghost atoms, into the internal PackedAtomArray and records the 
+      * packed index of each atom. Memory for the packed arrays is 
+      * allocated on the first call. The packed ordering remains valid
+      * (isPacked() remains true) until a local or ghost atom is added 
+      * or removed. 
+      */
+      void pack();
+
+      /**
+      * Copy current positions of all atoms into existing packed arrays.
+      *
+      * \pre isPacked() must be true.
+      */
+      void updatePacked();
+
+      /**
+      * Add packed forces to forces of local and (optionally) ghost atoms.
+      *
+      * \pre isPacked() must be true.
+      *
+      * \param addGhosts if true, also add packed forces to ghost atoms.
+      */
+      void addPackedForces(bool addGhosts);
+
+      /**
+      * Is the packed ordering valid for the current atom and ghost sets?
+      */
+      bool isPacked() const;
+
+      /**
+      * Return the packed index of a local or ghost atom.
+      *
+      * \pre isPacked() must be true.
+      *
+      * \param atom local or ghost atom owned by this storage.
+      */
+      int packedId(const Atom& atom) const;
+
+      /**
+      * Return PackedAtomArray by reference.
+      */
+      PackedAtomArray& packed();
+
+      /**
+      * Return PackedAtomArray by const reference.
+      */
+      const PackedAtomArray& packed() const;
+
+      //@}
+      /// \name Spatial Sorting
+      //@{
+
+      /**
+      * Sort local atoms into spatial order.
+      *
+      * Moves the data for all local atoms within the internal array of
+      * local Atom objects, so that local atoms occupy a contiguous block
+      * at the beginning of this array, in order of increasing Morton 
+      * (Z-order curve) index of their generalized coordinates. The order
+      * of iteration over local atoms is reset to the same order, and the 
+      * atom map is updated. Ghost atoms are not affected.
+      *
+      * Pointers to local atoms held by other objects, such as Group 
+      * objects in a GroupStorage, are invalid after this function, and
+      * must be reset by the caller (see GroupExchanger::findLocals).
+      *
+      * \pre Coordinates must be generalized, and storage must be unlocked.
+      */
+      void sortAtoms();
+
+      /**
+      * Increment a call counter, and return true if a sort is due.
+      *
+      * Returns true on the first call and every sortInterval() calls 
+      * thereafter if sortInterval() > 0, and always returns false if
+      * sortInterval() == 0. Intended to be called once per exchange.
+      */
+      bool updateSortCounter();
+
+      /**
+      * Return number of exchanges per sort (0 if sorting is disabled).
+      */
+      int sortInterval() const;
+
       //@}
       /// \name Iterator interface
       //@{
@@ -355,6 +451,36 @@ namespace DdMd
       */
       void begin(ConstGhostIterator& iterator) const;
 
+      /**
+      * Return local atom number i, for 0 <= i < nAtom().
+      *
+      * Local atoms are indexed in the order visited by an AtomIterator.
+      * This order changes whenever an atom is added or removed. This
+      * function is intended for loops that are divided among threads.
+      *
+      * \param i index within the set of local atoms
+      */
+      Atom& localAtom(int i);
+
+      /**
+      * Return ghost atom number i, for 0 <= i < nGhost().
+      *
+      * \param i index within the set of ghost atoms
+      */
+      Atom& ghostAtom(int i);
+
+      /**
+      * Return index of a local or ghost atom in the underlying arrays.
+      *
+      * Local atoms have indices 0 <= i < atomCapacity(), and ghosts have
+      * indices atomCapacity() <= i < atomCapacity() + ghostCapacity().
+      * The index of an atom does not change while it remains in this
+      * storage, and may thus be used to index per-thread work arrays.
+      *
+      * \param atom local or ghost atom owned by this storage.
+      */
+      int arrayId(const Atom& atom) const;
+
       //@}
       /// \name Accessors 
       //@{
@@ -523,6 +649,24 @@ namespace DdMd
       // Array of stored old positions.
       DArray<Vector>  snapshot_;
 
+      // Packed structure-of-arrays copy of atom and ghost data.
+      PackedAtomArray packed_;
+
+      // Packed indices of local atoms, indexed by position in atoms_.
+      DArray<int>  atomPackedIds_;
+
+      // Packed indices of ghost atoms, indexed by position in ghosts_.
+      DArray<int>  ghostPackedIds_;
+
+      // Sort keys and array indices of local atoms, used by sortAtoms.
+      DArray< std::pair<unsigned int, int> >  sortKeys_;
+
+      // Source array index for each element of atoms_, used by sortAtoms.
+      DArray<int>  sortSources_;
+
+      // Temporary Atom used by sortAtoms.
+      AtomArray  sortTemp_;
+
       // Pointer to space for a new local Atom
       Atom*  newAtomPtr_;
 
@@ -538,6 +682,12 @@ namespace DdMd
       // Maximum number of atoms on all processors, maximum id + 1
       int  totalAtomCapacity_;
 
+      // Number of exchanges per spatial sort of local atoms (0 = never).
+      int  sortInterval_;
+
+      // Number of calls to updateSortCounter (saved if sortInterval_ > 0).
+      int  sortCounter_;
+
       /// Maximum number of atoms on this proc since stats cleared.
       int  maxNAtomLocal_; 
    
@@ -566,6 +716,9 @@ namespace DdMd
       // Is this object initialized (has memory been allocated?).
       bool isInitialized_;
 
+      // Is the packed ordering valid for the current atom and ghost sets?
+      bool isPacked_;
+
       // Are atomic coordinates Cartesian (true) or generalized (false)?
       bool isCartesian_;
 
@@ -609,6 +762,49 @@ namespace DdMd
    inline const AtomMap& AtomStorage::map() const
    { return map_; }
 
+   inline bool AtomStorage::isPacked() const
+   { return isPacked_; }
+
+   inline PackedAtomArray& AtomStorage::packed()
+   { return packed_; }
+
+   inline const PackedAtomArray& AtomStorage::packed() const
+   { return packed_; }
+
+   inline Atom& AtomStorage::localAtom(int i)
+   {  return atomSet_[i]; }
+
+   inline Atom& AtomStorage::ghostAtom(int i)
+   {  return ghostSet_[i]; }
+
+   /*
+   * Return array index of an atom, from its offset in atoms_ or ghosts_.
+   */
+   inline int AtomStorage::arrayId(const Atom& atom) const
+   {
+      if (atom.isGhost()) {
+         return atomCapacity_ + int(&atom - &ghosts_[0]);
+      } else {
+         return int(&atom - &atoms_[0]);
+      }
+   }
+
+   /*
+   * Return packed index of an atom, from its offset in atoms_ or ghosts_.
+   */
+   inline int AtomStorage::sortInterval() const
+   {  return sortInterval_; }
+
+   inline int AtomStorage::packedId(const Atom& atom) const
+   {
+      assert(isPacked_);
+      if (atom.isGhost()) {
+         return ghostPackedIds_[int(&atom - &ghosts_[0])];
+      } else {
+         return atomPackedIds_[int(&atom - &atoms_[0])];
+      }
+   }
+
    /*
    * On master processor (rank=0), stored value of total number of atoms.
    */
@@ -110,6 +110,16 @@ namespace DdMd
       * \param atomStorage AtomStorage object used to find atom pointers
       */
       virtual void findGhosts(AtomStorage& atomStorage) = 0;
+
+      /**
+      * Reset pointers to local atoms in all groups.
+      *
+      * Usage: This is called after AtomStorage::sortAtoms() has moved 
+      * local atoms, to reset group pointers using the atom map.
+      *
+      * \param atomStorage AtomStorage object used to find atom pointers
+      */
+      virtual void findLocals(AtomStorage& atomStorage) = 0;
    
       /**
       * Return true if the container is valid, or throw an Exception.
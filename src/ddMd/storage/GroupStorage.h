@@ -221,6 +221,17 @@ namespace DdMd
       */
       void begin(ConstGroupIterator<N>& iterator) const;
 
+      /**
+      * Return local group number i, for 0 <= i < size().
+      *
+      * Groups are indexed in the order visited by a GroupIterator. This
+      * order changes whenever a group is added or removed. This function
+      * is intended for loops that are divided among threads.
+      *
+      * \param i index within the set of local groups
+      */
+      Group<N>& group(int i);
+
       //@}
       /// \name Accessors
       //@{
@@ -356,6 +367,16 @@ namespace DdMd
       */
       virtual
       void findGhosts(AtomStorage& atomStorage);
+
+      /**
+      * Reset pointers to local atoms in all groups.
+      *
+      * Usage: This is called after AtomStorage::sortAtoms().
+      *
+      * \param atomStorage AtomStorage object used to find atom pointers
+      */
+      virtual
+      void findLocals(AtomStorage& atomStorage);
    
       /**
       * Return true if the container is valid, or throw an Exception.
@@ -514,6 +535,13 @@ namespace DdMd
    void GroupStorage<N>::begin(ConstGroupIterator<N>& iterator) const
    {  groupSet_.begin(iterator); }
 
+   /*
+   * Return local group number i.
+   */
+   template <int N>
+   inline Group<N>& GroupStorage<N>::group(int i)
+   {  return groupSet_[i]; }
+
    template <int N>
    inline GroupDistributor<N>& GroupStorage<N>::distributor()
    {  return distributor_; }
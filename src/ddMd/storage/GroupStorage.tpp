@@ -823,5 +823,28 @@ namespace DdMd
       }
    }
 
+   /*
+   * Reset pointers to local atoms in all groups, after atoms are moved.
+   */
+   template <int N>
+   void GroupStorage<N>::findLocals(AtomStorage& atomStorage)
+   {
+      GroupIterator<N> groupIter;
+      const AtomMap& atomMap = atomStorage.map();
+      Atom* ptr;
+      int i;
+      for (begin(groupIter); groupIter.notEnd(); ++groupIter) {
+         for (i = 0; i < N; ++i) {
+            ptr = groupIter->atomPtr(i);
+            if (ptr && !ptr->isGhost()) {
+               ptr = atomMap.find(groupIter->atomId(i));
+               assert(ptr);
+               assert(!ptr->isGhost());
+               groupIter->setAtomPtr(i, ptr);
+            }
+         }
+      }
+   }
+
 } // namespace DdMd
 #endif
@@ -0,0 +1,177 @@
+#ifndef DDMD_PACKED_ATOM_ARRAY_CPP
+#define DDMD_PACKED_ATOM_ARRAY_CPP
+
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2012, David Morse (morse012@umn.edu)
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "PackedAtomArray.h"
+#include <ddMd/chemistry/Atom.h>
+#include <util/misc/Memory.h>
+
+#include <stddef.h>
+
+namespace DdMd
+{
+
+   using namespace Util;
+
+   /*
+   * Constructor.
+   */
+   PackedAtomArray::PackedAtomArray()
+    : positionBlock_(0),
+      forceBlock_(0),
+      positions_(0),
+      forces_(0),
+      typeIds_(),
+      ptrs_(),
+      stride_(0),
+      size_(0),
+      nLocal_(0),
+      capacity_(0)
+   {}
+
+   /*
+   * Destructor.
+   */
+   PackedAtomArray::~PackedAtomArray()
+   {
+      if (positionBlock_) {
+         Memory::deallocate<double>(positionBlock_, 3*stride_ + 8);
+      }
+      if (forceBlock_) {
+         Memory::deallocate<double>(forceBlock_, 3*stride_ + 8);
+      }
+   }
+
+   /*
+   * Allocate all arrays.
+   */
+   void PackedAtomArray::allocate(int capacity)
+   {
+      if (isAllocated()) {
+         UTIL_THROW("Cannot re-allocate a PackedAtomArray");
+      }
+      if (capacity <= 0) {
+         UTIL_THROW("Cannot allocate with capacity <= 0");
+      }
+      capacity_ = capacity;
+
+      // Round stride up to a multiple of 8 doubles (64 bytes), so that
+      // the y and z blocks share the alignment of the x block.
+      stride_ = 8*((capacity + 7)/8);
+
+      allocateBlock(positionBlock_, positions_);
+      allocateBlock(forceBlock_, forces_);
+      typeIds_.allocate(capacity_);
+      ptrs_.allocate(capacity_);
+
+      for (int i = 0; i < 3*stride_; ++i) {
+         positions_[i] = 0.0;
+         forces_[i] = 0.0;
+      }
+      size_ = 0;
+      nLocal_ = 0;
+   }
+
+   /*
+   * Allocate a block with room for 3*stride_ doubles aligned to 64 bytes.
+   *
+   * Memory::allocate provides no alignment guarantee, so 8 extra doubles
+   * are allocated and the aligned pointer is offset into the block.
+   */
+   void PackedAtomArray::allocateBlock(double*& block, double*& aligned)
+   {
+      Memory::allocate<double>(block, 3*stride_ + 8);
+      size_t address = (size_t)block;
+      size_t offset = (64 - address % 64) % 64;
+      aligned = block + offset/sizeof(double);
+   }
+
+   /*
+   * Remove all atoms.
+   */
+   void PackedAtomArray::clear()
+   {
+      size_ = 0;
+      nLocal_ = 0;
+   }
+
+   /*
+   * Append an atom.
+   */
+   int PackedAtomArray::append(Atom& atom)
+   {
+      if (size_ >= capacity_) {
+         UTIL_THROW("PackedAtomArray is full");
+      }
+      if (!atom.isGhost()) {
+         if (nLocal_ != size_) {
+            UTIL_THROW("Local atom appended after a ghost");
+         }
+         ++nLocal_;
+      }
+      const Vector& r = atom.position();
+      positions_[size_] = r[0];
+      positions_[size_ + stride_] = r[1];
+      positions_[size_ + 2*stride_] = r[2];
+      typeIds_[size_] = atom.typeId();
+      ptrs_[size_] = &atom;
+      ++size_;
+      return size_ - 1;
+   }
+
+   /*
+   * Copy positions of all atoms into packed arrays.
+   */
+   void PackedAtomArray::update()
+   {
+      double* x = positions_;
+      double* y = positions_ + stride_;
+      double* z = positions_ + 2*stride_;
+      for (int i = 0; i < size_; ++i) {
+         const Vector& r = ptrs_[i]->position();
+         x[i] = r[0];
+         y[i] = r[1];
+         z[i] = r[2];
+      }
+   }
+
+   /*
+   * Set all packed forces to zero.
+   */
+   void PackedAtomArray::zeroForces()
+   {
+      double* fx = forces_;
+      double* fy = forces_ + stride_;
+      double* fz = forces_ + 2*stride_;
+      for (int i = 0; i < size_; ++i) {
+         fx[i] = 0.0;
+         fy[i] = 0.0;
+         fz[i] = 0.0;
+      }
+   }
+
+   /*
+   * Add packed forces to atomic forces.
+   */
+   void PackedAtomArray::addForces(bool addGhosts)
+   {
+      const double* fx = forces_;
+      const double* fy = forces_ + stride_;
+      const double* fz = forces_ + 2*stride_;
+      int n = addGhosts ? size_ : nLocal_;
+      for (int i = 0; i < n; ++i) {
+         Vector& f = ptrs_[i]->force();
+         f[0] += fx[i];
+         f[1] += fy[i];
+         f[2] += fz[i];
+      }
+   }
+
+}
+#endif
@@ -0,0 +1,251 @@
+#ifndef DDMD_PACKED_ATOM_ARRAY_H
+#define DDMD_PACKED_ATOM_ARRAY_H
+
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2012, David Morse (morse012@umn.edu)
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <util/containers/DArray.h>       // member template
+#include <util/space/Vector.h>            // inline methods
+#include <util/global.h>
+
+namespace DdMd
+{
+
+   class Atom;
+   using namespace Util;
+
+   /**
+   * Packed structure-of-arrays copy of atomic positions, forces and types.
+   *
+   * A PackedAtomArray stores the x, y and z components of the position
+   * and force of each of a set of atoms in separate contiguous arrays of
+   * doubles, each of which is aligned to a 64 byte (cache line) boundary,
+   * along with a contiguous array of atom type ids. Atoms are identified
+   * by a packed index 0 <= i < size(). All local atoms must be appended
+   * before any ghost atoms, so that local atoms have packed indices
+   * i < nLocal() and ghosts have indices nLocal() <= i < size().
+   *
+   * The packed arrays are a cache of data owned by Atom objects, which is
+   * maintained by the parent AtomStorage: Positions are gathered from the
+   * atoms by update(), and forces accumulated in the packed force arrays
+   * are added to the atomic forces by addForces(). This layout allows
+   * force loops to use unit stride or indexed vector loads rather than
+   * dereferencing an Atom pointer for every pair.
+   *
+   * \ingroup DdMd_Storage_Module
+   */
+   class PackedAtomArray
+   {
+
+   public:
+
+      /**
+      * Constructor.
+      */
+      PackedAtomArray();
+
+      /**
+      * Destructor.
+      */
+      ~PackedAtomArray();
+
+      /**
+      * Allocate memory for all arrays.
+      *
+      * \param capacity maximum number of atoms (local + ghost)
+      */
+      void allocate(int capacity);
+
+      /**
+      * Remove all atoms (reset size to zero).
+      */
+      void clear();
+
+      /**
+      * Append an atom, copying its position and type id.
+      *
+      * Local atoms must all be appended before any ghosts.
+      *
+      * \param atom Atom to be added
+      * \return packed index of the new atom
+      */
+      int append(Atom& atom);
+
+      /**
+      * Copy current positions of all atoms into the packed arrays.
+      */
+      void update();
+
+      /**
+      * Set all packed forces to zero.
+      */
+      void zeroForces();
+
+      /**
+      * Add packed forces to the forces of the corresponding atoms.
+      *
+      * \param addGhosts if true, also add forces to ghost atoms.
+      */
+      void addForces(bool addGhosts);
+
+      /// \name Accessors
+      //@{
+
+      /**
+      * Return number of atoms (local and ghost).
+      */
+      int size() const;
+
+      /**
+      * Return number of local atoms (indices 0, ..., nLocal() - 1).
+      */
+      int nLocal() const;
+
+      /**
+      * Return maximum number of atoms.
+      */
+      int capacity() const;
+
+      /**
+      * Has memory been allocated?
+      */
+      bool isAllocated() const;
+
+      /**
+      * Return packed array of x, y or z position components.
+      *
+      * \param i Cartesian index (0, 1 or 2)
+      */
+      const double* position(int i) const;
+
+      /**
+      * Return packed array of x, y or z force components.
+      *
+      * \param i Cartesian index (0, 1 or 2)
+      */
+      double* force(int i);
+
+      /**
+      * Return packed array of x, y or z force components (const).
+      *
+      * \param i Cartesian index (0, 1 or 2)
+      */
+      const double* force(int i) const;
+
+      /**
+      * Return packed array of atom type ids.
+      */
+      const int* typeIds() const;
+
+      /**
+      * Get position of the atom with packed index i as a Vector.
+      *
+      * \param i packed atom index
+      * \param r position Vector (output)
+      */
+      void getPosition(int i, Vector& r) const;
+
+      /**
+      * Return pointer to Atom with packed index i.
+      *
+      * \param i packed atom index
+      */
+      Atom* ptr(int i) const;
+
+      //@}
+
+   private:
+
+      // Unaligned block holding positions (aligned at positions_).
+      double* positionBlock_;
+
+      // Unaligned block holding forces (aligned at forces_).
+      double* forceBlock_;
+
+      // Aligned position components: x at [0, stride_), y, then z.
+      double* positions_;
+
+      // Aligned force components: x at [0, stride_), y, then z.
+      double* forces_;
+
+      // Atom type ids.
+      DArray<int> typeIds_;
+
+      // Pointers to parent Atom objects.
+      DArray<Atom*> ptrs_;
+
+      // Distance between x, y and z blocks (a multiple of 8 doubles).
+      int stride_;
+
+      // Number of atoms.
+      int size_;
+
+      // Number of local atoms (atoms with indices < nLocal_ are local).
+      int nLocal_;
+
+      // Maximum number of atoms.
+      int capacity_;
+
+      /*
+      * Allocate a block of 3*stride_ doubles and align to 64 bytes.
+      */
+      void allocateBlock(double*& block, double*& aligned);
+
+      /*
+      * Copy constructor - private and not implemented.
+      */
+      PackedAtomArray(const PackedAtomArray& other);
+
+      /*
+      * Assignment - private and not implemented.
+      */
+      PackedAtomArray& operator = (const PackedAtomArray& other);
+
+   };
+
+   // Inline functions
+
+   inline int PackedAtomArray::size() const
+   {  return size_; }
+
+   inline int PackedAtomArray::nLocal() const
+   {  return nLocal_; }
+
+   inline int PackedAtomArray::capacity() const
+   {  return capacity_; }
+
+   inline bool PackedAtomArray::isAllocated() const
+   {  return (bool)positions_; }
+
+   inline const double* PackedAtomArray::position(int i) const
+   {  return positions_ + i*stride_; }
+
+   inline double* PackedAtomArray::force(int i)
+   {  return forces_ + i*stride_; }
+
+   inline const double* PackedAtomArray::force(int i) const
+   {  return forces_ + i*stride_; }
+
+   inline const int* PackedAtomArray::typeIds() const
+   {  return &typeIds_[0]; }
+
+   inline void PackedAtomArray::getPosition(int i, Vector& r) const
+   {
+      assert(i >= 0 && i < size_);
+      r[0] = positions_[i];
+      r[1] = positions_[i + stride_];
+      r[2] = positions_[i + 2*stride_];
+   }
+
+   inline Atom* PackedAtomArray::ptr(int i) const
+   {
+      assert(i >= 0 && i < size_);
+      return ptrs_[i];
+   }
+
+}
+#endif
@@ -16,6 +16,7 @@
 #include "configIos/ConfigIoTest.h"
 #include "communicate/CommunicateTestComposite.h"
 #include "neighbor/NeighborTestComposite.h"
+#include "integrators/IntegratorTest.h"
 #include "simulation/SimulationTest.h"
 #ifdef DDMD_MODIFIERS
 #include "modifiers/ModifierTestComposite.h"
@@ -27,6 +28,7 @@ TEST_COMPOSITE_BEGIN(DdMdNsTestComposite)
 addChild(new ChemistryTestComposite, "chemistry/");
 addChild(new StorageTestComposite, "storage/");
 addChild(new NeighborTestComposite, "neighbor/");
+addChild(new TEST_RUNNER(IntegratorTest), "integrators/");
 #ifdef DDMD_MODIFIERS
 addChild(new ModifierTestComposite, "modifiers/");
 #endif
@@ -178,6 +178,48 @@ public:
          }
       }
 
+   }
+
+   void testBalance()
+   {  
+      printMethod(TEST_FUNC); 
+ 
+      Boundary boundary; 
+      domain_.setBoundary(boundary);
+
+      openFile("in/Domain"); 
+      domain_.readParam(file()); 
+
+      // Load increases with grid coordinate 0
+      double load = 1.0 + 2.0*domain_.gridCoordinate(0);
+      Vector minWidths(0.2);
+      domain_.balance(load, minWidths);
+
+      // Boundary 1 along axis 0 moves right, by no more than 0.1 
+      TEST_ASSERT(domain_.plane(0, 0) == 0.0);
+      TEST_ASSERT(domain_.plane(0, 1) > 0.5);
+      TEST_ASSERT(domain_.plane(0, 1) < 0.5 + 0.1 + 1.0E-10);
+      TEST_ASSERT(domain_.plane(0, 2) == 1.0);
+
+      // Equal loads along axis 2: boundaries do not move
+      TEST_ASSERT(eq(domain_.plane(2, 1), 1.0/3.0));
+      TEST_ASSERT(eq(domain_.plane(2, 2), 2.0/3.0));
+
+      // Check consistency of ownerRank and isInDomain
+      Vector position;
+      int i, j, k;
+      for (i = 0; i < 10; ++i) {
+         position[0] = 0.05 + 0.1*i;
+         for (j = 0; j < 4; ++j) {
+            position[1] = 0.1 + 0.25*j;
+            for (k = 0; k < 10; ++k) {
+               position[2] = 0.05 + 0.1*k;
+               TEST_ASSERT(domain_.isInDomain(position) == 
+                           (domain_.ownerRank(position) == domain_.gridRank()));
+            }
+         }
+      }
+
    }
    #endif
 
@@ -187,6 +229,7 @@ TEST_BEGIN(DomainTest)
 TEST_ADD(DomainTest, testReadParam)
 #ifdef UTIL_MPI
 TEST_ADD(DomainTest, testPing)
+TEST_ADD(DomainTest, testBalance)
 #endif
 TEST_END(DomainTest)
 
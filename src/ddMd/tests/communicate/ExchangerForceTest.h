@@ -102,6 +102,7 @@ private:
    void testGhostUpdateCycle();
    void testInitialForces();
    void testForceCycle();
+   void testObservables();
 
 public:
 
@@ -114,6 +115,8 @@ public:
    void testInitialForcesR();
    void testForceCycleF();
    void testForceCycleR();
+   void testObservablesF();
+   void testObservablesR();
 };
 
 void ExchangerForceTest::setUp()
@@ -133,13 +136,13 @@ void ExchangerForceTest::initialize()
    exchanger.addGroupExchanger(bondStorage);
    #ifdef INTER_ANGLE
    angleStorage.associate(domain, atomStorage, buffer);
-   if (hasAngle) {
+   if (hasAngles) {
       exchanger.addGroupExchanger(angleStorage);
    }
    #endif
    #ifdef INTER_DIHEDRAL
    dihedralStorage.associate(domain, atomStorage, buffer);
-   if (hasDihedral) {
+   if (hasDihedrals) {
       exchanger.addGroupExchanger(dihedralStorage);
    }
    #endif
@@ -191,12 +194,12 @@ void ExchangerForceTest::initialize()
    bondStorage.readParam(file());
    #endif
    #ifdef INTER_ANGLE
-   if (hasAngle) {
+   if (hasAngles) {
       angleStorage.readParam(file());
    }
    #endif
    #ifdef INTER_DIHEDRAL
-   if (hasDihedral) {
+   if (hasDihedrals) {
       dihedralStorage.readParam(file());
    }
    #endif
@@ -1062,6 +1065,143 @@ void ExchangerForceTest::testForceCycle()
 
 }
 
+void ExchangerForceTest::testObservablesF() {
+   printMethod(TEST_FUNC);
+   reverseUpdateFlag = false;
+   testObservables();
+}
+
+void ExchangerForceTest::testObservablesR() {
+   printMethod(TEST_FUNC);
+   reverseUpdateFlag = true;
+   testObservables();
+}
+
+/*
+* Compare computeForcesAndObservables to separate force, energy and
+* stress calculations.
+*/
+void ExchangerForceTest::testObservables()
+{
+   initialize();
+   TEST_ASSERT(pairPotential.reverseUpdateFlag() == reverseUpdateFlag);
+
+   atomStorage.clearSnapshot();
+   exchanger.exchange();
+   exchangeNotify();
+
+   // Build cell and pair lists
+   pairPotential.buildCellList();
+   atomStorage.transformGenToCart(boundary);
+   pairPotential.buildPairList();
+   atomStorage.makeSnapshot();
+
+   // Move atoms within the skin, and update ghost positions
+   displaceAtoms(0.02);
+   exchanger.update();
+   pairPotential.setMethodId(0);
+
+   // Compute forces, energies and stresses separately
+   computeForces();
+   if (reverseUpdateFlag) {
+      exchanger.reverseUpdate();
+   }
+   saveForces();
+   double pairEnergy = 0.0;
+   double bondEnergy = 0.0;
+   Tensor pairStress;
+   Tensor bondStress;
+   pairPotential.unsetEnergy();
+   pairPotential.computeEnergy(domain.communicator());
+   bondPotential.unsetEnergy();
+   bondPotential.computeEnergy(domain.communicator());
+   pairPotential.unsetStress();
+   pairPotential.computeStress(domain.communicator());
+   bondPotential.unsetStress();
+   bondPotential.computeStress(domain.communicator());
+   if (domain.communicator().Get_rank() == 0) {
+      pairEnergy = pairPotential.energy();
+      bondEnergy = bondPotential.energy();
+      pairStress = pairPotential.stress();
+      bondStress = bondPotential.stress();
+   }
+
+   // Compute forces and local energies and stresses in one loop
+   double localEnergies[2];
+   Tensor localStresses[2];
+   localEnergies[0] = 0.0;
+   localEnergies[1] = 0.0;
+   localStresses[0].zero();
+   localStresses[1].zero();
+   zeroForces();
+   pairPotential.computeForcesAndObservables(&localEnergies[0],
+                                             &localStresses[0]);
+   bondPotential.computeForcesAndObservables(&localEnergies[1],
+                                             &localStresses[1]);
+   if (reverseUpdateFlag) {
+      exchanger.reverseUpdate();
+   }
+
+   // Sum local values over processors
+   const int nValue = 2*(1 + Dimension*Dimension);
+   double localValues[nValue];
+   double totalValues[nValue];
+   int i, j, k, n;
+   n = 0;
+   for (k = 0; k < 2; ++k) {
+      localValues[n++] = localEnergies[k];
+      for (i = 0; i < Dimension; ++i) {
+         for (j = 0; j < Dimension; ++j) {
+            localValues[n++] = localStresses[k](i, j);
+         }
+      }
+   }
+   communicator().Reduce(localValues, totalValues, nValue,
+                         MPI::DOUBLE, MPI::SUM, 0);
+
+   // Compare energies and stresses
+   if (communicator().Get_rank() == 0) {
+      n = 0;
+      TEST_ASSERT(eq(totalValues[n++], pairEnergy));
+      for (i = 0; i < Dimension; ++i) {
+         for (j = 0; j < Dimension; ++j) {
+            TEST_ASSERT(eq(totalValues[n++], pairStress(i, j)));
+         }
+      }
+      TEST_ASSERT(eq(totalValues[n++], bondEnergy));
+      for (i = 0; i < Dimension; ++i) {
+         for (j = 0; j < Dimension; ++j) {
+            TEST_ASSERT(eq(totalValues[n++], bondStress(i, j)));
+         }
+      }
+   }
+
+   // Compare forces
+   AtomIterator atomIter;
+   int id;
+   for (atomStorage.begin(atomIter); atomIter.notEnd(); ++atomIter) {
+      id = atomIter->id();
+      for (i = 0; i < Dimension; ++i) {
+         TEST_ASSERT(eq(forces[id][i], atomIter->force()[i]));
+      }
+   }
+
+   // With null pointers, only forces are computed
+   zeroForces();
+   pairPotential.computeForcesAndObservables(0, 0);
+   bondPotential.computeForcesAndObservables(0, 0);
+   if (reverseUpdateFlag) {
+      exchanger.reverseUpdate();
+   }
+   for (atomStorage.begin(atomIter); atomIter.notEnd(); ++atomIter) {
+      id = atomIter->id();
+      for (i = 0; i < Dimension; ++i) {
+         TEST_ASSERT(eq(forces[id][i], atomIter->force()[i]));
+      }
+   }
+
+}
+
 /*
 * Determine whether an atom exchange and reneighboring is needed.
 */
@@ -1096,6 +1236,8 @@ TEST_ADD(ExchangerForceTest, testInitialForcesF)
 TEST_ADD(ExchangerForceTest, testInitialForcesR)
 TEST_ADD(ExchangerForceTest, testForceCycleF)
 TEST_ADD(ExchangerForceTest, testForceCycleR)
+TEST_ADD(ExchangerForceTest, testObservablesF)
+TEST_ADD(ExchangerForceTest, testObservablesR)
 TEST_END(ExchangerForceTest)
 
 #endif /* EXCHANGER_TEST_H */
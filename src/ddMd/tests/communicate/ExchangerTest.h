@@ -70,6 +70,7 @@ public:
    void testDistribute();
    void testExchange();
    void testGhostUpdate();
+   void testNonblockingUpdate();
    void testGhostUpdateCycle();
    void testExchangeUpdateCycle();
 
@@ -368,6 +369,52 @@ void ExchangerTest::testGhostUpdate()
 
 }
 
+void ExchangerTest::testNonblockingUpdate()
+{
+   printMethod(TEST_FUNC);
+
+   GhostIterator  ghostIter;
+   DArray<Vector> ghostPositions;
+   int  i;
+
+   double range = 0.1;
+   displaceAtoms(range);
+
+   atomStorage.clearSnapshot();
+   exchanger.exchange();
+   exchangeNotify();
+   atomStorage.transformGenToCart(boundary);
+   atomStorage.makeSnapshot();
+   int nGhost = atomStorage.nGhost();
+
+   // Move local atoms, then update ghosts with beginUpdate and endUpdate
+   displaceAtoms(range);
+   exchanger.beginUpdate();
+   TEST_ASSERT(exchanger.isUpdatePending());
+   exchanger.endUpdate();
+   TEST_ASSERT(!exchanger.isUpdatePending());
+   TEST_ASSERT(nGhost == atomStorage.nGhost());
+
+   // Record ghost positions
+   ghostPositions.allocate(nGhost);
+   i = 0;
+   for (atomStorage.begin(ghostIter); ghostIter.notEnd(); ++ghostIter) {
+      ghostPositions[i] = ghostIter->position();
+      ++i;
+   }
+
+   // Check that a blocking update does not change ghost positions
+   exchanger.update();
+   i = 0;
+   for (atomStorage.begin(ghostIter); ghostIter.notEnd(); ++ghostIter) {
+      TEST_ASSERT(ghostPositions[i] == ghostIter->position());
+      ++i;
+   }
+
+   atomStorage.transformCartToGen(boundary);
+   TEST_ASSERT(atomStorage.isValid());
+}
+
 void ExchangerTest::testGhostUpdateCycle()
 {
    printMethod(TEST_FUNC);
@@ -626,6 +673,7 @@ TEST_BEGIN(ExchangerTest)
 TEST_ADD(ExchangerTest, testDistribute)
 TEST_ADD(ExchangerTest, testExchange)
 TEST_ADD(ExchangerTest, testGhostUpdate)
+TEST_ADD(ExchangerTest, testNonblockingUpdate)
 TEST_ADD(ExchangerTest, testGhostUpdateCycle)
 TEST_ADD(ExchangerTest, testExchangeUpdateCycle)
 TEST_END(ExchangerTest)
@@ -0,0 +1,93 @@
+#ifndef DDMD_INTEGRATOR_TEST_H
+#define DDMD_INTEGRATOR_TEST_H
+
+#include <ddMd/integrators/Integrator.h>
+
+#ifdef UTIL_MPI
+#ifndef TEST_MPI
+#define TEST_MPI
+#endif
+#endif
+
+#include <test/UnitTest.h>
+#include <test/UnitTestRunner.h>
+
+#include <cmath>
+
+using namespace Util;
+using namespace DdMd;
+
+class IntegratorTest : public UnitTest 
+{
+
+public:
+
+   void setUp()
+   {}
+
+   void tearDown()
+   {}  
+
+   /*
+   * Time per step (rc + s)^3 (a + b/s) of the model used by chooseSkin.
+   */
+   double modelTime(double a, double b, double rc, double skin)
+   {
+      double r = rc + skin;
+      return r*r*r*(a + b/skin);
+   }
+
+   void testChooseSkinMinimum() 
+   {
+      printMethod(TEST_FUNC);
+
+      double a = 1.0;
+      double b = 0.3;
+      double rc = 1.12;
+      double skin = Integrator::chooseSkin(a, b, rc, 0.4, 0.1, 1.0, 1.0);
+
+      // Unconstrained result minimizes the model time per step
+      double t = modelTime(a, b, rc, skin);
+      TEST_ASSERT(skin > 0.2 && skin < 0.8);
+      TEST_ASSERT(t < modelTime(a, b, rc, 0.99*skin));
+      TEST_ASSERT(t < modelTime(a, b, rc, 1.01*skin));
+   }
+
+   void testChooseSkinClamps() 
+   {
+      printMethod(TEST_FUNC);
+
+      double rc = 3.0;
+      double skin;
+
+      // Expensive reneighboring: grows by at most a factor of two
+      skin = Integrator::chooseSkin(1.0, 1.0E4, rc, 0.2, 0.1, 5.0, 5.0);
+      TEST_ASSERT(eq(skin, 0.4));
+
+      // Cheap reneighboring: shrinks by at most a factor of two
+      skin = Integrator::chooseSkin(1.0, 1.0E-6, rc, 0.4, 0.01, 1.0, 1.0);
+      TEST_ASSERT(eq(skin, 0.2));
+
+      // Bounds minSkin and maxSkin
+      skin = Integrator::chooseSkin(1.0, 1.0E4, rc, 0.4, 0.1, 0.5, 1.0);
+      TEST_ASSERT(eq(skin, 0.5));
+      skin = Integrator::chooseSkin(1.0, 1.0E-6, rc, 0.4, 0.3, 1.0, 1.0);
+      TEST_ASSERT(eq(skin, 0.3));
+
+      // Limit from domain widths or pair capacity
+      skin = Integrator::chooseSkin(1.0, 1.0E4, rc, 0.4, 0.1, 1.0, 0.6);
+      TEST_ASSERT(eq(skin, 0.6));
+
+      // Limit below minSkin: skin is left unchanged
+      skin = Integrator::chooseSkin(1.0, 1.0E4, rc, 0.4, 0.3, 1.0, 0.25);
+      TEST_ASSERT(eq(skin, 0.4));
+   }
+
+};
+
+TEST_BEGIN(IntegratorTest)
+TEST_ADD(IntegratorTest, testChooseSkinMinimum)
+TEST_ADD(IntegratorTest, testChooseSkinClamps)
+TEST_END(IntegratorTest)
+
+#endif
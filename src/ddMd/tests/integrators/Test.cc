@@ -0,0 +1,17 @@
+#include "IntegratorTest.h"
+
+int main() 
+{
+
+   #ifdef UTIL_MPI 
+   MPI::Init();
+   #endif
+
+   TEST_RUNNER(IntegratorTest) runner;
+   runner.run();
+
+   #ifdef UTIL_MPI 
+   MPI::Finalize();
+   #endif
+
+}
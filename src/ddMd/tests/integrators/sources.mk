@@ -0,0 +1,7 @@
+ddMd_tests_integrators_=ddMd/tests/integrators/Test.cc
+
+ddMd_tests_integrators_SRCS=\
+     $(addprefix $(SRC_DIR)/, $(ddMd_tests_integrators_))
+ddMd_tests_integrators_OBJS=\
+     $(addprefix $(BLD_DIR)/, $(ddMd_tests_integrators_:.cc=.o))
+
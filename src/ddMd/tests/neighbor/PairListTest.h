@@ -6,6 +6,9 @@
 #include <ddMd/neighbor/PairIterator.h>
 #include <ddMd/chemistry/Atom.h>
 #include <ddMd/chemistry/AtomArray.h>
+#include <ddMd/storage/AtomStorage.h>
+#include <ddMd/storage/AtomIterator.h>
+#include <ddMd/storage/GhostIterator.h>
 #include <util/containers/DPArray.h>
 #include <util/space/Vector.h>
 #include <util/random/Random.h>
@@ -33,6 +36,7 @@ private:
    PairList      pairList;
    CellList      cellList;
    AtomArray     atoms;
+   AtomStorage   storage;
    DPArray<Atom> locals;
    DPArray<Atom> ghosts;
    Vector        lengths;
@@ -363,12 +367,191 @@ public:
 
    }
 
+   void testPairIteratorParts()
+   {
+      printMethod(TEST_FUNC);
+
+      makeConfiguration();
+      pairList.build(cellList);
+
+      PairIterator iter, partIter;
+      Atom* atom1Ptr;
+      Atom* atom2Ptr;
+      Atom* part1Ptr = 0;
+      Atom* part2Ptr;
+      Atom* prev1Ptr = 0;
+      int   nPart = 3;
+      int   i, np, nMax;
+
+      // Check that consecutive parts visit all pairs, in order
+      pairList.begin(iter);
+      nMax = 0;
+      for (i = 0; i < nPart; ++i) {
+         np = 0;
+         pairList.begin(partIter, i, nPart);
+         for ( ; partIter.notEnd(); ++partIter) {
+            TEST_ASSERT(iter.notEnd());
+            partIter.getPair(part1Ptr, part2Ptr);
+            iter.getPair(atom1Ptr, atom2Ptr);
+            TEST_ASSERT(part1Ptr == atom1Ptr);
+            TEST_ASSERT(part2Ptr == atom2Ptr);
+            // Neighbors of a primary atom are never split among parts
+            if (np == 0) {
+               TEST_ASSERT(part1Ptr != prev1Ptr);
+            }
+            ++iter;
+            ++np;
+         }
+         prev1Ptr = part1Ptr;
+         if (np > nMax) nMax = np;
+      }
+      TEST_ASSERT(iter.isEnd());
+      TEST_ASSERT(nMax < pairList.nPair());
+   }
+
+   /*
+   * Place nAtom atoms at random in an AtomStorage, build cell list.
+   */
+   void makeStorageConfiguration()
+   {
+      int i, j;
+      for (i = 0; i < Dimension; ++i) {
+         lower[i] = lower[i]/lengths[i];
+         upper[i] = upper[i]/lengths[i];
+         cutoffs[i] = cutoff/lengths[i];
+      }
+      cellList.allocate(nAtom, lower, upper, cutoffs, 1);
+      cellList.makeGrid(lower, upper, cutoffs, 1);
+      pairList.allocate(nAtom, pairCapacity, cutoff);
+      storage.initialize(nAtom, nAtom, nAtom);
+
+      Random random;
+      random.setSeed(1098640);
+      Vector pos;
+      Atom*  ptr;
+      bool   ghost;
+      cellList.clear();
+      for (i = 0; i < nAtom; ++i) {
+         ghost = false;
+         for (j = 0; j < Dimension; ++j) {
+            pos[j] = random.uniform(lower[j] - cutoffs[j], 
+                                    upper[j] + cutoffs[j]);
+            if (pos[j] < lower[j] || pos[j] > upper[j]) {
+               ghost = true;
+            }
+         }
+         ptr = ghost ? storage.addGhost(i) : storage.addAtom(i);
+         ptr->setTypeId(1);
+         ptr->position() = pos;
+         cellList.placeAtom(*ptr);
+      }
+      cellList.build();
+
+      // Transform coordinates to Cartesian
+      AtomIterator localIter;
+      for (storage.begin(localIter); localIter.notEnd(); ++localIter) {
+         for (j = 0; j < Dimension; ++j) {
+            localIter->position()[j] *= lengths[j];
+         }
+      }
+      GhostIterator ghostIter;
+      for (storage.begin(ghostIter); ghostIter.notEnd(); ++ghostIter) {
+         for (j = 0; j < Dimension; ++j) {
+            ghostIter->position()[j] *= lengths[j];
+         }
+      }
+   }
+
+   void testBuildPacked()
+   {
+      printMethod(TEST_FUNC);
+
+      makeStorageConfiguration();
+      pairList.build(cellList);
+      storage.pack();
+      const int nLocal = storage.packed().nLocal();
+      TEST_ASSERT(nLocal == storage.nAtom());
+
+      // Half list: same pairs as Atom* list, sorted rows
+      pairList.buildPacked(storage, false);
+      TEST_ASSERT(pairList.hasPacked());
+      TEST_ASSERT(!pairList.isFull());
+      TEST_ASSERT(pairList.nPackedAtom() == nLocal);
+      TEST_ASSERT(pairList.nPackedPair() == pairList.nPair());
+
+      const int* first = pairList.packedFirst();
+      const int* neighbors = pairList.packedNeighbors();
+      PairIterator iter;
+      Atom* atom1Ptr;
+      Atom* atom2Ptr;
+      int i, k, id1, id2, nLocalPair;
+      bool found;
+      nLocalPair = 0;
+      for (pairList.begin(iter); iter.notEnd(); ++iter) {
+         iter.getPair(atom1Ptr, atom2Ptr);
+         id1 = storage.packedId(*atom1Ptr);
+         id2 = storage.packedId(*atom2Ptr);
+         TEST_ASSERT(id1 < nLocal);
+         found = false;
+         for (k = first[id1]; k < first[id1+1]; ++k) {
+            if (neighbors[k] == id2) found = true;
+         }
+         TEST_ASSERT(found);
+         if (id2 < nLocal) ++nLocalPair;
+      }
+      for (i = 0; i < nLocal; ++i) {
+         for (k = first[i] + 1; k < first[i+1]; ++k) {
+            TEST_ASSERT(neighbors[k-1] < neighbors[k]);
+         }
+      }
+
+      // Full list: pairs of local atoms appear in both rows
+      pairList.buildPacked(storage, true);
+      TEST_ASSERT(pairList.isFull());
+      TEST_ASSERT(pairList.nPackedAtom() == nLocal);
+      TEST_ASSERT(pairList.nPackedPair() == pairList.nPair() + nLocalPair);
+      first = pairList.packedFirst();
+      neighbors = pairList.packedNeighbors();
+      for (i = 0; i < nLocal; ++i) {
+         for (k = first[i]; k < first[i+1]; ++k) {
+            TEST_ASSERT(neighbors[k] != i);
+            if (k > first[i]) {
+               TEST_ASSERT(neighbors[k-1] < neighbors[k]);
+            }
+            id2 = neighbors[k];
+            if (id2 < nLocal) {
+               found = false;
+               for (int m = first[id2]; m < first[id2+1]; ++m) {
+                  if (neighbors[m] == i) found = true;
+               }
+               TEST_ASSERT(found);
+            }
+         }
+      }
+
+      // Parts of packed list cover all rows, in order
+      int begin, end, prevEnd = 0;
+      for (i = 0; i < 3; ++i) {
+         pairList.getPackedPart(i, 3, begin, end);
+         TEST_ASSERT(begin == prevEnd);
+         TEST_ASSERT(end >= begin);
+         prevEnd = end;
+      }
+      TEST_ASSERT(prevEnd == nLocal);
+
+      // Rebuilding the Atom* list invalidates the packed list
+      pairList.build(cellList);
+      TEST_ASSERT(!pairList.hasPacked());
+   }
+
 };
 
 TEST_BEGIN(PairListTest)
 TEST_ADD(PairListTest, testCountNeighbors)
 TEST_ADD(PairListTest, testCountNeighbors2)
 TEST_ADD(PairListTest, testPairIterator)
+TEST_ADD(PairListTest, testPairIteratorParts)
+TEST_ADD(PairListTest, testBuildPacked)
 TEST_END(PairListTest)
 
 #endif
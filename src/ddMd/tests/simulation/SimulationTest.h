@@ -33,6 +33,12 @@ private:
    void displaceAtoms(AtomStorage& atomStorage, const Boundary& boundary, 
                       Random& random, double range);
 
+   void readSimulation(DdMd::Simulation& simulation, 
+                       const char* paramFileName);
+
+   void computeEnergy(DdMd::Simulation& simulation, 
+                      double& kinetic, double& potential);
+
 public:
 
    virtual void setUp()
@@ -60,6 +66,10 @@ public:
 
    void testIntegrate1();
 
+   void testRespaMatchesNve();
+
+   void testRespaEnergy();
+
 };
 
 
@@ -84,6 +94,46 @@ SimulationTest::displaceAtoms(AtomStorage& atomStorage,
    }
 }
 
+/*
+* Read parameters and config3, an equilibrated bead-spring melt.
+*
+* Velocities are taken from the configuration file, so that separate 
+* Simulation objects start from identical states.
+*/
+inline void 
+SimulationTest::readSimulation(DdMd::Simulation& simulation, 
+                               const char* paramFileName)
+{
+   Label::clear();
+   simulation.fileMaster().setRootPrefix(filePrefix()); 
+   openFile(paramFileName); 
+   simulation.readParam(file()); 
+   closeFile();
+   std::string filename("config3");
+   simulation.readConfig(filename);
+}
+
+/*
+* Compute kinetic and potential energies (valid only on master).
+*
+* Call only after a run, when ghosts and the pair list are valid and
+* atomic coordinates are scaled (as between commands).
+*/
+inline void 
+SimulationTest::computeEnergy(DdMd::Simulation& simulation,
+                              double& kinetic, double& potential)
+{
+   AtomStorage& atomStorage = simulation.atomStorage();
+   atomStorage.transformGenToCart(simulation.boundary());
+   simulation.computeKineticEnergy();
+   simulation.computePotentialEnergies();
+   if (simulation.domain().isMaster()) {
+      kinetic = simulation.kineticEnergy();
+      potential = simulation.potentialEnergy();
+   }
+   atomStorage.transformCartToGen(simulation.boundary());
+}
+
 inline void SimulationTest::testReadParam()
 {  
    printMethod(TEST_FUNC); 
@@ -347,6 +397,68 @@ inline void SimulationTest::testIntegrate1()
 
 }
 
+inline void SimulationTest::testRespaMatchesNve()
+{
+   printMethod(TEST_FUNC); 
+
+   // With nInner = 1, RESPA is equivalent to velocity-Verlet
+   double kinetic[2], potential[2];
+   bool isMaster;
+   {
+      DdMd::Simulation nve;
+      readSimulation(nve, "in/param2");
+      isMaster = nve.domain().isMaster();
+      nve.integrator().run(100);
+      computeEnergy(nve, kinetic[0], potential[0]);
+   }
+   {
+      DdMd::Simulation respa;
+      readSimulation(respa, "in/respa1");
+      respa.integrator().run(100);
+      computeEnergy(respa, kinetic[1], potential[1]);
+   }
+   if (isMaster) {
+      if (verbose() > 0) {
+         std::cout << std::endl;
+         std::cout << Dbl(kinetic[0]) << Dbl(potential[0]) << std::endl;
+         std::cout << Dbl(kinetic[1]) << Dbl(potential[1]) << std::endl;
+      }
+      TEST_ASSERT(fabs(kinetic[1] - kinetic[0]) < 1.0E-8*kinetic[0]);
+      TEST_ASSERT(fabs(potential[1] - potential[0]) < 1.0E-8*potential[0]);
+   }
+}
+
+inline void SimulationTest::testRespaEnergy()
+{
+   printMethod(TEST_FUNC); 
+
+   // Total energy is conserved with 4 inner steps per outer step
+   readSimulation(simulation_, "in/respa4");
+   bool isMaster = simulation_.domain().isMaster();
+   double kinetic, potential, energy0, maxDiff;
+   simulation_.integrator().run(20);
+   computeEnergy(simulation_, kinetic, potential);
+   energy0 = kinetic + potential;
+   maxDiff = 0.0;
+   for (int i = 0; i < 4; ++i) {
+      simulation_.integrator().run(20);
+      computeEnergy(simulation_, kinetic, potential);
+      if (isMaster) {
+         if (fabs(kinetic + potential - energy0) > maxDiff) {
+            maxDiff = fabs(kinetic + potential - energy0);
+         }
+      }
+   }
+   if (isMaster) {
+      if (verbose() > 0) {
+         std::cout << std::endl;
+         std::cout << "Initial energy = " << energy0 << std::endl;
+         std::cout << "Maximum energy change = " << maxDiff << std::endl;
+      }
+      TEST_ASSERT(maxDiff < 1.0E-3*fabs(energy0));
+   }
+}
+
 TEST_BEGIN(SimulationTest)
 TEST_ADD(SimulationTest, testReadParam)
 TEST_ADD(SimulationTest, testReadConfig)
@@ -355,6 +467,8 @@ TEST_ADD(SimulationTest, testExchange)
 TEST_ADD(SimulationTest, testUpdate)
 TEST_ADD(SimulationTest, testCalculateForces)
 TEST_ADD(SimulationTest, testIntegrate1)
+TEST_ADD(SimulationTest, testRespaMatchesNve)
+TEST_ADD(SimulationTest, testRespaEnergy)
 TEST_END(SimulationTest)
 
 #endif
@@ -60,6 +60,10 @@ public:
 
    void testTransforms();
 
+   void testPack();
+
+   void testSort();
+
 };
 
 inline void AtomStorageTest::testReadParam()
@@ -306,6 +310,23 @@ void AtomStorageTest::testIterators()
    TEST_ASSERT(nGhost == storage_.nGhost());
    TEST_ASSERT(nGhost == 2);
 
+   // Check random access, in iterator order, and array indices
+   int i = 0;
+   for (storage_.begin(localIter); localIter.notEnd(); ++localIter) {
+      TEST_ASSERT(&storage_.localAtom(i) == localIter.get());
+      TEST_ASSERT(storage_.arrayId(*localIter) >= 0);
+      TEST_ASSERT(storage_.arrayId(*localIter) < storage_.atomCapacity());
+      ++i;
+   }
+   i = 0;
+   for (storage_.begin(ghostIter); ghostIter.notEnd(); ++ghostIter) {
+      TEST_ASSERT(&storage_.ghostAtom(i) == ghostIter.get());
+      TEST_ASSERT(storage_.arrayId(*ghostIter) >= storage_.atomCapacity());
+      ++i;
+   }
+   TEST_ASSERT(storage_.arrayId(localAtoms[0]) 
+               != storage_.arrayId(localAtoms[1]));
+
    storage_.removeAtom(&localAtoms[1]);
    --nLocal;
    TEST_ASSERT(storage_.isValid());
@@ -501,6 +522,179 @@ void AtomStorageTest::testTransforms()
 
 }
 
+void AtomStorageTest::testPack()
+{
+   printMethod(TEST_FUNC);
+
+   Random random;
+   random.setSeed(274454136);
+
+   // Add local atoms and ghosts, with some vacancies
+   Atom* ptr53 = storage_.addAtom(53);
+   storage_.addAtom(18);
+   storage_.addAtom(44);
+   storage_.removeAtom(ptr53);
+   storage_.addAtom(82);
+   storage_.addGhost(35);
+   storage_.addGhost(17);
+   TEST_ASSERT(!storage_.isPacked());
+
+   AtomIterator localIter;
+   GhostIterator ghostIter;
+   int j;
+   for (storage_.begin(localIter); localIter.notEnd(); ++localIter) {
+      for (j = 0; j < Dimension; ++j) {
+         localIter->position()[j] = random.uniform(0.0, 1.0);
+      }
+      localIter->setTypeId(localIter->id() % 2);
+      localIter->force().zero();
+   }
+   for (storage_.begin(ghostIter); ghostIter.notEnd(); ++ghostIter) {
+      for (j = 0; j < Dimension; ++j) {
+         ghostIter->position()[j] = random.uniform(0.0, 1.0);
+      }
+      ghostIter->setTypeId(1);
+      ghostIter->force().zero();
+   }
+
+   storage_.pack();
+   TEST_ASSERT(storage_.isPacked());
+   TEST_ASSERT(storage_.isValid());
+   const PackedAtomArray& packed = storage_.packed();
+   TEST_ASSERT(packed.size() == 5);
+   TEST_ASSERT(packed.nLocal() == 3);
+   TEST_ASSERT((size_t)packed.position(0) % 64 == 0);
+   TEST_ASSERT((size_t)packed.position(1) % 64 == 0);
+   TEST_ASSERT((size_t)packed.position(2) % 64 == 0);
+
+   // Check packed indices, positions and types
+   Vector r;
+   int i;
+   for (storage_.begin(localIter); localIter.notEnd(); ++localIter) {
+      i = storage_.packedId(*localIter);
+      TEST_ASSERT(i < packed.nLocal());
+      TEST_ASSERT(packed.ptr(i) == localIter.get());
+      TEST_ASSERT(packed.typeIds()[i] == localIter->typeId());
+      packed.getPosition(i, r);
+      TEST_ASSERT(r == localIter->position());
+   }
+   for (storage_.begin(ghostIter); ghostIter.notEnd(); ++ghostIter) {
+      i = storage_.packedId(*ghostIter);
+      TEST_ASSERT(i >= packed.nLocal());
+      TEST_ASSERT(i < packed.size());
+      TEST_ASSERT(packed.ptr(i) == ghostIter.get());
+      packed.getPosition(i, r);
+      TEST_ASSERT(r == ghostIter->position());
+   }
+
+   // Move an atom, update packed positions
+   Atom* ptr44 = storage_.map().find(44);
+   ptr44->position()[1] += 0.25;
+   storage_.updatePacked();
+   packed.getPosition(storage_.packedId(*ptr44), r);
+   TEST_ASSERT(r == ptr44->position());
+
+   // Accumulate packed forces and add them to atoms
+   storage_.packed().zeroForces();
+   i = storage_.packedId(*ptr44);
+   storage_.packed().force(0)[i] = 1.0;
+   storage_.packed().force(2)[i] = -2.0;
+   Atom* ptr17 = storage_.map().find(17);
+   i = storage_.packedId(*ptr17);
+   storage_.packed().force(1)[i] = 3.0;
+   storage_.addPackedForces(false);
+   TEST_ASSERT(eq(ptr44->force()[0], 1.0));
+   TEST_ASSERT(eq(ptr44->force()[1], 0.0));
+   TEST_ASSERT(eq(ptr44->force()[2], -2.0));
+   TEST_ASSERT(eq(ptr17->force()[1], 0.0));
+   storage_.addPackedForces(true);
+   TEST_ASSERT(eq(ptr44->force()[0], 2.0));
+   TEST_ASSERT(eq(ptr17->force()[1], 3.0));
+
+   // Adding a ghost invalidates the packed ordering
+   storage_.addGhost(92);
+   TEST_ASSERT(!storage_.isPacked());
+   storage_.pack();
+   TEST_ASSERT(storage_.packed().size() == 6);
+   TEST_ASSERT(storage_.isValid());
+}
+
+void AtomStorageTest::testSort()
+{
+   printMethod(TEST_FUNC);
+
+   Random random;
+   random.setSeed(8340521);
+
+   // Add local atoms, with vacancies, and one ghost
+   int ids[8] = {53, 18, 44, 82, 7, 61, 29, 90};
+   Atom* ptrs[8];
+   int i, j;
+   for (i = 0; i < 8; ++i) {
+      ptrs[i] = storage_.addAtom(ids[i]);
+   }
+   storage_.removeAtom(ptrs[0]);
+   storage_.removeAtom(ptrs[4]);
+   Atom* ghostPtr = storage_.addGhost(35);
+   TEST_ASSERT(storage_.nAtom() == 6);
+
+   // Set positions, velocities and types, indexed by atom id
+   DArray<Vector> positions;
+   DArray<Vector> velocities;
+   positions.allocate(100);
+   velocities.allocate(100);
+   AtomIterator iter;
+   for (storage_.begin(iter); iter.notEnd(); ++iter) {
+      for (j = 0; j < Dimension; ++j) {
+         iter->position()[j] = random.uniform(0.0, 1.0);
+         iter->velocity()[j] = random.uniform(-1.0, 1.0);
+      }
+      iter->setTypeId(iter->id() % 3);
+      positions[iter->id()] = iter->position();
+      velocities[iter->id()] = iter->velocity();
+   }
+   ghostPtr->position() = Vector(0.5, 0.5, 0.5);
+
+   storage_.sortAtoms();
+   TEST_ASSERT(storage_.nAtom() == 6);
+   TEST_ASSERT(storage_.nGhost() == 1);
+   TEST_ASSERT(storage_.isValid());
+   TEST_ASSERT(!storage_.isPacked());
+
+   // Local atoms are contiguous, in iteration order, with data preserved
+   unsigned int key, prevKey = 0;
+   int id, k;
+   i = 0;
+   for (storage_.begin(iter); iter.notEnd(); ++iter) {
+      TEST_ASSERT(iter.get() == &storage_.atoms_[i]);
+      id = iter->id();
+      TEST_ASSERT(map_.find(id) == iter.get());
+      TEST_ASSERT(iter->typeId() == id % 3);
+      for (j = 0; j < Dimension; ++j) {
+         TEST_ASSERT(eq(iter->position()[j], positions[id][j]));
+         TEST_ASSERT(eq(iter->velocity()[j], velocities[id][j]));
+      }
+      // Check Morton order (interleaved bits of 10-bit cell indices)
+      key = 0;
+      for (j = 0; j < Dimension; ++j) {
+         unsigned int c = (unsigned int)(iter->position()[j]*1024.0);
+         for (k = 0; k < 10; ++k) {
+            key |= ((c >> k) & 1u) << (3*k + j);
+         }
+      }
+      TEST_ASSERT(key >= prevKey);
+      prevKey = key;
+      ++i;
+   }
+   TEST_ASSERT(i == 6);
+   TEST_ASSERT(map_.find(35) == ghostPtr);
+
+   // New atoms are taken from the first unused element
+   Atom* newPtr = storage_.addAtom(12);
+   TEST_ASSERT(newPtr == &storage_.atoms_[6]);
+   TEST_ASSERT(storage_.isValid());
+}
+
 TEST_BEGIN(AtomStorageTest)
 TEST_ADD(AtomStorageTest, testReadParam)
 TEST_ADD(AtomStorageTest, testAddAtoms)
@@ -509,6 +703,8 @@ TEST_ADD(AtomStorageTest, testClear)
 TEST_ADD(AtomStorageTest, testIterators)
 TEST_ADD(AtomStorageTest, testSnapshot)
 TEST_ADD(AtomStorageTest, testTransforms)
+TEST_ADD(AtomStorageTest, testPack)
+TEST_ADD(AtomStorageTest, testSort)
 TEST_END(AtomStorageTest)
 
 #endif
@@ -10,6 +10,7 @@
 
 #include "DpdPair.h"
 #include <util/mpi/MpiLoader.h>
+#include "pairSimd.h"
 
 #include <iostream>
 namespace Inter
@@ -282,5 +283,264 @@ namespace Inter
       return value;
    }
 
+   namespace {
+
+      /*
+      * Portable implementation of DpdPair::forceBlock, for pairs k >= begin.
+      *
+      * Parameter arrays are indexed by i*nt + j for atom types i and j.
+      */
+      void dpdForceScalar(int begin, int n, 
+                          const int* type0, const int* type1, int nt,
+                          const double* sigmaSq, const double* sigma,
+                          const double* cf,
+                          double* dx, double* dy, double* dz)
+      {
+         double rsq, f;
+         int k, ij;
+         for (k = begin; k < n; ++k) {
+            ij  = type0[k]*nt + type1[k];
+            rsq = dx[k]*dx[k] + dy[k]*dy[k] + dz[k]*dz[k];
+            f = 0.0;
+            if (rsq < sigmaSq[ij]) {
+               f = cf[ij]*(sigma[ij]/sqrt(rsq) - 1.0);
+            }
+            dx[k] *= f;
+            dy[k] *= f;
+            dz[k] *= f;
+         }
+      }
+
+      /*
+      * Portable implementation of DpdPair::energyBlock, for pairs k >= begin.
+      */
+      void dpdEnergyScalar(int begin, int n, 
+                           const int* type0, const int* type1, int nt,
+                           const double* sigmaSq, const double* sigma,
+                           const double* ce,
+                           const double* rsq, double* energy)
+      {
+         double dr, e;
+         int k, ij;
+         for (k = begin; k < n; ++k) {
+            ij = type0[k]*nt + type1[k];
+            e = 0.0;
+            if (rsq[k] < sigmaSq[ij]) {
+               dr = sqrt(rsq[k]) - sigma[ij];
+               e = ce[ij]*dr*dr;
+            }
+            energy[k] = e;
+         }
+      }
+
+      #ifdef UTIL_SIMD_X86
+
+      /*
+      * AVX2 implementation of DpdPair::forceBlock (4 pairs per iteration).
+      *
+      * If uniform is true, all atom types are 0 and parameters are
+      * broadcast rather than gathered.
+      */
+      __attribute__((target("avx2,fma")))
+      void dpdForceAvx2(int n, const int* type0, const int* type1, int nt,
+                        bool uniform,
+                        const double* sigmaSq, const double* sigma,
+                        const double* cf,
+                        double* dx, double* dy, double* dz)
+      {
+         const __m256d one = _mm256_set1_pd(1.0);
+         __m256d c = _mm256_set1_pd(sigmaSq[0]);
+         __m256d s = _mm256_set1_pd(sigma[0]);
+         __m256d a = _mm256_set1_pd(cf[0]);
+         __m256d x, y, z, rsq, mask, f;
+         __m128i ij;
+         int k;
+         for (k = 0; k + 4 <= n; k += 4) {
+            if (!uniform) {
+               ij = pairIndex4(type0 + k, type1 + k, nt);
+               c = pairGather4(sigmaSq, ij);
+               s = pairGather4(sigma, ij);
+               a = pairGather4(cf, ij);
+            }
+            x = _mm256_loadu_pd(dx + k);
+            y = _mm256_loadu_pd(dy + k);
+            z = _mm256_loadu_pd(dz + k);
+            rsq = _mm256_mul_pd(x, x);
+            rsq = _mm256_fmadd_pd(y, y, rsq);
+            rsq = _mm256_fmadd_pd(z, z, rsq);
+            mask = _mm256_cmp_pd(rsq, c, _CMP_LT_OQ);
+            f = _mm256_div_pd(s, _mm256_sqrt_pd(rsq));
+            f = _mm256_mul_pd(a, _mm256_sub_pd(f, one));
+            f = _mm256_and_pd(f, mask);
+            _mm256_storeu_pd(dx + k, _mm256_mul_pd(x, f));
+            _mm256_storeu_pd(dy + k, _mm256_mul_pd(y, f));
+            _mm256_storeu_pd(dz + k, _mm256_mul_pd(z, f));
+         }
+         _mm256_zeroupper();
+         dpdForceScalar(k, n, type0, type1, nt, sigmaSq, sigma, cf, 
+                        dx, dy, dz);
+      }
+
+      /*
+      * AVX2 implementation of DpdPair::energyBlock (4 pairs per iteration).
+      */
+      __attribute__((target("avx2,fma")))
+      void dpdEnergyAvx2(int n, const int* type0, const int* type1, int nt,
+                         bool uniform,
+                         const double* sigmaSq, const double* sigma,
+                         const double* ce,
+                         const double* rsq, double* energy)
+      {
+         __m256d c = _mm256_set1_pd(sigmaSq[0]);
+         __m256d s = _mm256_set1_pd(sigma[0]);
+         __m256d a = _mm256_set1_pd(ce[0]);
+         __m256d r, mask, dr, e;
+         __m128i ij;
+         int k;
+         for (k = 0; k + 4 <= n; k += 4) {
+            if (!uniform) {
+               ij = pairIndex4(type0 + k, type1 + k, nt);
+               c = pairGather4(sigmaSq, ij);
+               s = pairGather4(sigma, ij);
+               a = pairGather4(ce, ij);
+            }
+            r = _mm256_loadu_pd(rsq + k);
+            mask = _mm256_cmp_pd(r, c, _CMP_LT_OQ);
+            dr = _mm256_sub_pd(_mm256_sqrt_pd(r), s);
+            e = _mm256_mul_pd(a, _mm256_mul_pd(dr, dr));
+            _mm256_storeu_pd(energy + k, _mm256_and_pd(e, mask));
+         }
+         _mm256_zeroupper();
+         dpdEnergyScalar(k, n, type0, type1, nt, sigmaSq, sigma, ce, 
+                         rsq, energy);
+      }
+
+      /*
+      * AVX-512 implementation of DpdPair::forceBlock (8 pairs per iteration).
+      *
+      * Parameter tables (nt*nt <= 16 elements) are held in registers.
+      */
+      __attribute__((target("avx512f")))
+      void dpdForceAvx512(int n, const int* type0, const int* type1, int nt,
+                          const double* sigmaSq, const double* sigma,
+                          const double* cf,
+                          double* dx, double* dy, double* dz)
+      {
+         const __m512d one = _mm512_set1_pd(1.0);
+         __m512d cLo, cHi, sLo, sHi, aLo, aHi;
+         pairTable8(sigmaSq, nt*nt, cLo, cHi);
+         pairTable8(sigma, nt*nt, sLo, sHi);
+         pairTable8(cf, nt*nt, aLo, aHi);
+         __m512i ij;
+         __m512d x, y, z, rsq, f;
+         __mmask8 mask;
+         int k;
+         for (k = 0; k + 8 <= n; k += 8) {
+            ij = pairIndex8(type0 + k, type1 + k, nt);
+            x = _mm512_loadu_pd(dx + k);
+            y = _mm512_loadu_pd(dy + k);
+            z = _mm512_loadu_pd(dz + k);
+            rsq = _mm512_mul_pd(x, x);
+            rsq = _mm512_fmadd_pd(y, y, rsq);
+            rsq = _mm512_fmadd_pd(z, z, rsq);
+            mask = _mm512_cmp_pd_mask(rsq, pairLookup8(cLo, cHi, ij),
+                                      _CMP_LT_OQ);
+            f = _mm512_div_pd(pairLookup8(sLo, sHi, ij), 
+                              pairSqrt8(rsq));
+            f = _mm512_maskz_mul_pd(mask, pairLookup8(aLo, aHi, ij), 
+                                    _mm512_sub_pd(f, one));
+            _mm512_storeu_pd(dx + k, _mm512_mul_pd(x, f));
+            _mm512_storeu_pd(dy + k, _mm512_mul_pd(y, f));
+            _mm512_storeu_pd(dz + k, _mm512_mul_pd(z, f));
+         }
+         _mm256_zeroupper();
+         dpdForceScalar(k, n, type0, type1, nt, sigmaSq, sigma, cf, 
+                        dx, dy, dz);
+      }
+
+      /*
+      * AVX-512 implementation of DpdPair::energyBlock (8 pairs per iteration).
+      */
+      __attribute__((target("avx512f")))
+      void dpdEnergyAvx512(int n, const int* type0, const int* type1, int nt,
+                           const double* sigmaSq, const double* sigma,
+                           const double* ce,
+                           const double* rsq, double* energy)
+      {
+         __m512d cLo, cHi, sLo, sHi, aLo, aHi;
+         pairTable8(sigmaSq, nt*nt, cLo, cHi);
+         pairTable8(sigma, nt*nt, sLo, sHi);
+         pairTable8(ce, nt*nt, aLo, aHi);
+         __m512i ij;
+         __m512d r, dr, e;
+         __mmask8 mask;
+         int k;
+         for (k = 0; k + 8 <= n; k += 8) {
+            ij = pairIndex8(type0 + k, type1 + k, nt);
+            r = _mm512_loadu_pd(rsq + k);
+            mask = _mm512_cmp_pd_mask(r, pairLookup8(cLo, cHi, ij),
+                                      _CMP_LT_OQ);
+            dr = _mm512_sub_pd(pairSqrt8(r), pairLookup8(sLo, sHi, ij));
+            e = _mm512_maskz_mul_pd(mask, pairLookup8(aLo, aHi, ij), 
+                                    _mm512_mul_pd(dr, dr));
+            _mm512_storeu_pd(energy + k, e);
+         }
+         _mm256_zeroupper();
+         dpdEnergyScalar(k, n, type0, type1, nt, sigmaSq, sigma, ce, 
+                         rsq, energy);
+      }
+
+      #endif // ifdef UTIL_SIMD_X86
+
+   }
+
+   /*
+   * Compute forces for a block of pairs.
+   */
+   void DpdPair::forceBlock(int n, const int* type0, const int* type1,
+                            double* dx, double* dy, double* dz) const
+   {
+      #ifdef UTIL_SIMD_X86
+      switch (Simd::level()) {
+         case Simd::Avx512:
+            dpdForceAvx512(n, type0, type1, MaxAtomType, sigmaSq_[0], 
+                           sigma_[0], cf_[0], dx, dy, dz);
+            return;
+         case Simd::Avx2:
+            dpdForceAvx2(n, type0, type1, MaxAtomType, nAtomType_ == 1,
+                         sigmaSq_[0], sigma_[0], cf_[0], dx, dy, dz);
+            return;
+         default:
+            break;
+      }
+      #endif
+      dpdForceScalar(0, n, type0, type1, MaxAtomType, sigmaSq_[0], 
+                     sigma_[0], cf_[0], dx, dy, dz);
+   }
+
+   /*
+   * Compute energies for a block of pairs.
+   */
+   void DpdPair::energyBlock(int n, const int* type0, const int* type1,
+                             const double* rsq, double* energy) const
+   {
+      #ifdef UTIL_SIMD_X86
+      switch (Simd::level()) {
+         case Simd::Avx512:
+            dpdEnergyAvx512(n, type0, type1, MaxAtomType, sigmaSq_[0], 
+                            sigma_[0], ce_[0], rsq, energy);
+            return;
+         case Simd::Avx2:
+            dpdEnergyAvx2(n, type0, type1, MaxAtomType, nAtomType_ == 1,
+                          sigmaSq_[0], sigma_[0], ce_[0], rsq, energy);
+            return;
+         default:
+            break;
+      }
+      #endif
+      dpdEnergyScalar(0, n, type0, type1, MaxAtomType, sigmaSq_[0], 
+                      sigma_[0], ce_[0], rsq, energy);
+   }
+
 } 
 #endif
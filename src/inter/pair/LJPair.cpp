@@ -10,6 +10,7 @@
 
 #include "LJPair.h"
 #include <util/mpi/MpiLoader.h>
+#include "pairSimd.h"
 
 #include <iostream>
 #include <cstring>
@@ -325,5 +326,298 @@ namespace Inter
       return value;
    }
 
+   namespace {
+
+      /*
+      * Portable implementation of LJPair::forceBlock, for pairs k >= begin.
+      *
+      * Parameter arrays are indexed by i*nt + j for atom types i and j.
+      */
+      void ljForceScalar(int begin, int n, 
+                         const int* type0, const int* type1, int nt,
+                         const double* cutoffSq, const double* sigmaSq,
+                         const double* eps48,
+                         double* dx, double* dy, double* dz)
+      {
+         double rsq, r2i, r6i, f;
+         int k, ij;
+         for (k = begin; k < n; ++k) {
+            ij  = type0[k]*nt + type1[k];
+            rsq = dx[k]*dx[k] + dy[k]*dy[k] + dz[k]*dz[k];
+            f = 0.0;
+            if (rsq < cutoffSq[ij]) {
+               r2i = 1.0/rsq;
+               r6i = sigmaSq[ij]*r2i;
+               r6i = r6i*r6i*r6i;
+               f = eps48[ij]*(r6i - 0.5)*r6i*r2i;
+            }
+            dx[k] *= f;
+            dy[k] *= f;
+            dz[k] *= f;
+         }
+      }
+
+      /*
+      * Portable implementation of LJPair::energyBlock, for pairs k >= begin.
+      */
+      void ljEnergyScalar(int begin, int n, 
+                          const int* type0, const int* type1, int nt,
+                          const double* cutoffSq, const double* sigmaSq,
+                          const double* epsilon, const double* ljShift,
+                          const double* rsq, double* energy)
+      {
+         double r, r6i, e;
+         int k, ij;
+         for (k = begin; k < n; ++k) {
+            ij = type0[k]*nt + type1[k];
+            e = 0.0;
+            if (rsq[k] < cutoffSq[ij]) {
+               r = rsq[k];
+               if (r < 0.6*sigmaSq[ij]) {
+                  r = 0.6*sigmaSq[ij];
+               }
+               r6i = sigmaSq[ij]/r;
+               r6i = r6i*r6i*r6i;
+               e = 4.0*epsilon[ij]*(r6i*r6i - r6i) + ljShift[ij];
+            }
+            energy[k] = e;
+         }
+      }
+
+      #ifdef UTIL_SIMD_X86
+
+      /*
+      * AVX2 implementation of LJPair::forceBlock (4 pairs per iteration).
+      *
+      * If uniform is true, all atom types are 0 and parameters are
+      * broadcast rather than gathered.
+      */
+      __attribute__((target("avx2,fma")))
+      void ljForceAvx2(int n, const int* type0, const int* type1, int nt,
+                       bool uniform,
+                       const double* cutoffSq, const double* sigmaSq,
+                       const double* eps48,
+                       double* dx, double* dy, double* dz)
+      {
+         const __m256d one  = _mm256_set1_pd(1.0);
+         const __m256d half = _mm256_set1_pd(0.5);
+         __m256d c = _mm256_set1_pd(cutoffSq[0]);
+         __m256d s = _mm256_set1_pd(sigmaSq[0]);
+         __m256d e = _mm256_set1_pd(eps48[0]);
+         __m256d x, y, z, rsq, mask, r2i, r6i, f;
+         __m128i ij;
+         int k;
+         for (k = 0; k + 4 <= n; k += 4) {
+            if (!uniform) {
+               ij = pairIndex4(type0 + k, type1 + k, nt);
+               c = pairGather4(cutoffSq, ij);
+               s = pairGather4(sigmaSq, ij);
+               e = pairGather4(eps48, ij);
+            }
+            x = _mm256_loadu_pd(dx + k);
+            y = _mm256_loadu_pd(dy + k);
+            z = _mm256_loadu_pd(dz + k);
+            rsq = _mm256_mul_pd(x, x);
+            rsq = _mm256_fmadd_pd(y, y, rsq);
+            rsq = _mm256_fmadd_pd(z, z, rsq);
+            mask = _mm256_cmp_pd(rsq, c, _CMP_LT_OQ);
+            r2i = _mm256_div_pd(one, rsq);
+            r6i = _mm256_mul_pd(s, r2i);
+            r6i = _mm256_mul_pd(_mm256_mul_pd(r6i, r6i), r6i);
+            f = _mm256_mul_pd(e, _mm256_sub_pd(r6i, half));
+            f = _mm256_mul_pd(_mm256_mul_pd(f, r6i), r2i);
+            f = _mm256_and_pd(f, mask);
+            _mm256_storeu_pd(dx + k, _mm256_mul_pd(x, f));
+            _mm256_storeu_pd(dy + k, _mm256_mul_pd(y, f));
+            _mm256_storeu_pd(dz + k, _mm256_mul_pd(z, f));
+         }
+         _mm256_zeroupper();
+         ljForceScalar(k, n, type0, type1, nt, cutoffSq, sigmaSq, eps48,
+                       dx, dy, dz);
+      }
+
+      /*
+      * AVX2 implementation of LJPair::energyBlock (4 pairs per iteration).
+      */
+      __attribute__((target("avx2,fma")))
+      void ljEnergyAvx2(int n, const int* type0, const int* type1, int nt,
+                        bool uniform,
+                        const double* cutoffSq, const double* sigmaSq,
+                        const double* epsilon, const double* ljShift,
+                        const double* rsq, double* energy)
+      {
+         const __m256d four = _mm256_set1_pd(4.0);
+         const __m256d pmin = _mm256_set1_pd(0.6);
+         __m256d c  = _mm256_set1_pd(cutoffSq[0]);
+         __m256d s  = _mm256_set1_pd(sigmaSq[0]);
+         __m256d ep = _mm256_set1_pd(epsilon[0]);
+         __m256d sh = _mm256_set1_pd(ljShift[0]);
+         __m256d r, mask, r6i, e;
+         __m128i ij;
+         int k;
+         for (k = 0; k + 4 <= n; k += 4) {
+            if (!uniform) {
+               ij = pairIndex4(type0 + k, type1 + k, nt);
+               c  = pairGather4(cutoffSq, ij);
+               s  = pairGather4(sigmaSq, ij);
+               ep = pairGather4(epsilon, ij);
+               sh = pairGather4(ljShift, ij);
+            }
+            r = _mm256_loadu_pd(rsq + k);
+            mask = _mm256_cmp_pd(r, c, _CMP_LT_OQ);
+            r = _mm256_max_pd(r, _mm256_mul_pd(pmin, s));
+            r6i = _mm256_div_pd(s, r);
+            r6i = _mm256_mul_pd(_mm256_mul_pd(r6i, r6i), r6i);
+            e = _mm256_mul_pd(_mm256_mul_pd(four, ep),
+                              _mm256_fmsub_pd(r6i, r6i, r6i));
+            e = _mm256_add_pd(e, sh);
+            _mm256_storeu_pd(energy + k, _mm256_and_pd(e, mask));
+         }
+         _mm256_zeroupper();
+         ljEnergyScalar(k, n, type0, type1, nt, cutoffSq, sigmaSq, 
+                        epsilon, ljShift, rsq, energy);
+      }
+
+      /*
+      * AVX-512 implementation of LJPair::forceBlock (8 pairs per iteration).
+      *
+      * Parameter tables (nt*nt <= 16 elements) are held in registers.
+      */
+      __attribute__((target("avx512f")))
+      void ljForceAvx512(int n, const int* type0, const int* type1, int nt,
+                         const double* cutoffSq, const double* sigmaSq,
+                         const double* eps48,
+                         double* dx, double* dy, double* dz)
+      {
+         const __m512d one  = _mm512_set1_pd(1.0);
+         const __m512d half = _mm512_set1_pd(0.5);
+         __m512d cLo, cHi, sLo, sHi, eLo, eHi;
+         pairTable8(cutoffSq, nt*nt, cLo, cHi);
+         pairTable8(sigmaSq, nt*nt, sLo, sHi);
+         pairTable8(eps48, nt*nt, eLo, eHi);
+         __m512i ij;
+         __m512d x, y, z, rsq, r2i, r6i, f;
+         __mmask8 mask;
+         int k;
+         for (k = 0; k + 8 <= n; k += 8) {
+            ij = pairIndex8(type0 + k, type1 + k, nt);
+            x = _mm512_loadu_pd(dx + k);
+            y = _mm512_loadu_pd(dy + k);
+            z = _mm512_loadu_pd(dz + k);
+            rsq = _mm512_mul_pd(x, x);
+            rsq = _mm512_fmadd_pd(y, y, rsq);
+            rsq = _mm512_fmadd_pd(z, z, rsq);
+            mask = _mm512_cmp_pd_mask(rsq, pairLookup8(cLo, cHi, ij), 
+                                      _CMP_LT_OQ);
+            r2i = _mm512_div_pd(one, rsq);
+            r6i = _mm512_mul_pd(pairLookup8(sLo, sHi, ij), r2i);
+            r6i = _mm512_mul_pd(_mm512_mul_pd(r6i, r6i), r6i);
+            f = _mm512_mul_pd(pairLookup8(eLo, eHi, ij), 
+                              _mm512_sub_pd(r6i, half));
+            f = _mm512_mul_pd(f, r6i);
+            f = _mm512_maskz_mul_pd(mask, f, r2i);
+            _mm512_storeu_pd(dx + k, _mm512_mul_pd(x, f));
+            _mm512_storeu_pd(dy + k, _mm512_mul_pd(y, f));
+            _mm512_storeu_pd(dz + k, _mm512_mul_pd(z, f));
+         }
+         _mm256_zeroupper();
+         ljForceScalar(k, n, type0, type1, nt, cutoffSq, sigmaSq, eps48,
+                       dx, dy, dz);
+      }
+
+      /*
+      * AVX-512 implementation of LJPair::energyBlock (8 pairs per iteration).
+      */
+      __attribute__((target("avx512f")))
+      void ljEnergyAvx512(int n, const int* type0, const int* type1, int nt,
+                          const double* cutoffSq, const double* sigmaSq,
+                          const double* epsilon, const double* ljShift,
+                          const double* rsq, double* energy)
+      {
+         const __m512d four = _mm512_set1_pd(4.0);
+         const __m512d pmin = _mm512_set1_pd(0.6);
+         __m512d cLo, cHi, sLo, sHi, epLo, epHi, shLo, shHi;
+         pairTable8(cutoffSq, nt*nt, cLo, cHi);
+         pairTable8(sigmaSq, nt*nt, sLo, sHi);
+         pairTable8(epsilon, nt*nt, epLo, epHi);
+         pairTable8(ljShift, nt*nt, shLo, shHi);
+         __m512i ij;
+         __m512d r, s, r6i, e;
+         __mmask8 mask;
+         int k;
+         for (k = 0; k + 8 <= n; k += 8) {
+            ij = pairIndex8(type0 + k, type1 + k, nt);
+            r = _mm512_loadu_pd(rsq + k);
+            mask = _mm512_cmp_pd_mask(r, pairLookup8(cLo, cHi, ij),
+                                      _CMP_LT_OQ);
+            s = pairLookup8(sLo, sHi, ij);
+            r = pairMax8(r, _mm512_mul_pd(pmin, s));
+            r6i = _mm512_div_pd(s, r);
+            r6i = _mm512_mul_pd(_mm512_mul_pd(r6i, r6i), r6i);
+            e = _mm512_mul_pd(_mm512_mul_pd(four, 
+                              pairLookup8(epLo, epHi, ij)),
+                              _mm512_fmsub_pd(r6i, r6i, r6i));
+            e = _mm512_maskz_add_pd(mask, e, pairLookup8(shLo, shHi, ij));
+            _mm512_storeu_pd(energy + k, e);
+         }
+         _mm256_zeroupper();
+         ljEnergyScalar(k, n, type0, type1, nt, cutoffSq, sigmaSq, 
+                        epsilon, ljShift, rsq, energy);
+      }
+
+      #endif // ifdef UTIL_SIMD_X86
+
+   }
+
+   /*
+   * Compute forces for a block of pairs.
+   */
+   void LJPair::forceBlock(int n, const int* type0, const int* type1,
+                           double* dx, double* dy, double* dz) const
+   {
+      #ifdef UTIL_SIMD_X86
+      switch (Simd::level()) {
+         case Simd::Avx512:
+            ljForceAvx512(n, type0, type1, MaxAtomType, cutoffSq_[0], 
+                          sigmaSq_[0], eps48_[0], dx, dy, dz);
+            return;
+         case Simd::Avx2:
+            ljForceAvx2(n, type0, type1, MaxAtomType, nAtomType_ == 1,
+                        cutoffSq_[0], sigmaSq_[0], eps48_[0], dx, dy, dz);
+            return;
+         default:
+            break;
+      }
+      #endif
+      ljForceScalar(0, n, type0, type1, MaxAtomType, cutoffSq_[0], 
+                    sigmaSq_[0], eps48_[0], dx, dy, dz);
+   }
+
+   /*
+   * Compute energies for a block of pairs.
+   */
+   void LJPair::energyBlock(int n, const int* type0, const int* type1,
+                            const double* rsq, double* energy) const
+   {
+      #ifdef UTIL_SIMD_X86
+      switch (Simd::level()) {
+         case Simd::Avx512:
+            ljEnergyAvx512(n, type0, type1, MaxAtomType, cutoffSq_[0], 
+                           sigmaSq_[0], epsilon_[0], ljShift_[0], 
+                           rsq, energy);
+            return;
+         case Simd::Avx2:
+            ljEnergyAvx2(n, type0, type1, MaxAtomType, nAtomType_ == 1,
+                         cutoffSq_[0], sigmaSq_[0], epsilon_[0], 
+                         ljShift_[0], rsq, energy);
+            return;
+         default:
+            break;
+      }
+      #endif
+      ljEnergyScalar(0, n, type0, type1, MaxAtomType, cutoffSq_[0], 
+                     sigmaSq_[0], epsilon_[0], ljShift_[0], rsq, energy);
+   }
+
 } 
 #endif
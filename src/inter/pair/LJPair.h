@@ -152,7 +152,42 @@ namespace Inter
       * \return    force divided by distance 
       */
       double forceOverR(double rsq, int i, int j) const;
-  
+
+      /**
+      * Compute pair forces for a block of pairs.
+      *
+      * On entry, dx[k], dy[k] and dz[k] are the components of the
+      * separation vector for pair k, for 0 <= k < n, and type0[k] and
+      * type1[k] are the types of the two atoms. On return, dx, dy and
+      * dz contain the components of the force on the first atom of each
+      * pair, which are zero for pairs with rsq >= cutoffSq. Unlike
+      * forceOverR(), this function may thus be applied to pairs outside
+      * the cutoff. Uses AVX-512 or AVX2 instructions if available.
+      *
+      * \param n     number of pairs
+      * \param type0 types of first atoms
+      * \param type1 types of second atoms
+      * \param dx    x components of separations (in) and forces (out)
+      * \param dy    y components of separations (in) and forces (out)
+      * \param dz    z components of separations (in) and forces (out)
+      */
+      void forceBlock(int n, const int* type0, const int* type1,
+                      double* dx, double* dy, double* dz) const;
+
+      /**
+      * Compute pair energies for a block of pairs.
+      *
+      * Sets energy[k] = energy(rsq[k], type0[k], type1[k]) for 0 <= k < n.
+      *
+      * \param n      number of pairs
+      * \param type0  types of first atoms
+      * \param type1  types of second atoms
+      * \param rsq    squared separations
+      * \param energy pair energies (output)
+      */
+      void energyBlock(int n, const int* type0, const int* type1,
+                       const double* rsq, double* energy) const;
+
       /**
       * Get square of cutoff distance for specific type pair.
       *
@@ -0,0 +1,607 @@
+#ifndef INTER_TABULATED_PAIR_CPP
+#define INTER_TABULATED_PAIR_CPP
+
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2012, David Morse (morse012@umn.edu)
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "TabulatedPair.h"
+#include <inter/pair/LJPair.h>
+#include <inter/pair/WcaPair.h>
+#include <inter/pair/DpdPair.h>
+#include <util/mpi/MpiLoader.h>
+#include <util/misc/Log.h>
+
+#include <fstream>
+#include <vector>
+#include <algorithm>
+
+namespace Inter
+{
+
+   using namespace Util;
+
+   /*
+   * Constructor.
+   */
+   TabulatedPair::TabulatedPair()
+    : table_(),
+      rMin_(0.0),
+      rsqMin_(0.0),
+      maxPairCutoff_(0.0),
+      nGrid_(0),
+      order_(3),
+      nAtomType_(0),
+      source_(),
+      tableFile_(),
+      sourcePtr_(0),
+      isInitialized_(false)
+   {  setClassName("TabulatedPair"); }
+
+   /*
+   * Copy constructor.
+   */
+   TabulatedPair::TabulatedPair(const TabulatedPair& other)
+    : table_(other.table_),
+      rMin_(other.rMin_),
+      rsqMin_(other.rsqMin_),
+      maxPairCutoff_(other.maxPairCutoff_),
+      nGrid_(other.nGrid_),
+      order_(other.order_),
+      nAtomType_(other.nAtomType_),
+      source_(other.source_),
+      tableFile_(other.tableFile_),
+      sourcePtr_(0),
+      isInitialized_(other.isInitialized_)
+   {
+      int i, j;
+      for (i = 0; i < nAtomType_; ++i) {
+         for (j = 0; j < nAtomType_; ++j) {
+            cutoff_[i][j]   = other.cutoff_[i][j];
+            cutoffSq_[i][j] = other.cutoffSq_[i][j];
+            dRsqInv_[i][j]  = other.dRsqInv_[i][j];
+            offset_[i][j]   = other.offset_[i][j];
+         }
+      }
+   }
+
+   /*
+   * Destructor.
+   */
+   TabulatedPair::~TabulatedPair()
+   {
+      if (sourcePtr_) {
+         delete sourcePtr_;
+      }
+   }
+
+   /*
+   * Assignment operator.
+   */
+   TabulatedPair& TabulatedPair::operator = (const TabulatedPair& other)
+   {
+      if (this == &other) return *this;
+      if (table_.isAllocated()) {
+         table_.deallocate();
+      }
+      if (other.table_.isAllocated()) {
+         table_.allocate(other.table_.capacity());
+         for (int k = 0; k < table_.capacity(); ++k) {
+            table_[k] = other.table_[k];
+         }
+      }
+      rMin_          = other.rMin_;
+      rsqMin_        = other.rsqMin_;
+      maxPairCutoff_ = other.maxPairCutoff_;
+      nGrid_         = other.nGrid_;
+      order_         = other.order_;
+      nAtomType_     = other.nAtomType_;
+      source_        = other.source_;
+      tableFile_     = other.tableFile_;
+      isInitialized_ = other.isInitialized_;
+      int i, j;
+      for (i = 0; i < nAtomType_; ++i) {
+         for (j = 0; j < nAtomType_; ++j) {
+            cutoff_[i][j]   = other.cutoff_[i][j];
+            cutoffSq_[i][j] = other.cutoffSq_[i][j];
+            dRsqInv_[i][j]  = other.dRsqInv_[i][j];
+            offset_[i][j]   = other.offset_[i][j];
+         }
+      }
+      return *this;
+   }
+
+   /*
+   * Set nAtomType
+   */
+   void TabulatedPair::setNAtomType(int nAtomType)
+   {
+      if (nAtomType <= 0) {
+         UTIL_THROW("nAtomType <= 0");
+      }
+      if (nAtomType > MaxAtomType) {
+         UTIL_THROW("nAtomType > TabulatedPair::MaxAtomType");
+      }
+      nAtomType_ = nAtomType;
+   }
+
+   /*
+   * Set grid and interpolation parameters.
+   */
+   void TabulatedPair::setGrid(double rMin, int nGrid, int order)
+   {
+      if (rMin <= 0.0) {
+         UTIL_THROW("rMin must be positive");
+      }
+      if (nGrid < 2) {
+         UTIL_THROW("nGrid < 2");
+      }
+      if (order != 1 && order != 3) {
+         UTIL_THROW("Invalid order: must be 1 or 3");
+      }
+      rMin_ = rMin;
+      rsqMin_ = rMin*rMin;
+      nGrid_ = nGrid;
+      order_ = order;
+   }
+
+   /*
+   * Read grid parameters, then read or generate tables.
+   */
+   void TabulatedPair::readParameters(std::istream &in)
+   {
+      if (nAtomType_ == 0) {
+         UTIL_THROW("nAtomType must be set before readParam");
+      }
+      read<double>(in, "rMin", rMin_);
+      read<int>(in, "nGrid", nGrid_);
+      read<int>(in, "order", order_);
+      setGrid(rMin_, nGrid_, order_);
+
+      read<std::string>(in, "source", source_);
+      if (source_ == "file") {
+         read<std::string>(in, "tableFile", tableFile_);
+
+         // Read the table file on the ioProcessor, if any
+         #ifdef UTIL_MPI
+         if (!hasIoCommunicator() || isIoProcessor()) {
+         #endif
+            std::ifstream file(tableFile_.c_str());
+            if (!file.is_open()) {
+               Log::file() << "tableFile = " << tableFile_ << std::endl;
+               UTIL_THROW("Cannot open pair table file");
+            }
+            readTable(file);
+            file.close();
+         #ifdef UTIL_MPI
+         } else {
+            allocateTable();
+         }
+
+         // Broadcast tables to all other processors
+         if (hasIoCommunicator()) {
+            MPI::Intracomm& comm = ioCommunicator();
+            int n = MaxAtomType*MaxAtomType;
+            bcast<double>(comm, maxPairCutoff_, 0);
+            bcast<double>(comm, cutoff_[0], n, 0);
+            bcast<double>(comm, cutoffSq_[0], n, 0);
+            bcast<double>(comm, dRsqInv_[0], n, 0);
+            bcast<int>(comm, offset_[0], n, 0);
+            bcast<double>(comm, table_, table_.capacity(), 0);
+            isInitialized_ = true;
+         }
+         #endif
+
+      } else
+      if (source_ == "LJPair") {
+         readSource<LJPair>(in);
+      } else
+      if (source_ == "WcaPair") {
+         readSource<WcaPair>(in);
+      } else
+      if (source_ == "DpdPair") {
+         readSource<DpdPair>(in);
+      } else {
+         UTIL_THROW("Unknown source: must be file, LJPair, WcaPair or DpdPair");
+      }
+   }
+
+   /*
+   * Create a source interaction, read its parameters, and tabulate.
+   */
+   template <class Interaction>
+   void TabulatedPair::readSource(std::istream& in)
+   {
+      if (sourcePtr_) {
+         delete sourcePtr_;
+      }
+      Interaction* ptr = new Interaction;
+      sourcePtr_ = ptr;
+      ptr->setNAtomType(nAtomType_);
+      readParamComposite(in, *ptr);
+      setTable(*ptr);
+   }
+
+   /*
+   * Create a source interaction and load its parameters.
+   *
+   * The tables are loaded separately, and are not recomputed.
+   */
+   template <class Interaction>
+   void TabulatedPair::loadSource(Serializable::IArchive& ar)
+   {
+      if (sourcePtr_) {
+         delete sourcePtr_;
+      }
+      Interaction* ptr = new Interaction;
+      sourcePtr_ = ptr;
+      loadParamComposite(ar, *ptr);
+   }
+
+   /*
+   * Load internal state from an archive.
+   */
+   void TabulatedPair::loadParameters(Serializable::IArchive &ar)
+   {
+      MpiLoader<Serializable::IArchive> loader(*this, ar);
+      loader.load(nAtomType_);
+      if (nAtomType_ <= 0) {
+         UTIL_THROW( "nAtomType must be positive");
+      }
+      loadParameter<double>(ar, "rMin", rMin_);
+      loadParameter<int>(ar, "nGrid", nGrid_);
+      loadParameter<int>(ar, "order", order_);
+      setGrid(rMin_, nGrid_, order_);
+      loadParameter<std::string>(ar, "source", source_);
+      if (source_ == "file") {
+         loadParameter<std::string>(ar, "tableFile", tableFile_);
+      } else
+      if (source_ == "LJPair") {
+         loadSource<LJPair>(ar);
+      } else
+      if (source_ == "WcaPair") {
+         loadSource<WcaPair>(ar);
+      } else
+      if (source_ == "DpdPair") {
+         loadSource<DpdPair>(ar);
+      } 
+      allocateTable();
+
+      loader.load(maxPairCutoff_);
+      loader.load(cutoff_[0], nAtomType_, nAtomType_, MaxAtomType);
+      loader.load(cutoffSq_[0], nAtomType_, nAtomType_, MaxAtomType);
+      loader.load(dRsqInv_[0], nAtomType_, nAtomType_, MaxAtomType);
+      loader.load(offset_[0], nAtomType_, nAtomType_, MaxAtomType);
+      loader.load(table_, table_.capacity());
+      isInitialized_ = true;
+   }
+
+   /*
+   * Save internal state to an archive.
+   */
+   void TabulatedPair::save(Serializable::OArchive &ar)
+   {
+      ar << nAtomType_;
+      ar << rMin_;
+      ar << nGrid_;
+      ar << order_;
+      ar << source_;
+      if (source_ == "file") {
+         ar << tableFile_;
+      } else 
+      if (sourcePtr_) {
+         sourcePtr_->save(ar);
+      }
+      ar << maxPairCutoff_;
+      ar.pack(cutoff_[0], nAtomType_, nAtomType_, MaxAtomType);
+      ar.pack(cutoffSq_[0], nAtomType_, nAtomType_, MaxAtomType);
+      ar.pack(dRsqInv_[0], nAtomType_, nAtomType_, MaxAtomType);
+      ar.pack(offset_[0], nAtomType_, nAtomType_, MaxAtomType);
+      ar << table_;
+   }
+
+   /*
+   * Allocate table_ and set offset_ for all type pairs.
+   */
+   void TabulatedPair::allocateTable()
+   {
+      int nInterval = nGrid_ - 1;
+      int nPair = nAtomType_*(nAtomType_ + 1)/2;
+      if (table_.isAllocated()) {
+         table_.deallocate();
+      }
+      table_.allocate(NCoeff*nPair*nInterval);
+      int i, j;
+      int p = 0;
+      for (i = 0; i < nAtomType_; ++i) {
+         for (j = i; j < nAtomType_; ++j) {
+            offset_[i][j] = p*nInterval;
+            offset_[j][i] = p*nInterval;
+            ++p;
+         }
+      }
+   }
+
+   /*
+   * Read tables from a file, resample onto the rsq grid.
+   */
+   void TabulatedPair::readTable(std::istream& in)
+   {
+      if (nAtomType_ <= 0) {
+         UTIL_THROW("nAtomType must be set before readTable");
+      }
+      if (nGrid_ < 2) {
+         UTIL_THROW("Grid must be set before readTable");
+      }
+      allocateTable();
+
+      DArray<double> energy;
+      DArray<double> force;
+      energy.allocate(nGrid_);
+      force.allocate(nGrid_);
+
+      bool isRead[MaxAtomType][MaxAtomType];
+      int i, j, k, m, n, nPair, p;
+      for (i = 0; i < nAtomType_; ++i) {
+         for (j = 0; j < nAtomType_; ++j) {
+            isRead[i][j] = false;
+         }
+      }
+
+      std::vector<double> r, v, f;
+      double rsq, dRsq, x, h, s, s2, s3;
+      maxPairCutoff_ = 0.0;
+      nPair = nAtomType_*(nAtomType_ + 1)/2;
+      for (p = 0; p < nPair; ++p) {
+
+         // Read block for one type pair
+         in >> i >> j >> n;
+         if (in.fail()) {
+            UTIL_THROW("Error reading pair table header");
+         }
+         if (i > j) {
+            std::swap(i, j);
+         }
+         if (i < 0 || j >= nAtomType_) {
+            UTIL_THROW("Invalid atom type index in pair table");
+         }
+         if (isRead[i][j]) {
+            UTIL_THROW("Repeated type pair in pair table");
+         }
+         if (n < 2) {
+            UTIL_THROW("Fewer than 2 rows in pair table");
+         }
+         isRead[i][j] = true;
+         r.resize(n);
+         v.resize(n);
+         f.resize(n);
+         for (m = 0; m < n; ++m) {
+            in >> r[m] >> v[m] >> f[m];
+            if (m > 0 && r[m] <= r[m-1]) {
+               UTIL_THROW("Separations in pair table are not increasing");
+            }
+         }
+         if (in.fail()) {
+            UTIL_THROW("Error reading pair table");
+         }
+         if (r[0] > rMin_*(1.0 + 1.0E-10)) {
+            UTIL_THROW("First separation in pair table > rMin");
+         }
+         if (r[n-1] <= rMin_) {
+            UTIL_THROW("Last separation in pair table <= rMin");
+         }
+         cutoff_[i][j] = r[n-1];
+         cutoffSq_[i][j] = r[n-1]*r[n-1];
+         if (cutoff_[i][j] > maxPairCutoff_) {
+            maxPairCutoff_ = cutoff_[i][j];
+         }
+
+         // Interpolate onto uniform grid in rsq. Energy is interpolated
+         // by a cubic Hermite polynomial in r with derivative -force, and
+         // force by a linear function of r.
+         dRsq = (cutoffSq_[i][j] - rsqMin_)/double(nGrid_ - 1);
+         m = 0;
+         for (k = 0; k < nGrid_; ++k) {
+            rsq = rsqMin_ + k*dRsq;
+            x = (k == nGrid_ - 1) ? r[n-1] : sqrt(rsq);
+            while (m < n - 2 && x > r[m+1]) {
+               ++m;
+            }
+            if (x < r[m]) {
+               x = r[m];
+            }
+            h = r[m+1] - r[m];
+            s = (x - r[m])/h;
+            s2 = s*s;
+            s3 = s2*s;
+            energy[k] = (2.0*s3 - 3.0*s2 + 1.0)*v[m]
+                      - (s3 - 2.0*s2 + s)*h*f[m]
+                      + (-2.0*s3 + 3.0*s2)*v[m+1]
+                      - (s3 - s2)*h*f[m+1];
+            force[k] = ((1.0 - s)*f[m] + s*f[m+1])/x;
+         }
+         setCoefficients(i, j, energy, force);
+      }
+      isInitialized_ = true;
+   }
+
+   /*
+   * Compute interpolation coefficients for one type pair.
+   */
+   void TabulatedPair::setCoefficients(int i, int j,
+                                       const DArray<double>& energy,
+                                       const DArray<double>& force)
+   {
+      const int nInterval = nGrid_ - 1;
+      double dRsq = (cutoffSq_[i][j] - rsqMin_)/double(nInterval);
+      dRsqInv_[i][j] = 1.0/dRsq;
+      dRsqInv_[j][i] = dRsqInv_[i][j];
+      cutoff_[j][i] = cutoff_[i][j];
+      cutoffSq_[j][i] = cutoffSq_[i][j];
+
+      double* c;
+      double e0, e1, m0, m1, f0, f1, d0, d1;
+      int k;
+
+      // Second derivatives of a clamped cubic spline of the force, with
+      // respect to t = (rsq - rsq_k)/dRsq, by the tridiagonal algorithm.
+      // End slopes are estimated by one-sided finite differences.
+      DArray<double> d;
+      DArray<double> w;
+      d.allocate(nGrid_);
+      w.allocate(nGrid_);
+      for (k = 0; k < nGrid_; ++k) {
+         d[k] = 0.0;
+      }
+      if (order_ == 3) {
+         const int n = nInterval;
+         double s0, s1, m;
+         if (nGrid_ >= 4) {
+            s0 = (-11.0*force[0] + 18.0*force[1] 
+                  - 9.0*force[2] + 2.0*force[3])/6.0;
+            s1 = (11.0*force[n] - 18.0*force[n-1] 
+                  + 9.0*force[n-2] - 2.0*force[n-3])/6.0;
+         } else {
+            s0 = force[1] - force[0];
+            s1 = force[n] - force[n-1];
+         }
+         w[0] = 0.5;
+         d[0] = 3.0*(force[1] - force[0] - s0);
+         for (k = 1; k < n; ++k) {
+            m = 4.0 - w[k-1];
+            w[k] = 1.0/m;
+            d[k] = (6.0*(force[k+1] - 2.0*force[k] + force[k-1]) - d[k-1])/m;
+         }
+         m = 2.0 - w[n-1];
+         d[n] = (6.0*(s1 - force[n] + force[n-1]) - d[n-1])/m;
+         for (k = n - 1; k >= 0; --k) {
+            d[k] -= w[k]*d[k+1];
+         }
+      }
+
+      for (k = 0; k < nInterval; ++k) {
+         c = &table_[NCoeff*(offset_[i][j] + k)];
+         e0 = energy[k];
+         e1 = energy[k+1];
+         f0 = force[k];
+         f1 = force[k+1];
+         if (order_ == 3) {
+
+            // Hermite cubic for energy, with dE/dt = -0.5*forceOverR*dRsq
+            m0 = -0.5*f0*dRsq;
+            m1 = -0.5*f1*dRsq;
+            c[0] = e0;
+            c[1] = m0;
+            c[2] = 3.0*(e1 - e0) - 2.0*m0 - m1;
+            c[3] = 2.0*(e0 - e1) + m0 + m1;
+
+            // Cubic spline for forceOverR
+            d0 = d[k];
+            d1 = d[k+1];
+            c[4] = f0;
+            c[5] = f1 - f0 - (2.0*d0 + d1)/6.0;
+            c[6] = 0.5*d0;
+            c[7] = (d1 - d0)/6.0;
+
+         } else {
+            c[0] = e0;
+            c[1] = e1 - e0;
+            c[2] = 0.0;
+            c[3] = 0.0;
+            c[4] = f0;
+            c[5] = f1 - f0;
+            c[6] = 0.0;
+            c[7] = 0.0;
+         }
+      }
+   }
+
+   /*
+   * Compute forces for a block of pairs.
+   */
+   void TabulatedPair::forceBlock(int n, const int* type0, const int* type1,
+                                  double* dx, double* dy, double* dz) const
+   {
+      double rsq, f;
+      int k, i, j;
+      for (k = 0; k < n; ++k) {
+         i = type0[k];
+         j = type1[k];
+         rsq = dx[k]*dx[k] + dy[k]*dy[k] + dz[k]*dz[k];
+         f = 0.0;
+         if (rsq < cutoffSq_[i][j]) {
+            f = forceOverR(rsq, i, j);
+         }
+         dx[k] *= f;
+         dy[k] *= f;
+         dz[k] *= f;
+      }
+   }
+
+   /*
+   * Compute energies for a block of pairs.
+   */
+   void TabulatedPair::energyBlock(int n, const int* type0, const int* type1,
+                                   const double* rsq, double* energy) const
+   {
+      for (int k = 0; k < n; ++k) {
+         energy[k] = TabulatedPair::energy(rsq[k], type0[k], type1[k]);
+      }
+   }
+
+   /*
+   * Get cutoff distance for a type pair.
+   */
+   double TabulatedPair::cutoff(int i, int j) const
+   {
+      assert(i >= 0 && i < nAtomType_);
+      assert(j >= 0 && j < nAtomType_);
+      return cutoff_[i][j];
+   }
+
+   /*
+   * Get minimum tabulated separation.
+   */
+   double TabulatedPair::rMin() const
+   {  return rMin_; }
+
+   /*
+   * Get number of grid points per type pair.
+   */
+   int TabulatedPair::nGrid() const
+   {  return nGrid_; }
+
+   /*
+   * Get interpolation order.
+   */
+   int TabulatedPair::order() const
+   {  return order_; }
+
+   /*
+   * Get maximum of pair cutoff distance, for all atom type pairs.
+   */
+   double TabulatedPair::maxPairCutoff() const
+   { return maxPairCutoff_; }
+
+   /*
+   * Modify a parameter, identified by a string (not supported).
+   */
+   void TabulatedPair::set(std::string name, int i, int j, double value)
+   {  UTIL_THROW("Unrecognized parameter name"); }
+
+   /*
+   * Get a parameter value, identified by a string.
+   */
+   double TabulatedPair::get(std::string name, int i, int j) const
+   {
+      if (name != "cutoff") {
+         UTIL_THROW("Unrecognized parameter name");
+      }
+      return cutoff_[i][j];
+   }
+
+}
+#endif
@@ -0,0 +1,463 @@
+#ifndef INTER_TABULATED_PAIR_H
+#define INTER_TABULATED_PAIR_H
+
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2012, David Morse (morse012@umn.edu)
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <util/param/ParamComposite.h>
+#include <util/containers/DArray.h>
+#include <util/global.h>
+
+#include <string>
+#include <math.h>
+
+namespace Inter
+{
+
+   using namespace Util;
+
+   /**
+   * Pair potential interpolated from tables of energy and force.
+   *
+   * Values of the energy and of the ratio forceOverR of force to
+   * separation are tabulated for each pair of atom types on a uniform
+   * grid of nGrid values of the squared separation rsq, between rMin^2
+   * and the cutoff^2 for that type pair, and are interpolated linearly
+   * (order 1) or with cubic polynomials (order 3). Tables may be read
+   * from a file, or generated from another pair interaction.
+   *
+   * \sa \ref inter_pair_TabulatedPair_page
+   * \sa \ref inter_pair_interface_page
+   * \sa \ref inter_pair_page
+   *
+   * \ingroup Inter_Pair_Module
+   */
+   class TabulatedPair : public ParamComposite
+   {
+
+   public:
+
+      /**
+      * Constructor.
+      */
+      TabulatedPair();
+
+      /**
+      * Copy constructor.
+      */
+      TabulatedPair(const TabulatedPair& other);
+
+      /**
+      * Destructor.
+      */
+      virtual ~TabulatedPair();
+
+      /**
+      * Assignment.
+      */
+      TabulatedPair& operator = (const TabulatedPair& other);
+
+      /// \name Mutators
+      //@{
+
+      /**
+      * Set nAtomType value.
+      *
+      * \param nAtomType number of atom types.
+      */
+      void setNAtomType(int nAtomType);
+
+      /**
+      * Read table parameters, and read or generate the tables.
+      *
+      * \pre nAtomType must be set, by calling setNAtomType().
+      *
+      * \param in  input stream
+      */
+      void readParameters(std::istream &in);
+
+      /**
+      * Load internal state from an archive.
+      *
+      * \param ar input/loading archive
+      */
+      virtual void loadParameters(Serializable::IArchive &ar);
+
+      /**
+      * Save internal state to an archive.
+      *
+      * \param ar output/saving archive
+      */
+      virtual void save(Serializable::OArchive &ar);
+
+      /**
+      * Set grid and interpolation parameters.
+      *
+      * Must be called before setTable or readTable, if the tables are
+      * not created by readParameters.
+      *
+      * \param rMin   minimum tabulated separation, for all type pairs
+      * \param nGrid  number of grid points per type pair (>= 2)
+      * \param order  interpolation order (1=linear, 3=cubic)
+      */
+      void setGrid(double rMin, int nGrid, int order);
+
+      /**
+      * Generate tables from another pair interaction.
+      *
+      * The cutoff for each type pair is taken from the other interaction.
+      *
+      * \pre nAtomType and grid parameters must be set.
+      *
+      * \param interaction  initialized pair interaction object
+      */
+      template <class Interaction>
+      void setTable(const Interaction& interaction);
+
+      /**
+      * Read tables from a file.
+      *
+      * The file contains one block for each pair of types i <= j. Each
+      * block begins with a line containing i, j and a number of rows n,
+      * followed by n lines with values of r, energy and force (minus the
+      * derivative of the energy), with increasing r. The first value of
+      * r may not exceed rMin, and the last value is taken as the cutoff.
+      *
+      * \pre nAtomType and grid parameters must be set.
+      *
+      * \param in  input file stream
+      */
+      void readTable(std::istream& in);
+
+      /**
+      * Modify a parameter, identified by a string (not supported).
+      *
+      * Throws an Exception: tabulated potentials have no parameters
+      * that can be modified after initialization.
+      *
+      * \param name   parameter name
+      * \param i      atom type index 1
+      * \param j      atom type index 2
+      * \param value  new value of parameter
+      */
+      void set(std::string name, int i, int j, double value);
+
+      //@}
+      /// \name Accessors (required)
+      //@{
+
+      /**
+      * Returns interaction energy for a single pair of particles.
+      *
+      * \param rsq square of distance between particles
+      * \param i   type of particle 1
+      * \param j   type of particle 2
+      * \return    pair interaction energy
+      */
+      double energy(double rsq, int i, int j) const;
+
+      /**
+      * Returns ratio of scalar pair interaction force to pair separation.
+      *
+      * Multiply this quantity by the components of the separation vector
+      * to obtain the force vector. A positive value for the return value
+      * represents a repulsive force between a pair of particles.
+      *
+      * Precondition: The square separation rsq must be less than cutoffSq.
+      * If rsq > cutoffSq, the return value is undefined (i.e., wrong).
+      *
+      * \param rsq square of distance between particles
+      * \param i type of particle 1
+      * \param j type of particle 2
+      * \return  force divided by distance
+      */
+      double forceOverR(double rsq, int i, int j) const;
+
+      /**
+      * Compute pair forces for a block of pairs.
+      *
+      * On entry, dx[k], dy[k] and dz[k] are the components of the
+      * separation vector for pair k, for 0 <= k < n, and type0[k] and
+      * type1[k] are the types of the two atoms. On return, dx, dy and
+      * dz contain the components of the force on the first atom of each
+      * pair, which are zero for pairs with rsq >= cutoffSq.
+      *
+      * \param n     number of pairs
+      * \param type0 types of first atoms
+      * \param type1 types of second atoms
+      * \param dx    x components of separations (in) and forces (out)
+      * \param dy    y components of separations (in) and forces (out)
+      * \param dz    z components of separations (in) and forces (out)
+      */
+      void forceBlock(int n, const int* type0, const int* type1,
+                      double* dx, double* dy, double* dz) const;
+
+      /**
+      * Compute pair energies for a block of pairs.
+      *
+      * Sets energy[k] = energy(rsq[k], type0[k], type1[k]) for 0 <= k < n.
+      *
+      * \param n      number of pairs
+      * \param type0  types of first atoms
+      * \param type1  types of second atoms
+      * \param rsq    squared separations
+      * \param energy pair energies (output)
+      */
+      void energyBlock(int n, const int* type0, const int* type1,
+                       const double* rsq, double* energy) const;
+
+      /**
+      * Get square of cutoff distance for specific type pair.
+      *
+      * \param i   type of Atom 1
+      * \param j   type of Atom 2
+      * \return    cutoffSq_[i][j]
+      */
+      double cutoffSq(int i, int j) const;
+
+      /**
+      * Get maximum of pair cutoff distance, for all atom type pairs.
+      */
+      double maxPairCutoff() const;
+
+      /**
+      * Get a parameter value, identified by a string.
+      *
+      * The only recognized name is "cutoff".
+      *
+      * \param name   parameter name
+      * \param i      atom type index 1
+      * \param j      atom type index 2
+      */
+      double get(std::string name, int i, int j) const;
+
+      //@}
+      /// \name Accessors (extra)
+      //@{
+
+      /**
+      * Get cutoff distance for a specific pair of Atom types.
+      *
+      * \param i   type of Atom 1
+      * \param j   type of Atom 2
+      * \return    cutoff_[i][j]
+      */
+      double cutoff(int i, int j) const;
+
+      /**
+      * Get minimum tabulated separation.
+      */
+      double rMin() const;
+
+      /**
+      * Get number of grid points per type pair.
+      */
+      int nGrid() const;
+
+      /**
+      * Get interpolation order (1=linear, 3=cubic).
+      */
+      int order() const;
+
+      //@}
+
+   private:
+
+      /// Maximum allowed value for nAtomType (# of particle types)
+      static const int MaxAtomType = 3;
+
+      /// Number of coefficients per grid interval (energy and force).
+      static const int NCoeff = 8;
+
+      /// Cutoff distance for each pair of types.
+      double cutoff_[MaxAtomType][MaxAtomType];
+
+      /// Square of cutoff_.
+      double cutoffSq_[MaxAtomType][MaxAtomType];
+
+      /// Inverse of grid spacing in rsq, for each pair of types.
+      double dRsqInv_[MaxAtomType][MaxAtomType];
+
+      /// Index of first interval of the table for each pair of types.
+      int offset_[MaxAtomType][MaxAtomType];
+
+      /**
+      * Polynomial coefficients for all intervals of all tables.
+      *
+      * For interval k of type pair (i, j), NCoeff elements beginning at
+      * element NCoeff*(offset_[i][j] + k) contain coefficients c0, .., c3
+      * of energy, then of forceOverR, as cubic polynomials in t =
+      * (rsq - rsq_k)/dRsq, for rsq_k <= rsq < rsq_{k+1}.
+      */
+      DArray<double> table_;
+
+      /// Minimum tabulated separation.
+      double rMin_;
+
+      /// Square of rMin_.
+      double rsqMin_;
+
+      /// Maximum pair potential cutoff radius, for all type pairs.
+      double maxPairCutoff_;
+
+      /// Number of grid points for each pair of types.
+      int nGrid_;
+
+      /// Interpolation order (1=linear, 3=cubic).
+      int order_;
+
+      /// Number of possible atom types.
+      int nAtomType_;
+
+      /// Source of tables: "file" or name of an interaction class.
+      std::string source_;
+
+      /// Name of table file (if source_ == "file").
+      std::string tableFile_;
+
+      /// Interaction from which tables were generated (if any).
+      ParamComposite* sourcePtr_;
+
+      /// Are all parameters and pointers initialized?
+      bool isInitialized_;
+
+      /*
+      * Allocate table_ and set offset_ (private).
+      */
+      void allocateTable();
+
+      /*
+      * Compute coefficients for pair (i, j) from values on the grid.
+      *
+      * \param i       type of Atom 1
+      * \param j       type of Atom 2
+      * \param energy  energy at grid points (nGrid_ values)
+      * \param force   forceOverR at grid points (nGrid_ values)
+      */
+      void setCoefficients(int i, int j, const DArray<double>& energy,
+                           const DArray<double>& force);
+
+      /*
+      * Create a source interaction, read its parameters, and tabulate.
+      */
+      template <class Interaction>
+      void readSource(std::istream& in);
+
+      /*
+      * Create a source interaction and load its parameters.
+      */
+      template <class Interaction>
+      void loadSource(Serializable::IArchive& ar);
+
+      /*
+      * Return pointer to coefficients and fractional position t.
+      */
+      const double* coefficients(double rsq, int i, int j, double& t) const;
+
+   };
+
+   // inline methods
+
+   /*
+   * Find coefficients for the interval containing rsq.
+   */
+   inline const double*
+   TabulatedPair::coefficients(double rsq, int i, int j, double& t) const
+   {
+      double x = (rsq - rsqMin_)*dRsqInv_[i][j];
+      if (x < 0.0) {
+         x = 0.0;
+      }
+      int k = int(x);
+      if (k > nGrid_ - 2) {
+         k = nGrid_ - 2;
+      }
+      t = x - double(k);
+      return &table_[NCoeff*(offset_[i][j] + k)];
+   }
+
+   /*
+   * Calculate interaction energy for a pair, as function of squared distance.
+   */
+   inline double TabulatedPair::energy(double rsq, int i, int j) const
+   {
+      if (rsq < cutoffSq_[i][j]) {
+         double t;
+         const double* c = coefficients(rsq, i, j, t);
+         return c[0] + t*(c[1] + t*(c[2] + t*c[3]));
+      } else {
+         return 0.0;
+      }
+   }
+
+   /*
+   * Calculate force/distance for a pair as function of squared distance.
+   */
+   inline double TabulatedPair::forceOverR(double rsq, int i, int j) const
+   {
+      double t;
+      const double* c = coefficients(rsq, i, j, t);
+      return c[4] + t*(c[5] + t*(c[6] + t*c[7]));
+   }
+
+   /*
+   * Get square of cutoff distance for a type pair.
+   */
+   inline double TabulatedPair::cutoffSq(int i, int j) const
+   {  return cutoffSq_[i][j]; }
+
+   /*
+   * Generate tables from another pair interaction.
+   */
+   template <class Interaction>
+   void TabulatedPair::setTable(const Interaction& interaction)
+   {
+      if (nAtomType_ <= 0) {
+         UTIL_THROW("nAtomType must be set before setTable");
+      }
+      if (nGrid_ < 2) {
+         UTIL_THROW("Grid must be set before setTable");
+      }
+      allocateTable();
+
+      DArray<double> energy;
+      DArray<double> force;
+      energy.allocate(nGrid_);
+      force.allocate(nGrid_);
+
+      double rsq, dRsq;
+      int i, j, k;
+      maxPairCutoff_ = 0.0;
+      for (i = 0; i < nAtomType_; ++i) {
+         for (j = i; j < nAtomType_; ++j) {
+            cutoffSq_[i][j] = interaction.cutoffSq(i, j);
+            cutoff_[i][j] = sqrt(cutoffSq_[i][j]);
+            if (cutoff_[i][j] <= rMin_) {
+               UTIL_THROW("Pair cutoff <= rMin");
+            }
+            if (cutoff_[i][j] > maxPairCutoff_) {
+               maxPairCutoff_ = cutoff_[i][j];
+            }
+            dRsq = (cutoffSq_[i][j] - rsqMin_)/double(nGrid_ - 1);
+            for (k = 0; k < nGrid_; ++k) {
+               rsq = rsqMin_ + k*dRsq;
+               // Evaluate the last point just inside the cutoff, where
+               // the energy and force of the interaction are defined.
+               if (k == nGrid_ - 1) {
+                  rsq = cutoffSq_[i][j]*(1.0 - 1.0E-12);
+               }
+               energy[k] = interaction.energy(rsq, i, j);
+               force[k] = interaction.forceOverR(rsq, i, j);
+            }
+            setCoefficients(i, j, energy, force);
+         }
+      }
+      isInitialized_ = true;
+   }
+
+}
+#endif
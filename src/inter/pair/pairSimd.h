@@ -0,0 +1,111 @@
+#ifndef INTER_PAIR_SIMD_H
+#define INTER_PAIR_SIMD_H
+
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2012, David Morse (morse012@umn.edu)
+* Distributed under the terms of the GNU General Public License.
+*/
+
+/*
+* Helper functions for explicitly vectorized pair interaction kernels.
+*
+* Pair interaction parameters are stored in MaxAtomType x MaxAtomType
+* C arrays, and are accessed here as flat arrays indexed by ij = i*nt + j,
+* where nt = MaxAtomType. This file should only be included in .cpp files
+* that implement block kernels (e.g., LJPair.cpp), since it includes
+* <immintrin.h>. All functions are defined only if UTIL_SIMD_X86 is
+* defined, and must only be called from functions with matching target
+* attributes.
+*/
+
+#include <util/misc/Simd.h>
+
+#ifdef UTIL_SIMD_X86
+#include <immintrin.h>
+
+namespace Inter
+{
+
+   /*
+   * Return flat parameter indices type0[k]*nt + type1[k] for 4 pairs.
+   */
+   __attribute__((target("avx2,fma")))
+   inline __m128i pairIndex4(const int* type0, const int* type1, int nt)
+   {
+      return _mm_add_epi32(
+                _mm_mullo_epi32(_mm_loadu_si128((const __m128i*)type0),
+                                _mm_set1_epi32(nt)),
+                _mm_loadu_si128((const __m128i*)type1));
+   }
+
+   /*
+   * Gather 4 parameters table[ij[0]], ..., table[ij[3]].
+   */
+   __attribute__((target("avx2,fma")))
+   inline __m256d pairGather4(const double* table, __m128i ij)
+   {
+      return _mm256_mask_i32gather_pd(_mm256_setzero_pd(), table, ij,
+                             _mm256_castsi256_pd(_mm256_set1_epi64x(-1)), 8);
+   }
+
+   /*
+   * Return flat parameter indices type0[k]*nt + type1[k] for 8 pairs.
+   */
+   __attribute__((target("avx512f")))
+   inline __m512i pairIndex8(const int* type0, const int* type1, int nt)
+   {
+      __m256i ij = _mm256_add_epi32(
+                      _mm256_mullo_epi32(
+                         _mm256_loadu_si256((const __m256i*)type0),
+                         _mm256_set1_epi32(nt)),
+                      _mm256_loadu_si256((const __m256i*)type1));
+      return _mm512_maskz_cvtepi32_epi64(0xFF, ij);
+   }
+
+   /*
+   * Return the square roots of 8 doubles.
+   *
+   * The zero-masked intrinsics with a full mask used here and in
+   * pairMax8 are equivalent to _mm512_sqrt_pd and _mm512_max_pd, but
+   * do not pass an undefined source register, for which some versions
+   * of gcc emit spurious -Wmaybe-uninitialized warnings.
+   */
+   __attribute__((target("avx512f")))
+   inline __m512d pairSqrt8(__m512d x)
+   {  return _mm512_maskz_sqrt_pd(0xFF, x); }
+
+   /*
+   * Return the elementwise maximum of 8 pairs of doubles.
+   */
+   __attribute__((target("avx512f")))
+   inline __m512d pairMax8(__m512d x, __m512d y)
+   {  return _mm512_maskz_max_pd(0xFF, x, y); }
+
+   /*
+   * Load a table of up to 16 parameters into two registers lo and hi.
+   *
+   * Elements with indices >= size are set to zero, and are not read.
+   */
+   __attribute__((target("avx512f")))
+   inline void pairTable8(const double* table, int size,
+                          __m512d& lo, __m512d& hi)
+   {
+      __mmask8 mLo = size >= 8 ? 0xFF : __mmask8((1 << size) - 1);
+      __mmask8 mHi = size >= 16 ? 0xFF :
+                     size <= 8 ? 0 : __mmask8((1 << (size - 8)) - 1);
+      lo = _mm512_maskz_loadu_pd(mLo, table);
+      hi = _mm512_maskz_loadu_pd(mHi, table + 8);
+   }
+
+   /*
+   * Look up 8 parameters from a table held in registers (see pairTable8).
+   */
+   __attribute__((target("avx512f")))
+   inline __m512d pairLookup8(__m512d lo, __m512d hi, __m512i ij)
+   {  return _mm512_permutex2var_pd(lo, ij, hi); }
+
+}
+#endif // ifdef UTIL_SIMD_X86
+#endif
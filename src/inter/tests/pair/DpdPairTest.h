@@ -19,6 +19,7 @@ protected:
    PairTestTemplate<DpdPair>::readParamFile;
    PairTestTemplate<DpdPair>::forceOverR;
    PairTestTemplate<DpdPair>::energy;
+   PairTestTemplate<DpdPair>::checkBlock;
 
 public:
 
@@ -105,6 +106,17 @@ public:
       //Note: Do not test beyond cutoff: result is undefined.
    }
 
+   void testBlock() 
+   {
+      printMethod(TEST_FUNC);
+      if (verbose() > 0) {
+         std::cout << std::endl;
+         std::cout << "SIMD level = " 
+                   << Simd::name(Simd::detectedLevel()) << std::endl;
+      }
+      TEST_ASSERT(checkBlock(37, 0.1, 1.2));
+   }
+
    void testGetSet() {
       printMethod(TEST_FUNC);
 
@@ -234,6 +246,7 @@ TEST_BEGIN(DpdPairTest)
 TEST_ADD(DpdPairTest, testSetUp)
 TEST_ADD(DpdPairTest, testEnergy)
 TEST_ADD(DpdPairTest, testForceOverR)
+TEST_ADD(DpdPairTest, testBlock)
 TEST_ADD(DpdPairTest, testGetSet)
 TEST_ADD(DpdPairTest, testModify)
 //TEST_ADD(DpdPairTest, testSaveLoad)
@@ -19,6 +19,7 @@ protected:
    PairTestTemplate<LJPair>::readParamFile;
    PairTestTemplate<LJPair>::forceOverR;
    PairTestTemplate<LJPair>::energy;
+   PairTestTemplate<LJPair>::checkBlock;
 
 public:
 
@@ -111,6 +112,17 @@ public:
       //Note: Do not test beyond cutoff: result is undefined.
    }
 
+   void testBlock() 
+   {
+      printMethod(TEST_FUNC);
+      if (verbose() > 0) {
+         std::cout << std::endl;
+         std::cout << "SIMD level = " 
+                   << Simd::name(Simd::detectedLevel()) << std::endl;
+      }
+      TEST_ASSERT(checkBlock(37, 0.7, 1.3));
+   }
+
    void testGetSet() {
       printMethod(TEST_FUNC);
 
@@ -240,6 +252,7 @@ TEST_BEGIN(LJPairTest)
 TEST_ADD(LJPairTest, testSetUp)
 TEST_ADD(LJPairTest, testEnergy)
 TEST_ADD(LJPairTest, testForceOverR)
+TEST_ADD(LJPairTest, testBlock)
 TEST_ADD(LJPairTest, testGetSet)
 TEST_ADD(LJPairTest, testModify)
 TEST_ADD(LJPairTest, testSaveLoad)
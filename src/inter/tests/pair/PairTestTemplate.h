@@ -5,12 +5,14 @@
 #include <test/UnitTestRunner.h>
 
 #include <util/containers/RArray.h>
+#include <util/misc/Simd.h>
 #include <util/archives/Serializable.h>
 #include <util/archives/Serializable_includes.h>
 
 #include <iostream>
 #include <fstream>
 #include <iomanip>
+#include <vector>
 
 using namespace Util;
 using namespace Inter;
@@ -85,6 +87,67 @@ protected:
       return (fabs(diff) < 1.0E-6);
    }
 
+   /*
+   * Compare forceBlock and energyBlock to forceOverR and energy.
+   *
+   * Uses n pairs with separations rMin <= r < rMax, for all atom type
+   * pairs, and repeats the comparison for every available SIMD level.
+   */
+   bool checkBlock(int n, double rMin, double rMax)
+   {
+      std::vector<int> type0(n), type1(n);
+      std::vector<double> dx(n), dy(n), dz(n), rsq(n), energy(n);
+      std::vector<double> x(n), y(n), z(n);
+      double r, theta, fOverR, e;
+      bool ok = true;
+      int k, level;
+      for (k = 0; k < n; ++k) {
+         r = rMin + (rMax - rMin)*double(k)/double(n);
+         theta = 0.7*k;
+         x[k] = r*cos(theta)*0.6;
+         y[k] = r*sin(theta)*0.6;
+         z[k] = r*0.8;
+         type0[k] = k % nAtomType_;
+         type1[k] = (k/nAtomType_) % nAtomType_;
+      }
+
+      Simd::Level maxLevel = Simd::detectedLevel();
+      for (level = Simd::Scalar; level <= maxLevel; ++level) {
+         Simd::setMaxLevel(Simd::Level(level));
+         for (k = 0; k < n; ++k) {
+            dx[k] = x[k];
+            dy[k] = y[k];
+            dz[k] = z[k];
+            rsq[k] = x[k]*x[k] + y[k]*y[k] + z[k]*z[k];
+         }
+         interaction_.forceBlock(n, &type0[0], &type1[0], 
+                                 &dx[0], &dy[0], &dz[0]);
+         interaction_.energyBlock(n, &type0[0], &type1[0], 
+                                  &rsq[0], &energy[0]);
+         for (k = 0; k < n; ++k) {
+            fOverR = 0.0;
+            if (rsq[k] < interaction_.cutoffSq(type0[k], type1[k])) {
+               fOverR = interaction_.forceOverR(rsq[k], type0[k], type1[k]);
+            }
+            e = interaction_.energy(rsq[k], type0[k], type1[k]);
+            if (fabs(dx[k] - fOverR*x[k]) > 1.0E-10*(1.0 + fabs(fOverR))) {
+               ok = false;
+            }
+            if (fabs(dy[k] - fOverR*y[k]) > 1.0E-10*(1.0 + fabs(fOverR))) {
+               ok = false;
+            }
+            if (fabs(dz[k] - fOverR*z[k]) > 1.0E-10*(1.0 + fabs(fOverR))) {
+               ok = false;
+            }
+            if (fabs(energy[k] - e) > 1.0E-10*(1.0 + fabs(e))) {
+               ok = false;
+            }
+         }
+      }
+      Simd::setMaxLevel(Simd::Avx512);
+      return ok;
+   }
+
 };
 
 #endif
@@ -0,0 +1,233 @@
+#ifndef TABULATED_PAIR_TEST_H
+#define TABULATED_PAIR_TEST_H
+
+#include <inter/pair/TabulatedPair.h>
+#include <inter/pair/LJPair.h>
+#include <inter/pair/DpdPair.h>
+#include <inter/tests/pair/PairTestTemplate.h>
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+
+using namespace Util;
+using namespace Inter;
+
+class TabulatedPairTest : public PairTestTemplate<TabulatedPair>
+{
+
+protected:
+
+   PairTestTemplate<TabulatedPair>::setNAtomType;
+   PairTestTemplate<TabulatedPair>::readParamFile;
+   PairTestTemplate<TabulatedPair>::forceOverR;
+   PairTestTemplate<TabulatedPair>::energy;
+   PairTestTemplate<TabulatedPair>::checkBlock;
+
+   /*
+   * Compare a TabulatedPair to another interaction for all type pairs.
+   *
+   * Returns true if energies and forces agree to within a relative
+   * tolerance tol at n separations with rMin <= r < cutoff.
+   */
+   template <class Interaction>
+   bool compare(const TabulatedPair& table, const Interaction& other,
+                int n, double tol)
+   {
+      double r, rsq, e0, e1, f0, f1, eScale, fScale;
+      int i, j, k;
+      bool ok = true;
+      for (i = 0; i < nAtomType_; ++i) {
+         for (j = 0; j < nAtomType_; ++j) {
+            if (!eq(table.cutoffSq(i, j), other.cutoffSq(i, j))) {
+               ok = false;
+            }
+            eScale = fabs(other.energy(table.rMin()*table.rMin(), i, j));
+            fScale = fabs(other.forceOverR(table.rMin()*table.rMin(), i, j));
+            for (k = 0; k < n; ++k) {
+               r = table.rMin()
+                 + (table.cutoff(i, j) - table.rMin())*(k + 0.37)/double(n);
+               rsq = r*r;
+               e0 = other.energy(rsq, i, j);
+               e1 = table.energy(rsq, i, j);
+               f0 = other.forceOverR(rsq, i, j);
+               f1 = table.forceOverR(rsq, i, j);
+               if (fabs(e1 - e0) > tol*(eScale + 1.0)) ok = false;
+               if (fabs(f1 - f0) > tol*(fScale + 1.0)) ok = false;
+            }
+            rsq = table.cutoffSq(i, j)*1.0001;
+            if (table.energy(rsq, i, j) != 0.0) ok = false;
+         }
+      }
+      return ok;
+   }
+
+public:
+
+   void setUp()
+   {
+      eps_ = 1.0E-6;
+      setNAtomType(2);
+      readParamFile("in/TabulatedPair");
+      // setVerbose(1);
+   }
+
+   void testSetUp()
+   {
+      printMethod(TEST_FUNC);
+      if (verbose() > 0) {
+         std::cout << std::endl;
+         interaction_.writeParam(std::cout);
+      }
+      TEST_ASSERT(eq(interaction_.rMin(), 0.85));
+      TEST_ASSERT(interaction_.nGrid() == 1000);
+      TEST_ASSERT(interaction_.order() == 3);
+      TEST_ASSERT(eq(interaction_.maxPairCutoff(), 1.122462048));
+      TEST_ASSERT(eq(interaction_.get("cutoff", 0, 1), 1.122462048));
+   }
+
+   void testReadSource()
+   {
+      printMethod(TEST_FUNC);
+
+      LJPair lj;
+      lj.setNAtomType(2);
+      std::ifstream in;
+      openInputFile("in/LJPair", in);
+      lj.readParameters(in);
+      in.close();
+
+      TEST_ASSERT(compare(interaction_, lj, 200, 1.0E-7));
+   }
+
+   void testSetTable()
+   {
+      printMethod(TEST_FUNC);
+
+      DpdPair dpd;
+      dpd.setNAtomType(2);
+      std::ifstream in;
+      openInputFile("in/DpdPair", in);
+      dpd.readParameters(in);
+      in.close();
+      dpd.setSigma(1, 1, 0.9);
+
+      TabulatedPair table;
+      table.setNAtomType(2);
+      table.setGrid(0.25, 500, 3);
+      table.setTable(dpd);
+      TEST_ASSERT(compare(table, dpd, 200, 1.0E-6));
+
+      table.setGrid(0.25, 2000, 1);
+      table.setTable(dpd);
+      TEST_ASSERT(compare(table, dpd, 200, 1.0E-4));
+   }
+
+   void testReadFile()
+   {
+      printMethod(TEST_FUNC);
+
+      DpdPair dpd;
+      dpd.setNAtomType(2);
+      std::ifstream in;
+      openInputFile("in/DpdPair", in);
+      dpd.readParameters(in);
+      in.close();
+      dpd.setSigma(1, 1, 0.9);
+
+      TabulatedPair table;
+      table.setNAtomType(2);
+      openInputFile("in/TabulatedPairFile", in);
+      table.readParameters(in);
+      in.close();
+
+      TEST_ASSERT(eq(table.cutoff(1, 1), 0.9));
+      TEST_ASSERT(eq(table.maxPairCutoff(), 1.0));
+      TEST_ASSERT(compare(table, dpd, 200, 1.0E-6));
+   }
+
+   void testForceOverR()
+   {
+      printMethod(TEST_FUNC);
+      type1_ = 0;
+      type2_ = 1;
+      rsq_ = 0.95;
+      TEST_ASSERT(testForce());
+      type1_ = 1;
+      type2_ = 1;
+      rsq_ = 1.1;
+      TEST_ASSERT(testForce());
+   }
+
+   void testBlock()
+   {
+      printMethod(TEST_FUNC);
+      TEST_ASSERT(checkBlock(37, 0.9, 1.2));
+   }
+
+   void testSaveLoad()
+   {
+      printMethod(TEST_FUNC);
+
+      Serializable::OArchive oar;
+      openOutputFile("out/serial", oar.file());
+      interaction_.save(oar);
+      oar.file().close();
+
+      Serializable::IArchive iar;
+      openInputFile("out/serial", iar.file());
+      TabulatedPair clone;
+      clone.loadParameters(iar);
+
+      TEST_ASSERT(clone.nGrid() == interaction_.nGrid());
+      TEST_ASSERT(compare(clone, interaction_, 50, 1.0E-12));
+
+      // Parameters of the source interaction are also restored
+      std::ostringstream original, restored;
+      interaction_.writeParam(original);
+      clone.writeParam(restored);
+      TEST_ASSERT(restored.str() == original.str());
+   }
+
+   void testSaveLoadFile()
+   {
+      printMethod(TEST_FUNC);
+
+      TabulatedPair table;
+      table.setNAtomType(2);
+      std::ifstream in;
+      openInputFile("in/TabulatedPairFile", in);
+      table.readParameters(in);
+      in.close();
+
+      Serializable::OArchive oar;
+      openOutputFile("out/serialFile", oar.file());
+      table.save(oar);
+      oar.file().close();
+
+      Serializable::IArchive iar;
+      openInputFile("out/serialFile", iar.file());
+      TabulatedPair clone;
+      clone.loadParameters(iar);
+
+      TEST_ASSERT(compare(clone, table, 50, 1.0E-12));
+      std::ostringstream original, restored;
+      table.writeParam(original);
+      clone.writeParam(restored);
+      TEST_ASSERT(restored.str() == original.str());
+   }
+
+};
+
+TEST_BEGIN(TabulatedPairTest)
+TEST_ADD(TabulatedPairTest, testSetUp)
+TEST_ADD(TabulatedPairTest, testReadSource)
+TEST_ADD(TabulatedPairTest, testSetTable)
+TEST_ADD(TabulatedPairTest, testReadFile)
+TEST_ADD(TabulatedPairTest, testForceOverR)
+TEST_ADD(TabulatedPairTest, testBlock)
+TEST_ADD(TabulatedPairTest, testSaveLoad)
+TEST_ADD(TabulatedPairTest, testSaveLoadFile)
+TEST_END(TabulatedPairTest)
+
+#endif
@@ -28,33 +28,31 @@ namespace McMd
    {}
 
    /* 
-   * Evaluate pressure, and add to accumulator.
+   * Evaluate virial stress, and add to accumulator.
    */
-   void McStressAutoCorrelation::sample(long iStep)
+   template <>
+   void StressAutoCorrelation<McSystem>::sample(long iStep)
    {
-      double pressure;
-      double temperature;
-      McSystem& sys=system(); 
-      sys.computeStress(pressure);
-
-      DArray<double> elements;
-      elements.allocate(9);
-
-      Tensor total;
-
       if (isAtInterval(iStep)){
+         McSystem& sys=system(); 
+         double pressure;
+         double temperature;
+         Tensor total;
+         Tensor elements;
+
+         sys.computeStress(pressure);
          sys.computeVirialStress(total);
          temperature = sys.energyEnsemble().temperature();
 
-         elements[0] = (total(0,0) - pressure / 3.0) / (10.0 * temperature);
-         elements[1] = (total(0,1) + total(1,0)) / 2.0 / (10.0 * temperature);
-         elements[2] = (total(0,2) + total(2,0)) / 2.0 / (10.0 * temperature);
-         elements[3] = elements[1];
-         elements[4] = (total(1,1) - pressure / 3.0) / (10.0 * temperature);
-         elements[5] = (total(1,2) + total(2,1)) / 2.0 / (10.0 * temperature);
-         elements[6] = elements[2];
-         elements[7] = elements[5];
-         elements[8] = (total(2,2) - pressure / 3.0) / (10.0 * temperature);
+         elements(0,0) = (total(0,0) - pressure / 3.0) / (10.0 * temperature);
+         elements(0,1) = (total(0,1) + total(1,0)) / 2.0 / (10.0 * temperature);
+         elements(0,2) = (total(0,2) + total(2,0)) / 2.0 / (10.0 * temperature);
+         elements(1,0) = elements(0,1);
+         elements(1,1) = (total(1,1) - pressure / 3.0) / (10.0 * temperature);
+         elements(1,2) = (total(1,2) + total(2,1)) / 2.0 / (10.0 * temperature);
+         elements(2,0) = elements(0,2);
+         elements(2,1) = elements(1,2);
+         elements(2,2) = (total(2,2) - pressure / 3.0) / (10.0 * temperature);
 
          accumulator_.sample(elements);
      }
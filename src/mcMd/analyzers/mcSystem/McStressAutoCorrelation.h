@@ -1,5 +1,5 @@
-#ifndef MCMD_MD_STRESS_AUTOCORRELATION_H
-#define MCMD_MD_STRESS_AUTOCORRELATION_H
+#ifndef MCMD_MC_STRESS_AUTOCORRELATION_H
+#define MCMD_MC_STRESS_AUTOCORRELATION_H
 
 /*
 * Simpatico - Simulation Package for Polymeric and Molecular Liquids
@@ -9,13 +9,19 @@
 */
 
 #include <mcMd/analyzers/system/StressAutoCorrelation.h>  // base class template
-#include <mcMd/mdSimulation/MdSystem.h>                   // base template parameter
+#include <mcMd/mcSimulation/McSystem.h>                   // base template parameter
 
 namespace McMd
 {
 
    /**
-   * Analyzer to calculate average isotropic pressure.
+   * Autocorrelation function of the deviatoric stress in an McSystem.
+   *
+   * Only the virial stress is included, since an McSystem has no
+   * velocities. The sample method is provided by an explicit
+   * specialization of StressAutoCorrelation<McSystem>::sample().
+   *
+   * \ingroup McMd_Analyzer_Module
    */
    class McStressAutoCorrelation : public StressAutoCorrelation<McSystem>
    {
@@ -33,12 +39,15 @@ namespace McMd
       */
       ~McStressAutoCorrelation();
 
-      /* 
-      * Evaluate pressure, and add to accumulator.
-      */
-      void sample(long iStep);
-
    };
 
+   /**
+   * Evaluate virial stress, and add to accumulator.
+   *
+   * \param iStep MC step index
+   */
+   template <>
+   void StressAutoCorrelation<McSystem>::sample(long iStep);
+
 }
 #endif 
@@ -14,6 +14,7 @@
 #include <mcMd/chemistry/Molecule.h>
 #include <mcMd/chemistry/Atom.h>
 #include <util/math/feq.h>
+#include <util/space/Dimension.h>
 #include <util/misc/FileMaster.h>
 #include <util/archives/Serializable_includes.h>
 
@@ -34,6 +35,11 @@ namespace McMd
       accumulator_(),
       typeNumbers_(),
       selector_(),
+      cellAtoms_(),
+      atomPtrs_(),
+      atomCells_(),
+      cellBegin_(),
+      gridDimensions_(),
       max_(1.0),
       normSum_(0.0),
       nBin_(1),
@@ -54,6 +60,7 @@ namespace McMd
       nAtomType_ = system().simulation().nAtomType();
       typeNumbers_.allocate(nAtomType_);
       accumulator_.setParam(max_, nBin_);
+      allocate();
       isInitialized_ = true;
    }
 
@@ -86,6 +93,7 @@ namespace McMd
          UTIL_THROW("Inconsistent max values");
       }
 
+      allocate();
       isInitialized_ = true;
    }
 
@@ -106,75 +114,164 @@ namespace McMd
       accumulator_.clear(); 
    }
 
+   /*
+   * Allocate cell list workspace.
+   */
+   void RDF::allocate()
+   {
+      int atomCapacity = system().simulation().atomCapacity();
+      if (!cellAtoms_.isAllocated()) {
+         cellAtoms_.allocate(atomCapacity);
+         atomPtrs_.allocate(atomCapacity);
+         atomCells_.allocate(atomCapacity);
+      }
+   }
+
+   /*
+   * Sort all atoms into a periodic grid of cells of width >= max_.
+   */
+   void RDF::buildCells()
+   {
+      const Boundary& boundary = system().boundary();
+      const Vector& lengths = boundary.lengths();
+      int i, nCell;
+
+      nCell = 1;
+      for (i = 0; i < Dimension; ++i) {
+         gridDimensions_[i] = int(lengths[i]/max_);
+         if (gridDimensions_[i] < 1) {
+            gridDimensions_[i] = 1;
+         }
+         nCell *= gridDimensions_[i];
+      }
+      if (cellBegin_.capacity() < nCell + 1) {
+         if (cellBegin_.isAllocated()) {
+            cellBegin_.deallocate();
+         }
+         cellBegin_.allocate(nCell + 1);
+      }
+      for (i = 0; i <= nCell; ++i) {
+         cellBegin_[i] = 0;
+      }
+
+      // Find the cell for each atom, and count atoms per cell
+      System::ConstMoleculeIterator molIter;
+      Molecule::ConstAtomIterator   atomIter;
+      Vector r;
+      int iSpecies, nSpecies, cell, c, nAtom;
+      nSpecies = system().simulation().nSpecies();
+      nAtom = 0;
+      for (iSpecies = 0; iSpecies < nSpecies; ++iSpecies) {
+         system().begin(iSpecies, molIter); 
+         for ( ; molIter.notEnd(); ++molIter) {
+            molIter->begin(atomIter); 
+            for ( ; atomIter.notEnd(); ++atomIter) {
+               r = atomIter->position();
+               boundary.shift(r);
+               cell = 0;
+               for (i = 0; i < Dimension; ++i) {
+                  c = int(r[i]*gridDimensions_[i]/lengths[i]);
+                  if (c >= gridDimensions_[i]) c = gridDimensions_[i] - 1;
+                  if (c < 0) c = 0;
+                  cell = cell*gridDimensions_[i] + c;
+               }
+               atomPtrs_[nAtom] = &(*atomIter);
+               atomCells_[nAtom] = cell;
+               ++cellBegin_[cell + 1];
+               ++nAtom;
+            }
+         }
+      }
+
+      // Convert counts to offsets, and sort atoms by cell
+      for (i = 0; i < nCell; ++i) {
+         cellBegin_[i+1] += cellBegin_[i];
+      }
+      for (i = 0; i < nAtom; ++i) {
+         cell = atomCells_[i];
+         cellAtoms_[cellBegin_[cell]] = atomPtrs_[i];
+         ++cellBegin_[cell];
+      }
+      for (i = nCell; i > 0; --i) {
+         cellBegin_[i] = cellBegin_[i-1];
+      }
+      cellBegin_[0] = 0;
+   }
+
    /// Add particle pairs to RDF histogram.
    void RDF::sample(long iStep) 
    {
       if (isAtInterval(iStep))  {
 
          accumulator_.beginSnapshot();
-
-         System::ConstMoleculeIterator molIter1, molIter2;
-         Molecule::ConstAtomIterator   atomIter1, atomIter2;
-         Vector    r1, r2;
-         double    dRsq, dR;
-         Boundary* boundaryPtr;
-         int       iSpecies1, iSpecies2, nSpecies, i;
-   
+         buildCells();
+
+         const Boundary& boundary = system().boundary();
+         const Atom* atom1Ptr;
+         const Atom* atom2Ptr;
+         IntVector c1, c2, minDel, maxDel;
+         double maxSq, dRsq;
+         int i, nCell, cell1, cell2, dx, dy, dz, k1, k2;
+
+         // Range of cell offsets in each direction. For directions 
+         // with fewer than 3 cells, visit each cell exactly once.
+         for (i = 0; i < Dimension; ++i) {
+            if (gridDimensions_[i] > 2) {
+               minDel[i] = -1;
+               maxDel[i] =  1;
+            } else {
+               minDel[i] = 0;
+               maxDel[i] = gridDimensions_[i] - 1;
+            }
+         }
+         nCell = gridDimensions_[0]*gridDimensions_[1]*gridDimensions_[2];
+         maxSq = max_*max_;
+  
          for (i = 0; i < nAtomType_; ++i) {
             typeNumbers_[i] = 0;
          }
 
-         boundaryPtr = &system().boundary();
-         nSpecies    = system().simulation().nSpecies();
-
-         // Loop over atom 1
-         for (iSpecies1 = 0; iSpecies1 < nSpecies; ++iSpecies1) {
-            system().begin(iSpecies1, molIter1); 
-            for ( ; molIter1.notEnd(); ++molIter1) {
-               molIter1->begin(atomIter1); 
-               for ( ; atomIter1.notEnd(); ++atomIter1) {
-                  r1 = atomIter1->position();
- 
-                  ++typeNumbers_[atomIter1->typeId()];
-  
-                  // Loop over atom 2 
-                  for (iSpecies2 = 0; iSpecies2 < nSpecies; ++iSpecies2) {
-                     system().begin(iSpecies2, molIter2); 
-                     for ( ; molIter2.notEnd(); ++molIter2) {
-
-                        //Check if molecules are the same  
-                        //if ( &(*molIter2) != &(*molIter1)) {
-
-                           molIter2->begin(atomIter2);
-                           for ( ; atomIter2.notEnd(); ++atomIter2) {
-
-                              if (selector_.match(*atomIter1, *atomIter2)) {
-                                 r2 = atomIter2->position();
-   
-                                 dRsq = boundaryPtr->distanceSq(r1, r2);
-                                 dR   = sqrt(dRsq);
-
-                                 accumulator_.sample(dR);
-
+         // Loop over atom 1, by cell
+         for (cell1 = 0; cell1 < nCell; ++cell1) {
+            c1[2] = cell1 % gridDimensions_[2];
+            c1[1] = (cell1/gridDimensions_[2]) % gridDimensions_[1];
+            c1[0] = cell1/(gridDimensions_[2]*gridDimensions_[1]);
+            for (k1 = cellBegin_[cell1]; k1 < cellBegin_[cell1+1]; ++k1) {
+               atom1Ptr = cellAtoms_[k1];
+               ++typeNumbers_[atom1Ptr->typeId()];
+
+               // Loop over atom 2 in this and neighboring cells
+               for (dx = minDel[0]; dx <= maxDel[0]; ++dx) {
+                  c2[0] = (c1[0] + dx + gridDimensions_[0]) % gridDimensions_[0];
+                  for (dy = minDel[1]; dy <= maxDel[1]; ++dy) {
+                     c2[1] = (c1[1] + dy + gridDimensions_[1]) % gridDimensions_[1];
+                     for (dz = minDel[2]; dz <= maxDel[2]; ++dz) {
+                        c2[2] = (c1[2] + dz + gridDimensions_[2]) % gridDimensions_[2];
+                        cell2 = (c2[0]*gridDimensions_[1] + c2[1])*gridDimensions_[2] 
+                              + c2[2];
+                        for (k2 = cellBegin_[cell2]; k2 < cellBegin_[cell2+1]; ++k2) {
+                           atom2Ptr = cellAtoms_[k2];
+                           dRsq = boundary.distanceSq(atom1Ptr->position(),
+                                                      atom2Ptr->position());
+                           if (dRsq < maxSq) {
+                              if (selector_.match(*atom1Ptr, *atom2Ptr)) {
+                                 accumulator_.sample(sqrt(dRsq));
                               }
-               
                            }
-
-                        //}
-
+                        }
                      }
-                  } // for iSpecies2
-   
+                  }
                }
+
             }
-         } // for iSpecies1
+         } // for cell1
 
          // Increment normSum_
          double number = 0;
          for (i = 0; i < nAtomType_; ++i) {
             number  += typeNumbers_[i];
          }
-         normSum_ += number*number/boundaryPtr->volume();
+         normSum_ += number*number/boundary.volume();
 
       } // if isAtInterval
 
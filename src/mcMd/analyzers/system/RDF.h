@@ -13,6 +13,7 @@
 #include <mcMd/analyzers/util/PairSelector.h>     // member
 #include <util/accumulators/RadialDistribution.h>   // member
 #include <util/containers/DArray.h>                 // member template
+#include <util/space/IntVector.h>                   // member
 
 #include <util/global.h>
 
@@ -25,9 +26,11 @@ namespace McMd
    * RDF evaluates the atomic radial distribution function.
    *
    * This class evaluates a radial distribution function in real space,
-   * by making a histogram of particle pairs. The algorithm is expensive:
-   * It simply executes a double loop over particles, at a cost of order
-   * N^2. 
+   * by making a histogram of particle pairs. Atoms are first sorted into 
+   * a private grid of cells with widths no less than the maximum radius
+   * max, so that only atoms in neighboring cells need to be compared. 
+   * The cost of each sample is thus of order N at fixed density, rather 
+   * than N^2.
    * 
    * Different types of RDF may be calculated by setting a PairSelector
    * too specify which types of particles pairs should be accepted: The
@@ -99,6 +102,16 @@ namespace McMd
 
    private:
 
+      /**
+      * Allocate cell list workspace, if not already allocated.
+      */
+      void allocate();
+
+      /**
+      * Sort all atoms into cells, and set cellBegin_ and cellAtoms_.
+      */
+      void buildCells();
+
       // Output file stream
       std::ofstream outputFile_;
 
@@ -111,6 +124,21 @@ namespace McMd
       /// Rule specifying which atom pairs to accept
       PairSelector   selector_;
 
+      /// Pointers to all atoms, sorted by cell.
+      DArray<const Atom*> cellAtoms_;
+
+      /// Pointers to all atoms, in order of iteration (workspace).
+      DArray<const Atom*> atomPtrs_;
+
+      /// Cell index for each atom, in order of iteration (workspace).
+      DArray<int> atomCells_;
+
+      /// Index in cellAtoms_ of first atom in each cell (nCell + 1 values).
+      DArray<int> cellBegin_;
+
+      /// Number of cells in each direction.
+      IntVector gridDimensions_;
+
       /// Maximum radius in histogram.
       double max_;
 
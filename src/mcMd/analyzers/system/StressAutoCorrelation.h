@@ -11,7 +11,11 @@
 #include <mcMd/analyzers/SystemAnalyzer.h>
 #include <util/space/Tensor.h>
 #include <util/ensembles/EnergyEnsemble.h>
-#include <util/accumulators/AutoCorrArray.h>     // member template
+#include <util/accumulators/AutoCorrelation.h>   // member template
+#include <util/format/Lng.h>
+#include <util/format/Dbl.h>
+
+#include <vector>
 
 namespace McMd
 {
@@ -19,11 +23,15 @@ namespace McMd
    using namespace Util;
 
    /**
-   * Periodically write (tensor) StressTensor to file.
+   * Compute the autocorrelation function of the deviatoric stress tensor.
+   *
+   * The autocorrelation function is computed by a hierarchical
+   * AutoCorrelation accumulator, which yields correlations at delays
+   * that span many decades at a bounded cost per sample.
    *
    * Typename SystemType can be McSystem or MdSystem.
    *
-   * \ingroup DdMd_Analyzer_Module
+   * \ingroup McMd_Analyzer_Module
    */
    template <class SystemType>
    class StressAutoCorrelation : public SystemAnalyzer<SystemType>
@@ -97,11 +105,14 @@ namespace McMd
       std::ofstream  outputFile_;
       
       /// Statistical accumulator.
-      AutoCorrArray<double, double>  accumulator_;
+      AutoCorrelation<Tensor, double>  accumulator_;
 
-      /// Number of samples per block average output
+      /// Number of values in history of each accumulator stage.
       int  capacity_;
 
+      /// Maximum stage index of the hierarchical accumulator.
+      int  maxStageId_;
+
       /// Has readParam been called?
       long  isInitialized_;
 
@@ -126,6 +137,7 @@ namespace McMd
       outputFile_(),
       accumulator_(),
       capacity_(-1),
+      maxStageId_(-1),
       isInitialized_(false)
    {}
 
@@ -138,9 +150,9 @@ namespace McMd
       readInterval(in);
       readOutputFileName(in);
       read(in,"capacity", capacity_);
+      read(in,"maxStageId", maxStageId_);
 
-      accumulator_.setParam(9, capacity_);
-      accumulator_.clear();
+      accumulator_.setParam(capacity_, maxStageId_);
 
       isInitialized_ = true;
    }
@@ -154,6 +166,7 @@ namespace McMd
       Analyzer::loadParameters(ar);
 
       loadParameter(ar, "capacity", capacity_);
+      loadParameter(ar, "maxStageId", maxStageId_);
       ar & accumulator_;
 
       if (accumulator_.bufferCapacity() != capacity_) {
@@ -180,6 +193,7 @@ namespace McMd
    {
       Analyzer::serialize(ar, version);
       ar & capacity_;
+      ar & maxStageId_;
       ar & accumulator_;
    }
 
@@ -201,33 +215,30 @@ namespace McMd
    template <class SystemType>
    void StressAutoCorrelation<SystemType>::sample(long iStep)
    {
-      double pressure;
-      double temperature;
-      SystemType& sys=system(); 
-      sys.computeStress(pressure);
-
-      DArray<double> elements;
-      elements.allocate(9);
-
-      Tensor total;
-      Tensor virial;
-      Tensor kinetic;
-
       if (isAtInterval(iStep)){
-         sys.computeVirialStress(total);
+         SystemType& sys=system(); 
+         double pressure;
+         double temperature;
+         Tensor virial;
+         Tensor kinetic;
+         Tensor total;
+         Tensor elements;
+
+         sys.computeStress(pressure);
+         sys.computeVirialStress(virial);
          sys.computeKineticStress(kinetic);
          total.add(virial, kinetic);
          temperature = sys.energyEnsemble().temperature();
 
-         elements[0] = (total(0,0) - pressure / 3.0) / (10.0 * temperature);
-         elements[1] = (total(0,1) + total(1,0)) / 2.0 / (10.0 * temperature);
-         elements[2] = (total(0,2) + total(2,0)) / 2.0 / (10.0 * temperature);
-         elements[3] = elements[1];
-         elements[4] = (total(1,1) - pressure / 3.0) / (10.0 * temperature);
-         elements[5] = (total(1,2) + total(2,1)) / 2.0 / (10.0 * temperature);
-         elements[6] = elements[2];
-         elements[7] = elements[5];
-         elements[8] = (total(2,2) - pressure / 3.0) / (10.0 * temperature);
+         elements(0,0) = (total(0,0) - pressure / 3.0) / (10.0 * temperature);
+         elements(0,1) = (total(0,1) + total(1,0)) / 2.0 / (10.0 * temperature);
+         elements(0,2) = (total(0,2) + total(2,0)) / 2.0 / (10.0 * temperature);
+         elements(1,0) = elements(0,1);
+         elements(1,1) = (total(1,1) - pressure / 3.0) / (10.0 * temperature);
+         elements(1,2) = (total(1,2) + total(2,1)) / 2.0 / (10.0 * temperature);
+         elements(2,0) = elements(0,2);
+         elements(2,1) = elements(1,2);
+         elements(2,2) = (total(2,2) - pressure / 3.0) / (10.0 * temperature);
 
          accumulator_.sample(elements);
      }
@@ -250,9 +261,16 @@ namespace McMd
       outputFile_ << std::endl;
       outputFile_.close();
 
-      // Write autocorrelation function to data file
+      // Write autocorrelation function, averaged over components
+      std::vector<long> delays;
+      std::vector<double> corrs;
+      accumulator_.getCorrelations(delays, corrs);
       system().simulation().fileMaster().openOutputFile(outputFileName(".corr"), outputFile_);
-      accumulator_.output(outputFile_);
+      for (unsigned int i = 0; i < delays.size(); ++i) {
+         outputFile_ << Lng(delays[i]) 
+                     << Dbl(corrs[i]/double(Dimension*Dimension)) 
+                     << std::endl;
+      }
       outputFile_.close(); 
    }
 
@@ -33,6 +33,9 @@ namespace McMd
    StructureFactor::StructureFactor(System& system) 
     : SystemAnalyzer<System>(system),
       isFirstStep_(true),
+      nAtom_(0),
+      nUpdate_(0),
+      hasFourierModes_(false),
       isInitialized_(false)
    {  setClassName("StructureFactor"); }
 
@@ -124,6 +127,7 @@ namespace McMd
          }
       }
       nSample_ = 0;
+      hasFourierModes_ = false;
    }
 
    /* 
@@ -133,54 +137,13 @@ namespace McMd
    {
       if (isAtInterval(iStep))  {
 
-<<<<<<< HEAD
-         fileMaster().openOutputFile(outputFileName("_max.dat"), outputFile_, !isFirstStep_);
-         //fileMaster().openOutputFile(outputFileName(".dat"), logFile_, !isFirstStep_);
-=======
          fileMaster().openOutputFile(outputFileName("_max.dat"), 
                                      outputFile_, !isFirstStep_);
->>>>>>> 7454788cb955ae6920d2fc65f1ee1fa595a406d8
          isFirstStep_ = false;
 
-         Vector position;
-         std::complex<double> expFactor;
-         double product;
-         System::ConstMoleculeIterator molIter;
-         Molecule::ConstAtomIterator atomIter;
-         int nSpecies, iSpecies, typeId, i, j;
-
+         int i, j;
          makeWaveVectors();
-
-         // Set all Fourier modes to zero
-         for (i = 0; i < nWave_; ++i) {
-            for (j = 0; j < nMode_; ++j) {
-               fourierModes_(i, j) = std::complex<double>(0.0, 0.0);
-            }
-         }
- 
-         // Loop over all atoms
-         nSpecies = system().simulation().nSpecies();
-         for (iSpecies = 0; iSpecies < nSpecies; ++iSpecies) {
-            system().begin(iSpecies, molIter); 
-            for ( ; molIter.notEnd(); ++molIter) {
-               molIter->begin(atomIter); 
-               for ( ; atomIter.notEnd(); ++atomIter) {
-                  position = atomIter->position();
-                  typeId   = atomIter->typeId();
- 
-		  // Loop over wavevectors
-                  for (i = 0; i < nWave_; ++i) {
-                     product = position.dot(waveVectors_[i]);
-                     expFactor = exp( product*Constants::Im );
-                     for (j = 0; j < nMode_; ++j) {
-                        fourierModes_(i, j) += modes_(j, typeId)*expFactor;
-                     }
-                  }
-  
-               }
-            }
-
-         }
+         updateFourierModes();
 
          double volume = system().boundary().volume();
          double norm;
@@ -229,6 +192,194 @@ namespace McMd
 
    }
 
+   /*
+   * Update Fourier modes, adding only changes since the last update.
+   */
+   void StructureFactor::updateFourierModes() 
+   {
+      if (!atomTypeIds_.isAllocated()) {
+         allocateCache();
+      }
+
+      // Recompute all modes if the boundary has changed, or periodically
+      const Boundary& boundary = system().boundary();
+      int i, j;
+      bool isValid = hasFourierModes_ && nUpdate_ < RecomputeInterval;
+      for (j = 0; j < Dimension; ++j) {
+         for (i = 0; i < Dimension; ++i) {
+            if (basisVectors_[j][i] != boundary.reciprocalBasisVector(j)[i]) {
+               isValid = false;
+            }
+         }
+      }
+      if (!isValid) {
+         computeFourierModes();
+         return;
+      }
+
+      // Find atoms that have moved or changed type since last update
+      System::ConstMoleculeIterator molIter;
+      Molecule::ConstAtomIterator atomIter;
+      int nSpecies, iSpecies, id, typeId, nAtom, nChanged;
+      bool isChanged;
+      nAtom = 0;
+      nChanged = 0;
+      nSpecies = system().simulation().nSpecies();
+      for (iSpecies = 0; iSpecies < nSpecies; ++iSpecies) {
+         system().begin(iSpecies, molIter); 
+         for ( ; molIter.notEnd(); ++molIter) {
+            molIter->begin(atomIter); 
+            for ( ; atomIter.notEnd(); ++atomIter) {
+               id = atomIter->id();
+               typeId = atomTypeIds_[id];
+               if (typeId < 0) {
+                  // Atom was added since last update
+                  computeFourierModes();
+                  return;
+               }
+               isChanged = (typeId != atomIter->typeId());
+               for (i = 0; i < Dimension; ++i) {
+                  if (atomPositions_[id][i] != atomIter->position()[i]) {
+                     isChanged = true;
+                  }
+               }
+               if (isChanged) {
+                  changedAtomPtrs_[nChanged] = atomIter.get();
+                  ++nChanged;
+               }
+               ++nAtom;
+            }
+         }
+      }
+
+      // Recompute if atoms were removed, or if most atoms have changed
+      if (nAtom != nAtom_ || 2*nChanged > nAtom) {
+         computeFourierModes();
+         return;
+      }
+
+      // Replace contributions of changed atoms
+      const Atom* atomPtr;
+      for (i = 0; i < nChanged; ++i) {
+         atomPtr = changedAtomPtrs_[i];
+         id = atomPtr->id();
+         addAtomModes(atomPositions_[id], atomTypeIds_[id], -1.0);
+         addAtomModes(atomPtr->position(), atomPtr->typeId(), 1.0);
+         atomPositions_[id] = atomPtr->position();
+         atomTypeIds_[id] = atomPtr->typeId();
+      }
+      ++nUpdate_;
+   }
+
+   /*
+   * Compute all Fourier modes from scratch.
+   */
+   void StructureFactor::computeFourierModes() 
+   {
+      System::ConstMoleculeIterator molIter;
+      Molecule::ConstAtomIterator atomIter;
+      int nSpecies, iSpecies, id, i, j;
+
+      // Set all Fourier modes to zero, and clear atom cache
+      for (i = 0; i < nWave_; ++i) {
+         for (j = 0; j < nMode_; ++j) {
+            fourierModes_(i, j) = std::complex<double>(0.0, 0.0);
+         }
+      }
+      for (i = 0; i < atomTypeIds_.capacity(); ++i) {
+         atomTypeIds_[i] = -1;
+      }
+      for (j = 0; j < Dimension; ++j) {
+         basisVectors_[j] = system().boundary().reciprocalBasisVector(j);
+      }
+ 
+      // Loop over all atoms
+      nAtom_ = 0;
+      nSpecies = system().simulation().nSpecies();
+      for (iSpecies = 0; iSpecies < nSpecies; ++iSpecies) {
+         system().begin(iSpecies, molIter); 
+         for ( ; molIter.notEnd(); ++molIter) {
+            molIter->begin(atomIter); 
+            for ( ; atomIter.notEnd(); ++atomIter) {
+               addAtomModes(atomIter->position(), atomIter->typeId(), 1.0);
+               id = atomIter->id();
+               atomPositions_[id] = atomIter->position();
+               atomTypeIds_[id] = atomIter->typeId();
+               ++nAtom_;
+            }
+         }
+      }
+      nUpdate_ = 0;
+      hasFourierModes_ = true;
+   }
+
+   /*
+   * Add weight*modes_(j, typeId)*exp(i k.r) to fourierModes_(k, j).
+   */
+   void StructureFactor::addAtomModes(const Vector& position, int typeId, 
+                                      double weight) 
+   {
+      std::complex<double> expFactor, conjFactor;
+      int i, j, n, offset;
+
+      // Compute exp(i n b_j.r) for all required Miller indices n
+      for (j = 0; j < Dimension; ++j) {
+         offset = -minIntVector_[j];
+         expFactor = exp(position.dot(basisVectors_[j])*Constants::Im);
+         conjFactor = std::conj(expFactor);
+         phases_(j, offset) = std::complex<double>(1.0, 0.0);
+         for (n = 1; n <= maxIntVector_[j]; ++n) {
+            phases_(j, offset + n) = phases_(j, offset + n - 1)*expFactor;
+         }
+         for (n = -1; n >= minIntVector_[j]; --n) {
+            phases_(j, offset + n) = phases_(j, offset + n + 1)*conjFactor;
+         }
+      }
+
+      // Loop over wavevectors
+      for (i = 0; i < nWave_; ++i) {
+         expFactor = phases_(0, waveIntVectors_[i][0] - minIntVector_[0]);
+         for (j = 1; j < Dimension; ++j) {
+            expFactor *= phases_(j, waveIntVectors_[i][j] - minIntVector_[j]);
+         }
+         for (j = 0; j < nMode_; ++j) {
+            fourierModes_(i, j) += weight*modes_(j, typeId)*expFactor;
+         }
+      }
+   }
+
+   /*
+   * Allocate atom cache and phase factor arrays.
+   */
+   void StructureFactor::allocateCache() 
+   {
+      int capacity = system().simulation().atomCapacity();
+      atomPositions_.allocate(capacity);
+      atomTypeIds_.allocate(capacity);
+      changedAtomPtrs_.allocate(capacity);
+
+      // Find range of Miller indices in each direction
+      int i, j, nPhase;
+      nPhase = 1;
+      for (j = 0; j < Dimension; ++j) {
+         minIntVector_[j] = 0;
+         maxIntVector_[j] = 0;
+         for (i = 0; i < nWave_; ++i) {
+            if (waveIntVectors_[i][j] < minIntVector_[j]) {
+               minIntVector_[j] = waveIntVectors_[i][j];
+            }
+            if (waveIntVectors_[i][j] > maxIntVector_[j]) {
+               maxIntVector_[j] = waveIntVectors_[i][j];
+            }
+         }
+         if (maxIntVector_[j] - minIntVector_[j] + 1 > nPhase) {
+            nPhase = maxIntVector_[j] - minIntVector_[j] + 1;
+         }
+      }
+      phases_.allocate(Dimension, nPhase);
+      hasFourierModes_ = false;
+   }
+
    /*
    * Calculate floating point wavevectors, using current boundary.
    */
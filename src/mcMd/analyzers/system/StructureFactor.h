@@ -12,6 +12,7 @@
 #include <mcMd/simulation/System.h>               // base class template parameter
 #include <util/containers/DMatrix.h>              // member template
 #include <util/containers/DArray.h>               // member template
+#include <util/containers/FArray.h>               // member template
 
 #include <util/global.h>
 
@@ -48,6 +49,20 @@ namespace McMd
    * an expansion of a reciprocal lattice wavevector as a sum of
    * recprocal lattice basis vectors for the periodic unit cell.
    *
+   * The Fourier amplitudes are maintained incrementally between samples.
+   * The position and type of every atom at the previous sample are 
+   * retained, and only the contributions of atoms that have since moved
+   * or changed type are subtracted and re-added. This makes sampling 
+   * cheap in MC simulations in which few atoms move between samples.
+   * All amplitudes are recomputed from scratch when the boundary 
+   * changes, when atoms are added or removed, when more than half
+   * of all atoms have changed, and after every RecomputeInterval
+   * incremental updates, to discard accumulated roundoff error. 
+   * Each factor exp(i k.r) is evaluated as
+   * a product of integer powers of the phase factors exp(i b_j.r) for
+   * the reciprocal basis vectors b_j, so that only Dimension complex 
+   * exponentials are required per atom.
+   *
    * See also: \ref mcMd_analyzer_StructureFactor_page 
    * 
    * \ingroup McMd_Analyzer_Module
@@ -116,6 +131,11 @@ namespace McMd
       */
       virtual void output();
 
+      /**
+      * Maximum number of incremental updates between full recomputations.
+      */
+      static const int RecomputeInterval = 100;
+
    protected:
 
       /**
@@ -179,8 +199,76 @@ namespace McMd
 
    private:
 
+      /**
+      * Position of each atom at last update of fourierModes_.
+      *
+      * Indexed by Atom::id().
+      */
+      DArray<Vector>  atomPositions_;
+
+      /**
+      * Type of each atom at last update of fourierModes_.
+      *
+      * Indexed by Atom::id(), with value -1 for absent atoms.
+      */
+      DArray<int>  atomTypeIds_;
+
+      /**
+      * Pointers to atoms that changed since last update (temporary).
+      */
+      DArray<const Atom*>  changedAtomPtrs_;
+
+      /**
+      * Phase factors exp(i n b_j.r) for one atom (temporary).
+      *
+      * First index is Cartesian axis j, second is n - minIntVector_[j].
+      */
+      DMatrix< std::complex<double> >  phases_;
+
+      /// Reciprocal basis vectors at last update of fourierModes_.
+      FArray<Vector, Dimension>  basisVectors_;
+
+      /// Minimum Miller index in each direction.
+      IntVector  minIntVector_;
+
+      /// Maximum Miller index in each direction.
+      IntVector  maxIntVector_;
+
+      /// Number of atoms at last update of fourierModes_.
+      int  nAtom_;
+
+      /// Number of incremental updates since fourierModes_ were computed.
+      int  nUpdate_;
+
+      /// Are fourierModes_ and the atom position cache up to date?
+      bool hasFourierModes_;
+
       /// Has readParam been called?
       bool isInitialized_;
+
+      /**
+      * Update fourierModes_ to reflect current atomic positions.
+      */
+      void updateFourierModes();
+
+      /**
+      * Compute fourierModes_ from scratch, and reset cache.
+      */
+      void computeFourierModes();
+
+      /**
+      * Add contribution of one atom to fourierModes_.
+      *
+      * \param position atomic position
+      * \param typeId   atom type index
+      * \param weight   prefactor (+1 to add, -1 to subtract)
+      */
+      void addAtomModes(const Vector& position, int typeId, double weight);
+
+      /**
+      * Allocate atom cache and phase factor arrays.
+      */
+      void allocateCache();
    };
 
    /**
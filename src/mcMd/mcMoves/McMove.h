@@ -135,6 +135,20 @@ namespace McMd
       */
       void incrementNAccept();
 
+      /**
+      * Add n to the number of attempted moves.
+      *
+      * \param n number of additional attempted moves
+      */
+      void incrementNAttempt(long n);
+
+      /**
+      * Add n to the number of accepted moves.
+      *
+      * \param n number of additional accepted moves
+      */
+      void incrementNAccept(long n);
+
       /**
       * Get parent Simulation object.
       */
@@ -197,6 +211,18 @@ namespace McMd
    inline void McMove::incrementNAccept()
    {  ++nAccept_; }
 
+   /*
+   * Add n to the number of attempted moves.
+   */
+   inline void McMove::incrementNAttempt(long n)
+   {  nAttempt_ += n; }
+
+   /*
+   * Add n to the number of accepted moves.
+   */
+   inline void McMove::incrementNAccept(long n)
+   {  nAccept_ += n; }
+
    /*
    * Get parent Simulation object.
    */
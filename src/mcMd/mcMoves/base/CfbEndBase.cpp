@@ -66,7 +66,7 @@ namespace McMd
    {
       Vector bondVec;
       Vector pvtPos = pvtPtr->position();
-      double trialEnergy, lengthSq, length;
+      double lengthSq, length;
    
       // Calculate bond length of pvt-end bond
       lengthSq = boundary().distanceSq(pvtPos, endPtr->position());
@@ -128,57 +128,50 @@ namespace McMd
       // This is the final value of inout energy parameter.
       energy += system().bondPotential().energy(lengthSq, bondType);
 
-      // Loop over nTrial - 1 additional trial positions:
-      for (int iTrial=0; iTrial < nTrial_ - 1; ++iTrial) {
-
+      // Generate nTrial - 1 additional trial positions
+      Vector trialPos[MaxTrial_];
+      double trialEnergy[MaxTrial_];
+      int    iTrial, nExtra = nTrial_ - 1;
+      for (iTrial=0; iTrial < nExtra; ++iTrial) {
          random().unitVector(bondVec);
          bondVec *= length;
-         endPtr->position().add(pvtPos, bondVec);  
-         boundary().shift(endPtr->position());
+         trialPos[iTrial].add(pvtPos, bondVec);  
+         boundary().shift(trialPos[iTrial]);
+      }
 
-         #ifndef INTER_NOPAIR
-         trialEnergy = system().pairPotential().atomEnergy(*endPtr);
-         #else
-         trialEnergy = 0.0;
-         #endif
+      // Calculate pair energies of all trials at once
+      #ifndef INTER_NOPAIR
+      system().pairPotential().trialEnergies(*endPtr, trialPos, nExtra, 
+                                             trialEnergy);
+      #else
+      for (iTrial=0; iTrial < nExtra; ++iTrial) {
+         trialEnergy[iTrial] = 0.0;
+      }
+      #endif
 
-         #ifdef INTER_ANGLE
-         if (system().hasAnglePotential()) {
+      // Loop over nTrial - 1 additional trial positions:
+      for (iTrial=0; iTrial < nExtra; ++iTrial) {
 
-            // Get the angle type and atom pointer at the angle.
-            endPtr->molecule().species().getAtomAngles(*endPtr, angles);
-            for (iAngle = 0; iAngle < angles.size(); ++iAngle) {
-               anglePtr = angles[iAngle];
-               if (&anglePtr->atom(1) == pvtPtr) {
-                  if (&anglePtr->atom(0) == endPtr) {
-                     pvtPtr2 = &anglePtr->atom(2);
-                  } else {
-                     pvtPtr2 = &anglePtr->atom(0);
-                  }
-                  angleTypeId = anglePtr->typeId();
-               }
-            }
+         endPtr->position() = trialPos[iTrial];
 
-            // Calculate energy.
-            rsq1 = boundary().distanceSq(pvtPtr->position(),
-                                         pvtPtr2->position(), dr1);
+         #ifdef INTER_ANGLE
+         if (system().hasAnglePotential()) {
             rsq2 = boundary().distanceSq(endPtr->position(),
                                          pvtPtr->position(), dr2);
             cosTheta = dr1.dot(dr2) / sqrt(rsq1 * rsq2);
-   
-            trialEnergy += system().anglePotential()
-                                   .energy(cosTheta, angleTypeId);
+            trialEnergy[iTrial] += system().anglePotential()
+                                           .energy(cosTheta, angleTypeId);
          }
          #endif
 
          #ifdef INTER_EXTERNAL
          if (system().hasExternalPotential()) {
-            trialEnergy += system().externalPotential()
-                                   .atomEnergy(*endPtr);
+            trialEnergy[iTrial] += system().externalPotential()
+                                           .atomEnergy(*endPtr);
          }
          #endif
 
-         rosenbluth += boltzmann(trialEnergy);
+         rosenbluth += boltzmann(trialEnergy[iTrial]);
       }
 
    }
@@ -212,40 +205,54 @@ namespace McMd
       length = 
          system().bondPotential().randomBondLength(&random(), beta, bondType);
    
-      // Loop over nTrial trial positions:
-      rosenbluth = 0.0;
+      // Generate nTrial trial positions
       for (iTrial=0; iTrial < nTrial_; ++iTrial) {
          random().unitVector(bondVec);
          bondVec *= length;
          // trialPos = pvtPos + bondVec
          trialPos[iTrial].add(pvtPos, bondVec); 
          boundary().shift(trialPos[iTrial]);
-         endPtr->position() = trialPos[iTrial];
-         #ifndef INTER_NOPAIR
-         trialEnergy[iTrial] = system().pairPotential().atomEnergy(*endPtr);
-         #else
+      }
+
+      // Calculate pair energies of all trials at once
+      #ifndef INTER_NOPAIR
+      system().pairPotential().trialEnergies(*endPtr, trialPos, nTrial_, 
+                                             trialEnergy);
+      #else
+      for (iTrial=0; iTrial < nTrial_; ++iTrial) {
          trialEnergy[iTrial] = 0.0;
-         #endif
+      }
+      #endif
 
-         #ifdef INTER_ANGLE
-         if (system().hasAnglePotential()) {
+      #ifdef INTER_ANGLE
+      if (system().hasAnglePotential()) {
 
-            endPtr->molecule().species().getAtomAngles(*endPtr, angles);
-            for (iAngle = 0; iAngle < angles.size(); ++iAngle) {
-               anglePtr = angles[iAngle];
-               if (&anglePtr->atom(1) == pvtPtr) {
-                  if (&anglePtr->atom(0) == endPtr) {
-                     pvtPtr2 = &anglePtr->atom(2);
-                  } else {
-                     pvtPtr2 = &anglePtr->atom(0);
-                  }
-                  angleTypeId = anglePtr->typeId();
+         // Get the angle type and pointers of atoms forming the angle.
+         endPtr->molecule().species().getAtomAngles(*endPtr, angles);
+         for (iAngle = 0; iAngle < angles.size(); ++iAngle) {
+            anglePtr = angles[iAngle];
+            if (&anglePtr->atom(1) == pvtPtr) {
+               if (&anglePtr->atom(0) == endPtr) {
+                  pvtPtr2 = &anglePtr->atom(2);
+               } else {
+                  pvtPtr2 = &anglePtr->atom(0);
                }
+               angleTypeId = anglePtr->typeId();
             }
-   
+         }
+         rsq1 = boundary().distanceSq(pvtPtr->position(),
+                                      pvtPtr2->position(), dr1);
+      }
+      #endif
+
+      // Loop over nTrial trial positions:
+      rosenbluth = 0.0;
+      for (iTrial=0; iTrial < nTrial_; ++iTrial) {
+         endPtr->position() = trialPos[iTrial];
+
+         #ifdef INTER_ANGLE
+         if (system().hasAnglePotential()) {
             // Get the angle spanned.
-            rsq1 = boundary().distanceSq(pvtPtr->position(),
-                                         pvtPtr2->position(), dr1);
             rsq2 = boundary().distanceSq(endPtr->position(),
                                          pvtPtr->position(), dr2);
             cosTheta = dr1.dot(dr2) / sqrt(rsq1 * rsq2);
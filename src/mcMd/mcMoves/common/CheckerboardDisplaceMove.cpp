@@ -0,0 +1,403 @@
+#ifndef MCMD_CHECKERBOARD_DISPLACE_MOVE_CPP
+#define MCMD_CHECKERBOARD_DISPLACE_MOVE_CPP
+
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2012, David Morse (morse012@umn.edu)
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "CheckerboardDisplaceMove.h"
+#include <mcMd/mcSimulation/McSystem.h>
+#include <mcMd/mcSimulation/mc_potentials.h>
+#include <mcMd/simulation/Simulation.h>
+#include <mcMd/species/Species.h>
+#include <mcMd/chemistry/Molecule.h>
+#include <mcMd/chemistry/Atom.h>
+#include <util/boundary/Boundary.h>
+#include <util/param/Parameter.h>
+#include <util/space/Vector.h>
+#include <util/space/Dimension.h>
+#include <util/global.h>
+
+#include <string>
+
+#ifndef INTER_NOPAIR
+namespace McMd
+{
+
+   using namespace Util;
+
+   /*
+   * Constructor
+   */
+   CheckerboardDisplaceMove::CheckerboardDisplaceMove(McSystem& system)
+    : SystemMove(system),
+      atomBlocks_(),
+      blockAtoms_(),
+      blockBegin_(),
+      blockSeeds_(),
+      nCells_(),
+      nBlocks_(),
+      offsets_(),
+      delta_(0.0),
+      nBlock_(0),
+      blockWidth_(2),
+      speciesId_(-1)
+   {
+      setClassName("CheckerboardDisplaceMove");
+      #ifdef INTER_TETHER
+      UTIL_THROW("CheckerboardDisplaceMove is unusable with tethers");
+      #endif
+      #ifdef MCMD_LINK
+      if (system.hasLinkPotential()) {
+         UTIL_THROW("CheckerboardDisplaceMove is unusable with links");
+      }
+      #endif
+      atomBlocks_.allocate(simulation().atomCapacity());
+      blockAtoms_.allocate(simulation().atomCapacity());
+   }
+
+   /*
+   * Read speciesId, delta and (optionally) blockWidth.
+   */
+   void CheckerboardDisplaceMove::readParameters(std::istream& in)
+   {
+      readProbability(in);
+      read<int>(in, "speciesId", speciesId_);
+      read<double>(in, "delta", delta_);
+      blockWidth_ = 2;
+      read<int>(in, "blockWidth", blockWidth_, false);
+      if (blockWidth_ < 1) {
+         UTIL_THROW("Invalid blockWidth");
+      }
+   }
+
+   /*
+   * Load internal state from an archive.
+   */
+   void CheckerboardDisplaceMove::loadParameters(Serializable::IArchive &ar)
+   {
+      McMove::loadParameters(ar);
+      loadParameter<int>(ar, "speciesId", speciesId_);
+      loadParameter<double>(ar, "delta", delta_);
+      blockWidth_ = 2;
+      loadParameter<int>(ar, "blockWidth", blockWidth_, false);
+   }
+
+   /*
+   * Save internal state to an archive.
+   */
+   void CheckerboardDisplaceMove::save(Serializable::OArchive &ar)
+   {
+      McMove::save(ar);
+      ar << speciesId_;
+      ar << delta_;
+      Parameter::saveOptional(ar, blockWidth_, (blockWidth_ != 2));
+   }
+
+   /*
+   * Attempt one sweep of atom displacements, one color at a time.
+   */
+   bool CheckerboardDisplaceMove::move()
+   {
+      int colors[NColor];
+      int i, j, k, color;
+      long nAccept = 0;
+
+      makeBlocks();
+      incrementNAttempt(blockBegin_[nBlock_]);
+
+      // Choose a random order of colors
+      for (i = 0; i < NColor; ++i) {
+         colors[i] = i;
+      }
+      for (i = NColor - 1; i > 0; --i) {
+         j = random().uniformInt(0, i + 1);
+         k = colors[i];
+         colors[i] = colors[j];
+         colors[j] = k;
+      }
+
+      std::string error;
+      for (i = 0; i < NColor; ++i) {
+         color = colors[i];
+
+         // Draw seeds for blocks of this color (serial, in block order)
+         for (k = 0; k < nBlock_; ++k) {
+            if (blockColor(k) == color) {
+               blockSeeds_[k] = random().uniformInt(1, 2147483647);
+            }
+         }
+
+         // Attempt moves in all blocks of this color
+         #ifdef UTIL_OPENMP
+         #pragma omp parallel reduction(+:nAccept)
+         #endif
+         {
+            Random blockRandom;
+            CellList::NeighborArray neighbors;
+            #ifdef UTIL_OPENMP
+            #pragma omp for schedule(dynamic)
+            #endif
+            for (int block = 0; block < nBlock_; ++block) {
+               if (blockColor(block) == color) {
+                  blockRandom.setSeed(blockSeeds_[block]);
+                  try {
+                     nAccept += attemptBlock(block, blockRandom, neighbors);
+                  } catch (Exception& e) {
+                     #ifdef UTIL_OPENMP
+                     #pragma omp critical
+                     #endif
+                     error = e.message();
+                  }
+               }
+            }
+         }
+
+         // Rethrow any exception thrown within the parallel region
+         if (!error.empty()) {
+            UTIL_THROW(error.c_str());
+         }
+      }
+      incrementNAccept(nAccept);
+
+      return (nAccept > 0);
+   }
+
+   /*
+   * Make a randomly shifted block grid, and sort atoms by block.
+   *
+   * Called by move() before any threads are started, so the offsets
+   * are drawn from the Simulation random number generator.
+   */
+   void CheckerboardDisplaceMove::makeBlocks()
+   {
+      const CellList& cellList = system().pairPotential().cellList();
+      int i;
+
+      nBlock_ = 1;
+      for (i = 0; i < Dimension; ++i) {
+         nCells_[i] = cellList.gridDimension(i);
+         nBlocks_[i] = 2*(nCells_[i]/(2*blockWidth_));
+         if (nBlocks_[i] < 2) {
+            UTIL_THROW("Cell grid too small for checkerboard");
+         }
+         offsets_[i] = random().uniformInt(0, nCells_[i]);
+         nBlock_ *= nBlocks_[i];
+      }
+      if (blockBegin_.capacity() < nBlock_ + 1) {
+         if (blockBegin_.isAllocated()) {
+            blockBegin_.deallocate();
+            blockSeeds_.deallocate();
+         }
+         blockBegin_.allocate(nBlock_ + 1);
+         blockSeeds_.allocate(nBlock_);
+      }
+      for (i = 0; i <= nBlock_; ++i) {
+         blockBegin_[i] = 0;
+      }
+
+      // Find block of each atom, and count atoms per block
+      System::MoleculeIterator molIter;
+      Molecule::AtomIterator   atomIter;
+      int block;
+      system().begin(speciesId_, molIter);
+      for ( ; molIter.notEnd(); ++molIter) {
+         for (molIter->begin(atomIter); atomIter.notEnd(); ++atomIter) {
+            block = blockIndex(atomIter->position());
+            atomBlocks_[atomIter->id()] = block;
+            ++blockBegin_[block + 1];
+         }
+      }
+
+      // Convert counts to offsets, and sort atoms by block
+      for (i = 0; i < nBlock_; ++i) {
+         blockBegin_[i+1] += blockBegin_[i];
+      }
+      system().begin(speciesId_, molIter);
+      for ( ; molIter.notEnd(); ++molIter) {
+         for (molIter->begin(atomIter); atomIter.notEnd(); ++atomIter) {
+            block = atomBlocks_[atomIter->id()];
+            blockAtoms_[blockBegin_[block]] = atomIter.get();
+            ++blockBegin_[block];
+         }
+      }
+      for (i = nBlock_; i > 0; --i) {
+         blockBegin_[i] = blockBegin_[i-1];
+      }
+      blockBegin_[0] = 0;
+   }
+
+   /*
+   * Return the index of the block containing a position.
+   *
+   * Cell coordinates are computed exactly as in CellList, so that
+   * each cell lies entirely within one block, and are then shifted
+   * periodically by the offset of the block grid.
+   */
+   int CheckerboardDisplaceMove::blockIndex(const Vector& position)
+   {
+      Vector r;
+      int i, c, block;
+      boundary().transformCartToGen(position, r);
+      block = 0;
+      for (i = 0; i < Dimension; ++i) {
+         c = int(r[i]*double(nCells_[i])) - offsets_[i];
+         if (c < 0) {
+            c += nCells_[i];
+         }
+         block = block*nBlocks_[i] + (c*nBlocks_[i])/nCells_[i];
+      }
+      return block;
+   }
+
+   /*
+   * Return the color of a block, from the parities of its coordinates.
+   */
+   int CheckerboardDisplaceMove::blockColor(int block) const
+   {
+      int color = 0;
+      for (int i = Dimension - 1; i >= 0; --i) {
+         color = 2*color + (block % nBlocks_[i]) % 2;
+         block /= nBlocks_[i];
+      }
+      return color;
+   }
+
+   /*
+   * Is every atom of a set of groups in the block, or in another color?
+   */
+   template <int N, int Capacity>
+   bool CheckerboardDisplaceMove::isFree(
+                   const FSArray<const Group<N>*, Capacity>& groups,
+                   int block) const
+   {
+      int color = blockColor(block);
+      int i, j, other;
+      for (i = 0; i < groups.size(); ++i) {
+         for (j = 0; j < N; ++j) {
+            other = atomBlocks_[groups[i]->atom(j).id()];
+            if (other != block && blockColor(other) == color) {
+               return false;
+            }
+         }
+      }
+      return true;
+   }
+
+   /*
+   * Can an atom be moved without affecting another block of its color?
+   *
+   * Atoms are confined to their blocks during a sweep, so the answer
+   * does not change while blocks of one color are being treated.
+   */
+   bool CheckerboardDisplaceMove::isFree(const Atom& atom, int block)
+   {
+      const Species& species = atom.molecule().species();
+      if (system().hasBondPotential()) {
+         Species::AtomBondArray bonds;
+         species.getAtomBonds(atom, bonds);
+         if (!isFree(bonds, block)) return false;
+      }
+      #ifdef INTER_ANGLE
+      if (system().hasAnglePotential()) {
+         Species::AtomAngleArray angles;
+         species.getAtomAngles(atom, angles);
+         if (!isFree(angles, block)) return false;
+      }
+      #endif
+      #ifdef INTER_DIHEDRAL
+      if (system().hasDihedralPotential()) {
+         Species::AtomDihedralArray dihedrals;
+         species.getAtomDihedrals(atom, dihedrals);
+         if (!isFree(dihedrals, block)) return false;
+      }
+      #endif
+      return true;
+   }
+
+   /*
+   * Return the potential energy of one atom, using a local neighbor array.
+   */
+   double
+   CheckerboardDisplaceMove::atomEnergy(const Atom& atom,
+                                        CellList::NeighborArray& neighbors)
+   {
+      double energy = system().pairPotential().atomEnergy(atom, neighbors);
+      if (system().hasBondPotential()) {
+         energy += system().bondPotential().atomEnergy(atom);
+      }
+      #ifdef INTER_ANGLE
+      if (system().hasAnglePotential()) {
+         energy += system().anglePotential().atomEnergy(atom);
+      }
+      #endif
+      #ifdef INTER_DIHEDRAL
+      if (system().hasDihedralPotential()) {
+         energy += system().dihedralPotential().atomEnergy(atom);
+      }
+      #endif
+      #ifdef INTER_EXTERNAL
+      if (system().hasExternalPotential()) {
+         energy += system().externalPotential().atomEnergy(atom);
+      }
+      #endif
+      return energy;
+   }
+
+   /*
+   * Attempt displacements of randomly chosen atoms in one block.
+   *
+   * The number of attempts equals the number of atoms in the block.
+   */
+   long
+   CheckerboardDisplaceMove::attemptBlock(int block, Random& random,
+                                          CellList::NeighborArray& neighbors)
+   {
+      Vector oldPos;
+      double newEnergy, oldEnergy;
+      Atom*  atomPtr;
+      int    begin = blockBegin_[block];
+      int    nAtom = blockBegin_[block + 1] - begin;
+      int    i, j;
+      long   nAccept = 0;
+
+      for (i = 0; i < nAtom; ++i) {
+
+         // Choose an atom of this block at random
+         atomPtr = blockAtoms_[begin + random.uniformInt(0, nAtom)];
+         if (!isFree(*atomPtr, block)) continue;
+
+         // Calculate current energy and store old position
+         oldPos    = atomPtr->position();
+         oldEnergy = atomEnergy(*atomPtr, neighbors);
+
+         for (j = 0; j < Dimension; ++j) {
+            atomPtr->position()[j] += random.uniform(-delta_, delta_);
+         }
+         boundary().shift(atomPtr->position());
+
+         // Reject moves that leave the block
+         if (blockIndex(atomPtr->position()) != block) {
+            atomPtr->position() = oldPos;
+            continue;
+         }
+         newEnergy = atomEnergy(*atomPtr, neighbors);
+
+         // Decide whether to accept move
+         if (random.metropolis(boltzmann(newEnergy - oldEnergy))) {
+            system().pairPotential().updateAtomCell(*atomPtr);
+            ++nAccept;
+         } else {
+            atomPtr->position() = oldPos;
+         }
+      }
+
+      return nAccept;
+   }
+
+}
+#endif // ifndef INTER_NOPAIR
+#endif
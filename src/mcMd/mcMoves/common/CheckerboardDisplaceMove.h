@@ -0,0 +1,176 @@
+#ifndef MCMD_CHECKERBOARD_DISPLACE_MOVE_H
+#define MCMD_CHECKERBOARD_DISPLACE_MOVE_H
+
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2012, David Morse (morse012@umn.edu)
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <mcMd/mcMoves/SystemMove.h>        // base class
+#include <mcMd/neighbor/CellList.h>         // typedef
+#include <mcMd/chemistry/Group.h>           // function template argument
+#include <util/random/Random.h>             // typedef
+#include <util/containers/DArray.h>         // member template
+#include <util/containers/FSArray.h>        // function template argument
+#include <util/space/IntVector.h>           // member
+#include <util/global.h>
+
+namespace McMd
+{
+
+   using namespace Util;
+
+   class McSystem;
+
+   /**
+   * Sweep of random single atom displacements, using threads.
+   *
+   * Each call to move() attempts, on average, one random displacement
+   * of each atom of one species, as for AtomDisplaceMove. The cells of
+   * the pair potential CellList are grouped into blocks, with an even
+   * number of blocks along each axis, and the blocks are colored like a
+   * three dimensional checkerboard, with 8 colors. The colors are visited
+   * in a random order. For each color, blocks of that color are treated
+   * concurrently, by OpenMP threads if UTIL_OPENMP is defined. Moves that
+   * would take an atom out of its block are rejected, as are moves of an
+   * atom that shares a bond, angle or dihedral with an atom in another
+   * block of the same color. Because blocks of the same color are never
+   * adjacent, and cells are at least as wide as the pair cutoff, moves
+   * in different blocks of the same color never interact. At the start
+   * of each sweep, the origin of the block grid is shifted along each
+   * axis by a random whole number of cells. Block boundaries thus move
+   * between sweeps, so that the rejection of moves that leave a block
+   * does not prevent atoms from diffusing through the system.
+   *
+   * Each block uses its own random number generator, seeded from that
+   * of the Simulation, so the outcome does not depend on the number of
+   * threads. The optional parameter blockWidth (default 2) is the minimum
+   * number of cells per block along each axis. Wider blocks reduce the
+   * overhead per block and the fraction of moves rejected at block 
+   * boundaries, but provide fewer blocks to share among threads. The 
+   * cell grid must have at least 2*blockWidth cells along each axis.
+   * A pair potential is required, and link and tether potentials are not
+   * supported.
+   *
+   * \ingroup McMd_McMove_Module
+   */
+   class CheckerboardDisplaceMove : public SystemMove
+   {
+
+   public:
+
+      /**
+      * Constructor.
+      */
+      CheckerboardDisplaceMove(McSystem& system);
+
+      /**
+      * Read species to which displacement is applied, delta and blockWidth.
+      */
+      virtual void readParameters(std::istream& in);
+
+      /**
+      * Load internal state from an archive.
+      *
+      * \param ar input/loading archive
+      */
+      virtual void loadParameters(Serializable::IArchive &ar);
+
+      /**
+      * Save internal state to an archive.
+      *
+      * \param ar output/saving archive
+      */
+      virtual void save(Serializable::OArchive &ar);
+
+      /**
+      * Attempt one sweep of atom displacements.
+      *
+      * Attempted and accepted displacements are counted individually.
+      *
+      * \return true if any displacement was accepted
+      */
+      virtual bool move();
+
+   private:
+
+      /// Number of colors of blocks.
+      static const int NColor = 8;
+
+      /// Block index for each atom of the species, indexed by atom id.
+      DArray<int> atomBlocks_;
+
+      /// Pointers to atoms of the species, sorted by block.
+      DArray<Atom*> blockAtoms_;
+
+      /// Index in blockAtoms_ of first atom in each block (nBlock + 1).
+      DArray<int> blockBegin_;
+
+      /// Random number generator seed for each block.
+      DArray<Random::SeedType> blockSeeds_;
+
+      /// Number of cells along each axis.
+      IntVector nCells_;
+
+      /// Number of blocks along each axis.
+      IntVector nBlocks_;
+
+      /// Offset of the block grid origin along each axis, in cells.
+      IntVector offsets_;
+
+      /// Maximum magnitude of displacement.
+      double delta_;
+
+      /// Total number of blocks.
+      int nBlock_;
+
+      /// Minimum number of cells per block along each axis.
+      int blockWidth_;
+
+      /// Integer Id of Species.
+      int speciesId_;
+
+      /*
+      * Make a randomly shifted block grid, and sort atoms by block.
+      */
+      void makeBlocks();
+
+      /*
+      * Return the index of the block containing a position.
+      */
+      int blockIndex(const Vector& position);
+
+      /*
+      * Return the color of a block.
+      */
+      int blockColor(int block) const;
+
+      /*
+      * Can an atom be moved without affecting another block of its color?
+      */
+      bool isFree(const Atom& atom, int block);
+
+      /*
+      * Is every atom of a set of groups in the block, or in another color?
+      */
+      template <int N, int Capacity>
+      bool isFree(const FSArray<const Group<N>*, Capacity>& groups, 
+                  int block) const;
+
+      /*
+      * Return the potential energy of one atom (thread safe).
+      */
+      double atomEnergy(const Atom& atom, CellList::NeighborArray& neighbors);
+
+      /*
+      * Attempt displacements of atoms in one block, return nAccept.
+      */
+      long attemptBlock(int block, Random& random,
+                        CellList::NeighborArray& neighbors);
+
+   };
+
+}
+#endif
@@ -1,5 +1,6 @@
 mcMd_mcMoves_common_=\
     mcMd/mcMoves/common/AtomDisplaceMove.cpp \
+    mcMd/mcMoves/common/CheckerboardDisplaceMove.cpp \
     mcMd/mcMoves/common/DpdMove.cpp \
     mcMd/mcMoves/common/HybridMdMove.cpp \
     mcMd/mcMoves/common/HybridNphMdMove.cpp \
@@ -331,16 +331,15 @@ namespace McMd
       isInitialized_ = true;
    }
 
+   /*
+   * Write a restart file with specified filename.
+   */
    void McSimulation::save(const std::string& filename)
    {
-      if (saveInterval_ > 0) {
-         if (iStep_ % saveInterval_ == 0) {
-            Serializable::OArchive ar;
-            fileMaster().openRestartOFile(filename, ".rst", ar.file());
-            save(ar);
-            ar.file().close();
-         }
-      }
+      Serializable::OArchive ar;
+      fileMaster().openRestartOFile(filename, ".rst", ar.file());
+      save(ar);
+      ar.file().close();
    }
 
    /*
@@ -637,10 +636,17 @@ namespace McMd
       timer.start();
       for ( ; iStep_ < endStep; ++iStep_) {
 
-         // Analyzers and restart outut
+         // Write restart file, before sampling so that a continuation
+         // does not sample this step twice
+         if (saveInterval_ > 0) {
+            if (iStep_ % saveInterval_ == 0) {
+               save(saveFileName_);
+            }
+         }
+
+         // Sample scheduled analyzers
          if (Analyzer::baseInterval > 0) {
             if (iStep_ % Analyzer::baseInterval == 0) {
-               save(saveFileName_);
                analyzerManager().sample(iStep_);
             }
          }
@@ -670,11 +676,15 @@ namespace McMd
       timer.stop();
       double time = timer.time();
 
-      // Final analyzers / save
+      // Final restart and analyzers
       assert(iStep_ == endStep);
+      if (saveInterval_ > 0) {
+         if (iStep_ % saveInterval_ == 0) {
+            save(saveFileName_);
+         }
+      }
       if (Analyzer::baseInterval > 0) {
          if (iStep_ % Analyzer::baseInterval == 0) {
-            save(saveFileName_);
             analyzerManager().sample(iStep_);
          }
       }
@@ -0,0 +1,233 @@
+#ifndef MCMD_NVE_RESPA_INTEGRATOR_CPP
+#define MCMD_NVE_RESPA_INTEGRATOR_CPP
+
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2012, David Morse (morse012@umn.edu)
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "NveRespaIntegrator.h"
+#include <mcMd/mdSimulation/MdSystem.h>
+#include <mcMd/simulation/Simulation.h>
+#include <mcMd/potentials/pair/MdPairPotential.h>
+#include <mcMd/chemistry/Molecule.h>
+#include <mcMd/chemistry/Atom.h>
+#include <util/archives/Serializable_includes.h>
+
+namespace McMd
+{
+
+   using namespace Util;
+
+   /* 
+   * Constructor.   
+   */
+   NveRespaIntegrator::NveRespaIntegrator(MdSystem& system)
+   : MdIntegrator(system),
+     nInner_(1)
+   {  setClassName("NveRespaIntegrator"); }
+
+   /* 
+   * Destructor.   
+   */
+   NveRespaIntegrator::~NveRespaIntegrator() 
+   {}
+
+   /* 
+   * Read parameters and allocate arrays.
+   */
+   void NveRespaIntegrator::readParameters(std::istream &in) 
+   {
+      read<double>(in, "dt", dt_);
+      read<int>(in, "nInner", nInner_);
+      if (nInner_ < 1) {
+         UTIL_THROW("nInner must be positive");
+      }
+      allocate();
+   }
+
+   /*
+   * Load the internal state from an archive.
+   */
+   void NveRespaIntegrator::loadParameters(Serializable::IArchive& ar)
+   {  
+      loadParameter<double>(ar, "dt", dt_);
+      loadParameter<int>(ar, "nInner", nInner_);
+      allocate();
+      ar & prefactors_;
+      ar & innerPrefactors_;
+      ar & fastForces_;
+   }
+
+   /*
+   * Save the internal state to an archive.
+   */
+   void NveRespaIntegrator::save(Serializable::OArchive& ar)
+   {  
+      ar & dt_;
+      ar & nInner_;
+      ar & prefactors_;
+      ar & innerPrefactors_;
+      ar & fastForces_;
+   }
+
+   /*
+   * Allocate arrays (private).
+   */
+   void NveRespaIntegrator::allocate()
+   {
+      int nAtomType = simulation().nAtomType();
+      prefactors_.allocate(nAtomType);
+      innerPrefactors_.allocate(nAtomType);
+      fastForces_.allocate(simulation().atomCapacity());
+   }
+
+   /* 
+   * Initialize constants and forces.
+   */
+   void NveRespaIntegrator::setup() 
+   {
+      double mass;
+      int nAtomType = prefactors_.capacity();
+      for (int i = 0; i < nAtomType; ++i) {
+         mass = simulation().atomType(i).mass();
+         prefactors_[i] = 0.5*dt_/mass;
+         innerPrefactors_[i] = 0.5*dt_/(mass*double(nInner_));
+      }
+      computeForces();
+   }
+
+   /*
+   * Compute all forces, and store the fast forces (private).
+   *
+   * On exit, each atom force is the sum of fast and slow forces.
+   */
+   void NveRespaIntegrator::computeForces()
+   {
+      System::MoleculeIterator molIter;
+      Atom* atomPtr;
+      int iSpecies, nSpecies, ia;
+
+      system().setZeroForces();
+      system().addBondedForces();
+      nSpecies = simulation().nSpecies();
+      for (iSpecies=0; iSpecies < nSpecies; ++iSpecies) {
+         system().begin(iSpecies, molIter); 
+         for ( ; molIter.notEnd(); ++molIter) {
+            for (ia=0; ia < molIter->nAtom(); ++ia) {
+               atomPtr = &molIter->atom(ia);
+               fastForces_[atomPtr->id()] = atomPtr->force();
+            }
+         }
+      }
+      system().addNonBondedForces();
+   }
+
+   /*
+   * Reversible RESPA NVE integrator step.
+   *
+   * With fast forces f and slow forces g, inner time step h = dt/nInner,
+   * this implements the algorithm:
+   *
+   *        v += 0.5*g*dt/m
+   *        repeat nInner times:
+   *           v += 0.5*f*h/m
+   *           x += v*h
+   *           calculate fast forces f
+   *           v += 0.5*f*h/m
+   *        calculate slow forces g
+   *        v += 0.5*g*dt/m
+   *
+   * Consecutive half step velocity updates are combined. On entry and 
+   * exit, each atom force is f + g, and the value of f is also stored
+   * in fastForces_.
+   */
+   void NveRespaIntegrator::step() 
+   {
+      Vector dv;
+      Vector dr;
+      Vector slow;
+      System::MoleculeIterator molIter;
+      Atom* atomPtr;
+      double prefactor, innerPrefactor;
+      double h = dt_/double(nInner_);
+      int iSpecies, nSpecies, ia, iInner;
+
+      nSpecies = simulation().nSpecies();
+
+      // Half step with slow forces, first inner step with fast forces
+      for (iSpecies=0; iSpecies < nSpecies; ++iSpecies) {
+         system().begin(iSpecies, molIter); 
+         for ( ; molIter.notEnd(); ++molIter) {
+            for (ia=0; ia < molIter->nAtom(); ++ia) {
+               atomPtr = &molIter->atom(ia);
+               const Vector& fast = fastForces_[atomPtr->id()];
+               prefactor = prefactors_[atomPtr->typeId()];
+               innerPrefactor = innerPrefactors_[atomPtr->typeId()];
+
+               slow.subtract(atomPtr->force(), fast);
+               dv.multiply(slow, prefactor);
+               atomPtr->velocity() += dv;
+               dv.multiply(fast, innerPrefactor);
+               atomPtr->velocity() += dv;
+
+               dr.multiply(atomPtr->velocity(), h);
+               atomPtr->position() += dr;
+            }
+         }
+      }
+
+      // Remaining inner steps, with fast forces only
+      for (iInner = 1; iInner < nInner_; ++iInner) {
+         system().setZeroForces();
+         system().addBondedForces();
+         for (iSpecies=0; iSpecies < nSpecies; ++iSpecies) {
+            system().begin(iSpecies, molIter); 
+            for ( ; molIter.notEnd(); ++molIter) {
+               for (ia=0; ia < molIter->nAtom(); ++ia) {
+                  atomPtr = &molIter->atom(ia);
+                  innerPrefactor = innerPrefactors_[atomPtr->typeId()];
+
+                  dv.multiply(atomPtr->force(), 2.0*innerPrefactor);
+                  atomPtr->velocity() += dv;
+
+                  dr.multiply(atomPtr->velocity(), h);
+                  atomPtr->position() += dr;
+               }
+            }
+         }
+      }
+
+      computeForces();
+
+      // Last half inner step with fast forces, half step with slow forces
+      for (iSpecies=0; iSpecies < nSpecies; ++iSpecies) {
+         system().begin(iSpecies, molIter); 
+         for ( ; molIter.notEnd(); ++molIter) {
+            for (ia=0; ia < molIter->nAtom(); ++ia) {
+               atomPtr = &molIter->atom(ia);
+               const Vector& fast = fastForces_[atomPtr->id()];
+               prefactor = prefactors_[atomPtr->typeId()];
+               innerPrefactor = innerPrefactors_[atomPtr->typeId()];
+
+               slow.subtract(atomPtr->force(), fast);
+               dv.multiply(slow, prefactor);
+               atomPtr->velocity() += dv;
+               dv.multiply(fast, innerPrefactor);
+               atomPtr->velocity() += dv;
+            }
+         }
+      }
+
+      #ifndef INTER_NOPAIR
+      if (!system().pairPotential().isPairListCurrent()) {
+         system().pairPotential().buildPairList();
+      }
+      #endif
+
+   }
+
+}
+#endif
@@ -0,0 +1,99 @@
+#ifndef MCMD_NVE_RESPA_INTEGRATOR_H
+#define MCMD_NVE_RESPA_INTEGRATOR_H
+
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2012, David Morse (morse012@umn.edu)
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <mcMd/mdIntegrators/MdIntegrator.h>
+#include <util/containers/DArray.h>
+#include <util/space/Vector.h>
+
+#include <iostream>
+
+namespace McMd
+{
+
+   using namespace Util;
+
+   /**
+   * An NVE multiple time step (RESPA) molecular dynamics integrator.
+   *
+   * Forces are split into fast forces, from the bonded and tether
+   * potentials, and slow forces, from the pair and external potentials.
+   * Each step of length dt is divided into nInner inner velocity-Verlet 
+   * steps of length dt/nInner, which use only the fast forces. The slow 
+   * forces are evaluated once per step, and applied as half-step impulses
+   * at its beginning and end (reversible RESPA). 
+   *
+   * \ingroup McMd_MdIntegrator_Module
+   */
+   class NveRespaIntegrator : public MdIntegrator
+   {
+   
+   public:
+
+      /// Constructor. 
+      NveRespaIntegrator(MdSystem& system);
+ 
+      /// Destructor.   
+      virtual ~NveRespaIntegrator();
+
+      /**
+      * Read parameters dt and nInner.
+      *
+      * \param in input file stream.
+      */
+      virtual void readParameters(std::istream &in);
+
+      /**
+      * Load the internal state to an archive.
+      *
+      * \param ar archive object.
+      */
+      virtual void loadParameters(Serializable::IArchive& ar);
+
+      /**
+      * Save the internal state to an archive.
+      *
+      * \param ar archive object.
+      */
+      virtual void save(Serializable::OArchive& ar);
+
+      /**
+      * Compute prefactors and fast forces before main loop.
+      */
+      virtual void setup();
+
+      /**
+      * Take a complete NVE RESPA step, of length dt.
+      */
+      virtual void step();
+
+   private:
+
+      /// Fast forces for all atoms, indexed by Atom::id().
+      DArray<Vector> fastForces_;
+
+      /// Factors of 0.5*dt/mass for different atom types.
+      DArray<double> prefactors_;
+
+      /// Factors of 0.5*(dt/nInner)/mass for different atom types.
+      DArray<double> innerPrefactors_;
+
+      /// Number of inner steps per step.
+      int nInner_;
+
+      /// Allocate arrays.
+      void allocate();
+
+      /// Compute fast forces, store them, and add slow forces.
+      void computeForces();
+
+   }; 
+
+} 
+#endif
@@ -656,7 +656,6 @@ namespace McMd
    {
       Timer             timer;
       std::stringstream indexString;
-      std::fstream*     trajectoryFile;
       TrajectoryIo*     trajectoryIo;
       int nFrames; 
 
@@ -669,18 +668,8 @@ namespace McMd
 
       Log::file() << "reading " << filename << std::endl;
 
-      // Open trajectory file
-      trajectoryFile = new std::fstream();
-      trajectoryFile->open(filename.c_str(), std::ios::in | std::ios::binary);
-
-      if (trajectoryFile->fail()) {
-        std::string message;
-        message= "Error opening trajectory file. Filename: " + filename;
-        UTIL_THROW(message.c_str());
-      }
-
-      // read in information from trajectory file
-      trajectoryIo->readHeader(*trajectoryFile);
+      // Open trajectory file, and read header information
+      trajectoryIo->open(filename);
 
       nFrames = trajectoryIo->nFrames();
 
@@ -697,10 +686,31 @@ namespace McMd
       if (max < 0 || max >= nFrames)  UTIL_THROW("max < 0 or max >= nFrames!");
       if (max < min)  UTIL_THROW("max < min!");
 
-      for (iStep_ = 0; iStep_ <= max; ++iStep_) {
-
-         // Read frames, even if they are not sampled
-         trajectoryIo->readFrame(*trajectoryFile);
+      // Frames other than min that are not multiples of baseInterval are
+      // never sampled, and so are skipped. If the TrajectoryIo supports
+      // random access, skipped frames are not read at all. Otherwise, they
+      // are read, but the pair list is only built for sampled frames.
+      long frameId = 0;   // index of next frame in file
+      int  nSample = 0;   // number of frames analyzed
+      bool isSeekable = trajectoryIo->seekFrame(min);
+      if (isSeekable) frameId = min;
+      iStep_ = min;
+      while (iStep_ <= max) {
+
+         // Skip to frame iStep_
+         if (isSeekable) {
+            if (frameId != iStep_) {
+               trajectoryIo->seekFrame(iStep_);
+               frameId = iStep_;
+            }
+         } else {
+            while (frameId < iStep_) {
+               trajectoryIo->readFrame();
+               ++frameId;
+            }
+         }
+         trajectoryIo->readFrame();
+         ++frameId;
 
          #ifndef INTER_NOPAIR
          // Build the system CellList
@@ -714,29 +724,30 @@ namespace McMd
          // Initialize analyzers (taking in molecular information).
          if (iStep_ == min) analyzerManager().setup();
 
-         // Sample property values only for iStep >= min
-         if (iStep_ >= min) analyzerManager().sample(iStep_);
+         analyzerManager().sample(iStep_);
+         ++nSample;
 
+         // Advance to next multiple of baseInterval
+         iStep_ = (iStep_/Analyzer::baseInterval + 1)*Analyzer::baseInterval;
       }
       timer.stop();
       Log::file() << "end main loop" << std::endl;
 
       // Close trajectory file
-      trajectoryFile->close();
+      trajectoryIo->close();
 
       // delete objects
       delete trajectoryIo;
-      delete trajectoryFile;
 
       // Output results of all analyzers to output files
       analyzerManager().output();
 
       // Output time 
       Log::file() << std::endl;
-      Log::file() << "nFrames       " << max-min+1 << std::endl;
+      Log::file() << "nFrames       " << nSample << std::endl;
       Log::file() << "run time      " << timer.time() 
                   << "  sec" << std::endl;
-      Log::file() << "time / frame " << timer.time()/double(nFrames) 
+      Log::file() << "time / frame " << timer.time()/double(nSample) 
                   << "  sec" << std::endl;
       Log::file() << std::endl;
 
@@ -679,6 +679,51 @@ namespace McMd
       #endif
    }
 
+   /*
+   * Add bonded and tether forces.
+   */
+   void MdSystem::addBondedForces()
+   {
+      if (hasBondPotential()) {
+         bondPotential().addForces();
+      }
+      #ifdef INTER_ANGLE
+      if (hasAnglePotential()) {
+         anglePotential().addForces();
+      }
+      #endif
+      #ifdef INTER_DIHEDRAL
+      if (hasDihedralPotential()) {
+         dihedralPotential().addForces();
+      }
+      #endif
+      #ifdef MCMD_LINK
+      if (hasLinkPotential()) {
+         linkPotential().addForces();
+      }
+      #endif
+      #ifdef INTER_TETHER
+      if (tetherPotentialPtr_) {
+         tetherPotential().addForces();
+      }
+      #endif
+   }
+
+   /*
+   * Add pair and external forces.
+   */
+   void MdSystem::addNonBondedForces()
+   {
+      #ifndef INTER_NOPAIR
+      pairPotential().addForces();
+      #endif
+      #ifdef INTER_EXTERNAL
+      if (hasExternalPotential()) {
+         externalPotential().addForces();
+      }
+      #endif
+   }
+
    /*
    * Calculate and return total potential energy.
    */
@@ -139,6 +139,26 @@ namespace McMd
       */
       void calculateForces();
 
+      /**
+      * Add forces arising from bonded and tether potentials.
+      *
+      * Adds forces computed by the bond, angle, dihedral, link and 
+      * tether potentials (if any) to the current atomic forces,
+      * without first zeroing them. These are the stiff, inexpensive
+      * forces that are evaluated on the inner steps of a multiple
+      * time step integrator.
+      */
+      void addBondedForces();
+
+      /**
+      * Add forces arising from pair and external potentials.
+      *
+      * Adds forces computed by the pair and external potentials to 
+      * the current atomic forces, without first zeroing them. The 
+      * pair list is updated if necessary.
+      */
+      void addNonBondedForces();
+
       /**
       * Compute and return total kinetic energy.
       */
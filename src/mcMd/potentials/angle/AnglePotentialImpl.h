@@ -10,6 +10,7 @@
 
 #include <mcMd/potentials/angle/AnglePotential.h>  // base class
 #include <mcMd/simulation/SubSystem.h>             // base class
+#include <mcMd/simulation/GroupList.h>             // member
 #include <util/global.h>
 
 namespace Util
@@ -169,7 +170,10 @@ namespace McMd
       virtual double atomEnergy(const Atom& atom) const;
 
       /**
-      * Calculate the angle energy for one Atom.
+      * Add angle forces to all atomic forces.
+      *
+      * Iterates over a flat list of angles, which is rebuilt only when 
+      * molecules are added to or removed from the System.
       */
       virtual void addForces();
 
@@ -203,6 +207,9 @@ namespace McMd
 
    private:
   
+      /// Flat list of all angles in the System.
+      GroupList<3> angleList_;
+
       Interaction* interactionPtr_;
 
       bool isCopy_;
@@ -239,6 +246,7 @@ namespace McMd
    AnglePotentialImpl<Interaction>::AnglePotentialImpl(System& system)
     : AnglePotential(),
       SubSystem(system),
+      angleList_(system),
       interactionPtr_(0),
       isCopy_(false)
    {  interactionPtr_ = new Interaction(); }
@@ -251,6 +259,7 @@ namespace McMd
                          AnglePotentialImpl<Interaction>& other)
     : AnglePotential(),
       SubSystem(other.system()),
+      angleList_(other.system()),
       interactionPtr_(&other.interaction()),
       isCopy_(true)
    {}
@@ -406,32 +415,26 @@ namespace McMd
    template <class Interaction>
    void AnglePotentialImpl<Interaction>::addForces() 
    {
+      const Boundary& boundary = this->boundary();
+      const Interaction& interaction = this->interaction();
       Vector dr1, dr2, force1, force2;
-      System::MoleculeIterator molIter;
-      Molecule::AngleIterator angleIter;
       Atom *atom0Ptr, *atom1Ptr, *atom2Ptr;
-      int iSpec;
-
-      for (iSpec=0; iSpec < simulation().nSpecies(); ++iSpec) {
-         if (simulation().species(iSpec).nAngle() > 0) {
-            for (begin(iSpec, molIter); molIter.notEnd(); ++molIter) {
-               for (molIter->begin(angleIter); angleIter.notEnd(); ++angleIter){
-                  atom0Ptr = &(angleIter->atom(0));
-                  atom1Ptr = &(angleIter->atom(1));
-                  atom2Ptr = &(angleIter->atom(2));
-                  boundary().distanceSq(atom1Ptr->position(),
-                                        atom0Ptr->position(), dr1);
-                  boundary().distanceSq(atom2Ptr->position(),
-                                        atom1Ptr->position(), dr2);
-                  interaction().force(dr1, dr2, force1, force2,
-                                    angleIter->typeId());
-                  atom0Ptr->force() += force1;
-                  atom1Ptr->force() -= force1;
-                  atom1Ptr->force() += force2;
-                  atom2Ptr->force() -= force2;
-               }
-            }
-         }
+      int i, nAngle;
+
+      angleList_.update();
+      nAngle = angleList_.size();
+      for (i = 0; i < nAngle; ++i) {
+         const typename GroupList<3>::Entry& angle = angleList_[i];
+         atom0Ptr = angle.atomPtrs[0];
+         atom1Ptr = angle.atomPtrs[1];
+         atom2Ptr = angle.atomPtrs[2];
+         boundary.distanceSq(atom1Ptr->position(), atom0Ptr->position(), dr1);
+         boundary.distanceSq(atom2Ptr->position(), atom1Ptr->position(), dr2);
+         interaction.force(dr1, dr2, force1, force2, angle.typeId);
+         atom0Ptr->force() += force1;
+         atom1Ptr->force() -= force1;
+         atom1Ptr->force() += force2;
+         atom2Ptr->force() -= force2;
       }
    }
 
@@ -10,6 +10,7 @@
 
 #include <mcMd/potentials/bond/BondPotential.h>
 #include <mcMd/simulation/SubSystem.h>
+#include <mcMd/simulation/GroupList.h>
 #include <util/global.h>
 
 namespace Util
@@ -132,6 +133,9 @@ namespace McMd
 
       /**
       * Add the bond forces for all atoms.
+      *
+      * Iterates over a flat list of bonds, which is rebuilt only when 
+      * molecules are added to or removed from the System.
       */
       void addForces();
 
@@ -175,6 +179,9 @@ namespace McMd
 
    private:
   
+      /// Flat list of all bonds in the System.
+      GroupList<2> bondList_;
+
       Interaction* interactionPtr_;
 
       bool isCopy_;
@@ -211,6 +218,7 @@ namespace McMd
    BondPotentialImpl<Interaction>::BondPotentialImpl(System& system)
     : BondPotential(),
       SubSystem(system),
+      bondList_(system),
       interactionPtr_(0),
       isCopy_(false)
    { interactionPtr_ = new Interaction(); }
@@ -222,6 +230,7 @@ namespace McMd
    BondPotentialImpl<Interaction>::BondPotentialImpl(
                          BondPotentialImpl<Interaction>& other)
     : BondPotential(other.system()),
+      bondList_(other.system()),
       interactionPtr_(&other.interaction()),
       isCopy_(true)
    {}
@@ -363,28 +372,25 @@ namespace McMd
    template <class Interaction>
    void BondPotentialImpl<Interaction>::addForces() 
    {
+      const Boundary& boundary = this->boundary();
+      const Interaction& interaction = this->interaction();
       Vector force;
       double rsq;
-      System::MoleculeIterator molIter;
-      Molecule::BondIterator bondIter;
       Atom *atom0Ptr, *atom1Ptr;
-      int iSpec;
+      int i, nBond;
 
       // Loop over all bonds in system
-      for (iSpec=0; iSpec < simulation().nSpecies(); ++iSpec) {
-         if (simulation().species(iSpec).nBond() > 0) {
-            for (begin(iSpec, molIter); molIter.notEnd(); ++molIter) {
-               for (molIter->begin(bondIter); bondIter.notEnd(); ++bondIter) {
-                  atom0Ptr = &(bondIter->atom(0));
-                  atom1Ptr = &(bondIter->atom(1));
-                  rsq = boundary().distanceSq(atom0Ptr->position(), 
-                                              atom1Ptr->position(), force);
-                  force *= interaction().forceOverR(rsq, bondIter->typeId());
-                  atom0Ptr->force() += force;
-                  atom1Ptr->force() -= force;
-               }
-            }
-         }
+      bondList_.update();
+      nBond = bondList_.size();
+      for (i = 0; i < nBond; ++i) {
+         const typename GroupList<2>::Entry& bond = bondList_[i];
+         atom0Ptr = bond.atomPtrs[0];
+         atom1Ptr = bond.atomPtrs[1];
+         rsq = boundary.distanceSq(atom0Ptr->position(), 
+                                   atom1Ptr->position(), force);
+         force *= interaction.forceOverR(rsq, bond.typeId);
+         atom0Ptr->force() += force;
+         atom1Ptr->force() -= force;
       }
    }
 
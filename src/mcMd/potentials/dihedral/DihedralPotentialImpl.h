@@ -10,6 +10,7 @@
 
 #include <mcMd/potentials/dihedral/DihedralPotential.h>  // base class
 #include <mcMd/simulation/SubSystem.h>                   // base class
+#include <mcMd/simulation/GroupList.h>                   // member
 #include <util/global.h>
 
 namespace Util
@@ -167,6 +168,9 @@ namespace McMd
 
       /**
       * Add dihedral forces to all atomic forces.
+      *
+      * Iterates over a flat list of dihedrals, which is rebuilt only 
+      * when molecules are added to or removed from the System.
       */
       virtual void addForces();
 
@@ -195,6 +199,9 @@ namespace McMd
 
    private:
   
+      /// Flat list of all dihedrals in the System.
+      GroupList<4> dihedralList_;
+
       Interaction* interactionPtr_;
 
       bool isCopy_;
@@ -231,6 +238,7 @@ namespace McMd
    DihedralPotentialImpl<Interaction>::DihedralPotentialImpl(System& system)
     : DihedralPotential(),
       SubSystem(system),
+      dihedralList_(system),
       interactionPtr_(0),
       isCopy_(false)
    {  interactionPtr_ = new Interaction(); }
@@ -243,6 +251,7 @@ namespace McMd
                          DihedralPotentialImpl<Interaction>& other)
     : DihedralPotential(),
       SubSystem(other.system()),
+      dihedralList_(other.system()),
       interactionPtr_(&other.interaction()),
       isCopy_(true)
    {}
@@ -383,41 +392,33 @@ namespace McMd
    template <class Interaction>
    void DihedralPotentialImpl<Interaction>::addForces() 
    {
+      const Boundary& boundary = this->boundary();
+      const Interaction& interaction = this->interaction();
       Vector dr1, dr2, dr3, force1, force2, force3;
       Atom *atom0Ptr, *atom1Ptr, *atom2Ptr, *atom3Ptr;
-      int iSpec;
-
-      System::MoleculeIterator molIter;
-      Molecule::DihedralIterator dihedralIter;
-      for (iSpec=0; iSpec < simulation().nSpecies(); ++iSpec) {
-         if (simulation().species(iSpec).nDihedral() > 0) {
-            for (begin(iSpec, molIter); molIter.notEnd(); ++molIter) {
-               molIter->begin(dihedralIter); 
-               for ( ; dihedralIter.notEnd(); ++dihedralIter) {
-
-                  atom0Ptr = &(dihedralIter->atom(0));
-                  atom1Ptr = &(dihedralIter->atom(1));
-                  atom2Ptr = &(dihedralIter->atom(2));
-                  atom3Ptr = &(dihedralIter->atom(3));
-
-                  boundary().distanceSq(atom1Ptr->position(),
-                                        atom0Ptr->position(), dr1);
-                  boundary().distanceSq(atom2Ptr->position(),
-                                        atom1Ptr->position(), dr2);
-                  boundary().distanceSq(atom3Ptr->position(),
-                                        atom2Ptr->position(), dr3);
-                  interaction().force(dr1, dr2, dr3,
-                     force1, force2, force3, dihedralIter->typeId());
-
-                  atom0Ptr->force() += force1;
-                  atom1Ptr->force() -= force1;
-                  atom1Ptr->force() += force2;
-                  atom2Ptr->force() -= force2;
-                  atom2Ptr->force() += force3;
-                  atom3Ptr->force() -= force3;
-               }
-            }
-         }
+      int i, nDihedral;
+
+      dihedralList_.update();
+      nDihedral = dihedralList_.size();
+      for (i = 0; i < nDihedral; ++i) {
+         const typename GroupList<4>::Entry& dihedral = dihedralList_[i];
+         atom0Ptr = dihedral.atomPtrs[0];
+         atom1Ptr = dihedral.atomPtrs[1];
+         atom2Ptr = dihedral.atomPtrs[2];
+         atom3Ptr = dihedral.atomPtrs[3];
+
+         boundary.distanceSq(atom1Ptr->position(), atom0Ptr->position(), dr1);
+         boundary.distanceSq(atom2Ptr->position(), atom1Ptr->position(), dr2);
+         boundary.distanceSq(atom3Ptr->position(), atom2Ptr->position(), dr3);
+         interaction.force(dr1, dr2, dr3, force1, force2, force3, 
+                           dihedral.typeId);
+
+         atom0Ptr->force() += force1;
+         atom1Ptr->force() -= force1;
+         atom1Ptr->force() += force2;
+         atom2Ptr->force() -= force2;
+         atom2Ptr->force() += force3;
+         atom3Ptr->force() -= force3;
       }
    }
 
@@ -12,6 +12,7 @@
 #include <mcMd/simulation/SubSystem.h>             // base class
 #include <mcMd/potentials/pair/PairPotential.h>    // base class
 #include <mcMd/neighbor/CellList.h>                // member
+#include <util/containers/GArray.h>                // member
 
 #include <util/global.h>
 
@@ -54,6 +55,40 @@ namespace McMd
       */
       virtual double atomEnergy(const Atom& atom) const = 0;
 
+      /**
+      * Calculate the nonbonded pair energy for one Atom.
+      *
+      * This variant uses a neighbor array provided by the caller, rather 
+      * than an internal array. It may thus be called concurrently from 
+      * several threads, each with its own array, as long as no thread
+      * moves atoms in cells neighboring those of another.
+      *
+      * \param  atom Atom object of interest
+      * \param  neighbors work array for neighbors
+      * \return nonbonded pair potential energy of atom
+      */
+      virtual double 
+      atomEnergy(const Atom& atom, CellList::NeighborArray& neighbors) const 
+      = 0;
+
+      /**
+      * Calculate the nonbonded pair energy for one Atom at trial positions.
+      *
+      * Upon return, energies[i] is the value that atomEnergy(atom) would 
+      * return if atom.position() were equal to positions[i], for each
+      * of nTrial trial positions. The position of atom is not used.
+      * Trial positions that lie in the same cell share one neighbor
+      * list, from which the atom itself and masked atoms are removed
+      * only once.
+      *
+      * \param atom      Atom object of interest
+      * \param positions array of nTrial trial positions
+      * \param nTrial    number of trial positions
+      * \param energies  array of nTrial energies (output)
+      */
+      virtual void trialEnergies(const Atom& atom, const Vector* positions,
+                                 int nTrial, double* energies) const = 0;
+
       /**
       * Calculate the nonbonded pair energy for an entire Molecule.
       *
@@ -130,6 +165,12 @@ namespace McMd
       /// Array to hold neighbors returned by a CellList.
       mutable CellList::NeighborArray neighbors_;
 
+      /// Array of unmasked neighbors, shared by trials in one cell.
+      mutable CellList::NeighborArray trialNeighbors_;
+
+      /// Cell indices of trial positions.
+      mutable GArray<int> trialCells_;
+
       /// Cell list for atom positions.
       CellList  cellList_;
 
@@ -137,6 +137,27 @@ namespace McMd
       */
       double atomEnergy(const Atom& atom) const;
 
+      /**
+      * Calculate the nonbonded pair energy for one Atom.
+      *
+      * \param  atom Atom object of interest
+      * \param  neighbors work array for neighbors
+      * \return nonbonded pair potential energy of atom
+      */
+      double 
+      atomEnergy(const Atom& atom, CellList::NeighborArray& neighbors) const;
+
+      /**
+      * Calculate the nonbonded pair energy for one Atom at trial positions.
+      *
+      * \param atom      Atom object of interest
+      * \param positions array of nTrial trial positions
+      * \param nTrial    number of trial positions
+      * \param energies  array of nTrial energies (output)
+      */
+      void trialEnergies(const Atom& atom, const Vector* positions,
+                         int nTrial, double* energies) const;
+
       /**
       * Calculate the nonbonded pair energy for an entire Molecule.
       *
@@ -302,6 +323,15 @@ namespace McMd
    */
    template <class Interaction>
    double McPairPotentialImpl<Interaction>::atomEnergy(const Atom &atom) const
+   {  return atomEnergy(atom, neighbors_); }
+
+   /* 
+   * Return nonbonded pair energy for one Atom, using a given neighbor array.
+   */
+   template <class Interaction>
+   double 
+   McPairPotentialImpl<Interaction>::atomEnergy(const Atom &atom, 
+                                   CellList::NeighborArray& neighbors) const
    {
       Atom   *jAtomPtr;
       double  energy;
@@ -310,13 +340,13 @@ namespace McMd
       int     id = atom.id();
 
       // Get array of neighbors
-      cellList_.getNeighbors(atom.position(), neighbors_);
-      nNeighbor = neighbors_.size();
+      cellList_.getNeighbors(atom.position(), neighbors);
+      nNeighbor = neighbors.size();
 
       // Loop over neighboring atoms
       energy = 0.0;
       for (j = 0; j < nNeighbor; ++j) {
-         jAtomPtr = neighbors_[j];
+         jAtomPtr = neighbors[j];
          jId      = jAtomPtr->id();
 
          // Check if atoms are the same
@@ -334,6 +364,69 @@ namespace McMd
       return energy;
    }
 
+   /* 
+   * Return nonbonded pair energies for one Atom at trial positions.
+   */
+   template <class Interaction>
+   void 
+   McPairPotentialImpl<Interaction>::trialEnergies(const Atom& atom, 
+                                                   const Vector* positions,
+                                                   int nTrial, 
+                                                   double* energies) const
+   {
+      const Boundary& boundary = this->boundary();
+      const Interaction& interaction = this->interaction();
+      Atom   *jAtomPtr;
+      double  energy;
+      double  rsq;
+      int     i, j, k, cellId, nNeighbor;
+      int     id = atom.id();
+      int     typeId = atom.typeId();
+
+      // Find the cell containing each trial position
+      trialCells_.clear();
+      for (i = 0; i < nTrial; ++i) {
+         trialCells_.append(cellList_.cellIndexFromPosition(positions[i]));
+      }
+
+      for (i = 0; i < nTrial; ++i) {
+
+         // Skip trials in a cell that was already treated
+         cellId = trialCells_[i];
+         for (k = 0; k < i; ++k) {
+            if (trialCells_[k] == cellId) break;
+         }
+         if (k < i) continue;
+
+         // Get array of unmasked neighbors, excluding the atom itself
+         cellList_.getNeighbors(positions[i], neighbors_);
+         nNeighbor = neighbors_.size();
+         trialNeighbors_.clear();
+         for (j = 0; j < nNeighbor; ++j) {
+            jAtomPtr = neighbors_[j];
+            if (jAtomPtr->id() != id) {
+               if (!atom.mask().isMasked(*jAtomPtr)) {
+                  trialNeighbors_.append(jAtomPtr);
+               }
+            }
+         }
+         nNeighbor = trialNeighbors_.size();
+
+         // Loop over this and all later trials in the same cell
+         for (k = i; k < nTrial; ++k) {
+            if (trialCells_[k] != cellId) continue;
+            energy = 0.0;
+            for (j = 0; j < nNeighbor; ++j) {
+               jAtomPtr = trialNeighbors_[j];
+               rsq = boundary.distanceSq(positions[k], jAtomPtr->position());
+               energy += interaction.energy(rsq, typeId, jAtomPtr->typeId());
+            }
+            energies[k] = energy;
+         }
+
+      }
+   }
+
    /* 
    * Return nonbonded pair potential energy for one Molecule.
    */
@@ -0,0 +1,48 @@
+#ifndef INTER_NOPAIR
+#ifndef MCMD_TABULATED_PAIR_POTENTIAL_CPP
+#define MCMD_TABULATED_PAIR_POTENTIAL_CPP
+
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2012, David Morse (morse012@umn.edu)
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "TabulatedPairPotential.h"
+#include <mcMd/simulation/System.h>
+#include <mcMd/potentials/pair/MdPairPotentialImpl.h>
+#include <mcMd/potentials/pair/McPairPotentialImpl.h>
+#include <inter/pair/TabulatedPair.h>
+
+namespace McMd
+{
+
+   using namespace Util;
+   using namespace Inter;
+
+   /*
+   * Return a pointer to a new McPairPotentialImpl<TabulatedPair>.
+   */
+   McPairPotential* newTabulatedMcPairPotential(System& system)
+   {  return new McPairPotentialImpl<TabulatedPair>(system); }
+
+   /*
+   * Return a pointer to a new MdPairPotentialImpl<TabulatedPair>.
+   */
+   MdPairPotential* newTabulatedMdPairPotential(System& system)
+   {  return new MdPairPotentialImpl<TabulatedPair>(system); }
+
+   /*
+   * Create an MdPairPotentialImpl<TabulatedPair> from a McPairPotential.
+   */
+   MdPairPotential* newTabulatedMdPairPotential(McPairPotential& potential)
+   {
+      McPairPotentialImpl<TabulatedPair>* mcPtr 
+          = dynamic_cast< McPairPotentialImpl<TabulatedPair>* >(&potential);
+      return new MdPairPotentialImpl<TabulatedPair>(*mcPtr);
+   }
+
+}
+#endif
+#endif
@@ -0,0 +1,52 @@
+#ifndef INTER_NOPAIR
+#ifndef MCMD_TABULATED_PAIR_POTENTIAL_H
+#define MCMD_TABULATED_PAIR_POTENTIAL_H
+
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2012, David Morse (morse012@umn.edu)
+* Distributed under the terms of the GNU General Public License.
+*/
+
+namespace McMd
+{
+
+   class System;
+   class MdPairPotential;
+   class McPairPotential;
+
+   /*
+   * Functions that create pair potentials with a TabulatedPair interaction.
+   *
+   * These are called by PairFactory, but are defined in a separate file 
+   * so that the McPairPotentialImpl and MdPairPotentialImpl templates 
+   * are instantiated for fewer interactions in each file. With all of 
+   * them in one file, gcc reaches its limit on the growth of a unit by 
+   * inlining, and then fails to inline pair interaction functions.
+   */
+
+   /**
+   * Return a pointer to a new McPairPotentialImpl<TabulatedPair>.
+   *
+   * \param system associated System
+   */
+   McPairPotential* newTabulatedMcPairPotential(System& system);
+
+   /**
+   * Return a pointer to a new MdPairPotentialImpl<TabulatedPair>.
+   *
+   * \param system associated System
+   */
+   MdPairPotential* newTabulatedMdPairPotential(System& system);
+
+   /**
+   * Create an MdPairPotentialImpl<TabulatedPair> from a McPairPotential.
+   *
+   * \param potential McPairPotentialImpl<TabulatedPair> to be cloned
+   */
+   MdPairPotential* newTabulatedMdPairPotential(McPairPotential& potential);
+
+}
+#endif
+#endif
@@ -1,7 +1,8 @@
 mcMd_potentials_pair_=\
     mcMd/potentials/pair/McPairPotential.cpp \
     mcMd/potentials/pair/MdPairPotential.cpp \
-    mcMd/potentials/pair/PairFactory.cpp
+    mcMd/potentials/pair/PairFactory.cpp \
+    mcMd/potentials/pair/TabulatedPairPotential.cpp
 
 mcMd_potentials_pair_SRCS=\
      $(addprefix $(SRC_DIR)/, $(mcMd_potentials_pair_))
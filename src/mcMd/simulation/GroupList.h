@@ -0,0 +1,169 @@
+#ifndef MCMD_GROUP_LIST_H
+#define MCMD_GROUP_LIST_H
+
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2012, David Morse (morse012@umn.edu)
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <mcMd/simulation/System.h>        // base class MoleculeSetObserver
+#include <mcMd/simulation/Simulation.h>
+#include <mcMd/chemistry/Molecule.h>
+#include <mcMd/chemistry/Group.h>
+#include <util/containers/GArray.h>        // member template
+#include <util/containers/ArrayIterator.h>
+
+namespace McMd
+{
+
+   using namespace Util;
+
+   class Atom;
+
+   /**
+   * A flat list of all covalent groups of N atoms in a System.
+   *
+   * A GroupList stores atom pointers and a type index for every 
+   * Group<N> (i.e., every bond, angle or dihedral, for N = 2, 3, 4)
+   * of every molecule in a System, in a contiguous array. It allows 
+   * force loops to iterate over groups without the nested species, 
+   * molecule and group iterators. The list is invalidated whenever a 
+   * molecule is added to or removed from the System, and is rebuilt 
+   * by the next call to update().
+   *
+   * \ingroup McMd_Simulation_Module
+   */
+   template <int N>
+   class GroupList : public MoleculeSetObserver
+   {
+
+   public:
+
+      /**
+      * Atom pointers and type for one group.
+      */
+      struct Entry 
+      {
+         Atom* atomPtrs[N];
+         int   typeId;
+      };
+
+      /**
+      * Constructor.
+      *
+      * \param system System whose groups are listed
+      */
+      GroupList(System& system);
+
+      /**
+      * Destructor.
+      */
+      virtual ~GroupList();
+
+      /**
+      * Rebuild the list, if it is not valid.
+      */
+      void update();
+
+      /**
+      * Mark the list as invalid (called by System).
+      */
+      virtual void notifyMoleculeSetChanged();
+
+      /**
+      * Get the number of groups.
+      */
+      int size() const;
+
+      /**
+      * Get one group by index.
+      *
+      * \param i group index, 0 <= i < size()
+      */
+      const Entry& operator[] (int i) const;
+
+   private:
+
+      /// Array of groups.
+      GArray<Entry> entries_;
+
+      /// Pointer to associated System.
+      System* systemPtr_;
+
+      /// Is the list consistent with the current set of molecules?
+      bool isValid_;
+
+   };
+
+   /*
+   * Constructor.
+   */
+   template <int N>
+   GroupList<N>::GroupList(System& system)
+    : entries_(),
+      systemPtr_(&system),
+      isValid_(false)
+   {  systemPtr_->subscribeMoleculeSetChange(*this); }
+
+   /*
+   * Destructor.
+   */
+   template <int N>
+   GroupList<N>::~GroupList()
+   {  systemPtr_->unsubscribeMoleculeSetChange(*this); }
+
+   /*
+   * Rebuild the list, if necessary.
+   */
+   template <int N>
+   void GroupList<N>::update()
+   {
+      if (isValid_) return;
+
+      System::MoleculeIterator molIter;
+      ArrayIterator< Group<N> > groupIter;
+      Entry entry;
+      int iSpec, j;
+
+      entries_.clear();
+      for (iSpec = 0; iSpec < systemPtr_->simulation().nSpecies(); ++iSpec) {
+         systemPtr_->begin(iSpec, molIter);
+         for ( ; molIter.notEnd(); ++molIter) {
+            for (molIter->begin(groupIter); groupIter.notEnd(); ++groupIter) {
+               for (j = 0; j < N; ++j) {
+                  entry.atomPtrs[j] = &(groupIter->atom(j));
+               }
+               entry.typeId = groupIter->typeId();
+               entries_.append(entry);
+            }
+         }
+      }
+      isValid_ = true;
+   }
+
+   /*
+   * Invalidate the list.
+   */
+   template <int N>
+   void GroupList<N>::notifyMoleculeSetChanged()
+   {  isValid_ = false; }
+
+   /*
+   * Get the number of groups.
+   */
+   template <int N>
+   inline int GroupList<N>::size() const
+   {  return entries_.size(); }
+
+   /*
+   * Get one group by index.
+   */
+   template <int N>
+   inline const typename GroupList<N>::Entry& 
+   GroupList<N>::operator[] (int i) const
+   {  return entries_[i]; }
+
+}
+#endif
@@ -10,10 +10,17 @@
 #include <mcMd/chemistry/Atom.h>
 #include <mcMd/potentials/pair/McPairPotential.h>
 #include <mcMd/potentials/bond/BondPotential.h>
+#include <mcMd/neighbor/CellList.h>
+#include <mcMd/analyzers/system/StructureFactor.h>
 #ifdef INTER_ANGLE
 #include <mcMd/potentials/angle/AnglePotential.h>
 #endif
 
+#include <util/boundary/Boundary.h>
+#include <util/space/Vector.h>
+#include <util/space/Dimension.h>
+#include <util/containers/DArray.h>
+
 #include <util/archives/MemoryCounter.h>
 #include <util/archives/MemoryOArchive.h>
 #include <util/archives/MemoryIArchive.h>
@@ -28,10 +35,27 @@
 
 #include <string>
 #include <fstream>
+#include <complex>
 
 using namespace Util;
 using namespace McMd;
 
+/*
+* StructureFactor with access to its instantaneous Fourier modes.
+*/
+class TestStructureFactor : public StructureFactor
+{
+public:
+
+   TestStructureFactor(System& system)
+    : StructureFactor(system)
+   {}
+
+   std::complex<double> fourierMode(int i, int j) const
+   {  return fourierModes_(i, j); }
+
+};
+
 class McSimulationTest : public ParamFileTest
 {
 
@@ -76,12 +100,20 @@ public:
    #endif
    void testWriteRestart();
    void testReadRestart();
+   void testCheckerboardDisplace();
+   void testStructureFactorUpdate();
 
 private:
 
    McSimulation simulation_;
    McSystem&    system_;
 
+   /*
+   * Block of a position in an unshifted checkerboard grid of 2 blocks
+   * per axis, as used by CheckerboardDisplaceMove with blockWidth 2.
+   */
+   int fixedBlock(const Vector& position);
+
 };
 
 #if 1
@@ -307,6 +339,110 @@ void McSimulationTest::testReadRestart()
    simulation_.save(baseFileName);
 }
 
+int McSimulationTest::fixedBlock(const Vector& position)
+{
+   const CellList& cellList = system_.pairPotential().cellList();
+   Vector r;
+   int i, n, block;
+   system_.boundary().transformCartToGen(position, r);
+   block = 0;
+   for (i = 0; i < Dimension; ++i) {
+      n = cellList.gridDimension(i);
+      block = 2*block + (int(r[i]*double(n))*2)/n;
+   }
+   return block;
+}
+
+void McSimulationTest::testCheckerboardDisplace()
+{
+   printMethod(TEST_FUNC);
+   std::cout << std::endl;
+   openFile("in/McCheckerboard"); 
+   simulation_.readParam(file());
+   simulation_.readCommands();
+
+   const CellList& cellList = system_.pairPotential().cellList();
+   for (int i = 0; i < Dimension; ++i) {
+      TEST_ASSERT(cellList.gridDimension(i) >= 4);
+      TEST_ASSERT(cellList.gridDimension(i) < 8);
+   }
+
+   // Record the block of each atom in an unshifted grid
+   System::MoleculeIterator molIter;
+   Molecule::AtomIterator   atomIter;
+   DArray<int> blocks;
+   blocks.allocate(simulation_.atomCapacity());
+   for (system_.begin(0, molIter); molIter.notEnd(); ++molIter) {
+      for (molIter->begin(atomIter); atomIter.notEnd(); ++atomIter) {
+         blocks[atomIter->id()] = fixedBlock(atomIter->position());
+      }
+   }
+
+   simulation_.simulate(200);
+
+   // Some atoms must have crossed boundaries of the unshifted grid
+   int nCross = 0;
+   for (system_.begin(0, molIter); molIter.notEnd(); ++molIter) {
+      for (molIter->begin(atomIter); atomIter.notEnd(); ++atomIter) {
+         if (fixedBlock(atomIter->position()) != blocks[atomIter->id()]) {
+            ++nCross;
+         }
+      }
+   }
+   if (verbose() > 0) {
+      std::cout << "nCross = " << nCross << std::endl;
+   }
+   TEST_ASSERT(nCross > 0);
+}
+
+void McSimulationTest::testStructureFactorUpdate()
+{
+   printMethod(TEST_FUNC);
+   std::cout << std::endl;
+   openFile("in/McSimulation"); 
+   simulation_.readParam(file());
+   simulation_.readCommands();
+
+   // Sample incrementally after each random displacement of a few atoms
+   TestStructureFactor incremental(system_);
+   closeFile();
+   openFile("in/StructureFactor"); 
+   incremental.readParam(file());
+   incremental.setup();
+   int nSample = 3*StructureFactor::RecomputeInterval/2;
+   int nMolecule = system_.nMolecule(0);
+   int i, j, k;
+   for (i = 0; i < nSample; ++i) {
+      for (j = 0; j < 4; ++j) {
+         Molecule& molecule 
+            = system_.molecule(0, simulation_.random().uniformInt(0, nMolecule));
+         Atom& atom = molecule.atom(simulation_.random().uniformInt(0, 2));
+         for (k = 0; k < Dimension; ++k) {
+            atom.position()[k] += simulation_.random().uniform(-0.1, 0.1);
+         }
+         system_.boundary().shift(atom.position());
+      }
+      incremental.sample(10*i);
+   }
+
+   // Compute all modes from scratch, and compare
+   TestStructureFactor full(system_);
+   closeFile();
+   openFile("in/StructureFactor"); 
+   full.readParam(file());
+   full.setup();
+   full.sample(0);
+   std::complex<double> diff;
+   for (i = 0; i < 4; ++i) {
+      diff = incremental.fourierMode(i, 0) - full.fourierMode(i, 0);
+      if (verbose() > 0) {
+         std::cout << full.fourierMode(i, 0) << "  " 
+                   << std::abs(diff) << std::endl;
+      }
+      TEST_ASSERT(std::abs(diff) < 1.0E-10);
+   }
+}
+
 TEST_BEGIN(McSimulationTest)
 TEST_ADD(McSimulationTest, testReadParam)
 TEST_ADD(McSimulationTest, testPairEnergy)
@@ -321,6 +457,8 @@ TEST_ADD(McSimulationTest, testSimulateAngle)
 #endif
 TEST_ADD(McSimulationTest, testWriteRestart)
 //TEST_ADD(McSimulationTest, testReadRestart)
+TEST_ADD(McSimulationTest, testCheckerboardDisplace)
+TEST_ADD(McSimulationTest, testStructureFactorUpdate)
 TEST_END(McSimulationTest)
 
 #endif
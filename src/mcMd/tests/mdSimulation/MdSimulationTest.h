@@ -4,6 +4,7 @@
 #include <mcMd/mdSimulation/MdSimulation.h>
 #include <mcMd/mdSimulation/MdSystem.h>
 #include <mcMd/mdIntegrators/MdIntegrator.h>
+#include <mcMd/mdIntegrators/NveVvIntegrator.h>
 #include <mcMd/potentials/pair/MdPairPotential.h>
 #include <mcMd/potentials/bond/BondPotential.h>
 #include <mcMd/species/Species.h>
@@ -40,6 +41,8 @@ public:
    void testCalculateForces();
    void testStep();
    void testSimulate();
+   void testRespaMatchesNveVv();
+   void testRespaEnergy();
    void testWriteRestart();
    void testReadRestart();
 
@@ -48,8 +51,26 @@ private:
    MdSimulation simulation_;
    MdSystem&    system_;
 
+   /*
+   * Read a parameter file and commands, and set up the integrator.
+   */
+   void setupSimulation(MdSimulation& simulation, const char* paramFileName);
+
 };
 
+void MdSimulationTest::setupSimulation(MdSimulation& simulation, 
+                                       const char* paramFileName)
+{
+   std::ifstream paramFile;
+   openInputFile(paramFileName, paramFile); 
+   simulation.readParam(paramFile);
+   paramFile.close();
+   simulation.readCommands();
+   simulation.system().pairPotential().buildPairList();
+   simulation.system().calculateForces();
+   simulation.system().mdIntegrator().setup();
+}
+
 
 
 void MdSimulationTest::testReadParam()
@@ -292,6 +313,96 @@ void MdSimulationTest::testSimulate()
    //simulation_.save(baseFileName);
 }
 
+void MdSimulationTest::testRespaMatchesNveVv()
+{
+   printMethod(TEST_FUNC);
+   std::cout << std::endl;
+
+   // With nInner = 1, RESPA is equivalent to velocity-Verlet
+   setupSimulation(simulation_, "in/NveRespa1");
+   NveVvIntegrator nveVv(system_);
+   std::ifstream paramFile;
+   openInputFile("in/NveVvIntegrator", paramFile); 
+   nveVv.readParam(paramFile);
+   paramFile.close();
+
+   // Store initial state
+   int nAtom = simulation_.atomCapacity();
+   DArray<Vector> positions, velocities;
+   positions.allocate(nAtom);
+   velocities.allocate(nAtom);
+   System::MoleculeIterator molIter;
+   Molecule::AtomIterator atomIter;
+   int is, i;
+   for (is = 0; is < simulation_.nSpecies(); ++is) {
+      for (system_.begin(is, molIter); molIter.notEnd(); ++molIter) {
+         for (molIter->begin(atomIter); atomIter.notEnd(); ++atomIter) {
+            positions[atomIter->id()] = atomIter->position();
+            velocities[atomIter->id()] = atomIter->velocity();
+         }
+      }
+   }
+
+   // Integrate with RESPA, then restore and integrate with NveVv
+   for (i = 0; i < 200; ++i) {
+      system_.mdIntegrator().step();
+   }
+   for (is = 0; is < simulation_.nSpecies(); ++is) {
+      for (system_.begin(is, molIter); molIter.notEnd(); ++molIter) {
+         for (molIter->begin(atomIter); atomIter.notEnd(); ++atomIter) {
+            Vector r = atomIter->position();
+            atomIter->position() = positions[atomIter->id()];
+            atomIter->velocity() = velocities[atomIter->id()];
+            positions[atomIter->id()] = r;
+         }
+      }
+   }
+   system_.pairPotential().buildPairList();
+   system_.calculateForces();
+   nveVv.setup();
+   for (i = 0; i < 200; ++i) {
+      nveVv.step();
+   }
+
+   // Compare final positions, allowing for shifts into the unit cell
+   double maxDiff = 0.0;
+   double dr;
+   for (is = 0; is < simulation_.nSpecies(); ++is) {
+      for (system_.begin(is, molIter); molIter.notEnd(); ++molIter) {
+         for (molIter->begin(atomIter); atomIter.notEnd(); ++atomIter) {
+            dr = sqrt(system_.boundary().distanceSq(atomIter->position(),
+                                              positions[atomIter->id()]));
+            if (dr > maxDiff) maxDiff = dr;
+         }
+      }
+   }
+   if (verbose() > 0) {
+      std::cout << "Maximum position difference = " << maxDiff << std::endl;
+   }
+   TEST_ASSERT(maxDiff < 1.0E-10);
+}
+
+void MdSimulationTest::testRespaEnergy()
+{
+   printMethod(TEST_FUNC);
+   std::cout << std::endl;
+
+   // Total energy is conserved with 4 inner steps per outer step
+   setupSimulation(simulation_, "in/NveRespa4");
+   double energy0 = system_.kineticEnergy() + system_.potentialEnergy();
+   double energy, maxDiff = 0.0;
+   for (int i = 0; i < 500; ++i) {
+      system_.mdIntegrator().step();
+      energy = system_.kineticEnergy() + system_.potentialEnergy();
+      if (fabs(energy - energy0) > maxDiff) maxDiff = fabs(energy - energy0);
+   }
+   if (verbose() > 0) {
+      std::cout << "Initial energy = " << energy0 << std::endl;
+      std::cout << "Maximum energy change = " << maxDiff << std::endl;
+   }
+   TEST_ASSERT(maxDiff < 1.0E-3*fabs(energy0));
+}
+
 void MdSimulationTest::testWriteRestart()
 {
    printMethod(TEST_FUNC);
@@ -360,6 +471,8 @@ TEST_ADD(MdSimulationTest, testAddBondForces)
 TEST_ADD(MdSimulationTest, testCalculateForces)
 TEST_ADD(MdSimulationTest, testStep)
 TEST_ADD(MdSimulationTest, testSimulate)
+TEST_ADD(MdSimulationTest, testRespaMatchesNveVv)
+TEST_ADD(MdSimulationTest, testRespaEnergy)
 TEST_ADD(MdSimulationTest, testWriteRestart)
 TEST_ADD(MdSimulationTest, testReadRestart)
 TEST_END(MdSimulationTest)
@@ -19,6 +19,12 @@
 
 #include <vector>
 #include <sstream>
+#include <cstring>
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
 
 //! File position of NFILE in DCD header
 #define NFILE_POS 8L
@@ -36,14 +42,24 @@ namespace McMd
    * Constructor.
    */
    DCDTrajectoryIo::DCDTrajectoryIo(System &system)
-   : TrajectoryIo(system)
+   : TrajectoryIo(system),
+     nAtoms_(0),
+     frameSize_(0),
+     mapPtr_(0),
+     mapSize_(0),
+     mapOffset_(0),
+     fd_(-1)
    {}
 
    /*
    * Destructor.
    */
    DCDTrajectoryIo::~DCDTrajectoryIo()
-   {}
+   {
+      if (mapPtr_) {
+         close();
+      }
+   }
 
    static unsigned int read_int(std::fstream &file)
    {
@@ -52,11 +68,13 @@ namespace McMd
       return val;
    }
 
-   void DCDTrajectoryIo::readHeader(std::fstream &file)
+   /*
+   * Add all molecules to the system (private).
+   */
+   int DCDTrajectoryIo::addMolecules()
    {
       // Calculate atomCapacity for entire simulation
       int atomCapacity = 0;
-      int bondCapacity = 0;
       int nSpecies = simulation().nSpecies();
       int speciesCapacity = 0;
       int iSpec,iMol;
@@ -73,15 +91,16 @@ namespace McMd
             system().addMolecule(*molPtr);
          }
          atomCapacity += speciesCapacity*speciesPtr->nAtom();
-         bondCapacity += speciesCapacity*speciesPtr->nBond();
       }
+      return atomCapacity;
+   }
 
-      // read number of frames
-      file.seekp(NFILE_POS);
-      nFrames_ = read_int(file);
-
-      file.seekp(NATOMS_POS);
-      nAtoms_ = read_int(file);
+   /*
+   * Validate number of atoms and compute frame size (private).
+   */
+   void DCDTrajectoryIo::setNAtoms(int nAtoms, int atomCapacity)
+   {
+      nAtoms_ = nAtoms;
       if (nAtoms_ != atomCapacity) {
          std::ostringstream oss;
          oss << "Number of atoms in DCD file (" << nAtoms_ << ") does not "
@@ -89,6 +108,23 @@ namespace McMd
          UTIL_THROW(oss.str().c_str());
       }
 
+      // Frame header block and 3 coordinate blocks, each with leading 
+      // and trailing integer block sizes
+      frameSize_ = 2*sizeof(unsigned int) + 6*sizeof(double);
+      frameSize_ += 3*(2*sizeof(unsigned int) + nAtoms_*sizeof(float));
+   }
+
+   void DCDTrajectoryIo::readHeader(std::fstream &file)
+   {
+      int atomCapacity = addMolecules();
+
+      // read number of frames
+      file.seekp(NFILE_POS);
+      nFrames_ = read_int(file);
+
+      file.seekp(NATOMS_POS);
+      setNAtoms(read_int(file), atomCapacity);
+
       file.seekp(FRAMEDATA_POS);
 
       xBuffer_.allocate(nAtoms_);
@@ -96,13 +132,27 @@ namespace McMd
       zBuffer_.allocate(nAtoms_);
    }
 
+   /*
+   * Move to the beginning of frame frameId.
+   */
+   bool DCDTrajectoryIo::seekFrame(std::fstream &file, int frameId)
+   {
+      if (frameId < 0 || frameId >= nFrames_) {
+         UTIL_THROW("Frame index out of range");
+      }
+      file.clear();
+      file.seekg(FRAMEDATA_POS + std::streamoff(frameId)*frameSize_);
+      if (file.fail()) {
+         UTIL_THROW("Error seeking in trajectory file!");
+      }
+      return true;
+   }
+
    void DCDTrajectoryIo::readFrame(std::fstream &file)
    {
       double lx,ly,lz;
       double angle0,angle1,angle2;
 
-      Vector lengths;
-
       // Read frame header
       int headerSize;
       headerSize=read_int(file);
@@ -132,10 +182,7 @@ namespace McMd
          UTIL_THROW(oss.str().c_str());
       }
 
-      lengths[0]=lx;
-      lengths[1]=ly;
-      lengths[2]=lz;
-      boundary().setOrthorhombic(lengths);
+      setBoundary(lx, ly, lz);
 
       // Read frame data
       int blockSize;
@@ -171,6 +218,166 @@ namespace McMd
          UTIL_THROW(oss.str().c_str());
       }
 
+      setPositions(xBuffer_.cArray(), yBuffer_.cArray(), zBuffer_.cArray());
+   }
+
+   /*
+   * Memory map a trajectory file and read its header.
+   */
+   void DCDTrajectoryIo::open(const std::string& filename)
+   {
+      if (mapPtr_) {
+         UTIL_THROW("A trajectory file is already open");
+      }
+
+      // Open and map the whole file
+      fd_ = ::open(filename.c_str(), O_RDONLY);
+      if (fd_ < 0) {
+         std::string message;
+         message = "Error opening trajectory file. Filename: " + filename;
+         UTIL_THROW(message.c_str());
+      }
+      struct stat status;
+      if (fstat(fd_, &status) != 0 || status.st_size < FRAMEDATA_POS) {
+         ::close(fd_);
+         fd_ = -1;
+         UTIL_THROW("Trajectory file is too small for a DCD header");
+      }
+      mapSize_ = status.st_size;
+      void* ptr = mmap(0, mapSize_, PROT_READ, MAP_SHARED, fd_, 0);
+      if (ptr == MAP_FAILED) {
+         ::close(fd_);
+         fd_ = -1;
+         UTIL_THROW("Error mapping trajectory file");
+      }
+      mapPtr_ = (const char*) ptr;
+      madvise(ptr, mapSize_, MADV_SEQUENTIAL);
+
+      // Read number of frames and atoms from the header
+      unsigned int value;
+      int atomCapacity = addMolecules();
+      memcpy(&value, mapPtr_ + NFILE_POS, sizeof(unsigned int));
+      nFrames_ = value;
+      memcpy(&value, mapPtr_ + NATOMS_POS, sizeof(unsigned int));
+      setNAtoms(value, atomCapacity);
+      if (FRAMEDATA_POS + nFrames_*frameSize_ > (std::streamoff)mapSize_) {
+         close();
+         UTIL_THROW("Trajectory file is shorter than nFrames frames");
+      }
+      mapOffset_ = FRAMEDATA_POS;
+   }
+
+   /*
+   * Read the next frame directly from the mapped file.
+   */
+   void DCDTrajectoryIo::readFrame()
+   {
+      if (!mapPtr_) {
+         UTIL_THROW("No mapped trajectory file");
+      }
+      if (mapOffset_ + frameSize_ > mapSize_) {
+         UTIL_THROW("Error reading trajectory file!");
+      }
+      const char* framePtr = mapPtr_ + mapOffset_;
+      unsigned int blockSize;
+
+      // Read frame header: unit cell lengths and angles
+      double cell[6];
+      memcpy(&blockSize, framePtr, sizeof(unsigned int));
+      if (blockSize != 6*sizeof(double)) {
+         UTIL_THROW("Unknown file format!");
+      }
+      memcpy(&blockSize, framePtr + sizeof(unsigned int) + 6*sizeof(double),
+             sizeof(unsigned int));
+      if (blockSize != 6*sizeof(double)) {
+         UTIL_THROW("Unknown file format!");
+      }
+      memcpy(cell, framePtr + sizeof(unsigned int), 6*sizeof(double));
+      setBoundary(cell[0], cell[2], cell[5]);
+      framePtr += 2*sizeof(unsigned int) + 6*sizeof(double);
+
+      // Point to coordinate blocks, which are 4 byte aligned
+      // Check the record markers before and after each block
+      const float* coords[3];
+      unsigned int endSize;
+      for (int i = 0; i < 3; ++i) {
+         memcpy(&blockSize, framePtr, sizeof(unsigned int));
+         memcpy(&endSize, framePtr + sizeof(unsigned int) 
+                          + sizeof(float)*nAtoms_, sizeof(unsigned int));
+         if (blockSize != sizeof(float)*nAtoms_ || endSize != blockSize) {
+            std::ostringstream oss;
+            oss << "Invalid frame size (got " << blockSize << " and " 
+                << endSize << ", expected " << nAtoms_ << ")";
+            UTIL_THROW(oss.str().c_str());
+         }
+         coords[i] = (const float*)(framePtr + sizeof(unsigned int));
+         framePtr += 2*sizeof(unsigned int) + sizeof(float)*nAtoms_;
+      }
+      setPositions(coords[0], coords[1], coords[2]);
+
+      mapOffset_ += frameSize_;
+   }
+
+   /*
+   * Move to the beginning of frame frameId in the mapped file.
+   */
+   bool DCDTrajectoryIo::seekFrame(int frameId)
+   {
+      if (!mapPtr_) {
+         UTIL_THROW("No mapped trajectory file");
+      }
+      if (frameId < 0 || frameId >= nFrames_) {
+         UTIL_THROW("Frame index out of range");
+      }
+      size_t offset = FRAMEDATA_POS + size_t(frameId)*frameSize_;
+      if (offset != mapOffset_) {
+
+         // Request read-ahead of the new frame (from a page boundary)
+         size_t pageSize = sysconf(_SC_PAGESIZE);
+         size_t begin = (offset/pageSize)*pageSize;
+         madvise((void*)(mapPtr_ + begin), offset + frameSize_ - begin, 
+                 MADV_WILLNEED);
+
+         mapOffset_ = offset;
+      }
+      return true;
+   }
+
+   /*
+   * Unmap and close the mapped file.
+   */
+   void DCDTrajectoryIo::close()
+   {
+      if (mapPtr_) {
+         munmap((void*)mapPtr_, mapSize_);
+         mapPtr_ = 0;
+         mapSize_ = 0;
+         mapOffset_ = 0;
+      }
+      if (fd_ >= 0) {
+         ::close(fd_);
+         fd_ = -1;
+      }
+   }
+
+   /*
+   * Set an orthorhombic boundary (private).
+   */
+   void DCDTrajectoryIo::setBoundary(double lx, double ly, double lz)
+   {
+      Vector lengths;
+      lengths[0]=lx;
+      lengths[1]=ly;
+      lengths[2]=lz;
+      boundary().setOrthorhombic(lengths);
+   }
+
+   /*
+   * Set atomic positions from coordinate arrays (private).
+   */
+   void DCDTrajectoryIo::setPositions(const float* x, const float* y, 
+                                      const float* z)
+   {
       // Load positions, assume they are ordered according to species
       int iSpecies,iMol;
       int bufferIdx=0;
@@ -183,9 +390,9 @@ namespace McMd
          for (iMol = 0; iMol < speciesPtr->capacity(); ++iMol) {
             molPtr = &system().molecule(iSpecies, iMol);
             for (molPtr->begin(atomIter); atomIter.notEnd(); ++atomIter) {
-               atomIter->position()[0] = (double) xBuffer_[bufferIdx];
-               atomIter->position()[1] = (double) yBuffer_[bufferIdx];
-               atomIter->position()[2] = (double) zBuffer_[bufferIdx];
+               atomIter->position()[0] = (double) x[bufferIdx];
+               atomIter->position()[1] = (double) y[bufferIdx];
+               atomIter->position()[2] = (double) z[bufferIdx];
 
                // shift into simulation cell
                boundary().shift(atomIter->position());
@@ -195,5 +402,6 @@ namespace McMd
          }
       }
    }
+
 }
 #endif
@@ -12,6 +12,8 @@
 #include <util/boundary/Boundary.h>      // base class
 #include <util/containers/DArray.h>
 
+#include <cstddef>
+
 namespace McMd
 {
 
@@ -24,6 +26,12 @@ namespace McMd
    * It is assumed that the atoms belonging to all species and molecules of a species occur in the file
    * consecutively.
    *
+   * A file opened with open() is memory mapped, rather than read through a stream.
+   * Atomic positions are then set directly from the mapped coordinate arrays of each
+   * frame, without intermediate buffers, and the kernel is advised to read ahead for
+   * sequential access. Mapped pages are shared with any other process that reads the
+   * same file.
+   *
    * \ingroup McMd_TrajectoryIo_Module
    */
    class DCDTrajectoryIo : public TrajectoryIo
@@ -51,10 +59,50 @@ namespace McMd
       */
       void readFrame(std::fstream &file);
 
+      /**
+      * Move to the beginning of a specified frame.
+      *
+      * Frames have a fixed size, so the offset of each is computed
+      * directly from the frame index.
+      *
+      * \param file input file stream.
+      * \param frameId index of frame to be read next
+      * \return true
+      */
+      bool seekFrame(std::fstream &file, int frameId);
+
+      /**
+      * Memory map a trajectory file, and read and validate its header.
+      *
+      * \param filename name of trajectory file
+      */
+      void open(const std::string& filename);
+
+      /**
+      * Read the next frame from the mapped file.
+      */
+      void readFrame();
+
+      /**
+      * Move to the beginning of a specified frame of the mapped file.
+      *
+      * \param frameId index of frame to be read next
+      * \return true
+      */
+      bool seekFrame(int frameId);
+
+      /**
+      * Unmap and close the mapped file.
+      */
+      void close();
+
       private:
           /// The number of atoms stored in the file
           int nAtoms_;
 
+          /// Size of one frame, in bytes
+          std::streamoff frameSize_;
+
           /// buffer for reading data (x values)
           DArray<float> xBuffer_;
 
@@ -63,6 +111,30 @@ namespace McMd
 
           /// buffer for reading data (z values)
           DArray<float> zBuffer_;
+
+          /// Start of mapped file (null if not mapped)
+          const char* mapPtr_;
+
+          /// Size of mapped file, in bytes
+          size_t mapSize_;
+
+          /// Offset of next frame in mapped file, in bytes
+          size_t mapOffset_;
+
+          /// File descriptor of mapped file
+          int fd_;
+
+          /// Add all molecules to the system, and return the number of atoms.
+          int addMolecules();
+
+          /// Check the number of atoms in the file, and compute frameSize_.
+          void setNAtoms(int nAtoms, int atomCapacity);
+
+          /// Set the boundary from unit cell lengths.
+          void setBoundary(double lx, double ly, double lz);
+
+          /// Set atomic positions from arrays of coordinates.
+          void setPositions(const float* x, const float* y, const float* z);
    }; 
 
 } 
@@ -48,6 +48,44 @@ namespace McMd
        UTIL_THROW("This TrajectoryIo class does not implement a readFrame() method.");
    }
 
+   /*
+   * Move to a specified frame (random access not supported by default).
+   */
+   bool TrajectoryIo::seekFrame(std::fstream& file, int frameId)
+   {  return false; }
+
+   /*
+   * Open file stream and read header.
+   */
+   void TrajectoryIo::open(const std::string& filename)
+   {
+      file_.open(filename.c_str(), std::ios::in | std::ios::binary);
+      if (file_.fail()) {
+         std::string message;
+         message = "Error opening trajectory file. Filename: " + filename;
+         UTIL_THROW(message.c_str());
+      }
+      readHeader(file_);
+   }
+
+   /*
+   * Read the next frame from the file stream.
+   */
+   void TrajectoryIo::readFrame()
+   {  readFrame(file_); }
+
+   /*
+   * Move to a specified frame of the file stream.
+   */
+   bool TrajectoryIo::seekFrame(int frameId)
+   {  return seekFrame(file_, frameId); }
+
+   /*
+   * Close the file stream.
+   */
+   void TrajectoryIo::close()
+   {  file_.close(); }
+
    /*
    * Write the trajectory file header.
    */
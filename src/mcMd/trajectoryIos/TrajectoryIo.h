@@ -12,6 +12,8 @@
 #include <util/global.h>
 
 #include <iostream>
+#include <fstream>
+#include <string>
 
 namespace McMd
 {
@@ -27,6 +29,11 @@ namespace McMd
    * If either pair is not implemented, calling the standard implementation will result in an
    * error message.
    *
+   * A trajectory may also be read through the functions open(), readFrame(), seekFrame()
+   * and close() that take no file stream argument. By default, these use a binary 
+   * std::fstream owned by this object, and call the corresponding stream-based functions.
+   * A subclass may override them to access the file by other means.
+   *
    * \ingroup McMd_TrajectoryIo_Module
    */
    class TrajectoryIo
@@ -55,6 +62,53 @@ namespace McMd
       */
       virtual void readFrame(std::fstream& file);
 
+      /**
+      * Move to the beginning of a specified frame, if possible.
+      *
+      * Frames are indexed from 0. A subclass that supports random access
+      * should position the file so that the next call to readFrame() reads 
+      * frame frameId, and return true. The default implementation does 
+      * nothing and returns false, in which case frames must be read
+      * consecutively.
+      *
+      * \param file input file stream
+      * \param frameId index of frame to be read next
+      * \return true if random access is supported, false otherwise
+      */
+      virtual bool seekFrame(std::fstream& file, int frameId);
+
+      /**
+      * Open a trajectory file and read its header.
+      *
+      * The default implementation opens a binary std::fstream and calls
+      * readHeader(std::fstream&).
+      *
+      * \param filename name of trajectory file
+      */
+      virtual void open(const std::string& filename);
+
+      /**
+      * Read the next frame from the file opened by open().
+      *
+      * The default implementation calls readFrame(std::fstream&).
+      */
+      virtual void readFrame();
+
+      /**
+      * Move to a specified frame of the file opened by open(), if possible.
+      *
+      * The default implementation calls seekFrame(std::fstream&, int).
+      *
+      * \param frameId index of frame to be read next
+      * \return true if random access is supported, false otherwise
+      */
+      virtual bool seekFrame(int frameId);
+
+      /**
+      * Close the file opened by open().
+      */
+      virtual void close();
+
       /**
       * Write trajectory file header.
       *
@@ -89,6 +143,9 @@ namespace McMd
       Boundary &boundary() const;
 
    private:
+
+      /// File stream used by open(), readFrame(), seekFrame() and close().
+      std::fstream file_;
    
       /// Boundary object.
       Boundary   *boundaryPtr_;
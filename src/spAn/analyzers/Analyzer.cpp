@@ -58,6 +58,16 @@ namespace SpAn
    void Analyzer::readOutputFileName(std::istream &in)
    {  read<std::string>(in, "outputFileName", outputFileName_); }
 
+   /*
+   * Merge accumulators (not supported by default).
+   */
+   void Analyzer::merge(Analyzer& other)
+   {
+      std::string msg = className();
+      msg += " does not support parallel analysis";
+      UTIL_THROW(msg.c_str());
+   }
+
    /*
    * Get the outputFileName string with an added suffix
    */
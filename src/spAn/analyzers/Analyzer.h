@@ -94,6 +94,29 @@ namespace SpAn
       */
       virtual void output()
       {}
+
+      /**
+      * Add statistical accumulators of another Analyzer to this one.
+      *
+      * This is used to combine the results of identical analyzers that 
+      * sampled different blocks of frames in a parallel analysis, before
+      * output() is called. The other Analyzer is an instance of the same
+      * subclass, created from the same parameter file. 
+      *
+      * The default implementation throws an Exception. Subclasses that
+      * override merge() must also override isMergeable().
+      *
+      * \param other Analyzer that sampled a later block of frames
+      */
+      virtual void merge(Analyzer& other);
+
+      /**
+      * Does this class implement merge()?
+      *
+      * The default implementation returns false.
+      */
+      virtual bool isMergeable() const
+      {  return false; }
   
       /**
       * Get interval value.
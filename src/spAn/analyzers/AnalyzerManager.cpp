@@ -82,6 +82,30 @@ namespace SpAn
       }
    }
 
+   /*
+   * Call merge method of each analyzer.
+   */
+   void AnalyzerManager::merge(AnalyzerManager& other) 
+   {
+      if (other.size() != size()) {
+         UTIL_THROW("Inconsistent numbers of analyzers");
+      }
+      for (int i=0; i < size(); ++i) {
+         (*this)[i].merge(other[i]);
+      }
+   }
+
+   /*
+   * Return true iff every analyzer implements merge.
+   */
+   bool AnalyzerManager::isMergeable() const
+   {
+      for (int i=0; i < size(); ++i) {
+         if (!(*this)[i].isMergeable()) return false;
+      }
+      return true;
+   }
+
    /*
    * Return pointer to default factory.
    */
@@ -70,6 +70,22 @@ namespace SpAn
       */
       void output();
 
+      /**
+      * Call merge method of each analyzer.
+      *
+      * The other AnalyzerManager must have been created by reading the
+      * same parameter file, so that corresponding analyzers have the 
+      * same class and parameters.
+      *
+      * \param other AnalyzerManager that sampled a later block of frames
+      */
+      void merge(AnalyzerManager& other);
+
+      /**
+      * Return true iff every analyzer implements merge().
+      */
+      bool isMergeable() const;
+
       /**
       * Return pointer to a new default factory.
       */
@@ -161,6 +161,15 @@ namespace SpAn
 
    }
 
+   /*
+   * Add accumulator of another AtomMSD.
+   */
+   void AtomMSD::merge(Analyzer& other)
+   {
+      AtomMSD& otherMSD = dynamic_cast<AtomMSD&>(other);
+      accumulator_.merge(otherMSD.accumulator_);
+   }
+
    #if 1
    /// Output results to file after simulation is completed.
    void AtomMSD::output() 
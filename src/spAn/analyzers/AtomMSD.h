@@ -59,6 +59,22 @@ namespace SpAn
       */
       virtual void output();
 
+      /**
+      * Add accumulator of another AtomMSD to this one.
+      *
+      * Displacements between frames analyzed by different AtomMSD 
+      * objects are not included.
+      *
+      * \param other AtomMSD that sampled a later block of frames
+      */
+      virtual void merge(Analyzer& other);
+
+      /**
+      * Return true (AtomMSD implements merge).
+      */
+      virtual bool isMergeable() const
+      {  return true; }
+
    private:
    
       /// Output file stream
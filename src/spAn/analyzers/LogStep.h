@@ -47,17 +47,38 @@ namespace SpAn
       virtual void setup(){};
    
       /** 
-      * Evaluate end-to-end vectors of all chains, add to ensemble.
+      * Write step number to std::cout.
+      *
+      * Output is serialized, because Processor::analyzeDumps() may call
+      * this from several threads, for different Processor objects.
       *
       * \param iStep counter for number of steps
       */
       virtual void sample(long iStep)
-      {  std::cout << "iStep = " << iStep << std::endl; }
+      {
+         #ifdef UTIL_OPENMP
+         #pragma omp critical(SpAn_LogStep_sample)
+         #endif
+         std::cout << "iStep = " << iStep << std::endl;
+      }
 
       /**
       * Output results to file after simulation is completed.
       */
       virtual void output(){};
+
+      /**
+      * Merge with another LogStep (nothing to merge).
+      *
+      * \param other another LogStep
+      */
+      virtual void merge(Analyzer& other){};
+
+      /**
+      * Return true (LogStep implements merge).
+      */
+      virtual bool isMergeable() const
+      {  return true; }
    
    };
 
@@ -117,7 +117,7 @@ namespace SpAn
             speciesId = iter->speciesId;
             configuration().species(speciesId).addAtom(*iter);
          }
-         for (int i = 0; configuration().nSpecies(); ++i) {
+         for (int i = 0; i < configuration().nSpecies(); ++i) {
             configuration().species(i).isValid();
          }
       }
@@ -21,7 +21,7 @@ using namespace Util;
 * 
 * Usage:
 *
-*    mdPp [-t] [-i inputConfigIo]  param config first last
+*    mdPp [-t] [-i inputConfigIo] [-n nThread]  param config first last
 *
 * Required arguments:
 *
@@ -45,6 +45,11 @@ using namespace Util;
 *        Specify input configuration/trajectory format. The required
 *        argument inputConfigIo is the name of a ConfigIo subclass.
 *
+*     -n nThread
+*
+*        Analyze configuration files using nThread threads, each of 
+*        which analyzes a contiguous block of files. Requires OpenMP.
+*
 * \ingroup
 */
 
@@ -57,9 +62,10 @@ int main(int argc, char** argv)
    bool tFlag = false;
    bool iFlag = false;
    std::string configIoName = "DdMdConfigIo";
+   int nThread = 1;
    int c;
    opterr = 0;
-   while ((c = getopt(argc, argv, "ti:")) != -1) {
+   while ((c = getopt(argc, argv, "ti:n:")) != -1) {
       switch (c) {
       case 't':
          tFlag = true;
@@ -68,6 +74,9 @@ int main(int argc, char** argv)
          iFlag = true;
          configIoName = optarg;
          break;
+      case 'n':
+         nThread = atoi(optarg);
+         break;
       case '?':
          Log::file() << "Unknown option -" << optopt << std::endl;
       }
@@ -89,10 +98,7 @@ int main(int argc, char** argv)
    std::cout << "last       = " << last << std::endl;
 
    // Read parameter file
-   std::ifstream paramFile;
-   paramFile.open(paramFileName);
-   processor.readParam(paramFile);
-   paramFile.close();
+   processor.readParam(paramFileName);
 
    // Set input file format format
    if (iFlag) {
@@ -101,7 +107,7 @@ int main(int argc, char** argv)
    }
 
    // Process dumps
-   processor.analyzeDumps(first, last, configFileName);
+   processor.analyzeDumps(first, last, configFileName, nThread);
 
    return 0;
 }
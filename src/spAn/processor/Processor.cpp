@@ -10,6 +10,8 @@
 
 #include "Processor.h"
 #include <spAn/configIos/DdMdConfigIo.h>
+#include <util/containers/DArray.h>
+#include <util/misc/Log.h>
 
 // std headers
 #include <fstream>
@@ -47,6 +49,7 @@ namespace SpAn
       in.open(filename);
       readParam(in);
       in.close();
+      paramFileName_ = filename;
    }
 
    /*
@@ -73,6 +76,7 @@ namespace SpAn
          msg += configIoName;
          UTIL_THROW(msg.c_str());
       }
+      configIoName_ = configIoName;
    }
 
    /*
@@ -129,20 +133,93 @@ namespace SpAn
    /*
    * Read and analyze a sequence of configuration files.
    */
-   void Processor::analyzeDumps(int min, int max, std::string baseFileName)
+   void Processor::analyzeDumps(int min, int max, std::string baseFileName,
+                                int nThread)
    {
       // Preconditions
       if (min < 0)    UTIL_THROW("min < 0");
       if (max < min)  UTIL_THROW("max < min");
+      if (nThread < 1)  UTIL_THROW("nThread < 1");
 
-      //Timer timer;
+      if (nThread > max - min + 1) {
+         nThread = max - min + 1;
+      }
+      #ifndef UTIL_OPENMP
+      if (nThread > 1) {
+         Log::file() << "Warning: OpenMP is disabled, using 1 thread" 
+                     << std::endl;
+         nThread = 1;
+      }
+      #endif
+      if (nThread > 1 && !analyzerManager_.isMergeable()) {
+         Log::file() << "Warning: Not all analyzers support parallel "
+                     << "analysis, using 1 thread" << std::endl;
+         nThread = 1;
+      }
+
+      // Main loop
+      Log::file() << "begin main loop" << std::endl;
+      if (nThread == 1) {
+         sampleDumps(min, max, baseFileName);
+      } 
+      #ifdef UTIL_OPENMP
+      else {
+         if (paramFileName_.empty()) {
+            UTIL_THROW("Parallel analysis requires a parameter file name");
+         }
+
+         // Create a separate Processor for each additional thread
+         DArray<Processor> processors;
+         processors.allocate(nThread - 1);
+         int i;
+         for (i = 0; i < nThread - 1; ++i) {
+            processors[i].readParam(paramFileName_.c_str());
+            if (!configIoName_.empty()) {
+               processors[i].setConfigIo(configIoName_);
+            }
+         }
+
+         // Analyze contiguous blocks of files in parallel
+         int nFile = max - min + 1;
+         std::string error;
+         #pragma omp parallel for num_threads(nThread) schedule(static, 1)
+         for (i = 0; i < nThread; ++i) {
+            Processor& processor = (i == 0) ? *this : processors[i-1];
+            int first = min + (i*nFile)/nThread;
+            int last  = min + ((i+1)*nFile)/nThread - 1;
+            try {
+               processor.sampleDumps(first, last, baseFileName);
+            } catch (Exception& e) {
+               #pragma omp critical
+               error = e.message();
+            }
+         }
+         if (!error.empty()) {
+            UTIL_THROW(error.c_str());
+         }
+
+         // Merge results of later blocks into this Processor
+         for (i = 0; i < nThread - 1; ++i) {
+            analyzerManager_.merge(processors[i].analyzerManager_);
+         }
+      }
+      #endif
+      Log::file() << "end main loop" << std::endl;
+
+      // Output results of all analyzers to output files
+      analyzerManager_.output();
+   }
+
+   /*
+   * Read and sample a sequence of configuration files.
+   */
+   void Processor::sampleDumps(int min, int max, 
+                               const std::string& baseFileName)
+   {
       std::string filename;
       std::stringstream indexString;
       std::ifstream configFile;
 
-      // Main loop
-      Log::file() << "begin main loop" << std::endl;
-      //timer.start();
       for (int iStep = min; iStep <= max; ++iStep) {
 
          indexString << iStep;
@@ -162,17 +239,6 @@ namespace SpAn
          readConfig(configFile);
          configFile.close();
 
-         #if 0
-         #ifndef INTER_NOPAIR
-         // Build the configuration CellList
-         pairPotential().buildCellList();
-         #endif
-
-         #ifdef UTIL_DEBUG
-         isValid();
-         #endif
-         #endif
-
          // Initialize analyzers (taking in molecular information).
          if (iStep == min) {
             analyzerManager_.setup();
@@ -182,23 +248,6 @@ namespace SpAn
          analyzerManager_.sample(iStep);
 
       }
-      //timer.stop();
-      Log::file() << "end main loop" << std::endl;
-
-      // Output results of all analyzers to output files
-      analyzerManager_.output();
-
-      #if 0
-      // Output time
-      Log::file() << std::endl;
-      Log::file() << "nConfig       " << nConfig << std::endl;
-      Log::file() << "run time      " << timer.time()
-                  << "  sec" << std::endl;
-      Log::file() << "time / config " << timer.time()/double(nConfig)
-                  << "  sec" << std::endl;
-      Log::file() << std::endl;
-      #endif
-
    }
 
    /*
@@ -56,6 +56,9 @@ namespace SpAn
 
       /**
       * Open, read, and close parameter file.
+      *
+      * The file name is retained, and is used to create additional
+      * Processor objects for parallel analysis by analyzeDumps.
       */
       void readParam(const char* filename);
 
@@ -110,11 +113,24 @@ namespace SpAn
       * reads files with names of the form inputPrefix() + n for integer 
       * suffixes min <= n <= max. 
       *
+      * If nThread > 1 and OpenMP is enabled (UTIL_OPENMP), the range of 
+      * files is divided into nThread contiguous blocks that are analyzed
+      * by different threads. Each additional thread uses a separate 
+      * Processor, with its own configuration and analyzers, that is 
+      * created by re-reading the parameter file. The accumulators of all
+      * analyzers are then merged before output. Time correlations are
+      * thus only computed within each block. This requires that the 
+      * parameter file was read with readParam(const char*). If any 
+      * analyzer does not implement Analyzer::merge(), as indicated by
+      * Analyzer::isMergeable(), all files are analyzed by one thread.
+      *
       * \param min  integer suffix of first configuration file name
       * \param max  integer suffix of last configuration file name
       * \param fileBaseName root name for dump files (without integer suffix)
+      * \param nThread number of threads (default 1)
       */  
-      void analyzeDumps(int min, int max, std::string fileBaseName);
+      void analyzeDumps(int min, int max, std::string fileBaseName, 
+                        int nThread = 1);
 
       /**
       * Analyze a trajectory file.
@@ -154,6 +170,18 @@ namespace SpAn
       /// String identifier for ConfigIo class name
       std::string configIoName_;
 
+      /// Name of parameter file (empty if not read by name)
+      std::string paramFileName_;
+
+      /**
+      * Read and sample a sequence of configuration files, without output.
+      *
+      * \param min  integer suffix of first configuration file name
+      * \param max  integer suffix of last configuration file name
+      * \param fileBaseName root name for dump files
+      */  
+      void sampleDumps(int min, int max, const std::string& fileBaseName);
+
    };
 
 }
@@ -121,6 +121,9 @@ namespace SpAn
          dihedrals_.clear();
       }
       #endif
+      for (int i = 0; i < nSpecies_; ++i) {
+         species_[i].clear();
+      }
    }
 
 }
@@ -0,0 +1,521 @@
+#ifndef UTIL_AUTO_CORR_STAGE_H
+#define UTIL_AUTO_CORR_STAGE_H
+
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2012, David Morse (morse012@umn.edu)
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <util/containers/RingBuffer.h>   // member
+#include <util/containers/DArray.h>       // member
+
+// Needed for implementation
+#include <util/accumulators/setToZero.h>
+#include <util/accumulators/product.h>
+#include <util/global.h>
+
+namespace Util
+{
+
+   /**
+   * A hierarchical (multiple-tau) autocorrelation algorithm.
+   *
+   * This class implements one stage of a hierarchical algorithm that
+   * calculates the autocorrelation function of a sequence of values
+   * of type Data over a range of time delays that grows geometrically
+   * with the number of stages, with a bounded cost per sample and a
+   * bounded amount of memory. The algorithm is implemented by a chain
+   * of AutoCorrStage objects, in a manner closely analogous to the
+   * hierarchical block averaging algorithm of AverageStage.
+   *
+   * Each stage holds a RingBuffer containing the most recent values of
+   * the sequence that it samples, and accumulates sums of products of
+   * the current value with each value in this history, as in AutoCorr.
+   * The "primary" stage (stageId = 0) samples the primary sequence of
+   * measured values that are passed to its sample method. Every
+   * blockFactor samples, each stage passes the average of the block
+   * of its most recent blockFactor values to the sample method of a
+   * child stage, which is created when first needed. The stage with
+   * stageId = n thus samples a sequence in which each value is an
+   * average of blockFactor**n values of the primary sequence, and
+   * computes correlations for time delays that are integer multiples
+   * of stageInterval = blockFactor**n. No stage is created with a
+   * stageId greater than the maxStageId parameter of the root stage.
+   *
+   * With a bufferCapacity of m values per stage, the chain yields the
+   * autocorrelation function for all delays 0,...,m-1, and for delays
+   * j*blockFactor**n with m/blockFactor <= j < m for stages n > 0.
+   * The amortized cost per sample is of order m*blockFactor/(blockFactor-1),
+   * independent of the maximum time delay.
+   *
+   * The public interface of the primary AutoCorrStage object gives
+   * access only to statistics of this stage. Access to descendants is
+   * provided by the AutoCorrelation subclass, which maintains an array
+   * of pointers to all stages.
+   *
+   * \ingroup Accumulators_Module
+   */
+   template <typename Data, typename Product>
+   class AutoCorrStage
+   {
+
+   public:
+
+      /**
+      * Constructor.
+      *
+      * This constructor creates a primary AutoCorrStage object with
+      * stageId = 0 and stageInterval = 1. A private constructor is used
+      * to recursively create children of this object.
+      */
+      AutoCorrStage();
+
+      /**
+      * Destructor.
+      *
+      * Recursively destroy all children.
+      */
+      virtual ~AutoCorrStage();
+
+      /**
+      * Set all parameters and allocate memory for the primary stage.
+      *
+      * \param bufferCapacity number of values in history of each stage
+      * \param maxStageId maximum stage index (0 = primary stage only)
+      * \param blockFactor ratio of block sizes of subsequent stages
+      */
+      void setParam(int bufferCapacity = 64, int maxStageId = 10,
+                    int blockFactor = 2);
+
+      /**
+      * Reset to empty state, and recursively destroy all children.
+      */
+      virtual void clear();
+
+      /**
+      * Register the creation of a descendant stage.
+      *
+      * This should be called only by a root stage.
+      *
+      * \param descendantPtr pointer to a descendant AutoCorrStage.
+      */
+      virtual void registerDescendant(AutoCorrStage<Data, Product>*
+                                      descendantPtr);
+
+      /**
+      * Sample a value.
+      *
+      * \param value current value
+      */
+      virtual void sample(Data value);
+
+      /**
+      * Serialize to/from an archive.
+      *
+      * \param ar      archive
+      * \param version archive version id
+      */
+      template <class Archive>
+      void serialize(Archive& ar, const unsigned int version);
+
+      ///\name Accessors
+      //@{
+
+      /**
+      * Return capacity of the history buffer of each stage.
+      */
+      int bufferCapacity() const;
+
+      /**
+      * Return the number of values sampled by this stage.
+      */
+      long nSample() const;
+
+      /**
+      * Return the number of primary values per sample at this stage.
+      */
+      long stageInterval() const;
+
+      /**
+      * Return average of all values sampled by this stage.
+      */
+      Data average() const;
+
+      /**
+      * Return number of time delays for which correlations are stored.
+      */
+      int nDelay() const;
+
+      /**
+      * Return average of products for delay index i, with 0 <= i < nDelay.
+      *
+      * \param i index of delay, in units of stageInterval
+      */
+      Product corrAverage(int i) const;
+
+      //@}
+
+   protected:
+
+      /// Physical capacity (# of elements) of buffer, corr, and nCorr.
+      int  bufferCapacity_;
+
+      /// Maximum allowed stage index.
+      int  maxStageId_;
+
+      /// Number of samples per block.
+      int  blockFactor_;
+
+      /**
+      * Allocate memory, and initialize to empty state.
+      */
+      void allocate();
+
+      /**
+      * Does this object have a child AutoCorrStage for block averages?
+      */
+      bool hasChild() const;
+
+      /**
+      * Return the child AutoCorrStage by reference.
+      */
+      AutoCorrStage& child();
+
+   private:
+
+      // Ring buffer containing a sequence of stored Data values.
+      RingBuffer<Data>  buffer_;
+
+      // Array in which corr[j] = sum of values of <x(i-j), x(i)>
+      DArray<Product>  corr_;
+
+      // Array in which nCorr[i] = number of values added to corr[i]
+      DArray<long>  nCorr_;
+
+      // Sum of all values sampled by this stage.
+      Data  sum_;
+
+      // Sum of sampled values in the current block.
+      Data  blockSum_;
+
+      // Number of values sampled by this stage.
+      long  nSample_;
+
+      // Number of values in the current block.
+      long  nBlockSample_;
+
+      // Number of primary values per sampled value at this stage.
+      long  stageInterval_;
+
+      // Pointer to child stage, if any.
+      AutoCorrStage<Data, Product>* childPtr_;
+
+      // Pointer to root stage.
+      AutoCorrStage<Data, Product>* rootPtr_;
+
+      // Stage index.
+      int  stageId_;
+
+      /**
+      * Constructor for child objects.
+      *
+      * \param stageInterval number of primary values per sample
+      * \param stageId       integer id for this stage
+      * \param maxStageId    maximum stage index
+      * \param rootPtr       pointer to root AutoCorrStage
+      * \param blockFactor   ratio of block sizes of subsequent stages
+      */
+      AutoCorrStage(long stageInterval, int stageId, int maxStageId,
+                    AutoCorrStage<Data, Product>* rootPtr, int blockFactor);
+
+      /**
+      * Copy constructor - private and not implemented.
+      */
+      AutoCorrStage(const AutoCorrStage& other);
+
+      /**
+      * Assignment - private and not implemented.
+      */
+      AutoCorrStage& operator = (const AutoCorrStage& other);
+
+   };
+
+   // Inline methods
+
+   /*
+   * Does this object have a child?  (protected)
+   */
+   template <typename Data, typename Product>
+   inline bool AutoCorrStage<Data, Product>::hasChild() const
+   {  return bool(childPtr_); }
+
+   /*
+   * Return child object by reference. (protected)
+   */
+   template <typename Data, typename Product>
+   inline AutoCorrStage<Data, Product>& AutoCorrStage<Data, Product>::child()
+   {  return *childPtr_; }
+
+   // Non-inline methods
+
+   /*
+   * Constructor for root AutoCorrStage, with stageId = 0.
+   */
+   template <typename Data, typename Product>
+   AutoCorrStage<Data, Product>::AutoCorrStage()
+    : bufferCapacity_(0),
+      maxStageId_(0),
+      blockFactor_(2),
+      buffer_(),
+      corr_(),
+      nCorr_(),
+      nSample_(0),
+      nBlockSample_(0),
+      stageInterval_(1),
+      childPtr_(0),
+      rootPtr_(0),
+      stageId_(0)
+   {
+      rootPtr_ = this;
+      setToZero(sum_);
+      setToZero(blockSum_);
+   }
+
+   /*
+   * Constructor for dynamically generated objects with stageId > 0.
+   */
+   template <typename Data, typename Product>
+   AutoCorrStage<Data, Product>::AutoCorrStage(long stageInterval,
+                                      int stageId, int maxStageId,
+                                      AutoCorrStage<Data, Product>* rootPtr,
+                                      int blockFactor)
+    : bufferCapacity_(rootPtr->bufferCapacity()),
+      maxStageId_(maxStageId),
+      blockFactor_(blockFactor),
+      buffer_(),
+      corr_(),
+      nCorr_(),
+      nSample_(0),
+      nBlockSample_(0),
+      stageInterval_(stageInterval),
+      childPtr_(0),
+      rootPtr_(rootPtr),
+      stageId_(stageId)
+   {
+      setToZero(sum_);
+      setToZero(blockSum_);
+      allocate();
+   }
+
+   /*
+   * Destructor.
+   */
+   template <typename Data, typename Product>
+   AutoCorrStage<Data, Product>::~AutoCorrStage()
+   {
+      if (childPtr_) {
+         delete childPtr_;
+      }
+   }
+
+   /*
+   * Set parameters and allocate memory of the primary stage.
+   */
+   template <typename Data, typename Product>
+   void AutoCorrStage<Data, Product>::setParam(int bufferCapacity,
+                                               int maxStageId,
+                                               int blockFactor)
+   {
+      bufferCapacity_ = bufferCapacity;
+      maxStageId_ = maxStageId;
+      blockFactor_ = blockFactor;
+      allocate();
+   }
+
+   /*
+   * Allocate arrays and RingBuffer, and initialize.
+   */
+   template <typename Data, typename Product>
+   void AutoCorrStage<Data, Product>::allocate()
+   {
+      if (bufferCapacity_ <= 0) {
+         UTIL_THROW("Nonpositive bufferCapacity");
+      }
+      if (blockFactor_ < 2) {
+         UTIL_THROW("blockFactor < 2");
+      }
+      corr_.allocate(bufferCapacity_);
+      nCorr_.allocate(bufferCapacity_);
+      buffer_.allocate(bufferCapacity_);
+      clear();
+   }
+
+   /*
+   * Set previously allocated to initial empty state.
+   */
+   template <typename Data, typename Product>
+   void AutoCorrStage<Data, Product>::clear()
+   {
+      setToZero(sum_);
+      setToZero(blockSum_);
+      nSample_ = 0;
+      nBlockSample_ = 0;
+      if (bufferCapacity_ > 0) {
+         for (int i = 0; i < bufferCapacity_; ++i) {
+            setToZero(corr_[i]);
+            nCorr_[i] = 0;
+         }
+         buffer_.clear();
+      }
+      if (childPtr_) {
+         delete childPtr_;
+         childPtr_ = 0;
+      }
+   }
+
+   /*
+   * Register a descendant (empty default implementation).
+   */
+   template <typename Data, typename Product>
+   void
+   AutoCorrStage<Data, Product>::registerDescendant(AutoCorrStage<Data, Product>*
+                                                    descendantPtr)
+   {}
+
+   /*
+   * Sample a single value from a time sequence.
+   */
+   template <typename Data, typename Product>
+   void AutoCorrStage<Data, Product>::sample(Data value)
+   {
+      // Increment global accumulators
+      ++nSample_;
+      sum_ += value;
+      buffer_.append(value);
+      for (int i = 0; i < buffer_.size(); ++i) {
+         corr_[i] += product(buffer_[i], value);
+         ++nCorr_[i];
+      }
+
+      // Increment block accumulators
+      blockSum_ += value;
+      ++nBlockSample_;
+
+      if (nBlockSample_ == blockFactor_) {
+         if (stageId_ < maxStageId_) {
+            if (!childPtr_) {
+               long nextStageInterval = stageInterval_*blockFactor_;
+               int  nextStageId = stageId_ + 1;
+               childPtr_ = new AutoCorrStage(nextStageInterval, nextStageId,
+                                             maxStageId_, rootPtr_,
+                                             blockFactor_);
+               rootPtr_->registerDescendant(childPtr_);
+            }
+            // Add block average to child ensemble
+            blockSum_ /= double(blockFactor_);
+            childPtr_->sample(blockSum_);
+         }
+         // Reset block accumulators
+         setToZero(blockSum_);
+         nBlockSample_ = 0;
+      }
+   }
+
+   /*
+   * Return capacity of history buffer.
+   */
+   template <typename Data, typename Product>
+   int AutoCorrStage<Data, Product>::bufferCapacity() const
+   {  return bufferCapacity_; }
+
+   /*
+   * Return number of values sampled by this stage.
+   */
+   template <typename Data, typename Product>
+   long AutoCorrStage<Data, Product>::nSample() const
+   {  return nSample_; }
+
+   /*
+   * Return the number of primary values per sample at this stage.
+   */
+   template <typename Data, typename Product>
+   long AutoCorrStage<Data, Product>::stageInterval() const
+   {  return stageInterval_; }
+
+   /*
+   * Return average of values sampled by this stage.
+   */
+   template <typename Data, typename Product>
+   Data AutoCorrStage<Data, Product>::average() const
+   {
+      Data ave = sum_;
+      ave /= double(nSample_);
+      return ave;
+   }
+
+   /*
+   * Return number of delays for which correlations are stored.
+   */
+   template <typename Data, typename Product>
+   int AutoCorrStage<Data, Product>::nDelay() const
+   {  return buffer_.size(); }
+
+   /*
+   * Return average product <x(j-i), x(j)> for delay index i.
+   */
+   template <typename Data, typename Product>
+   Product AutoCorrStage<Data, Product>::corrAverage(int i) const
+   {
+      assert(i < buffer_.size());
+      Product value = corr_[i];
+      value /= double(nCorr_[i]);
+      return value;
+   }
+
+   /*
+   * Serialize this stage, and recursively serialize all children.
+   */
+   template <typename Data, typename Product>
+   template <class Archive>
+   void AutoCorrStage<Data, Product>::serialize(Archive& ar,
+                                                const unsigned int version)
+   {
+      ar & buffer_;
+      ar & corr_;
+      ar & nCorr_;
+      ar & sum_;
+      ar & blockSum_;
+      ar & nSample_;
+      ar & nBlockSample_;
+      ar & stageInterval_;
+      ar & blockFactor_;
+
+      // Does this stage have a child?
+      int hasChild;
+      if (Archive::is_saving()) {
+         hasChild = (childPtr_ == 0) ? 0 : 1;
+      }
+      ar & hasChild;
+
+      // Serialize child (if any)
+      if (hasChild) {
+         if (Archive::is_loading()) {
+            long nextStageInterval = stageInterval_*blockFactor_;
+            int  nextStageId = stageId_ + 1;
+            childPtr_ = new AutoCorrStage(nextStageInterval, nextStageId,
+                                          maxStageId_, rootPtr_,
+                                          blockFactor_);
+            rootPtr_->registerDescendant(childPtr_);
+         }
+         ar & (*childPtr_);
+      } else {
+         if (Archive::is_loading()) {
+            childPtr_ = 0;
+         }
+      }
+   }
+
+}
+#endif
@@ -0,0 +1,305 @@
+#ifndef UTIL_AUTO_CORRELATION_H
+#define UTIL_AUTO_CORRELATION_H
+
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2012, David Morse (morse012@umn.edu)
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <util/accumulators/AutoCorrStage.h>  // base class
+#include <util/param/ParamComposite.h>        // base class
+
+// Needed for implementation
+#include <util/format/Lng.h>
+#include <util/format/write.h>
+
+#include <vector>
+
+namespace Util
+{
+
+   /**
+   * Auto-correlation function, using a hierarchical algorithm.
+   *
+   * This class computes the autocorrelation function of a sequence of
+   * Data values, using the hierarchical (multiple-tau) algorithm that
+   * is implemented by the AutoCorrStage base class. Correlations are
+   * obtained for all time delays less than the buffer capacity, and for
+   * sparser, logarithmically spaced delays up to a maximum delay of order
+   * capacity*blockFactor**maxStageId, at a cost per sample that does
+   * not depend on the maximum delay.
+   *
+   * The output() method writes the autocorrelation function, after
+   * subtraction of the square of the average, as pairs of values of
+   * the time delay (in units of the sampling interval) and correlation,
+   * in order of increasing delay.
+   *
+   * \ingroup Accumulators_Module
+   */
+   template <typename Data, typename Product>
+   class AutoCorrelation : public AutoCorrStage<Data, Product>,
+                           public ParamComposite
+   {
+
+   public:
+
+      /**
+      * Constructor
+      */
+      AutoCorrelation();
+
+      /**
+      * Destructor
+      */
+      virtual ~AutoCorrelation();
+
+      /**
+      * Reset to empty state.
+      */
+      virtual void clear();
+
+      /**
+      * Read parameters, allocate memory and initialize.
+      *
+      * Reads the buffer capacity and maximum stage index.
+      *
+      * \param in input parameter stream.
+      */
+      void readParameters(std::istream& in);
+
+      /**
+      * Load state from an archive.
+      *
+      * \param ar binary loading (input) archive.
+      */
+      virtual void loadParameters(Serializable::IArchive& ar);
+
+      /**
+      * Save state to an archive.
+      *
+      * \param ar binary saving (output) archive.
+      */
+      virtual void save(Serializable::OArchive& ar);
+
+      /**
+      * Serialize to/from an archive.
+      *
+      * \param ar      archive
+      * \param version archive version id
+      */
+      template <class Archive>
+      void serialize(Archive& ar, const unsigned int version);
+
+      /**
+      * Output the autocorrelation function.
+      *
+      * \param out output stream.
+      */
+      void output(std::ostream& out);
+
+      /**
+      * Get delays and correlations, in order of increasing delay.
+      *
+      * \param delays time delays, in units of the sampling interval
+      * \param corrs  correlations, after subtraction of average squared
+      */
+      void getCorrelations(std::vector<long>& delays,
+                           std::vector<Product>& corrs) const;
+
+      /**
+      * Numerical integration of the autocorrelation function.
+      *
+      * Returns the integral of the autocorrelation function, divided
+      * by its value at zero delay, in units of the sampling interval.
+      */
+      double corrTime() const;
+
+      /**
+      * Add pointer to a descendant to an array.
+      *
+      * \param descendantPtr pointer to new descendant stage
+      */
+      virtual void registerDescendant(AutoCorrStage<Data, Product>*
+                                      descendantPtr);
+
+   private:
+
+      typedef AutoCorrStage<Data, Product> Stage;
+
+      /// Array of pointers to all stages, indexed by stage id.
+      std::vector<Stage*>  descendants_;
+
+      /// Private and not implemented to prohibit copying.
+      AutoCorrelation(const AutoCorrelation& other);
+
+      /// Private and not implemented to prohibit assignment.
+      AutoCorrelation& operator = (const AutoCorrelation& other);
+
+   };
+
+   /*
+   * Default constructor.
+   */
+   template <typename Data, typename Product>
+   AutoCorrelation<Data, Product>::AutoCorrelation()
+    : Stage(),
+      ParamComposite(),
+      descendants_()
+   {
+      setClassName("AutoCorrelation");
+      // Register self as first "descendant" stage.
+      descendants_.push_back(this);
+   }
+
+   /*
+   * Destructor.
+   */
+   template <typename Data, typename Product>
+   AutoCorrelation<Data, Product>::~AutoCorrelation()
+   {}
+
+   /*
+   * Reset to empty state, and remove pointers to destroyed descendants.
+   */
+   template <typename Data, typename Product>
+   void AutoCorrelation<Data, Product>::clear()
+   {
+      Stage::clear();
+      descendants_.resize(1);
+   }
+
+   /*
+   * Read parameters and allocate all required memory.
+   */
+   template <typename Data, typename Product>
+   void AutoCorrelation<Data, Product>::readParameters(std::istream& in)
+   {
+      read<int>(in, "capacity", Stage::bufferCapacity_);
+      read<int>(in, "maxStageId", Stage::maxStageId_);
+      Stage::allocate();
+      descendants_.resize(1);
+   }
+
+   /*
+   * Load state from an archive.
+   */
+   template <typename Data, typename Product>
+   void
+   AutoCorrelation<Data, Product>::loadParameters(Serializable::IArchive& ar)
+   {
+      loadParameter<int>(ar, "capacity", Stage::bufferCapacity_);
+      loadParameter<int>(ar, "maxStageId", Stage::maxStageId_);
+      descendants_.resize(1);
+      Stage::serialize(ar, 0);
+   }
+
+   /*
+   * Save state to an archive.
+   */
+   template <typename Data, typename Product>
+   void AutoCorrelation<Data, Product>::save(Serializable::OArchive& ar)
+   {  ar & *this; }
+
+   /*
+   * Serialize to/from an archive.
+   */
+   template <typename Data, typename Product>
+   template <class Archive>
+   void AutoCorrelation<Data, Product>::serialize(Archive& ar,
+                                                  const unsigned int version)
+   {
+      ar & Stage::bufferCapacity_;
+      ar & Stage::maxStageId_;
+      if (Archive::is_loading()) {
+         descendants_.resize(1);
+      }
+      Stage::serialize(ar, version);
+   }
+
+   /*
+   * Add a pointer to a descendant stage.
+   */
+   template <typename Data, typename Product>
+   void
+   AutoCorrelation<Data, Product>::registerDescendant(Stage* descendantPtr)
+   {  descendants_.push_back(descendantPtr); }
+
+   /*
+   * Get delays and correlations, in order of increasing delay.
+   *
+   * All delays less than the buffer capacity are taken from the primary
+   * stage. Each later stage contributes only delays that are greater
+   * than those available from the previous stage.
+   */
+   template <typename Data, typename Product>
+   void
+   AutoCorrelation<Data, Product>::getCorrelations(std::vector<long>& delays,
+                                          std::vector<Product>& corrs) const
+   {
+      delays.clear();
+      corrs.clear();
+      if (Stage::nSample() == 0) return;
+
+      Data ave = Stage::average();
+      Product aveSq = product(ave, ave);
+      Product corr;
+
+      Stage* stagePtr;
+      long interval;
+      int  i, j, jMin, nDelay;
+      int  n = descendants_.size();
+      for (i = 0; i < n; ++i) {
+         stagePtr = descendants_[i];
+         interval = stagePtr->stageInterval();
+         nDelay = stagePtr->nDelay();
+         jMin = (i == 0) ? 0 : Stage::bufferCapacity_/Stage::blockFactor_;
+         for (j = jMin; j < nDelay; ++j) {
+            corr = stagePtr->corrAverage(j);
+            corr -= aveSq;
+            delays.push_back(j*interval);
+            corrs.push_back(corr);
+         }
+      }
+   }
+
+   /*
+   * Output autocorrelation function, with delays in sampling intervals.
+   */
+   template <typename Data, typename Product>
+   void AutoCorrelation<Data, Product>::output(std::ostream& out)
+   {
+      std::vector<long> delays;
+      std::vector<Product> corrs;
+      getCorrelations(delays, corrs);
+      for (unsigned int i = 0; i < delays.size(); ++i) {
+         out << Lng(delays[i]);
+         write<Product>(out, corrs[i]);
+         out << std::endl;
+      }
+   }
+
+   /*
+   * Return correlation time, in units of the sampling interval.
+   *
+   * Integrates over the non-uniform grid of delays by the trapezoidal rule.
+   */
+   template <typename Data, typename Product>
+   double AutoCorrelation<Data, Product>::corrTime() const
+   {
+      std::vector<long> delays;
+      std::vector<Product> corrs;
+      getCorrelations(delays, corrs);
+
+      Product sum;
+      setToZero(sum);
+      for (unsigned int i = 1; i < delays.size(); ++i) {
+         sum += 0.5*double(delays[i] - delays[i-1])*(corrs[i] + corrs[i-1]);
+      }
+      sum /= corrs[0];
+      return sum;
+   }
+
+}
+#endif
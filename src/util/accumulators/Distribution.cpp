@@ -214,18 +214,18 @@ namespace Util
             histogram_[i] = 0.0;
          }
       }
-      delete totHistogram;
+      delete [] totHistogram;
 
-      long totSample; 
-      communicator.Reduce(&nSample_, &totSample, 1, MPI::LONG, MPI::SUM, root);
+      int totSample; 
+      communicator.Reduce(&nSample_, &totSample, 1, MPI::INT, MPI::SUM, root);
       if (communicator.Get_rank() == root) {
          nSample_ = totSample;
       } else {
          nSample_ = 0;
       }
 
-      long totReject; 
-      communicator.Reduce(&nReject_, &totReject, 1, MPI::LONG, MPI::SUM, root);
+      int totReject; 
+      communicator.Reduce(&nReject_, &totReject, 1, MPI::INT, MPI::SUM, root);
       if (communicator.Get_rank() == root) {
          nReject_ = totReject;
       } else {
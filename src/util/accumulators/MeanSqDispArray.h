@@ -118,6 +118,21 @@ namespace Util
       * \param values Array of current values
       */
       void sample(const Array<Data>& values);
+
+      /**
+      * Add the statistical sums of another MeanSqDispArray to this one.
+      *
+      * This is used to combine results obtained from different blocks 
+      * of a long sequence, e.g., by different threads. Displacements 
+      * between values in different blocks are not included. The 
+      * history buffers of this object are not modified.
+      *
+      * \pre other.bufferCapacity() == bufferCapacity()
+      * \pre other.nEnsemble() == nEnsemble()
+      *
+      * \param other MeanSqDispArray containing results for another block
+      */
+      void merge(const MeanSqDispArray<Data>& other);
    
       /**
       * Output the autocorrelation function
@@ -356,6 +371,25 @@ namespace Util
       };
    }
   
+   /*
+   * Add sums accumulated by another MeanSqDispArray.
+   */
+   template <typename Data>
+   void MeanSqDispArray<Data>::merge(const MeanSqDispArray<Data>& other)
+   {
+      if (other.bufferCapacity_ != bufferCapacity_) {
+         UTIL_THROW("Inconsistent bufferCapacity values");
+      }
+      if (other.nEnsemble_ != nEnsemble_) {
+         UTIL_THROW("Inconsistent nEnsemble values");
+      }
+      for (int j = 0; j < bufferCapacity_; ++j) {
+         sqDiffSums_[j] += other.sqDiffSums_[j];
+         nValues_[j] += other.nValues_[j];
+      }
+      nSample_ += other.nSample_;
+   }
+
    /**
    * Square difference for integer data = double(|data1 - data2|^2) .
    *
@@ -410,8 +444,7 @@ namespace Util
       double msd;
    
       // Calculate and output mean-squared difference
-      int bufferSize = buffers_[0].size();
-      for (int i = 0; i < bufferSize; ++i) {
+      for (int i = 0; i < bufferCapacity_ && nValues_[i] > 0; ++i) {
          msd = sqDiffSums_[i]/double(nValues_[i]*nEnsemble_);
          out << Int(i) << Dbl(msd) << std::endl;
       }
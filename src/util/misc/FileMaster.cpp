@@ -210,13 +210,7 @@ namespace Util
    void
    FileMaster::openInputFile(const std::string& name, std::ifstream& in) const
    {
-      // Construct filename = inputPrefix_ + name
-      std::string filename(rootPrefix_);
-      if (hasDirectoryId_) {
-         filename += directoryIdPrefix_;
-      }
-      filename += inputPrefix_;
-      filename += name;
+      std::string filename = inputFilePath(name);
 
       in.open(filename.c_str());
 
@@ -230,19 +224,28 @@ namespace Util
    }
 
    /*
-   * Open and return an output file named outputPrefix + name
+   * Return the path to an input file.
    */
-   void
-   FileMaster::openOutputFile(const std::string& name, std::ofstream& out, bool append)
-   const
+   std::string FileMaster::inputFilePath(const std::string& name) const
    {
-      // Construct filename = outputPrefix_ + name
+      // Construct filename = inputPrefix_ + name
       std::string filename(rootPrefix_);
       if (hasDirectoryId_) {
          filename += directoryIdPrefix_;
       }
-      filename += outputPrefix_;
+      filename += inputPrefix_;
       filename += name;
+      return filename;
+   }
+
+   /*
+   * Open and return an output file named outputPrefix + name
+   */
+   void
+   FileMaster::openOutputFile(const std::string& name, std::ofstream& out, bool append)
+   const
+   {
+      std::string filename = outputFilePath(name);
 
       if (append)
          out.open(filename.c_str(), std::ios::out | std::ios::app);
@@ -258,6 +261,21 @@ namespace Util
 
    }
 
+   /*
+   * Return the path to an output file.
+   */
+   std::string FileMaster::outputFilePath(const std::string& name) const
+   {
+      // Construct filename = outputPrefix_ + name
+      std::string filename(rootPrefix_);
+      if (hasDirectoryId_) {
+         filename += directoryIdPrefix_;
+      }
+      filename += outputPrefix_;
+      filename += name;
+      return filename;
+   }
+
    /*
    * Open an input restart parameter file.
    */
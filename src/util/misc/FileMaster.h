@@ -223,6 +223,17 @@ namespace Util
       */
       void openInputFile(const std::string& filename, std::ifstream& in) const;
 
+      /**
+      * Return the path to an input file.
+      *
+      * The path is constructed as in openInputFile(), by concatenating:
+      * [rootPrefix] + [directoryIdPrefix] + inputPrefix + filename.
+      *
+      * \param  filename  file name, without any prefix
+      * \return full path to the input file
+      */
+      std::string inputFilePath(const std::string& filename) const;
+
       /**
       * Open an output file.
       *
@@ -236,6 +247,17 @@ namespace Util
       void 
       openOutputFile(const std::string& filename, std::ofstream& out, bool append = false) const;
 
+      /**
+      * Return the path to an output file.
+      *
+      * The path is constructed as in openOutputFile(), by concatenating:
+      * [rootPrefix] + [directoryIdPrefix] + outputPrefix + filename.
+      *
+      * \param  filename  file name, without any prefix
+      * \return full path to the output file
+      */
+      std::string outputFilePath(const std::string& filename) const;
+
       /**
       * Open an input restart parameter file for reading.
       *
@@ -0,0 +1,83 @@
+#ifndef UTIL_SIMD_CPP
+#define UTIL_SIMD_CPP
+
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2012, David Morse (morse012@umn.edu)
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "Simd.h"
+
+namespace Util
+{
+
+   int Simd::level_ = -1;
+
+   int Simd::detectedLevel_ = -1;
+
+   int Simd::maxLevel_ = Simd::Avx512;
+
+   /*
+   * Detect processor capabilities and set the level used by kernels.
+   */
+   void Simd::initStatic()
+   {
+      if (detectedLevel_ < 0) {
+         detectedLevel_ = detect();
+      }
+      level_ = detectedLevel_ < maxLevel_ ? detectedLevel_ : maxLevel_;
+   }
+
+   /*
+   * Return highest level supported by the processor.
+   */
+   Simd::Level Simd::detectedLevel()
+   {
+      if (detectedLevel_ < 0) {
+         initStatic();
+      }
+      return Level(detectedLevel_);
+   }
+
+   /*
+   * Set maximum level used by kernels.
+   */
+   void Simd::setMaxLevel(Simd::Level maxLevel)
+   {
+      maxLevel_ = maxLevel;
+      initStatic();
+   }
+
+   /*
+   * Return name string for a level.
+   */
+   const char* Simd::name(Simd::Level level)
+   {
+      switch (level) {
+         case Avx512: return "Avx512";
+         case Avx2:   return "Avx2";
+         default:     return "Scalar";
+      }
+   }
+
+   /*
+   * Query the processor, using the GNU cpu feature builtins.
+   */
+   int Simd::detect()
+   {
+      #ifdef UTIL_SIMD_X86
+      __builtin_cpu_init();
+      if (__builtin_cpu_supports("avx512f")) {
+         return Avx512;
+      }
+      if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+         return Avx2;
+      }
+      #endif
+      return Scalar;
+   }
+
+}
+#endif
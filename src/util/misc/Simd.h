@@ -0,0 +1,110 @@
+#ifndef UTIL_SIMD_H
+#define UTIL_SIMD_H
+
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2012, David Morse (morse012@umn.edu)
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <util/global.h>
+
+/*
+* UTIL_SIMD_X86 is defined if the compiler can generate x86 AVX2 and
+* AVX-512 code for individual functions (via the GNU "target" function
+* attribute) in a file that is otherwise compiled for a generic target.
+* Define UTIL_NO_SIMD to disable all explicitly vectorized kernels.
+*/
+#ifndef UTIL_NO_SIMD
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#if defined(__clang__) || (__GNUC__ > 4) || \
+    (__GNUC__ == 4 && __GNUC_MINOR__ >= 9)
+#define UTIL_SIMD_X86
+#endif
+#endif
+#endif
+
+namespace Util
+{
+
+   /**
+   * Run-time selection of SIMD instruction set extensions.
+   *
+   * Explicitly vectorized kernels (e.g., the pair interaction block
+   * kernels) call Simd::level() to choose among an AVX-512, AVX2 or a
+   * portable scalar implementation. The level is the highest one that
+   * is supported by both the processor and the compiler, and that does
+   * not exceed a maximum level set by setMaxLevel().
+   *
+   * \ingroup Misc_Module
+   */
+   class Simd
+   {
+   public:
+
+      /**
+      * Instruction set levels, in order of increasing capability.
+      */
+      enum Level {Scalar = 0, Avx2 = 1, Avx512 = 2};
+
+      /**
+      * Return the instruction set level to be used by kernels.
+      */
+      static Level level();
+
+      /**
+      * Return the highest level supported by the processor.
+      */
+      static Level detectedLevel();
+
+      /**
+      * Set maximum level to be used (e.g., for testing or to disable SIMD).
+      *
+      * \param maxLevel maximum allowed instruction set level
+      */
+      static void setMaxLevel(Level maxLevel);
+
+      /**
+      * Return a name string for a level ("Scalar", "Avx2" or "Avx512").
+      *
+      * \param level instruction set level
+      */
+      static const char* name(Level level);
+
+      /**
+      * Call this to ensure initialization of static members.
+      */
+      static void initStatic();
+
+   private:
+
+      // Level chosen for use by kernels (-1 before initialization).
+      static int level_;
+
+      // Highest level supported by the processor (-1 before detection).
+      static int detectedLevel_;
+
+      // Maximum allowed level.
+      static int maxLevel_;
+
+      // Detect processor capabilities.
+      static int detect();
+
+   };
+
+   // Inline method
+
+   /*
+   * Return the instruction set level to be used by kernels.
+   */
+   inline Simd::Level Simd::level()
+   {
+      if (level_ < 0) {
+         initStatic();
+      }
+      return Level(level_);
+   }
+
+}
+#endif
@@ -13,6 +13,7 @@
 
 #include <util/misc/Log.h>
 #include <util/misc/Memory.h>
+#include <util/misc/Simd.h>
 #include <util/format/Format.h>
 #include <util/param/ParamComponent.h>
 #include <util/math/Constants.h>
@@ -35,6 +36,7 @@ namespace Util
          Log::initStatic();
          Format::initStatic();
          Memory::initStatic();
+         Simd::initStatic();
          ParamComponent::initStatic();
          Constants::initStatic();
          Vector::initStatic();
@@ -6,7 +6,8 @@ util_misc_=\
     util/misc/initStatic.cpp \
     util/misc/ioUtil.cpp \
     util/misc/Log.cpp \
-    util/misc/Memory.cpp
+    util/misc/Memory.cpp \
+    util/misc/Simd.cpp
 
 
 util_misc_SRCS=$(addprefix $(SRC_DIR)/, $(util_misc_))
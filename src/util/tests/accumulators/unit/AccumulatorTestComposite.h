@@ -4,6 +4,8 @@
 #include "AverageTest.h"
 #include "AutoCorrTest.h"
 #include "AutoCorrArrayTest.h"
+#include "AutoCorrelationTest.h"
+#include "MeanSqDispArrayTest.h"
 
 #include <test/CompositeTestRunner.h>
 
@@ -11,6 +13,8 @@ TEST_COMPOSITE_BEGIN(AccumulatorTestComposite)
 TEST_COMPOSITE_ADD_UNIT(AverageTest)
 TEST_COMPOSITE_ADD_UNIT(AutoCorrTest)
 TEST_COMPOSITE_ADD_UNIT(AutoCorrArrayTest)
+TEST_COMPOSITE_ADD_UNIT(AutoCorrelationTest)
+TEST_COMPOSITE_ADD_UNIT(MeanSqDispArrayTest)
 TEST_COMPOSITE_END
 
 #endif
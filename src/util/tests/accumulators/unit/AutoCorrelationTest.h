@@ -0,0 +1,188 @@
+#ifndef AUTOCORRELATION_TEST_H
+#define AUTOCORRELATION_TEST_H
+
+#include <test/UnitTest.h>
+#include <test/UnitTestRunner.h>
+
+#include <util/accumulators/AutoCorrelation.h>
+#include <util/accumulators/AutoCorr.h>
+#include <util/archives/MemoryOArchive.h>
+#include <util/archives/MemoryIArchive.h>
+#include <util/archives/MemoryCounter.h>
+#include <util/archives/BinaryFileIArchive.h>
+#include <util/archives/BinaryFileOArchive.h>
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <math.h>
+
+using namespace Util;
+
+class AutoCorrelationTest : public UnitTest
+{
+
+   AutoCorrelation<double, double> accumulator_;
+
+public:
+
+   AutoCorrelationTest();
+   ~AutoCorrelationTest();
+
+   void setUp(); 
+   void readData();
+   void testReadParam(); 
+   void testSample();
+   void testPrimaryStage();
+   void testSerialize();
+   void testSaveLoad(); 
+
+};
+
+AutoCorrelationTest::AutoCorrelationTest(){}
+AutoCorrelationTest::~AutoCorrelationTest(){}
+
+void AutoCorrelationTest::setUp() 
+{
+   std::ifstream paramFile; 
+   openInputFile("in/AutoCorrelation", paramFile); 
+   accumulator_.readParam(paramFile);
+   paramFile.close();
+}
+
+void AutoCorrelationTest::readData() 
+{
+   int i, n;
+   double x;
+   std::ifstream dataFile; 
+   openInputFile("in/data", dataFile); 
+   dataFile >> n;
+   for (i = 0; i < n; ++i) {
+      dataFile >> x;
+      accumulator_.sample(x);
+   }
+   dataFile.close();
+}
+
+void AutoCorrelationTest::testReadParam() 
+{
+   printMethod(TEST_FUNC);
+
+   printEndl();
+   accumulator_.writeParam(std::cout);
+}
+
+void AutoCorrelationTest::testSample() 
+{
+   printMethod(TEST_FUNC);
+
+   readData();
+   TEST_ASSERT(accumulator_.nSample() == 1000);
+
+   printEndl();
+   accumulator_.output(std::cout);
+}
+
+/*
+* Check that delays less than the capacity agree with AutoCorr.
+*/
+void AutoCorrelationTest::testPrimaryStage() 
+{
+   printMethod(TEST_FUNC);
+
+   readData();
+
+   AutoCorr<double, double> reference;
+   reference.setParam(accumulator_.bufferCapacity());
+   int i, n;
+   double x;
+   std::ifstream dataFile; 
+   openInputFile("in/data", dataFile); 
+   dataFile >> n;
+   for (i = 0; i < n; ++i) {
+      dataFile >> x;
+      reference.sample(x);
+   }
+   dataFile.close();
+
+   std::stringstream out;
+   accumulator_.output(out);
+   long delay;
+   double corr;
+   for (i = 0; i < reference.bufferCapacity(); ++i) {
+      out >> delay >> corr;
+      TEST_ASSERT(delay == i);
+      TEST_ASSERT(fabs(corr - reference.autoCorrelation(i)) < 1.0E-6);
+   }
+}
+
+void AutoCorrelationTest::testSerialize() 
+{
+   printMethod(TEST_FUNC);
+   printEndl();
+
+   readData();
+
+   int size = memorySize(accumulator_);
+
+   MemoryOArchive u;
+   u.allocate(size);
+   u << accumulator_;
+   TEST_ASSERT(u.cursor() == u.begin() + size);
+
+   MemoryIArchive v;
+   v = u;
+
+   AutoCorrelation<double, double> clone;
+   v & clone;
+
+   std::stringstream out1, out2;
+   accumulator_.output(out1);
+   clone.output(out2);
+   TEST_ASSERT(out1.str() == out2.str());
+
+   // Check that both continue identically after further samples
+   for (int i = 0; i < 100; ++i) {
+      accumulator_.sample(0.01*double(i));
+      clone.sample(0.01*double(i));
+   }
+   out1.str("");
+   out2.str("");
+   accumulator_.output(out1);
+   clone.output(out2);
+   TEST_ASSERT(out1.str() == out2.str());
+}
+
+void AutoCorrelationTest::testSaveLoad() 
+{
+   printMethod(TEST_FUNC);
+   printEndl();
+
+   readData();
+
+   BinaryFileOArchive u;
+   openOutputFile("binary", u.file());
+   accumulator_.save(u);
+   u.file().close();
+
+   AutoCorrelation<double, double> clone;
+   BinaryFileIArchive v;
+   openInputFile("binary", v.file());
+   clone.loadParameters(v);
+   v.file().close();
+
+   std::stringstream out1, out2;
+   accumulator_.output(out1);
+   clone.output(out2);
+   TEST_ASSERT(out1.str() == out2.str());
+}
+
+TEST_BEGIN(AutoCorrelationTest)
+TEST_ADD(AutoCorrelationTest, testReadParam)
+TEST_ADD(AutoCorrelationTest, testSample)
+TEST_ADD(AutoCorrelationTest, testPrimaryStage)
+TEST_ADD(AutoCorrelationTest, testSerialize)
+TEST_ADD(AutoCorrelationTest, testSaveLoad)
+TEST_END(AutoCorrelationTest)
+
+#endif
@@ -0,0 +1,132 @@
+#ifndef MEAN_SQ_DISP_ARRAY_TEST_H
+#define MEAN_SQ_DISP_ARRAY_TEST_H
+
+#include <test/UnitTest.h>
+#include <test/UnitTestRunner.h>
+
+#include <util/accumulators/MeanSqDispArray.h>
+#include <util/containers/DArray.h>
+
+#include <iostream>
+#include <sstream>
+#include <cmath>
+
+using namespace Util;
+
+class MeanSqDispArrayTest : public UnitTest
+{
+
+public:
+
+   void setUp()
+   {}
+
+   void tearDown()
+   {}
+
+   /*
+   * Add values x(t) = (i+1)*t*t for sequences i = 0, 1, for t in [min, max].
+   */
+   void sample(MeanSqDispArray<double>& msd, int min, int max)
+   {
+      DArray<double> values;
+      values.allocate(2);
+      for (int t = min; t <= max; ++t) {
+         values[0] = double(t*t);
+         values[1] = 2.0*double(t*t);
+         msd.sample(values);
+      }
+   }
+
+   /*
+   * Mean-squared displacement for lag j, using only pairs within blocks.
+   */
+   double expected(int j, int nBlock, const int* first, const int* last)
+   {
+      double sum = 0.0;
+      double d;
+      int n = 0;
+      for (int k = 0; k < nBlock; ++k) {
+         for (int t = first[k] + j; t <= last[k]; ++t) {
+            d = double(t*t - (t-j)*(t-j));
+            sum += d*d + 4.0*d*d;
+            ++n;
+         }
+      }
+      return sum/double(2*n);
+   }
+
+   /*
+   * Compare to the precision of the output format.
+   */
+   bool near(double value, double expected)
+   {  return (fabs(value - expected) <= 1.0E-6*fabs(expected) + 1.0E-12); }
+
+   /*
+   * Read output into arrays of lag values and mean-squared displacements.
+   */
+   int readOutput(MeanSqDispArray<double>& msd, DArray<double>& values)
+   {
+      std::stringstream out;
+      msd.output(out);
+      int i, j;
+      for (i = 0; i < values.capacity(); ++i) {
+         out >> j;
+         if (out.fail()) break;
+         TEST_ASSERT(j == i);
+         out >> values[i];
+      }
+      return i;
+   }
+
+   void testSample()
+   {
+      printMethod(TEST_FUNC);
+
+      MeanSqDispArray<double> msd;
+      msd.setParam(2, 5);
+      sample(msd, 0, 19);
+      TEST_ASSERT(msd.nSample() == 20);
+
+      DArray<double> values;
+      values.allocate(10);
+      TEST_ASSERT(readOutput(msd, values) == 5);
+      int first = 0;
+      int last = 19;
+      for (int j = 0; j < 5; ++j) {
+         TEST_ASSERT(near(values[j], expected(j, 1, &first, &last)));
+      }
+   }
+
+   void testMerge()
+   {
+      printMethod(TEST_FUNC);
+
+      MeanSqDispArray<double> msd1;
+      MeanSqDispArray<double> msd2;
+      msd1.setParam(2, 5);
+      msd2.setParam(2, 5);
+      sample(msd1, 0, 2);
+      sample(msd2, 3, 19);
+      msd1.merge(msd2);
+      TEST_ASSERT(msd1.nSample() == 20);
+
+      // All lags are output, though msd1 has only 3 values in its buffer
+      DArray<double> values;
+      values.allocate(10);
+      TEST_ASSERT(readOutput(msd1, values) == 5);
+      int first[2] = {0, 3};
+      int last[2]  = {2, 19};
+      for (int j = 0; j < 5; ++j) {
+         TEST_ASSERT(near(values[j], expected(j, 2, first, last)));
+      }
+   }
+
+};
+
+TEST_BEGIN(MeanSqDispArrayTest)
+TEST_ADD(MeanSqDispArrayTest, testSample)
+TEST_ADD(MeanSqDispArrayTest, testMerge)
+TEST_END(MeanSqDispArrayTest)
+
+#endif